@@ -0,0 +1,344 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ArrayLiveness.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSet>
+
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+
+#include "SIMPLView/MemoryEstimator.h"
+#include "SIMPLView/ProcessStats.h"
+
+namespace
+{
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonArray toJsonArray(const QVector<ArrayLiveness::DeadArray>& deadArrays)
+{
+  QJsonArray jsonArray;
+  for(const ArrayLiveness::DeadArray& deadArray : deadArrays)
+  {
+    QJsonObject json;
+    json["Filter Index"] = deadArray.filterIndex;
+    json["Human Label"] = deadArray.filterLabel;
+    json["Array"] = deadArray.path.serialize("/");
+    json["Bytes"] = deadArray.bytes;
+    jsonArray.append(json);
+  }
+  return jsonArray;
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ArrayLiveness::ArrayLiveness() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ArrayLiveness::~ArrayLiveness()
+{
+  for(const QMetaObject::Connection& connection : m_Connections)
+  {
+    QObject::disconnect(connection);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArrayLiveness::setKeepEverything(bool value)
+{
+  QMutexLocker locker(&m_Mutex);
+  m_KeepEverything = value;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ArrayLiveness::getKeepEverything() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_KeepEverything;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<ArraySpiller::ArrayUse> ArrayLiveness::FindArrayUses(const QList<AbstractFilter::Pointer>& filters)
+{
+  QVector<ArraySpiller::ArrayUse> uses;
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    uses.push_back(ArraySpiller::FindArrayUse(filter.get()));
+  }
+  return uses;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ArrayLiveness::LastEnabledIndex(const QList<AbstractFilter::Pointer>& filters)
+{
+  for(int i = filters.size() - 1; i >= 0; i--)
+  {
+    if(filters[i]->getEnabled())
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<ArrayLiveness::DeadArray> ArrayLiveness::FindDeadArrays(const QList<AbstractFilter::Pointer>& filters, const QVector<ArraySpiller::ArrayUse>& uses, int position,
+                                                                 const DataContainerArray::Pointer& dca)
+{
+  QVector<DeadArray> deadArrays;
+  if(dca.get() == nullptr || position >= LastEnabledIndex(filters))
+  {
+    return deadArrays;
+  }
+
+  for(DataContainer::Pointer dc : dca->getDataContainers())
+  {
+    for(AttributeMatrix::Pointer am : dc->getAttributeMatrices())
+    {
+      for(const QString& arrayName : am->getAttributeArrayNames())
+      {
+        bool live = false;
+        for(int i = position + 1; i < filters.size() && !live; i++)
+        {
+          live = filters[i]->getEnabled() && ArraySpiller::IsUsedBy(uses[i], dc->getName(), am->getName(), arrayName);
+        }
+        if(!live)
+        {
+          DeadArray deadArray;
+          deadArray.filterIndex = position;
+          deadArray.filterLabel = filters[position]->getHumanLabel();
+          deadArray.path = DataArrayPath(dc->getName(), am->getName(), arrayName);
+          deadArray.bytes = MemoryEstimator::DeclaredBytes(am->getAttributeArray(arrayName));
+          deadArrays.push_back(deadArray);
+        }
+      }
+    }
+  }
+  return deadArrays;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArrayLiveness::analyze(const QList<AbstractFilter::Pointer>& filters)
+{
+  QVector<ArraySpiller::ArrayUse> uses = FindArrayUses(filters);
+
+  // The preflight does not free anything, so an array stays in the structures behind the filter it dies at
+  QVector<DeadArray> plan;
+  QSet<QString> planned;
+  for(int i = 0; i < filters.size(); i++)
+  {
+    if(!filters[i]->getEnabled())
+    {
+      continue;
+    }
+    for(const DeadArray& deadArray : FindDeadArrays(filters, uses, i, filters[i]->getDataContainerArray()))
+    {
+      QString pathKey = deadArray.path.serialize("|");
+      if(!planned.contains(pathKey))
+      {
+        planned.insert(pathKey);
+        plan.push_back(deadArray);
+      }
+    }
+  }
+
+  QMutexLocker locker(&m_Mutex);
+  m_Plan = plan;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<ArrayLiveness::DeadArray> ArrayLiveness::getPlan() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_Plan;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArrayLiveness::attach(const QList<AbstractFilter::Pointer>& filters)
+{
+  for(const QMetaObject::Connection& connection : m_Connections)
+  {
+    QObject::disconnect(connection);
+  }
+  m_Connections.clear();
+
+  setPipeline(filters);
+
+  // Without a context object the connections are direct, the arrays have to be freed before the next filter runs
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    if(filter.get() == nullptr)
+    {
+      continue;
+    }
+    m_Connections.push_back(QObject::connect(filter.get(), &AbstractFilter::filterInProgress, [this](AbstractFilter* f) { beginFilter(f); }));
+    m_Connections.push_back(QObject::connect(filter.get(), &AbstractFilter::filterCompleted, [this](AbstractFilter* f) { endFilter(f); }));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArrayLiveness::setPipeline(const QList<AbstractFilter::Pointer>& filters)
+{
+  QMutexLocker locker(&m_Mutex);
+  m_Filters = filters;
+  m_ArrayUses.clear();
+  m_Running = false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArrayLiveness::beginFilter(AbstractFilter* filter)
+{
+  Q_UNUSED(filter)
+
+  QMutexLocker locker(&m_Mutex);
+  if(m_KeepEverything || m_Running)
+  {
+    return;
+  }
+
+  // The parameters may have been edited since the pipeline was attached
+  m_Running = true;
+  m_Dropped.clear();
+  m_ArrayUses = FindArrayUses(m_Filters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArrayLiveness::endFilter(AbstractFilter* filter)
+{
+  QMutexLocker locker(&m_Mutex);
+  if(m_KeepEverything || !m_Running || filter->getErrorCondition() < 0 || filter->getCancel())
+  {
+    return;
+  }
+
+  int position = -1;
+  for(int i = 0; i < m_Filters.size() && position < 0; i++)
+  {
+    position = (m_Filters[i].get() == filter) ? i : -1;
+  }
+  if(position < 0)
+  {
+    return;
+  }
+
+  DataContainerArray::Pointer dca = filter->getDataContainerArray();
+  for(const DeadArray& deadArray : FindDeadArrays(m_Filters, m_ArrayUses, position, dca))
+  {
+    AttributeMatrix::Pointer am = dca->getAttributeMatrix(deadArray.path);
+    if(am.get() != nullptr && am->removeAttributeArray(deadArray.path.getDataArrayName()).get() != nullptr)
+    {
+      m_Dropped.push_back(deadArray);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArrayLiveness::finishRun()
+{
+  QMutexLocker locker(&m_Mutex);
+  m_Running = false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<ArrayLiveness::DeadArray> ArrayLiveness::getDroppedArrays() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_Dropped;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ArrayLiveness::summary() const
+{
+  QMutexLocker locker(&m_Mutex);
+  if(m_KeepEverything)
+  {
+    return QString("Every array was kept");
+  }
+
+  qint64 bytes = 0;
+  for(const DeadArray& deadArray : m_Dropped)
+  {
+    bytes += deadArray.bytes;
+  }
+  return QString("%1 arrays were freed behind their last use (%2)").arg(m_Dropped.size()).arg(ProcessStats::FormatBytes(bytes));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject ArrayLiveness::toJson() const
+{
+  QMutexLocker locker(&m_Mutex);
+  QJsonObject json;
+  json["Keep Everything"] = m_KeepEverything;
+  json["Planned"] = toJsonArray(m_Plan);
+  json["Dropped"] = toJsonArray(m_Dropped);
+  return json;
+}
@@ -0,0 +1,198 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QMetaObject>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataContainers/DataArrayPath.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+#include "SIMPLView/ArraySpiller.h"
+
+/**
+ * @brief The ArrayLiveness class frees the attribute arrays of an executing pipeline once no later filter uses
+ * them. The uses are predicted from the filters' parameters the same way the ArraySpiller predicts them, so a
+ * path to a data container or attribute matrix keeps all of its arrays alive and a writer keeps everything that
+ * exists when it runs. An array is freed behind its last use; the arrays that exist behind the last enabled
+ * filter are kept as the result of the run.
+ *
+ * analyze() works on the preflight DataContainerArrays of the filters and lists the arrays a run would free.
+ * During the run the same rule is applied to the arrays that actually exist.
+ */
+class ArrayLiveness
+{
+public:
+  SIMPL_SHARED_POINTERS(ArrayLiveness)
+
+  static Pointer New()
+  {
+    Pointer sharedPtr(new ArrayLiveness());
+    return sharedPtr;
+  }
+
+  struct DeadArray
+  {
+    int filterIndex = -1;
+    QString filterLabel;
+    DataArrayPath path;
+    qint64 bytes = 0;
+  };
+
+  virtual ~ArrayLiveness();
+
+  /**
+   * @brief setKeepEverything Turns freeing off, for looking at intermediate arrays while debugging a pipeline
+   * @param value
+   */
+  void setKeepEverything(bool value);
+
+  /**
+   * @brief getKeepEverything
+   * @return
+   */
+  bool getKeepEverything() const;
+
+  /**
+   * @brief analyze Finds the arrays a run would free from the preflight DataContainerArray of each filter
+   * @param filters The preflighted filters of the pipeline in execution order
+   */
+  void analyze(const QList<AbstractFilter::Pointer>& filters);
+
+  /**
+   * @brief getPlan
+   * @return The arrays the last analysis found, with the filter they are freed behind
+   */
+  QVector<DeadArray> getPlan() const;
+
+  /**
+   * @brief attach Listens to the filters' filterInProgress and filterCompleted signals. Must not be called while
+   * the filters are executing.
+   * @param filters The filters of the pipeline in execution order
+   */
+  void attach(const QList<AbstractFilter::Pointer>& filters);
+
+  /**
+   * @brief setPipeline Starts over with the filters without listening to them, for callers that call
+   * beginFilter and endFilter themselves
+   * @param filters
+   */
+  void setPipeline(const QList<AbstractFilter::Pointer>& filters);
+
+  /**
+   * @brief beginFilter Predicts the uses of every filter when a run starts
+   * @param filter
+   */
+  void beginFilter(AbstractFilter* filter);
+
+  /**
+   * @brief endFilter Frees the arrays that no filter behind this one uses
+   * @param filter
+   */
+  void endFilter(AbstractFilter* filter);
+
+  /**
+   * @brief finishRun
+   */
+  void finishRun();
+
+  /**
+   * @brief getDroppedArrays
+   * @return The arrays the current or the last run freed
+   */
+  QVector<DeadArray> getDroppedArrays() const;
+
+  /**
+   * @brief summary
+   * @return A one line summary of the current or the last run
+   */
+  QString summary() const;
+
+  /**
+   * @brief toJson
+   * @return
+   */
+  QJsonObject toJson() const;
+
+protected:
+  ArrayLiveness();
+
+  /**
+   * @brief FindArrayUses
+   * @param filters
+   * @return The predicted uses of every filter
+   */
+  static QVector<ArraySpiller::ArrayUse> FindArrayUses(const QList<AbstractFilter::Pointer>& filters);
+
+  /**
+   * @brief LastEnabledIndex
+   * @param filters
+   * @return
+   */
+  static int LastEnabledIndex(const QList<AbstractFilter::Pointer>& filters);
+
+  /**
+   * @brief FindDeadArrays
+   * @param filters
+   * @param uses
+   * @param position The filter that just executed or preflighted
+   * @param dca Its DataContainerArray
+   * @return The arrays in the DataContainerArray that no enabled filter behind the position uses
+   */
+  static QVector<DeadArray> FindDeadArrays(const QList<AbstractFilter::Pointer>& filters, const QVector<ArraySpiller::ArrayUse>& uses, int position,
+                                           const DataContainerArray::Pointer& dca);
+
+private:
+  bool m_KeepEverything = false;
+
+  mutable QMutex m_Mutex;
+  QList<AbstractFilter::Pointer> m_Filters;
+  QVector<ArraySpiller::ArrayUse> m_ArrayUses;
+  QList<QMetaObject::Connection> m_Connections;
+
+  bool m_Running = false;
+  QVector<DeadArray> m_Plan;
+  QVector<DeadArray> m_Dropped;
+
+  ArrayLiveness(const ArrayLiveness&) = delete;  // Copy Constructor Not Implemented
+  void operator=(const ArrayLiveness&) = delete; // Move assignment Not Implemented
+};
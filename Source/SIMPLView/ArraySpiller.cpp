@@ -0,0 +1,864 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ArraySpiller.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QMutexLocker>
+
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/DataContainerArrayProxyFilterParameter.h"
+#include "SIMPLib/FilterParameters/DataContainerSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/MultiDataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/OutputPathFilterParameter.h"
+
+#include "SIMPLView/ProcessStats.h"
+
+namespace
+{
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString pathKey(const QString& dataContainer, const QString& attributeMatrix = QString(), const QString& arrayName = QString())
+{
+  if(attributeMatrix.isEmpty())
+  {
+    return dataContainer;
+  }
+  if(arrayName.isEmpty())
+  {
+    return dataContainer + "|" + attributeMatrix;
+  }
+  return dataContainer + "|" + attributeMatrix + "|" + arrayName;
+}
+
+// -----------------------------------------------------------------------------
+// DataArrayPaths are written as objects with these three keys, a data container selection may also be a plain name
+// -----------------------------------------------------------------------------
+void collectPaths(const QJsonValue& value, QSet<QString>& paths)
+{
+  if(value.isObject())
+  {
+    QJsonObject obj = value.toObject();
+    if(obj.contains("Data Container Name"))
+    {
+      QString dataContainer = obj["Data Container Name"].toString();
+      if(!dataContainer.isEmpty())
+      {
+        paths.insert(pathKey(dataContainer, obj["Attribute Matrix Name"].toString(), obj["Data Array Name"].toString()));
+      }
+    }
+    for(const QJsonValue& child : obj)
+    {
+      collectPaths(child, paths);
+    }
+  }
+  else if(value.isArray())
+  {
+    for(const QJsonValue& child : value.toArray())
+    {
+      collectPaths(child, paths);
+    }
+  }
+  else if(value.isString() && !value.toString().isEmpty())
+  {
+    paths.insert(pathKey(value.toString()));
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Adds the attribute matrix of every array path
+// -----------------------------------------------------------------------------
+void addAttributeMatrices(QSet<QString>& paths)
+{
+  for(const QString& path : QSet<QString>(paths))
+  {
+    QStringList parts = path.split('|');
+    if(parts.size() == 3)
+    {
+      paths.insert(pathKey(parts[0], parts[1]));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Collects the checked arrays of a DataContainerArrayProxy written as Json
+// -----------------------------------------------------------------------------
+void collectCheckedPaths(const QJsonObject& proxy, QSet<QString>& paths)
+{
+  for(const QJsonValue& dcValue : proxy["Data Containers"].toArray())
+  {
+    QJsonObject dcObj = dcValue.toObject();
+    if(dcObj["Flag"].toInt() == Qt::Unchecked)
+    {
+      continue;
+    }
+    for(const QJsonValue& amValue : dcObj["Attribute Matricies"].toArray())
+    {
+      QJsonObject amObj = amValue.toObject();
+      if(amObj["Flag"].toInt() == Qt::Unchecked)
+      {
+        continue;
+      }
+      for(const QJsonValue& daValue : amObj["Data Arrays"].toArray())
+      {
+        QJsonObject daObj = daValue.toObject();
+        if(daObj["Flag"].toInt() == Qt::Checked)
+        {
+          paths.insert(pathKey(dcObj["Name"].toString(), amObj["Name"].toString(), daObj["Name"].toString()));
+        }
+      }
+    }
+  }
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ArraySpiller::ArraySpiller()
+: m_ScratchDirectory(QDir(QDir::tempPath()).filePath(QString("SIMPLView-Spill-%1").arg(QCoreApplication::applicationPid())))
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ArraySpiller::~ArraySpiller()
+{
+  for(const QMetaObject::Connection& connection : m_Connections)
+  {
+    QObject::disconnect(connection);
+  }
+
+  for(const SpilledArray& spilled : m_Spilled)
+  {
+    QFile::remove(spilled.filePath);
+  }
+  QDir().rmdir(m_ScratchDirectory);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArraySpiller::setBudgetMB(qint64 budgetMB)
+{
+  QMutexLocker locker(&m_Mutex);
+  m_BudgetBytes = qMax(0LL, budgetMB) * 1024 * 1024;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ArraySpiller::getBudgetMB() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_BudgetBytes / (1024 * 1024);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArraySpiller::setScratchDirectory(const QString& dirPath)
+{
+  QMutexLocker locker(&m_Mutex);
+  m_ScratchDirectory = dirPath;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArraySpiller::setActivityHandler(const ActivityHandler& handler)
+{
+  QMutexLocker locker(&m_Mutex);
+  m_ActivityHandler = handler;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArraySpiller::attach(const QList<AbstractFilter::Pointer>& filters)
+{
+  for(const QMetaObject::Connection& connection : m_Connections)
+  {
+    QObject::disconnect(connection);
+  }
+  m_Connections.clear();
+
+  setPipeline(filters);
+
+  // Without a context object the connections are direct, the arrays have to be moved on the executing thread
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    if(filter.get() == nullptr)
+    {
+      continue;
+    }
+    m_Connections.push_back(QObject::connect(filter.get(), &AbstractFilter::filterInProgress, [this](AbstractFilter* f) { beginFilter(f); }));
+    m_Connections.push_back(QObject::connect(filter.get(), &AbstractFilter::filterCompleted, [this](AbstractFilter* f) { endFilter(f); }));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArraySpiller::setPipeline(const QList<AbstractFilter::Pointer>& filters)
+{
+  QMutexLocker locker(&m_Mutex);
+  m_Filters = filters;
+  m_ArrayUses.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ArraySpiller::ArrayUse ArraySpiller::FindArrayUse(AbstractFilter* filter)
+{
+  ArrayUse use;
+  bool writesFile = false;
+  bool selectsData = false;
+  for(FilterParameter::Pointer parameter : filter->getFilterParameters())
+  {
+    FilterParameter* p = parameter.get();
+    if(dynamic_cast<OutputFileFilterParameter*>(p) != nullptr || dynamic_cast<OutputPathFilterParameter*>(p) != nullptr)
+    {
+      writesFile = true;
+      continue;
+    }
+    if(dynamic_cast<DataContainerArrayProxyFilterParameter*>(p) != nullptr)
+    {
+      // Only the arrays checked in the proxy are read, whatever else is in the data container array
+      selectsData = true;
+      QJsonObject json;
+      parameter->writeJson(json);
+      collectCheckedPaths(json[parameter->getPropertyName()].toObject(), use.paths);
+      continue;
+    }
+    if(dynamic_cast<DataArraySelectionFilterParameter*>(p) == nullptr && dynamic_cast<MultiDataArraySelectionFilterParameter*>(p) == nullptr &&
+       dynamic_cast<AttributeMatrixSelectionFilterParameter*>(p) == nullptr && dynamic_cast<DataContainerSelectionFilterParameter*>(p) == nullptr)
+    {
+      continue;
+    }
+
+    // The parameter writes the filter's current selection under its property name
+    selectsData = true;
+    QJsonObject json;
+    parameter->writeJson(json);
+    collectPaths(json[parameter->getPropertyName()], use.paths);
+  }
+
+  // A filter that writes a file without selecting what goes into it, like a DataContainerWriter without a proxy, writes everything
+  use.usesEverything = writesFile && !selectsData;
+  return use;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ArraySpiller::IsUsedBy(const ArrayUse& use, const QString& dataContainer, const QString& attributeMatrix, const QString& arrayName)
+{
+  return use.usesEverything || use.paths.contains(pathKey(dataContainer)) || use.paths.contains(pathKey(dataContainer, attributeMatrix)) ||
+         use.paths.contains(pathKey(dataContainer, attributeMatrix, arrayName));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ArraySpiller::nextUse(int position, const QString& dataContainer, const QString& attributeMatrix, const QString& arrayName) const
+{
+  for(int i = position; i < m_Filters.size(); i++)
+  {
+    if(m_Filters[i]->getEnabled() && IsUsedBy(m_ArrayUses[i], dataContainer, attributeMatrix, arrayName))
+    {
+      return i;
+    }
+  }
+  return m_Filters.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ArraySpiller::ArrayBytes(const IDataArray::Pointer& array)
+{
+  if(array.get() == nullptr)
+  {
+    return 0;
+  }
+  return static_cast<qint64>(array->getSize()) * array->getTypeSize();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArraySpiller::beginFilter(AbstractFilter* filter)
+{
+  QMutexLocker locker(&m_Mutex);
+  if(m_BudgetBytes <= 0)
+  {
+    return;
+  }
+
+  int position = -1;
+  for(int i = 0; i < m_Filters.size() && position < 0; i++)
+  {
+    position = (m_Filters[i].get() == filter) ? i : -1;
+  }
+  if(position < 0)
+  {
+    return;
+  }
+
+  if(!m_Running)
+  {
+    // The arrays the last run left on disk belong to the result that this run replaces
+    for(const SpilledArray& spilled : m_Spilled)
+    {
+      QFile::remove(spilled.filePath);
+    }
+    m_Spilled.clear();
+
+    m_Running = true;
+    m_RunTimer.start();
+    m_Events.clear();
+    m_DroppedArrays.clear();
+    m_PeakBytes = 0;
+    m_ArrayUses.clear();
+  }
+  if(m_ArrayUses.size() != m_Filters.size())
+  {
+    // The parameters cannot change until the run has finished
+    m_ArrayUses.clear();
+    for(const AbstractFilter::Pointer& f : m_Filters)
+    {
+      // Removing or reordering tuples touches every array of the attribute matrix, not just the selected ones
+      ArrayUse use = FindArrayUse(f.get());
+      addAttributeMatrices(use.paths);
+      m_ArrayUses.push_back(use);
+    }
+  }
+
+  m_DataContainerArray = filter->getDataContainerArray();
+  refill(m_DataContainerArray, position);
+  spill(m_DataContainerArray, position);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArraySpiller::endFilter(AbstractFilter* filter)
+{
+  QMutexLocker locker(&m_Mutex);
+  if(!m_Running)
+  {
+    return;
+  }
+
+  int position = -1;
+  for(int i = 0; i < m_Filters.size() && position < 0; i++)
+  {
+    position = (m_Filters[i].get() == filter) ? i : -1;
+  }
+  if(position < 0)
+  {
+    return;
+  }
+
+  m_DataContainerArray = filter->getDataContainerArray();
+  spill(m_DataContainerArray, position + 1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArraySpiller::refill(const DataContainerArray::Pointer& dca, int position)
+{
+  for(int i = 0; i < m_Spilled.size();)
+  {
+    const SpilledArray& spilled = m_Spilled[i];
+    if(IsUsedBy(m_ArrayUses[position], spilled.dataContainer, spilled.attributeMatrix, spilled.array->getName()) && refillArray(dca, spilled, position))
+    {
+      m_Spilled.removeAt(i);
+    }
+    else
+    {
+      i++;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArraySpiller::spill(const DataContainerArray::Pointer& dca, int position)
+{
+  if(dca.get() == nullptr)
+  {
+    return;
+  }
+
+  struct Candidate
+  {
+    QString dataContainer;
+    QString attributeMatrix;
+    QString arrayName;
+    qint64 bytes = 0;
+    int nextUse = 0;
+  };
+
+  qint64 usedBytes = 0;
+  QVector<Candidate> candidates;
+  for(DataContainer::Pointer dc : dca->getDataContainers())
+  {
+    for(AttributeMatrix::Pointer am : dc->getAttributeMatrices())
+    {
+      for(const QString& arrayName : am->getAttributeArrayNames())
+      {
+        Candidate candidate;
+        candidate.bytes = ArrayBytes(am->getAttributeArray(arrayName));
+        usedBytes += candidate.bytes;
+
+        bool usedNow = position < m_Filters.size() && IsUsedBy(m_ArrayUses[position], dc->getName(), am->getName(), arrayName);
+        if(candidate.bytes > 0 && !usedNow)
+        {
+          candidate.dataContainer = dc->getName();
+          candidate.attributeMatrix = am->getName();
+          candidate.arrayName = arrayName;
+          candidate.nextUse = nextUse(position, candidate.dataContainer, candidate.attributeMatrix, arrayName);
+          candidates.push_back(candidate);
+        }
+      }
+    }
+  }
+  m_PeakBytes = qMax(m_PeakBytes, usedBytes);
+
+  if(usedBytes <= m_BudgetBytes)
+  {
+    return;
+  }
+
+  // Arrays needed again last go first, the largest of those first
+  std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) { return (a.nextUse != b.nextUse) ? (a.nextUse > b.nextUse) : (a.bytes > b.bytes); });
+  for(const Candidate& candidate : candidates)
+  {
+    if(usedBytes <= m_BudgetBytes)
+    {
+      break;
+    }
+    if(spillArray(dca, candidate.dataContainer, candidate.attributeMatrix, candidate.arrayName, position))
+    {
+      usedBytes -= candidate.bytes;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ArraySpiller::spillArray(const DataContainerArray::Pointer& dca, const QString& dataContainer, const QString& attributeMatrix, const QString& arrayName, int position)
+{
+  AttributeMatrix::Pointer am = dca->getDataContainer(dataContainer)->getAttributeMatrix(attributeMatrix);
+  IDataArray::Pointer array = am->getAttributeArray(arrayName);
+  qint64 bytes = ArrayBytes(array);
+  if(bytes <= 0 || !QDir().mkpath(m_ScratchDirectory))
+  {
+    return false;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+
+  SpilledArray spilled;
+  spilled.dataContainer = dataContainer;
+  spilled.attributeMatrix = attributeMatrix;
+  spilled.array = array;
+  spilled.numberOfTuples = array->getNumberOfTuples();
+  spilled.bytes = bytes;
+  spilled.filePath = QDir(m_ScratchDirectory).filePath(QString("Array_%1.raw").arg(m_FileCounter++));
+
+  QFile file(spilled.filePath);
+  if(!file.open(QIODevice::ReadWrite | QIODevice::Truncate) || !file.resize(bytes))
+  {
+    file.remove();
+    return false;
+  }
+  uchar* mapped = file.map(0, bytes);
+  if(mapped == nullptr)
+  {
+    file.remove();
+    return false;
+  }
+  std::memcpy(mapped, array->getVoidPointer(0), static_cast<size_t>(bytes));
+  file.unmap(mapped);
+  file.close();
+
+  // The array object survives outside of its attribute matrix with no memory behind it
+  am->removeAttributeArray(arrayName);
+  array->resizeTuples(0);
+  m_Spilled.push_back(spilled);
+
+  Event event;
+  event.spill = true;
+  event.filterIndex = position;
+  event.arrayPath = pathKey(dataContainer, attributeMatrix, arrayName).replace('|', '/');
+  event.bytes = bytes;
+  event.ioMSecs = timer.elapsed();
+  report(event);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ArraySpiller::refillArray(const DataContainerArray::Pointer& dca, const SpilledArray& spilled, int position)
+{
+  QElapsedTimer timer;
+  timer.start();
+
+  QFile file(spilled.filePath);
+  DataContainer::Pointer dc = dca->getDataContainer(spilled.dataContainer);
+  AttributeMatrix::Pointer am = (dc.get() != nullptr) ? dc->getAttributeMatrix(spilled.attributeMatrix) : AttributeMatrix::NullPointer();
+  if(am.get() == nullptr || am->doesAttributeArrayExist(spilled.array->getName()))
+  {
+    // A filter removed the attribute matrix or replaced the array, the spilled copy is not needed anymore
+    file.remove();
+    return true;
+  }
+
+  QString arrayPath = pathKey(spilled.dataContainer, spilled.attributeMatrix, spilled.array->getName()).replace('|', '/');
+  if(am->getNumberOfTuples() != spilled.numberOfTuples)
+  {
+    // A filter resized the attribute matrix while the array was out, its values no longer line up with the tuples
+    file.remove();
+    m_DroppedArrays.push_back(arrayPath);
+    if(m_ActivityHandler)
+    {
+      m_ActivityHandler(QString("Dropped %1: its attribute matrix now has %2 tuples instead of %3").arg(arrayPath).arg(am->getNumberOfTuples()).arg(spilled.numberOfTuples));
+    }
+    return true;
+  }
+
+  if(!ReadSpilledFile(spilled))
+  {
+    // The scratch file stays, the array can be mapped back in later
+    if(m_ActivityHandler)
+    {
+      m_ActivityHandler(QString("Could not map %1 back in from %2").arg(arrayPath, spilled.filePath));
+    }
+    return false;
+  }
+  file.remove();
+
+  am->addAttributeArray(spilled.array->getName(), spilled.array);
+
+  Event event;
+  event.spill = false;
+  event.filterIndex = position;
+  event.arrayPath = arrayPath;
+  event.bytes = spilled.bytes;
+  event.ioMSecs = timer.elapsed();
+  report(event);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ArraySpiller::ReadSpilledFile(const SpilledArray& spilled)
+{
+  QFile file(spilled.filePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return false;
+  }
+  uchar* mapped = file.map(0, spilled.bytes);
+  if(mapped == nullptr)
+  {
+    return false;
+  }
+  spilled.array->resizeTuples(spilled.numberOfTuples);
+  std::memcpy(spilled.array->getVoidPointer(0), mapped, static_cast<size_t>(spilled.bytes));
+  file.unmap(mapped);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ArraySpiller::visitSpilledArrays(const DataContainerArray::Pointer& dca, const SpilledArrayHandler& handler)
+{
+  QMutexLocker locker(&m_Mutex);
+  int visited = 0;
+  for(const SpilledArray& spilled : m_Spilled)
+  {
+    DataContainer::Pointer dc = dca->getDataContainer(spilled.dataContainer);
+    AttributeMatrix::Pointer am = (dc.get() != nullptr) ? dc->getAttributeMatrix(spilled.attributeMatrix) : AttributeMatrix::NullPointer();
+    if(am.get() == nullptr || am->doesAttributeArrayExist(spilled.array->getName()) || am->getNumberOfTuples() != spilled.numberOfTuples)
+    {
+      continue;
+    }
+    if(!ReadSpilledFile(spilled))
+    {
+      return -1;
+    }
+    bool handled = handler(spilled.dataContainer, am, spilled.array);
+    spilled.array->resizeTuples(0);
+    if(!handled)
+    {
+      return -1;
+    }
+    visited++;
+  }
+  return visited;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArraySpiller::report(const Event& event)
+{
+  Event timedEvent = event;
+  timedEvent.timeMSecs = m_RunTimer.elapsed();
+  m_Events.push_back(timedEvent);
+
+  if(m_ActivityHandler)
+  {
+    QString action = event.spill ? "Spilled" : "Mapped back";
+    m_ActivityHandler(QString("%1 %2 (%3) in %4 ms").arg(action, event.arrayPath, ProcessStats::FormatBytes(event.bytes)).arg(event.ioMSecs));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArraySpiller::finishRun()
+{
+  QMutexLocker locker(&m_Mutex);
+  if(!m_Running)
+  {
+    return;
+  }
+
+  // Whatever fits goes back, so that the data browser shows the complete result
+  refillWithinBudget(m_DataContainerArray);
+  m_Running = false;
+  if(m_Spilled.isEmpty())
+  {
+    m_DataContainerArray.reset();
+    QDir().rmdir(m_ScratchDirectory);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ArraySpiller::restoreSpilledArrays()
+{
+  QMutexLocker locker(&m_Mutex);
+  if(m_Running)
+  {
+    return m_Spilled.size();
+  }
+
+  refillWithinBudget(m_DataContainerArray);
+  if(m_Spilled.isEmpty())
+  {
+    m_DataContainerArray.reset();
+    QDir().rmdir(m_ScratchDirectory);
+  }
+  return m_Spilled.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArraySpiller::refillWithinBudget(const DataContainerArray::Pointer& dca)
+{
+  if(dca.get() == nullptr)
+  {
+    return;
+  }
+
+  qint64 usedBytes = 0;
+  for(DataContainer::Pointer dc : dca->getDataContainers())
+  {
+    for(AttributeMatrix::Pointer am : dc->getAttributeMatrices())
+    {
+      for(const QString& arrayName : am->getAttributeArrayNames())
+      {
+        usedBytes += ArrayBytes(am->getAttributeArray(arrayName));
+      }
+    }
+  }
+
+  // Without a budget, e.g. when it was turned off during the run, everything goes back
+  qint64 limitBytes = (m_BudgetBytes > 0) ? m_BudgetBytes : std::numeric_limits<qint64>::max();
+  for(int i = 0; i < m_Spilled.size();)
+  {
+    const SpilledArray& spilled = m_Spilled[i];
+    if(usedBytes > limitBytes - spilled.bytes || !refillArray(dca, spilled, m_Filters.size()))
+    {
+      i++;
+      continue;
+    }
+    // An array that was dropped or replaced stays empty
+    usedBytes += ArrayBytes(spilled.array);
+    m_Spilled.removeAt(i);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<ArraySpiller::Event> ArraySpiller::getEvents() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_Events;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList ArraySpiller::getDroppedArrays() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_DroppedArrays;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList ArraySpiller::getArraysOnDisk() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return arraysOnDisk();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList ArraySpiller::arraysOnDisk() const
+{
+  QStringList arrayPaths;
+  if(m_Running)
+  {
+    return arrayPaths;
+  }
+  for(const SpilledArray& spilled : m_Spilled)
+  {
+    arrayPaths.push_back(pathKey(spilled.dataContainer, spilled.attributeMatrix, spilled.array->getName()).replace('|', '/'));
+  }
+  return arrayPaths;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ArraySpiller::summary() const
+{
+  QMutexLocker locker(&m_Mutex);
+
+  int spills = 0;
+  int refills = 0;
+  qint64 spilledBytes = 0;
+  qint64 refilledBytes = 0;
+  for(const Event& event : m_Events)
+  {
+    (event.spill ? spills : refills)++;
+    (event.spill ? spilledBytes : refilledBytes) += event.bytes;
+  }
+
+  QString text = QString("Memory budget %1: peak %2 in arrays, %3 arrays spilled (%4), %5 mapped back (%6)")
+                     .arg(ProcessStats::FormatBytes(m_BudgetBytes), ProcessStats::FormatBytes(m_PeakBytes))
+                     .arg(spills)
+                     .arg(ProcessStats::FormatBytes(spilledBytes))
+                     .arg(refills)
+                     .arg(ProcessStats::FormatBytes(refilledBytes));
+  QStringList onDisk = arraysOnDisk();
+  if(!onDisk.isEmpty())
+  {
+    text += QString(", %1 arrays did not fit back and stay on disk until the budget allows them: %2").arg(onDisk.size()).arg(onDisk.join(", "));
+  }
+  if(!m_DroppedArrays.isEmpty())
+  {
+    text += QString(", %1 arrays were dropped because their attribute matrix was resized: %2").arg(m_DroppedArrays.size()).arg(m_DroppedArrays.join(", "));
+  }
+  return text;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject ArraySpiller::toJson() const
+{
+  QMutexLocker locker(&m_Mutex);
+
+  QJsonArray events;
+  qint64 spilledBytes = 0;
+  qint64 refilledBytes = 0;
+  for(const Event& event : m_Events)
+  {
+    QJsonObject obj;
+    obj["Time MSecs"] = event.timeMSecs;
+    obj["Action"] = event.spill ? QString("Spill") : QString("Refill");
+    obj["Filter Index"] = event.filterIndex;
+    obj["Array"] = event.arrayPath;
+    obj["Bytes"] = event.bytes;
+    obj["IO MSecs"] = event.ioMSecs;
+    events.append(obj);
+    (event.spill ? spilledBytes : refilledBytes) += event.bytes;
+  }
+
+  QJsonObject report;
+  report["Budget MB"] = m_BudgetBytes / (1024 * 1024);
+  report["Peak Array Bytes"] = m_PeakBytes;
+  report["Spilled Bytes"] = spilledBytes;
+  report["Refilled Bytes"] = refilledBytes;
+  report["Dropped Arrays"] = QJsonArray::fromStringList(m_DroppedArrays);
+  report["Arrays On Disk"] = QJsonArray::fromStringList(arraysOnDisk());
+  report["Events"] = events;
+  return report;
+}
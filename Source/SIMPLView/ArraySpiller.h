@@ -0,0 +1,326 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <functional>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QMetaObject>
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+/**
+ * @brief The ArraySpiller class keeps the attribute arrays of an executing pipeline within a memory budget.
+ * Before and after every filter it adds up the bytes held by the DataContainerArray. Above the budget it moves
+ * the arrays whose next use is furthest away into memory-mapped scratch files and takes them out of their
+ * attribute matrix. Before a filter executes, the spilled arrays it uses are mapped back in.
+ *
+ * SIMPL arrays cannot fault pages in on access, so the arrays a filter uses are predicted from its data array,
+ * attribute matrix and data container selection parameters: a path to a data container or attribute matrix
+ * covers all of its arrays and filters that write a file without selecting any data get every array back.
+ * Filters resize or reorder whole attribute matrices, e.g. when they remove features, so a filter that selects
+ * one array of an attribute matrix gets all of its arrays back. Arrays that no filter references are the first
+ * to go. An array whose attribute matrix was resized anyway while it was spilled can not be mapped back and is
+ * dropped.
+ */
+class ArraySpiller
+{
+public:
+  SIMPL_SHARED_POINTERS(ArraySpiller)
+
+  static Pointer New()
+  {
+    Pointer sharedPtr(new ArraySpiller());
+    return sharedPtr;
+  }
+
+  using ActivityHandler = std::function<void(const QString&)>;
+  using SpilledArrayHandler = std::function<bool(const QString& dataContainer, const AttributeMatrix::Pointer& attributeMatrix, const IDataArray::Pointer& array)>;
+
+  struct Event
+  {
+    qint64 timeMSecs = 0;
+    bool spill = true;
+    int filterIndex = -1;
+    QString arrayPath;
+    qint64 bytes = 0;
+    qint64 ioMSecs = 0;
+  };
+
+  struct ArrayUse
+  {
+    QSet<QString> paths;
+    bool usesEverything = false;
+  };
+
+  virtual ~ArraySpiller();
+
+  /**
+   * @brief setBudgetMB A budget of 0 turns spilling off
+   * @param budgetMB
+   */
+  void setBudgetMB(qint64 budgetMB);
+
+  /**
+   * @brief getBudgetMB
+   * @return
+   */
+  qint64 getBudgetMB() const;
+
+  /**
+   * @brief setScratchDirectory Defaults to a directory in the system's temporary directory
+   * @param dirPath
+   */
+  void setScratchDirectory(const QString& dirPath);
+
+  /**
+   * @brief setActivityHandler The handler is called on the executing thread for every spill and refill
+   * @param handler
+   */
+  void setActivityHandler(const ActivityHandler& handler);
+
+  /**
+   * @brief attach Predicts the arrays each filter uses and listens to the filters' filterInProgress and
+   * filterCompleted signals. Must not be called while the filters are executing.
+   * @param filters The filters of the pipeline in execution order
+   */
+  void attach(const QList<AbstractFilter::Pointer>& filters);
+
+  /**
+   * @brief setPipeline Predicts the arrays each filter uses without listening to the filters, for callers
+   * that call beginFilter and endFilter themselves
+   * @param filters
+   */
+  void setPipeline(const QList<AbstractFilter::Pointer>& filters);
+
+  /**
+   * @brief beginFilter Maps the arrays the filter uses back in, then spills others if the budget is exceeded
+   * @param filter
+   */
+  void beginFilter(AbstractFilter* filter);
+
+  /**
+   * @brief endFilter Spills arrays if the filter left the DataContainerArray above the budget
+   * @param filter
+   */
+  void endFilter(AbstractFilter* filter);
+
+  /**
+   * @brief finishRun Maps back in as many spilled arrays as the budget allows. Arrays that do not fit stay in
+   * their scratch files, outside of the DataContainerArray, until restoreSpilledArrays maps them back in or the
+   * next run replaces the result.
+   */
+  void finishRun();
+
+  /**
+   * @brief restoreSpilledArrays Maps the arrays that the last run left in scratch files back in as far as the
+   * current budget allows, all of them without a budget. Does nothing while a run is executing.
+   * @return The number of arrays that are still in scratch files
+   */
+  int restoreSpilledArrays();
+
+  /**
+   * @brief visitSpilledArrays Reads the spilled arrays back one at a time and hands each to the handler, e.g. to add
+   * it to a checkpoint of the whole DataContainerArray. An array is emptied again before the next one is read, so
+   * that no more than one of them is held in memory. The arrays stay outside of their attribute matrices and keep
+   * their scratch files. Arrays whose attribute matrix was removed or resized are skipped.
+   * @param dca
+   * @param handler Returns false if it failed
+   * @return The number of arrays handed to the handler, or -1 if one could not be read or the handler failed
+   */
+  int visitSpilledArrays(const DataContainerArray::Pointer& dca, const SpilledArrayHandler& handler);
+
+  /**
+   * @brief getEvents
+   * @return The spills and refills of the current or the last run
+   */
+  QVector<Event> getEvents() const;
+
+  /**
+   * @brief getDroppedArrays
+   * @return The arrays the last run could not map back in because their attribute matrix was resized
+   */
+  QStringList getDroppedArrays() const;
+
+  /**
+   * @brief getArraysOnDisk
+   * @return The arrays that did not fit back in at the end of the last run and are still in scratch files
+   */
+  QStringList getArraysOnDisk() const;
+
+  /**
+   * @brief summary
+   * @return A one line summary of the current or the last run
+   */
+  QString summary() const;
+
+  /**
+   * @brief toJson
+   * @return The report of the current or the last run
+   */
+  QJsonObject toJson() const;
+
+  /**
+   * @brief ArrayBytes
+   * @param array
+   * @return
+   */
+  static qint64 ArrayBytes(const IDataArray::Pointer& array);
+
+  /**
+   * @brief FindArrayUse Collects the data paths of the filter's selection parameters and the checked arrays of its proxy parameters
+   * @param filter
+   * @return
+   */
+  static ArrayUse FindArrayUse(AbstractFilter* filter);
+
+  /**
+   * @brief IsUsedBy
+   * @param use
+   * @param dataContainer
+   * @param attributeMatrix
+   * @param arrayName
+   * @return
+   */
+  static bool IsUsedBy(const ArrayUse& use, const QString& dataContainer, const QString& attributeMatrix, const QString& arrayName);
+
+protected:
+  ArraySpiller();
+
+  struct SpilledArray
+  {
+    QString dataContainer;
+    QString attributeMatrix;
+    IDataArray::Pointer array;
+    size_t numberOfTuples = 0;
+    qint64 bytes = 0;
+    QString filePath;
+  };
+
+  /**
+   * @brief nextUse
+   * @param position The position in the pipeline to look from
+   * @param dataContainer
+   * @param attributeMatrix
+   * @param arrayName
+   * @return The position of the next filter that uses the array, or the number of filters if none does
+   */
+  int nextUse(int position, const QString& dataContainer, const QString& attributeMatrix, const QString& arrayName) const;
+
+  /**
+   * @brief refill Maps the spilled arrays the filter at the position uses back in, m_Mutex must be held
+   * @param dca
+   * @param position
+   */
+  void refill(const DataContainerArray::Pointer& dca, int position);
+
+  /**
+   * @brief spill Spills arrays not used by the filter at the position until the budget is met, m_Mutex must be held
+   * @param dca
+   * @param position
+   */
+  void spill(const DataContainerArray::Pointer& dca, int position);
+
+  /**
+   * @brief spillArray m_Mutex must be held
+   * @return
+   */
+  bool spillArray(const DataContainerArray::Pointer& dca, const QString& dataContainer, const QString& attributeMatrix, const QString& arrayName, int position);
+
+  /**
+   * @brief refillArray m_Mutex must be held
+   * @return False if the scratch file could not be read and the array stays spilled
+   */
+  bool refillArray(const DataContainerArray::Pointer& dca, const SpilledArray& spilled, int position);
+
+  /**
+   * @brief refillWithinBudget Maps spilled arrays back in until the next one would exceed the budget, m_Mutex must be held
+   * @param dca
+   */
+  void refillWithinBudget(const DataContainerArray::Pointer& dca);
+
+  /**
+   * @brief arraysOnDisk m_Mutex must be held
+   * @return The paths of the arrays the last run left in scratch files
+   */
+  QStringList arraysOnDisk() const;
+
+  /**
+   * @brief ReadSpilledFile Sizes the array again and copies its values back from the scratch file, which is kept
+   * @param spilled
+   * @return
+   */
+  static bool ReadSpilledFile(const SpilledArray& spilled);
+
+  /**
+   * @brief report
+   * @param event
+   */
+  void report(const Event& event);
+
+private:
+  qint64 m_BudgetBytes = 0;
+  QString m_ScratchDirectory;
+  ActivityHandler m_ActivityHandler;
+
+  mutable QMutex m_Mutex;
+  QList<AbstractFilter::Pointer> m_Filters;
+  QVector<ArrayUse> m_ArrayUses;
+  QList<QMetaObject::Connection> m_Connections;
+
+  bool m_Running = false;
+  QElapsedTimer m_RunTimer;
+  DataContainerArray::Pointer m_DataContainerArray;
+  QList<SpilledArray> m_Spilled;
+  int m_FileCounter = 0;
+  qint64 m_PeakBytes = 0;
+  QVector<Event> m_Events;
+  QStringList m_DroppedArrays;
+
+  ArraySpiller(const ArraySpiller&) = delete;  // Copy Constructor Not Implemented
+  void operator=(const ArraySpiller&) = delete; // Move assignment Not Implemented
+};
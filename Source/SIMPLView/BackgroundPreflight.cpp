@@ -0,0 +1,432 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "BackgroundPreflight.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QMetaProperty>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSet>
+#include <QtCore/QTimer>
+
+#include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+
+#include "SVWidgetsLib/QtSupport/QtSSettings.h"
+#include "SVWidgetsLib/Widgets/PipelineModel.h"
+#include "SVWidgetsLib/Widgets/SVPipelineView.h"
+
+#include "SIMPLView/StageCache.h"
+
+namespace
+{
+// -----------------------------------------------------------------------------
+// The properties a filter class adds to AbstractFilter that are not filter parameters, e.g. the header
+// values a reader found in its file during the preflight
+// -----------------------------------------------------------------------------
+QVariantMap readProperties(AbstractFilter* filter)
+{
+  QSet<QString> parameterNames;
+  for(FilterParameter::Pointer parameter : filter->getFilterParameters())
+  {
+    parameterNames.insert(parameter->getPropertyName());
+  }
+
+  QVariantMap properties;
+  const QMetaObject* metaObject = filter->metaObject();
+  for(int i = AbstractFilter::staticMetaObject.propertyCount(); i < metaObject->propertyCount(); i++)
+  {
+    QMetaProperty property = metaObject->property(i);
+    if(property.isReadable() && property.isWritable() && !parameterNames.contains(property.name()))
+    {
+      properties.insert(property.name(), property.read(filter));
+    }
+  }
+  return properties;
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BackgroundPreflight::BackgroundPreflight(SVPipelineView* view, QObject* parent)
+: QObject(parent)
+, m_PipelineView(view)
+{
+  m_DebounceTimer = new QTimer(this);
+  m_DebounceTimer->setSingleShot(true);
+  m_DebounceTimer->setInterval(ReadDebounceMSecs());
+  connect(m_DebounceTimer, &QTimer::timeout, this, &BackgroundPreflight::startPreflight);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BackgroundPreflight::~BackgroundPreflight()
+{
+  // The job only shares its own state with the worker, so the worker may finish after this object is gone
+  cancel();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool BackgroundPreflight::ReadEnabled()
+{
+  QtSSettings prefs;
+  prefs.beginGroup("Application Settings");
+  bool enabled = prefs.value("Background Preflight", true).toBool();
+  prefs.endGroup();
+
+  QByteArray enabledEnv = qgetenv("SIMPL_BACKGROUND_PREFLIGHT");
+  if(!enabledEnv.isEmpty())
+  {
+    enabled = (enabledEnv != "0");
+  }
+
+  return enabled;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int BackgroundPreflight::ReadDebounceMSecs()
+{
+  QtSSettings prefs;
+  prefs.beginGroup("Application Settings");
+  int debounceMSecs = prefs.value("Preflight Debounce MSecs", DefaultDebounceMSecs).toInt();
+  prefs.endGroup();
+
+  QByteArray debounceEnv = qgetenv("SIMPL_PREFLIGHT_DEBOUNCE_MSECS");
+  if(!debounceEnv.isEmpty())
+  {
+    debounceMSecs = debounceEnv.toInt();
+  }
+
+  return qBound(0, debounceMSecs, 5000);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool BackgroundPreflight::isRunning() const
+{
+  return m_RunningJob.get() != nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int BackgroundPreflight::getLastStartIndex() const
+{
+  return m_LastStartIndex;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 BackgroundPreflight::getLastElapsedMSecs() const
+{
+  return m_LastElapsedMSecs;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BackgroundPreflight::schedule()
+{
+  m_DebounceTimer->start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BackgroundPreflight::invalidate()
+{
+  cancel();
+  m_Stages.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BackgroundPreflight::cancel()
+{
+  m_DebounceTimer->stop();
+  if(m_RunningJob.get() == nullptr)
+  {
+    return;
+  }
+
+  m_RunningJob->canceled = true;
+  {
+    QMutexLocker locker(&m_RunningJob->currentFilterMutex);
+    if(m_RunningJob->currentFilter.get() != nullptr)
+    {
+      m_RunningJob->currentFilter->setCancel(true);
+    }
+  }
+  m_RunningJob.reset();
+
+  // Whatever the canceled job still delivers is stale
+  m_Generation++;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BackgroundPreflight::startPreflight()
+{
+  // An executing pipeline owns the filters' DataContainerArrays, it asks for a preflight once it has finished
+  if(m_PipelineView->isPipelineCurrentlyRunning())
+  {
+    return;
+  }
+
+  cancel();
+
+  JobPointer job = std::make_shared<Job>();
+  job->pipelineFilePath = job->tempDir.filePath("Preflight.json");
+  if(!job->tempDir.isValid() || m_PipelineView->writePipeline(job->pipelineFilePath) < 0)
+  {
+    return;
+  }
+
+  QFile file(job->pipelineFilePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return;
+  }
+  job->keys = StageCache::ComputeStageKeys(QJsonDocument::fromJson(file.readAll()).object());
+  file.close();
+
+  // Filters above the first changed key see exactly the DataContainerArray they saw last time
+  int startIndex = 0;
+  while(startIndex < job->keys.size() && startIndex < m_Stages.size() && m_Stages[startIndex].key == job->keys[startIndex])
+  {
+    startIndex++;
+  }
+
+  if(startIndex == job->keys.size() && m_Stages.size() == job->keys.size())
+  {
+    // Nothing that affects the preflight changed, only filters that were re-created, e.g. by an undo, need their results
+    if(applyStages(m_Stages) > 0)
+    {
+      QVector<PipelineMessage> messages;
+      int err = 0;
+      for(const Stage& stage : m_Stages)
+      {
+        messages += stage.messages;
+        if(err >= 0 && stage.errorCode < 0)
+        {
+          err = stage.errorCode;
+        }
+      }
+      emit preflightFinished(FilterPipeline::NullPointer(), messages, err);
+    }
+    return;
+  }
+
+  job->generation = ++m_Generation;
+  job->startIndex = startIndex;
+  job->stages = m_Stages.mid(0, startIndex);
+  m_RunningJob = job;
+
+  QFutureWatcher<void>* watcher = new QFutureWatcher<void>(this);
+  connect(watcher, &QFutureWatcher<void>::finished, this, [this, watcher, job] {
+    watcher->deleteLater();
+    finishJob(job);
+  });
+  watcher->setFuture(QtConcurrent::run([job] { RunJob(job); }));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BackgroundPreflight::RunJob(const JobPointer& job)
+{
+  QElapsedTimer timer;
+  timer.start();
+
+  JsonFilterParametersReader::Pointer jsonReader = JsonFilterParametersReader::New();
+  job->pipeline = jsonReader->readPipelineFromFile(job->pipelineFilePath);
+  if(nullptr == job->pipeline.get())
+  {
+    job->canceled = true;
+    return;
+  }
+
+  FilterPipeline::FilterContainerType filters = job->pipeline->getFilterContainer();
+  if(filters.size() != job->keys.size())
+  {
+    job->canceled = true;
+    return;
+  }
+
+  job->stages.resize(filters.size());
+  DataContainerArray::Pointer input = (job->startIndex > 0) ? job->stages[job->startIndex - 1].output : DataContainerArray::New();
+  for(int i = job->startIndex; i < filters.size() && !job->canceled; i++)
+  {
+    AbstractFilter::Pointer filter = filters[i];
+    Stage& stage = job->stages[i];
+    stage.key = job->keys[i];
+
+    if(!filter->getEnabled())
+    {
+      stage.output = input;
+      continue;
+    }
+
+    {
+      QMutexLocker locker(&job->currentFilterMutex);
+      if(job->canceled)
+      {
+        break;
+      }
+      job->currentFilter = filter;
+    }
+
+    // Every stage keeps its own copy, so the cached results are never modified by the filters below them
+    QMetaObject::Connection connection =
+        QObject::connect(filter.get(), &AbstractFilter::filterGeneratedMessage, [&stage](const PipelineMessage& msg) { stage.messages.push_back(msg); });
+    filter->setDataContainerArray(input->deepCopy(true));
+    filter->preflight();
+    QObject::disconnect(connection);
+    stage.errorCode = filter->getErrorCondition();
+    stage.output = filter->getDataContainerArray();
+
+    // Filters update some of their own values during the preflight, the view's copies have to get them too
+    stage.parameters = QJsonObject();
+    filter->writeFilterParameters(stage.parameters);
+    stage.properties = readProperties(filter.get());
+
+    {
+      QMutexLocker locker(&job->currentFilterMutex);
+      job->currentFilter = AbstractFilter::NullPointer();
+    }
+
+    input = stage.output;
+  }
+
+  for(const Stage& stage : job->stages)
+  {
+    if(stage.errorCode < 0)
+    {
+      job->errorCode = stage.errorCode;
+      break;
+    }
+  }
+  job->elapsedMSecs = timer.elapsed();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BackgroundPreflight::finishJob(const JobPointer& job)
+{
+  if(job == m_RunningJob)
+  {
+    m_RunningJob.reset();
+  }
+
+  if(job->canceled || job->generation != m_Generation || m_PipelineView->isPipelineCurrentlyRunning())
+  {
+    return;
+  }
+
+  m_Stages = job->stages;
+  m_LastStartIndex = job->startIndex;
+  m_LastElapsedMSecs = job->elapsedMSecs;
+
+  applyStages(m_Stages);
+
+  QVector<PipelineMessage> messages;
+  for(const Stage& stage : m_Stages)
+  {
+    messages += stage.messages;
+  }
+  emit preflightFinished(job->pipeline, messages, job->errorCode);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int BackgroundPreflight::applyStages(const QVector<Stage>& stages)
+{
+  PipelineModel* model = m_PipelineView->getPipelineModel();
+  if(model->rowCount() != stages.size())
+  {
+    return 0;
+  }
+
+  int applied = 0;
+  DataContainerArray::Pointer input = DataContainerArray::New();
+  for(int i = 0; i < stages.size(); i++)
+  {
+    const Stage& stage = stages[i];
+    QModelIndex index = model->index(i, PipelineItem::PipelineItemData::Contents);
+    AbstractFilter::Pointer filter = model->filter(index);
+    if(filter.get() != nullptr && filter->getDataContainerArray() != stage.output)
+    {
+      // The filter's input widgets read the DataContainerArray above the filter before a preflight and the
+      // data browser shows the one the filter produced afterwards
+      filter->setDataContainerArray(input);
+      emit filter->preflightAboutToExecute();
+      filter->setDataContainerArray(stage.output);
+      filter->setErrorCondition(stage.errorCode);
+
+      // The widgets write their values into the filter before a preflight, so the preflight's values go in
+      // afterwards and the widgets pick them up once it executed
+      if(!stage.parameters.isEmpty())
+      {
+        QJsonObject parameters = stage.parameters;
+        filter->readFilterParameters(parameters);
+      }
+      for(auto iter = stage.properties.constBegin(); iter != stage.properties.constEnd(); ++iter)
+      {
+        filter->setProperty(iter.key().toLatin1().constData(), iter.value());
+      }
+      emit filter->preflightExecuted();
+      applied++;
+    }
+    input = stage.output;
+  }
+
+  return applied;
+}
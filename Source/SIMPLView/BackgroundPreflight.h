@@ -0,0 +1,196 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QVariantMap>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Common/PipelineMessage.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+class QTimer;
+class SVPipelineView;
+
+/**
+ * @brief The BackgroundPreflight class preflights a window's pipeline on a worker thread instead of in the
+ * pipeline view's slots. Requests are debounced so that typing into a parameter only preflights once the
+ * edits settle. Each preflight runs on a copy of the pipeline, starts at the first filter whose stage key
+ * changed and reuses the preflight DataContainerArray of the unchanged filters above it. A request that
+ * arrives while a preflight is running cancels it. The results are handed to the view's filters on the
+ * main thread, which lets their input widgets and the data browser refresh as after a regular preflight.
+ */
+class BackgroundPreflight : public QObject
+{
+  Q_OBJECT
+
+public:
+  struct Stage
+  {
+    QString key;
+    DataContainerArray::Pointer output;
+    QJsonObject parameters;
+    QVariantMap properties;
+    QVector<PipelineMessage> messages;
+    int errorCode = 0;
+  };
+
+  BackgroundPreflight(SVPipelineView* view, QObject* parent = nullptr);
+  ~BackgroundPreflight() override;
+
+  static const int DefaultDebounceMSecs = 250;
+
+  /**
+   * @brief ReadEnabled
+   * @return False if the pipeline view should keep preflighting synchronously
+   */
+  static bool ReadEnabled();
+
+  /**
+   * @brief ReadDebounceMSecs
+   * @return
+   */
+  static int ReadDebounceMSecs();
+
+  /**
+   * @brief isRunning
+   * @return
+   */
+  bool isRunning() const;
+
+  /**
+   * @brief getLastStartIndex
+   * @return The index of the first filter the last finished preflight had to preflight again
+   */
+  int getLastStartIndex() const;
+
+  /**
+   * @brief getLastElapsedMSecs
+   * @return
+   */
+  qint64 getLastElapsedMSecs() const;
+
+public slots:
+  /**
+   * @brief schedule Preflights the pipeline once no further request arrived for the debounce interval
+   */
+  void schedule();
+
+  /**
+   * @brief invalidate Forgets the preflight results, e.g. after files the filters read may have changed
+   */
+  void invalidate();
+
+  /**
+   * @brief cancel Stops the running preflight and drops its result
+   */
+  void cancel();
+
+signals:
+  /**
+   * @brief preflightFinished Emitted on the main thread after the results were handed to the view's filters
+   * @param pipeline The copy of the pipeline that was preflighted
+   * @param messages The messages of every filter, including those whose results were reused
+   * @param err
+   */
+  void preflightFinished(FilterPipeline::Pointer pipeline, QVector<PipelineMessage> messages, int err);
+
+protected slots:
+  /**
+   * @brief startPreflight
+   */
+  void startPreflight();
+
+protected:
+  struct Job
+  {
+    int generation = 0;
+    QTemporaryDir tempDir;
+    QString pipelineFilePath;
+    QStringList keys;
+    int startIndex = 0;
+    QVector<Stage> stages;
+    FilterPipeline::Pointer pipeline;
+    int errorCode = 0;
+    qint64 elapsedMSecs = 0;
+
+    std::atomic<bool> canceled{false};
+    QMutex currentFilterMutex;
+    AbstractFilter::Pointer currentFilter;
+  };
+  using JobPointer = std::shared_ptr<Job>;
+
+  /**
+   * @brief RunJob Preflights the filters of the job from its start index on the calling thread
+   * @param job
+   */
+  static void RunJob(const JobPointer& job);
+
+  /**
+   * @brief finishJob Called on the main thread when the worker is done with the job
+   * @param job
+   */
+  void finishJob(const JobPointer& job);
+
+  /**
+   * @brief applyStages Gives each filter of the view the DataContainerArray it sees during a preflight.
+   * Filters that already hold their stage's result are left alone.
+   * @param stages
+   * @return The number of filters that were updated
+   */
+  int applyStages(const QVector<Stage>& stages);
+
+private:
+  SVPipelineView* m_PipelineView = nullptr;
+  QTimer* m_DebounceTimer = nullptr;
+  QVector<Stage> m_Stages;
+  JobPointer m_RunningJob;
+  int m_Generation = 0;
+  int m_LastStartIndex = -1;
+  qint64 m_LastElapsedMSecs = 0;
+
+  BackgroundPreflight(const BackgroundPreflight&) = delete; // Copy Constructor Not Implemented
+  void operator=(const BackgroundPreflight&) = delete;      // Move assignment Not Implemented
+};
@@ -0,0 +1,714 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "BatchQueue.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QPair>
+#include <QtCore/QProcess>
+#include <QtCore/QThread>
+
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+#include "SIMPLView/ArrayLiveness.h"
+#include "SIMPLView/MemoryEstimator.h"
+#include "SIMPLView/SIMPLViewApplication.h"
+#include "SIMPLView/SettingsStore.h"
+#include "SIMPLView/WorkerPool.h"
+
+namespace
+{
+const qint64 k_BytesPerMB = 1024 * 1024;
+}
+
+BatchQueue* BatchQueue::self = nullptr;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BatchQueue::BatchQueue(QObject* parent)
+: QObject(parent)
+{
+  m_MaxConcurrentJobs = qMax(1, QThread::idealThreadCount() / 4);
+  readSettings();
+
+  // Preflights are cheap next to the jobs themselves, one at a time keeps them in queue order
+  m_EstimatePool.setMaxThreadCount(1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BatchQueue::~BatchQueue()
+{
+  shutdown();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BatchQueue* BatchQueue::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new BatchQueue();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString BatchQueue::RunnerExecutablePath()
+{
+  QByteArray executableEnv = qgetenv("SIMPL_RUNNER_EXECUTABLE");
+  if(!executableEnv.isEmpty())
+  {
+    return QString::fromLocal8Bit(executableEnv);
+  }
+  return WorkerPool::ToolExecutablePath("HeadlessPipelineRunner");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList BatchQueue::MissingFilters(const QString& filePath, const FilterPipeline::FilterContainerType& filters)
+{
+  QStringList missingFilters;
+  QFile file(filePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return missingFilters;
+  }
+
+  QStringList createdFilters;
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    createdFilters.push_back(filter->getNameOfClass());
+  }
+
+  QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+  int count = root["PipelineBuilder"].toObject()["Number_Filters"].toInt();
+  for(int i = 0; i < count; i++)
+  {
+    QString className = root[QString::number(i)].toObject()["Filter_Name"].toString();
+    if(!createdFilters.removeOne(className))
+    {
+      missingFilters.push_back(className);
+    }
+  }
+  return missingFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 BatchQueue::EstimatePipelineFile(const QString& filePath, QString& error)
+{
+  JsonFilterParametersReader::Pointer jsonReader = JsonFilterParametersReader::New();
+  FilterPipeline::Pointer pipeline = jsonReader->readPipelineFromFile(filePath);
+  if(nullptr == pipeline.get())
+  {
+    error = QString("Not estimated: the pipeline could not be read");
+    return -1;
+  }
+
+  // The reader leaves out the filters it could not create, an estimate without them would be too low
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+  QStringList missingFilters = MissingFilters(filePath, filters);
+  if(!missingFilters.isEmpty())
+  {
+    error = QString("Not estimated: %1 could not be created").arg(missingFilters.join(", "));
+    return -1;
+  }
+
+  // Each filter keeps its own preflight structure, which is what the estimator reads
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  for(AbstractFilter::Pointer filter : filters)
+  {
+    if(!filter->getEnabled())
+    {
+      continue;
+    }
+    filter->setDataContainerArray(dca->deepCopy(true));
+    filter->preflight();
+    if(filter->getErrorCondition() < 0)
+    {
+      error = QString("Not estimated: %1 failed to preflight with error %2").arg(filter->getHumanLabel()).arg(filter->getErrorCondition());
+      return -1;
+    }
+    dca = filter->getDataContainerArray();
+  }
+
+  // The runner frees the arrays behind their last use
+  ArrayLiveness::Pointer liveness = ArrayLiveness::New();
+  liveness->analyze(filters);
+  return MemoryEstimator::EstimatePipeline(filters, liveness->getPlan()).peakBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString BatchQueue::StatusString(JobStatus status)
+{
+  switch(status)
+  {
+  case JobStatus::Queued:
+    return QString("Queued");
+  case JobStatus::Running:
+    return QString("Running");
+  case JobStatus::Completed:
+    return QString("Completed");
+  case JobStatus::Failed:
+    return QString("Failed");
+  case JobStatus::Canceled:
+    return QString("Canceled");
+  }
+  return QString();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int BatchQueue::addPipelineFile(const QString& filePath)
+{
+  Job job;
+  job.id = m_NextJobId++;
+  job.pipelineFilePath = QFileInfo(filePath).absoluteFilePath();
+  m_Jobs.push_back(job);
+
+  // The estimate thread can not activate deferred plugins, the filters it creates must already be registered
+  dream3dApp->activatePluginsForPipelineFile(job.pipelineFilePath);
+
+  emit jobAdded(job.id);
+  estimateJob(job);
+  return job.id;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::addPipelineFiles(const QStringList& filePaths)
+{
+  for(const QString& filePath : filePaths)
+  {
+    addPipelineFile(filePath);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int BatchQueue::addDirectory(const QString& dirPath)
+{
+  QStringList filePaths;
+  QDirIterator iter(dirPath, QStringList() << "*.json", QDir::Files, QDirIterator::Subdirectories);
+  while(iter.hasNext())
+  {
+    filePaths.push_back(iter.next());
+  }
+
+  // Sample directories are usually numbered, so keep them in a predictable order
+  filePaths.sort();
+  addPipelineFiles(filePaths);
+  return filePaths.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::cancelJob(int id)
+{
+  Job* job = findJob(id);
+  if(nullptr == job)
+  {
+    return;
+  }
+
+  if(job->status == JobStatus::Queued)
+  {
+    job->status = JobStatus::Canceled;
+    emit jobChanged(id);
+  }
+  else if(job->status == JobStatus::Running)
+  {
+    // The job is marked as canceled once its process has exited. Killing is safe, nothing but the
+    // process's own memory and the files it was writing are lost.
+    QProcess* process = m_Processes.value(id);
+    if(nullptr != process)
+    {
+      m_CanceledJobs.insert(id);
+      process->kill();
+    }
+    job->message = "Canceling...";
+    emit jobChanged(id);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::cancelAllJobs()
+{
+  for(int i = 0; i < m_Jobs.size(); i++)
+  {
+    cancelJob(m_Jobs[i].id);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::clearFinishedJobs()
+{
+  QVector<Job> remainingJobs;
+  for(const Job& job : m_Jobs)
+  {
+    if(job.status == JobStatus::Queued || job.status == JobStatus::Running)
+    {
+      remainingJobs.push_back(job);
+    }
+  }
+  m_Jobs = remainingJobs;
+  emit jobsRemoved();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::shutdown()
+{
+  cancelAllJobs();
+  QMap<int, QProcess*> processes = m_Processes;
+  for(QProcess* process : processes)
+  {
+    process->waitForFinished(1000);
+  }
+  m_EstimatePool.waitForDone();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<BatchQueue::Job> BatchQueue::getJobs() const
+{
+  return m_Jobs;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BatchQueue::Job BatchQueue::getJob(int id) const
+{
+  for(const Job& job : m_Jobs)
+  {
+    if(job.id == id)
+    {
+      return job;
+    }
+  }
+  return Job();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int BatchQueue::getJobCount(JobStatus status) const
+{
+  int count = 0;
+  for(const Job& job : m_Jobs)
+  {
+    if(job.status == status)
+    {
+      count++;
+    }
+  }
+  return count;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double BatchQueue::getThroughputPerHour() const
+{
+  qint64 elapsedMSecs = m_BatchTimer.isValid() ? m_BatchTimer.elapsed() : m_BatchElapsedMSecs;
+  if(elapsedMSecs <= 0)
+  {
+    return 0.0;
+  }
+  return m_FinishedInBatch * 3600000.0 / elapsedMSecs;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 BatchQueue::getReservedMemoryBytes() const
+{
+  return m_ReservedBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::setMaxConcurrentJobs(int value)
+{
+  m_MaxConcurrentJobs = qMax(1, value);
+  writeSettings();
+  emit settingsChanged();
+  scheduleJobs();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int BatchQueue::getMaxConcurrentJobs() const
+{
+  return m_MaxConcurrentJobs;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::setMemoryBudgetMB(int value)
+{
+  m_MemoryBudgetMB = qMax(0, value);
+  writeSettings();
+  emit settingsChanged();
+  scheduleJobs();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int BatchQueue::getMemoryBudgetMB() const
+{
+  return m_MemoryBudgetMB;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::setMemoryPerJobMB(int value)
+{
+  m_MemoryPerJobMB = qMax(0, value);
+  writeSettings();
+  emit settingsChanged();
+  scheduleJobs();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int BatchQueue::getMemoryPerJobMB() const
+{
+  return m_MemoryPerJobMB;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::estimateJob(const Job& job)
+{
+  int id = job.id;
+  QString filePath = job.pipelineFilePath;
+  QFutureWatcher<QPair<qint64, QString>>* watcher = new QFutureWatcher<QPair<qint64, QString>>(this);
+  connect(watcher, &QFutureWatcher<QPair<qint64, QString>>::finished, this, [this, watcher, id] {
+    jobEstimated(id, watcher->result().first, watcher->result().second);
+    watcher->deleteLater();
+  });
+  watcher->setFuture(QtConcurrent::run(&m_EstimatePool, [filePath] {
+    QString error;
+    qint64 estimatedBytes = EstimatePipelineFile(filePath, error);
+    return qMakePair(estimatedBytes, error);
+  }));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::jobEstimated(int id, qint64 estimatedBytes, const QString& error)
+{
+  Job* job = findJob(id);
+  if(nullptr == job)
+  {
+    return;
+  }
+  job->estimated = true;
+  job->estimatedBytes = estimatedBytes;
+  if(job->status == JobStatus::Queued)
+  {
+    job->message = error;
+  }
+  emit jobChanged(id);
+  scheduleJobs();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::scheduleJobs()
+{
+  qint64 budgetBytes = m_MemoryBudgetMB * k_BytesPerMB;
+  for(Job& job : m_Jobs)
+  {
+    if(m_RunningJobCount >= m_MaxConcurrentJobs)
+    {
+      break;
+    }
+    if(job.status != JobStatus::Queued)
+    {
+      continue;
+    }
+
+    // Later jobs wait for the estimate of an earlier one, so the queue keeps its order
+    if(!job.estimated)
+    {
+      break;
+    }
+
+    // A pipeline that did not preflight fails in its runner right away, but is still given the fallback
+    // reservation in case the preflight only failed here. A job that does not fit holds back the jobs
+    // behind it, otherwise a stream of smaller jobs would keep it waiting forever. It starts once the
+    // queue is idle, so a job that is larger than the budget can not stall the queue.
+    qint64 jobBytes = (job.estimatedBytes >= 0) ? job.estimatedBytes : m_MemoryPerJobMB * k_BytesPerMB;
+    if(m_MemoryBudgetMB > 0 && m_RunningJobCount > 0 && m_ReservedBytes + jobBytes > budgetBytes)
+    {
+      break;
+    }
+
+    job.reservedBytes = jobBytes;
+    startJob(job);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::startJob(Job& job)
+{
+  if(m_RunningJobCount == 0 && !m_BatchTimer.isValid())
+  {
+    m_BatchTimer.start();
+    m_FinishedInBatch = 0;
+  }
+
+  job.status = JobStatus::Running;
+  job.startMSecsSinceEpoch = QDateTime::currentMSecsSinceEpoch();
+  job.message.clear();
+  m_RunningJobCount++;
+  m_ReservedBytes += job.reservedBytes;
+
+  // The running jobs share the cores instead of each starting a thread per core
+  int threads = qMax(1, QThread::idealThreadCount() / m_MaxConcurrentJobs);
+
+  int id = job.id;
+  QString reportFilePath = m_ReportDir.filePath(QString("Job-%1.json").arg(id));
+  QFile::remove(reportFilePath);
+  QStringList arguments;
+  arguments << "--threads" << QString::number(threads) << "--json-report" << reportFilePath << job.pipelineFilePath;
+
+  QProcess* process = new QProcess(this);
+  process->setStandardOutputFile(QProcess::nullDevice());
+  m_Processes.insert(id, process);
+  connect(process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished), this,
+          [this, id](int exitCode, QProcess::ExitStatus exitStatus) { jobFinished(id, exitCode, exitStatus == QProcess::CrashExit); });
+  connect(process, &QProcess::errorOccurred, this, [this, id](QProcess::ProcessError error) {
+    if(error == QProcess::FailedToStart)
+    {
+      jobFinished(id, -1, true);
+    }
+  });
+  process->start(RunnerExecutablePath(), arguments);
+
+  emit jobChanged(id);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::jobFinished(int id, int exitCode, bool crashed)
+{
+  QProcess* process = m_Processes.take(id);
+  if(nullptr == process)
+  {
+    return;
+  }
+  bool canceled = m_CanceledJobs.remove(id);
+
+  // The runner prints each filter's errors as "Error (code): message", keep the first one
+  QString errorMessage;
+  QStringList errorLines = QString::fromLocal8Bit(process->readAllStandardError()).split('\n', QString::SkipEmptyParts);
+  for(const QString& line : errorLines)
+  {
+    if(line.startsWith("Error ("))
+    {
+      errorMessage = line.mid(line.indexOf(": ") + 2).trimmed();
+      break;
+    }
+  }
+  if(errorMessage.isEmpty() && !errorLines.isEmpty())
+  {
+    errorMessage = errorLines.last().trimmed();
+  }
+  process->disconnect(this);
+  process->deleteLater();
+
+  int errorCode = (exitCode == 0) ? 0 : -1;
+  qint64 peakBytes = 0;
+  QFile reportFile(m_ReportDir.filePath(QString("Job-%1.json").arg(id)));
+  if(reportFile.open(QIODevice::ReadOnly))
+  {
+    QJsonObject report = QJsonDocument::fromJson(reportFile.readAll()).object();
+    reportFile.close();
+    reportFile.remove();
+    if(report.contains("Error Code") && report["Error Code"].toInt() < 0)
+    {
+      errorCode = report["Error Code"].toInt();
+    }
+    peakBytes = report["Peak Memory Bytes"].toVariant().toLongLong();
+  }
+  if(crashed && !canceled)
+  {
+    errorCode = -1;
+    errorMessage = tr("The pipeline runner %1 crashed or could not be started").arg(RunnerExecutablePath());
+  }
+
+  m_RunningJobCount--;
+  m_FinishedInBatch++;
+
+  Job* job = findJob(id);
+  if(nullptr != job)
+  {
+    m_ReservedBytes -= job->reservedBytes;
+    job->elapsedMSecs = QDateTime::currentMSecsSinceEpoch() - job->startMSecsSinceEpoch;
+    job->errorCode = errorCode;
+    job->peakBytes = peakBytes;
+    job->message = errorMessage;
+    if(canceled)
+    {
+      job->status = JobStatus::Canceled;
+      job->message.clear();
+    }
+    else if(errorCode < 0)
+    {
+      job->status = JobStatus::Failed;
+    }
+    else
+    {
+      job->status = JobStatus::Completed;
+    }
+    emit jobChanged(id);
+  }
+
+  scheduleJobs();
+
+  if(m_RunningJobCount == 0)
+  {
+    m_BatchElapsedMSecs = m_BatchTimer.elapsed();
+    m_BatchTimer.invalidate();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BatchQueue::Job* BatchQueue::findJob(int id)
+{
+  for(int i = 0; i < m_Jobs.size(); i++)
+  {
+    if(m_Jobs[i].id == id)
+    {
+      return &m_Jobs[i];
+    }
+  }
+  return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::readSettings()
+{
+  SettingsStore* store = SettingsStore::Instance();
+  m_MaxConcurrentJobs = store->value("Application Settings/Batch Concurrent Jobs", m_MaxConcurrentJobs).toInt();
+  m_MemoryBudgetMB = store->value("Application Settings/Batch Memory Budget MB", m_MemoryBudgetMB).toInt();
+  m_MemoryPerJobMB = store->value("Application Settings/Batch Memory Per Job MB", m_MemoryPerJobMB).toInt();
+
+  // The environment wins so that a batch machine can be set up without touching the preferences
+  QByteArray concurrentJobsEnv = qgetenv("SIMPL_BATCH_CONCURRENT_JOBS");
+  if(!concurrentJobsEnv.isEmpty())
+  {
+    m_MaxConcurrentJobs = concurrentJobsEnv.toInt();
+  }
+  QByteArray memoryBudgetEnv = qgetenv("SIMPL_BATCH_MEMORY_BUDGET_MB");
+  if(!memoryBudgetEnv.isEmpty())
+  {
+    m_MemoryBudgetMB = memoryBudgetEnv.toInt();
+  }
+
+  m_MaxConcurrentJobs = qMax(1, m_MaxConcurrentJobs);
+  m_MemoryBudgetMB = qMax(0, m_MemoryBudgetMB);
+  m_MemoryPerJobMB = qMax(0, m_MemoryPerJobMB);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::writeSettings()
+{
+  int maxConcurrentJobs = m_MaxConcurrentJobs;
+  int memoryBudgetMB = m_MemoryBudgetMB;
+  int memoryPerJobMB = m_MemoryPerJobMB;
+  SettingsStore::Instance()->write([maxConcurrentJobs, memoryBudgetMB, memoryPerJobMB](SettingsWriter* prefs) {
+    prefs->beginGroup("Application Settings");
+    prefs->setValue("Batch Concurrent Jobs", maxConcurrentJobs);
+    prefs->setValue("Batch Memory Budget MB", memoryBudgetMB);
+    prefs->setValue("Batch Memory Per Job MB", memoryPerJobMB);
+    prefs->endGroup();
+  });
+}
@@ -0,0 +1,292 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMap>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+class QProcess;
+
+/**
+ * @brief The BatchQueue class executes many pipeline files side by side, each in its own HeadlessPipelineRunner
+ * process, so that a job that crashes or runs out of memory does not take the application or the other jobs with it.
+ * Every queued pipeline is preflighted in the background and the MemoryEstimator's peak for it is what the job
+ * reserves. Jobs are started in the order they were queued as long as fewer than the maximum number of concurrent
+ * jobs are running and the memory reserved for the running jobs stays inside the memory budget. There is one queue
+ * for the whole application; every window shows it in its batch queue dock.
+ */
+class BatchQueue : public QObject
+{
+  Q_OBJECT
+
+public:
+  enum class JobStatus : int
+  {
+    Queued,
+    Running,
+    Completed,
+    Failed,
+    Canceled
+  };
+
+  struct Job
+  {
+    int id = 0;
+    QString pipelineFilePath;
+    JobStatus status = JobStatus::Queued;
+    bool estimated = false;
+    qint64 estimatedBytes = -1;
+    qint64 reservedBytes = 0;
+    qint64 peakBytes = 0;
+    qint64 startMSecsSinceEpoch = 0;
+    qint64 elapsedMSecs = 0;
+    int errorCode = 0;
+    QString message;
+  };
+
+  ~BatchQueue() override;
+
+  /**
+   * @brief Instance
+   * @return
+   */
+  static BatchQueue* Instance();
+
+  /**
+   * @brief RunnerExecutablePath
+   * @return The HeadlessPipelineRunner next to the application, or the one given by SIMPL_RUNNER_EXECUTABLE
+   */
+  static QString RunnerExecutablePath();
+
+  /**
+   * @brief EstimatePipelineFile Preflights the pipeline file on the calling thread. The plugins of its filters must
+   * have been activated on the main thread before.
+   * @param filePath
+   * @param error Says why there is no estimate
+   * @return The estimated peak of the attribute arrays, or -1 if the pipeline could not be read, one of its filters
+   * could not be created or it did not preflight
+   */
+  static qint64 EstimatePipelineFile(const QString& filePath, QString& error);
+
+  /**
+   * @brief StatusString
+   * @param status
+   * @return
+   */
+  static QString StatusString(JobStatus status);
+
+  /**
+   * @brief addPipelineFile Queues a pipeline file
+   * @param filePath
+   * @return The id of the new job
+   */
+  int addPipelineFile(const QString& filePath);
+
+  /**
+   * @brief addPipelineFiles
+   * @param filePaths
+   */
+  void addPipelineFiles(const QStringList& filePaths);
+
+  /**
+   * @brief addDirectory Queues every pipeline file in the directory and its sub directories
+   * @param dirPath
+   * @return The number of pipeline files that were queued
+   */
+  int addDirectory(const QString& dirPath);
+
+  /**
+   * @brief cancelJob Removes a queued job from the schedule or cancels a running one
+   * @param id
+   */
+  void cancelJob(int id);
+
+  /**
+   * @brief cancelAllJobs
+   */
+  void cancelAllJobs();
+
+  /**
+   * @brief clearFinishedJobs Forgets the jobs that are no longer queued or running
+   */
+  void clearFinishedJobs();
+
+  /**
+   * @brief shutdown Cancels all jobs and waits for the running ones to stop
+   */
+  void shutdown();
+
+  /**
+   * @brief getJobs
+   * @return The jobs in the order they were queued
+   */
+  QVector<Job> getJobs() const;
+
+  /**
+   * @brief getJob
+   * @param id
+   * @return
+   */
+  Job getJob(int id) const;
+
+  /**
+   * @brief getJobCount
+   * @param status
+   * @return The number of jobs with the given status
+   */
+  int getJobCount(JobStatus status) const;
+
+  /**
+   * @brief getThroughputPerHour
+   * @return The number of jobs finished per hour since the current batch started
+   */
+  double getThroughputPerHour() const;
+
+  /**
+   * @brief getReservedMemoryBytes
+   * @return The memory reserved by the running jobs
+   */
+  qint64 getReservedMemoryBytes() const;
+
+  void setMaxConcurrentJobs(int value);
+  int getMaxConcurrentJobs() const;
+
+  /**
+   * @brief setMemoryBudgetMB 0 means the memory used by the jobs is not limited
+   * @param value
+   */
+  void setMemoryBudgetMB(int value);
+  int getMemoryBudgetMB() const;
+
+  /**
+   * @brief setMemoryPerJobMB The memory reserved for a job whose pipeline could not be estimated
+   * @param value
+   */
+  void setMemoryPerJobMB(int value);
+  int getMemoryPerJobMB() const;
+
+signals:
+  void jobAdded(int id);
+  void jobChanged(int id);
+  void jobsRemoved();
+  void settingsChanged();
+
+protected:
+  BatchQueue(QObject* parent = nullptr);
+
+  /**
+   * @brief MissingFilters
+   * @param filePath A Json pipeline file
+   * @param filters The filters that were read from it
+   * @return The class names of the filters in the file that the reader could not create
+   */
+  static QStringList MissingFilters(const QString& filePath, const FilterPipeline::FilterContainerType& filters);
+
+  /**
+   * @brief estimateJob Preflights the job's pipeline on the estimate thread
+   * @param job
+   */
+  void estimateJob(const Job& job);
+
+  /**
+   * @brief jobEstimated
+   * @param id
+   * @param estimatedBytes
+   * @param error
+   */
+  void jobEstimated(int id, qint64 estimatedBytes, const QString& error);
+
+  /**
+   * @brief scheduleJobs Starts as many queued jobs as the limits allow
+   */
+  void scheduleJobs();
+
+  /**
+   * @brief startJob
+   * @param job
+   */
+  void startJob(Job& job);
+
+  /**
+   * @brief jobFinished Reads the job's report and releases its process
+   * @param id
+   * @param exitCode
+   * @param crashed
+   */
+  void jobFinished(int id, int exitCode, bool crashed);
+
+  /**
+   * @brief findJob
+   * @param id
+   * @return
+   */
+  Job* findJob(int id);
+
+  void readSettings();
+  void writeSettings();
+
+private:
+  static BatchQueue* self;
+
+  QVector<Job> m_Jobs;
+  QMap<int, QProcess*> m_Processes;
+  QSet<int> m_CanceledJobs;
+  QThreadPool m_EstimatePool;
+  QTemporaryDir m_ReportDir;
+  int m_NextJobId = 1;
+  int m_RunningJobCount = 0;
+  qint64 m_ReservedBytes = 0;
+
+  int m_MaxConcurrentJobs = 1;
+  int m_MemoryBudgetMB = 0;
+  int m_MemoryPerJobMB = 2048;
+
+  // Throughput is measured from the moment an idle queue starts a job
+  QElapsedTimer m_BatchTimer;
+  qint64 m_BatchElapsedMSecs = 0;
+  int m_FinishedInBatch = 0;
+
+  BatchQueue(const BatchQueue&) = delete;        // Copy Constructor Not Implemented
+  void operator=(const BatchQueue&) = delete;    // Move assignment Not Implemented
+};
@@ -0,0 +1,318 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "BatchQueueWidget.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTimer>
+
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QHeaderView>
+
+namespace
+{
+enum JobColumn
+{
+  PipelineColumn = 0,
+  StatusColumn,
+  TimeColumn,
+  MessageColumn
+};
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BatchQueueWidget::BatchQueueWidget(QWidget* parent)
+: QWidget(parent)
+, m_Queue(BatchQueue::Instance())
+, m_LastDirectory(QDir::homePath())
+{
+  setupUi(this);
+  setupGui();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BatchQueueWidget::~BatchQueueWidget() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::setupGui()
+{
+  jobTable->horizontalHeader()->setSectionResizeMode(PipelineColumn, QHeaderView::Interactive);
+  jobTable->horizontalHeader()->setSectionResizeMode(StatusColumn, QHeaderView::ResizeToContents);
+  jobTable->horizontalHeader()->setSectionResizeMode(TimeColumn, QHeaderView::ResizeToContents);
+
+  listenSettingsChanged();
+  listenJobsRemoved();
+
+  connect(m_Queue, &BatchQueue::jobAdded, this, &BatchQueueWidget::listenJobAdded);
+  connect(m_Queue, &BatchQueue::jobChanged, this, &BatchQueueWidget::listenJobChanged);
+  connect(m_Queue, &BatchQueue::jobsRemoved, this, &BatchQueueWidget::listenJobsRemoved);
+  connect(m_Queue, &BatchQueue::settingsChanged, this, &BatchQueueWidget::listenSettingsChanged);
+
+  // editingFinished so that typing a number does not reschedule the queue on every key press
+  connect(concurrentJobsSpinBox, &QSpinBox::editingFinished, [=] { m_Queue->setMaxConcurrentJobs(concurrentJobsSpinBox->value()); });
+  connect(memoryBudgetSpinBox, &QSpinBox::editingFinished, [=] { m_Queue->setMemoryBudgetMB(memoryBudgetSpinBox->value()); });
+  connect(memoryPerJobSpinBox, &QSpinBox::editingFinished, [=] { m_Queue->setMemoryPerJobMB(memoryPerJobSpinBox->value()); });
+
+  m_RefreshTimer = new QTimer(this);
+  m_RefreshTimer->setInterval(1000);
+  connect(m_RefreshTimer, &QTimer::timeout, this, &BatchQueueWidget::updateRunningTimes);
+  m_RefreshTimer->start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::addPipelineFiles(const QStringList& filePaths)
+{
+  m_Queue->addPipelineFiles(filePaths);
+  jobTable->scrollToBottom();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::on_addPipelinesBtn_clicked()
+{
+  QStringList filePaths = QFileDialog::getOpenFileNames(this, tr("Add Pipelines to the Batch Queue"), m_LastDirectory, tr("Json File (*.json);;All Files (*.*)"));
+  if(filePaths.isEmpty())
+  {
+    return;
+  }
+
+  m_LastDirectory = QFileInfo(filePaths.front()).absolutePath();
+  addPipelineFiles(filePaths);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::on_addDirectoryBtn_clicked()
+{
+  QString dirPath = QFileDialog::getExistingDirectory(this, tr("Add a Directory of Pipelines to the Batch Queue"), m_LastDirectory);
+  if(dirPath.isEmpty())
+  {
+    return;
+  }
+
+  m_LastDirectory = dirPath;
+  m_Queue->addDirectory(dirPath);
+  jobTable->scrollToBottom();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::on_cancelSelectedBtn_clicked()
+{
+  QModelIndexList selectedRows = jobTable->selectionModel()->selectedRows(PipelineColumn);
+  for(const QModelIndex& index : selectedRows)
+  {
+    m_Queue->cancelJob(index.data(Qt::UserRole).toInt());
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::on_clearFinishedBtn_clicked()
+{
+  m_Queue->clearFinishedJobs();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::listenJobAdded(int id)
+{
+  int row = jobTable->rowCount();
+  jobTable->insertRow(row);
+  updateRow(row, m_Queue->getJob(id));
+  updateSummary();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::listenJobChanged(int id)
+{
+  int row = rowForJob(id);
+  if(row >= 0)
+  {
+    updateRow(row, m_Queue->getJob(id));
+  }
+  updateSummary();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::listenJobsRemoved()
+{
+  QVector<BatchQueue::Job> jobs = m_Queue->getJobs();
+  jobTable->setRowCount(jobs.size());
+  for(int row = 0; row < jobs.size(); row++)
+  {
+    updateRow(row, jobs[row]);
+  }
+  updateSummary();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::listenSettingsChanged()
+{
+  concurrentJobsSpinBox->setValue(m_Queue->getMaxConcurrentJobs());
+  memoryBudgetSpinBox->setValue(m_Queue->getMemoryBudgetMB());
+  memoryPerJobSpinBox->setValue(m_Queue->getMemoryPerJobMB());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::updateRunningTimes()
+{
+  if(!isVisible())
+  {
+    return;
+  }
+
+  qint64 now = QDateTime::currentMSecsSinceEpoch();
+  for(int row = 0; row < jobTable->rowCount(); row++)
+  {
+    QTableWidgetItem* statusItem = jobTable->item(row, StatusColumn);
+    if(nullptr != statusItem && statusItem->data(Qt::UserRole).toInt() == static_cast<int>(BatchQueue::JobStatus::Running))
+    {
+      qint64 startMSecs = jobTable->item(row, TimeColumn)->data(Qt::UserRole).toLongLong();
+      jobTable->item(row, TimeColumn)->setText(FormatMSecs(now - startMSecs));
+    }
+  }
+  updateSummary();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int BatchQueueWidget::rowForJob(int id) const
+{
+  for(int row = 0; row < jobTable->rowCount(); row++)
+  {
+    QTableWidgetItem* item = jobTable->item(row, PipelineColumn);
+    if(nullptr != item && item->data(Qt::UserRole).toInt() == id)
+    {
+      return row;
+    }
+  }
+  return -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::updateRow(int row, const BatchQueue::Job& job)
+{
+  QTableWidgetItem* pipelineItem = new QTableWidgetItem(QFileInfo(job.pipelineFilePath).fileName());
+  pipelineItem->setData(Qt::UserRole, job.id);
+  pipelineItem->setToolTip(job.pipelineFilePath);
+  jobTable->setItem(row, PipelineColumn, pipelineItem);
+
+  QTableWidgetItem* statusItem = new QTableWidgetItem(BatchQueue::StatusString(job.status));
+  statusItem->setData(Qt::UserRole, static_cast<int>(job.status));
+  jobTable->setItem(row, StatusColumn, statusItem);
+
+  QTableWidgetItem* timeItem = new QTableWidgetItem();
+  timeItem->setData(Qt::UserRole, job.startMSecsSinceEpoch);
+  if(job.status == BatchQueue::JobStatus::Running)
+  {
+    timeItem->setText(FormatMSecs(QDateTime::currentMSecsSinceEpoch() - job.startMSecsSinceEpoch));
+  }
+  else if(job.startMSecsSinceEpoch > 0)
+  {
+    timeItem->setText(FormatMSecs(job.elapsedMSecs));
+  }
+  jobTable->setItem(row, TimeColumn, timeItem);
+
+  QString message = job.message;
+  if(job.status == BatchQueue::JobStatus::Failed && message.isEmpty())
+  {
+    message = tr("Error %1").arg(job.errorCode);
+  }
+  QTableWidgetItem* messageItem = new QTableWidgetItem(message);
+  messageItem->setToolTip(message);
+  jobTable->setItem(row, MessageColumn, messageItem);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::updateSummary()
+{
+  QString summary = tr("%1 running, %2 queued, %3 completed, %4 failed")
+                        .arg(m_Queue->getJobCount(BatchQueue::JobStatus::Running))
+                        .arg(m_Queue->getJobCount(BatchQueue::JobStatus::Queued))
+                        .arg(m_Queue->getJobCount(BatchQueue::JobStatus::Completed))
+                        .arg(m_Queue->getJobCount(BatchQueue::JobStatus::Failed));
+
+  double throughput = m_Queue->getThroughputPerHour();
+  if(throughput > 0.0)
+  {
+    summary.append(tr(" | %1 jobs/hour").arg(throughput, 0, 'f', 1));
+  }
+
+  qint64 reservedMB = m_Queue->getReservedMemoryBytes() / (1024 * 1024);
+  if(reservedMB > 0)
+  {
+    summary.append(tr(" | %1 MB reserved").arg(reservedMB));
+  }
+
+  summaryLabel->setText(summary);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString BatchQueueWidget::FormatMSecs(qint64 msecs)
+{
+  qint64 secs = msecs / 1000;
+  return QString("%1:%2:%3").arg(secs / 3600).arg((secs / 60) % 60, 2, 10, QChar('0')).arg(secs % 60, 2, 10, QChar('0'));
+}
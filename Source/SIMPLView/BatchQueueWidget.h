@@ -0,0 +1,120 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtWidgets/QWidget>
+
+#include "SIMPLView/BatchQueue.h"
+
+//-- UIC generated Header
+#include "ui_BatchQueueWidget.h"
+
+class QTimer;
+
+/**
+ * @brief The BatchQueueWidget class shows the jobs of the application's BatchQueue with their status
+ * and lets the user queue pipeline files and change the concurrency and memory limits.
+ */
+class BatchQueueWidget : public QWidget, private Ui::BatchQueueWidget
+{
+  Q_OBJECT
+
+public:
+  BatchQueueWidget(QWidget* parent = nullptr);
+  ~BatchQueueWidget() override;
+
+  /**
+   * @brief addPipelineFiles Queues the files and brings the jobs into view
+   * @param filePaths
+   */
+  void addPipelineFiles(const QStringList& filePaths);
+
+protected slots:
+  void on_addPipelinesBtn_clicked();
+  void on_addDirectoryBtn_clicked();
+  void on_cancelSelectedBtn_clicked();
+  void on_clearFinishedBtn_clicked();
+
+  void listenJobAdded(int id);
+  void listenJobChanged(int id);
+  void listenJobsRemoved();
+  void listenSettingsChanged();
+
+  /**
+   * @brief updateRunningTimes Refreshes the time column of the running jobs and the summary
+   */
+  void updateRunningTimes();
+
+protected:
+  /**
+   * @brief setupGui
+   */
+  void setupGui();
+
+  /**
+   * @brief rowForJob
+   * @param id
+   * @return The table row that shows the job, or -1
+   */
+  int rowForJob(int id) const;
+
+  /**
+   * @brief updateRow
+   * @param row
+   * @param job
+   */
+  void updateRow(int row, const BatchQueue::Job& job);
+
+  /**
+   * @brief updateSummary
+   */
+  void updateSummary();
+
+  /**
+   * @brief FormatMSecs
+   * @param msecs
+   * @return
+   */
+  static QString FormatMSecs(qint64 msecs);
+
+private:
+  BatchQueue* m_Queue = nullptr;
+  QTimer* m_RefreshTimer = nullptr;
+  QString m_LastDirectory;
+
+  BatchQueueWidget(const BatchQueueWidget&) = delete; // Copy Constructor Not Implemented
+  void operator=(const BatchQueueWidget&) = delete;   // Move assignment Not Implemented
+};
@@ -0,0 +1,633 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "DirectoryWatcher.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QFileSystemWatcher>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QSaveFile>
+#include <QtCore/QTimer>
+
+#include "SIMPLView/ParameterSweep.h"
+
+namespace
+{
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonValue jsonValueAt(const QJsonObject& pipelineJson, const QString& parameterPath)
+{
+  QStringList path = parameterPath.split('/');
+  QJsonValue current = pipelineJson;
+  for(int i = 0; i < path.size() && !current.isUndefined(); i++)
+  {
+    current = current.isArray() ? current.toArray().at(path[i].toInt()) : current.toObject().value(path[i]);
+  }
+  return current;
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DirectoryWatcher::DirectoryWatcher(QObject* parent)
+: QObject(parent)
+{
+  m_Clock.start();
+
+  m_FileSystemWatcher = new QFileSystemWatcher(this);
+  connect(m_FileSystemWatcher, &QFileSystemWatcher::directoryChanged, this, &DirectoryWatcher::scanDirectory);
+
+  // The directory only changes when a file appears or goes away, whether a file is still growing is polled
+  m_PollTimer = new QTimer(this);
+  connect(m_PollTimer, &QTimer::timeout, this, &DirectoryWatcher::scanDirectory);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DirectoryWatcher::~DirectoryWatcher() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList DirectoryWatcher::FindFileParameters(const QJsonObject& pipelineJson)
+{
+  QStringList parameters;
+  int filterCount = pipelineJson["PipelineBuilder"].toObject()["Number_Filters"].toInt();
+  for(int i = 0; i < filterCount; i++)
+  {
+    QJsonObject filterObject = pipelineJson[QString::number(i)].toObject();
+    for(const QString& key : filterObject.keys())
+    {
+      if(!key.startsWith("Filter_") && filterObject[key].isString() && (key.contains("File", Qt::CaseInsensitive) || key.contains("Path", Qt::CaseInsensitive)))
+      {
+        parameters.push_back(QString("%1/%2").arg(i).arg(key));
+      }
+    }
+  }
+  return parameters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString DirectoryWatcher::StatusString(RunStatus status)
+{
+  switch(status)
+  {
+  case RunStatus::Queued:
+    return "Queued";
+  case RunStatus::Running:
+    return "Running";
+  case RunStatus::Completed:
+    return "Completed";
+  case RunStatus::Failed:
+    return "Failed";
+  }
+  return QString();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool DirectoryWatcher::setPipelineFile(const QString& filePath, QString& error)
+{
+  QFile file(filePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    error = QString("Could not open the pipeline file '%1'").arg(filePath);
+    return false;
+  }
+
+  QJsonParseError parseError;
+  QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+  if(parseError.error != QJsonParseError::NoError || !doc.isObject())
+  {
+    error = QString("The pipeline file '%1' is not valid JSON: %2").arg(filePath, parseError.errorString());
+    return false;
+  }
+
+  m_PipelineJson = doc.object();
+  m_InputParameter.clear();
+  m_OutputParameter.clear();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject DirectoryWatcher::getPipelineJson() const
+{
+  return m_PipelineJson;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool DirectoryWatcher::setInputParameter(const QString& parameterPath, QString& error)
+{
+  if(!jsonValueAt(m_PipelineJson, parameterPath).isString())
+  {
+    error = QString("The pipeline has no file parameter '%1'").arg(parameterPath);
+    return false;
+  }
+  m_InputParameter = parameterPath;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool DirectoryWatcher::setOutputParameter(const QString& parameterPath, QString& error)
+{
+  if(!parameterPath.isEmpty() && !jsonValueAt(m_PipelineJson, parameterPath).isString())
+  {
+    error = QString("The pipeline has no file parameter '%1'").arg(parameterPath);
+    return false;
+  }
+  m_OutputParameter = parameterPath;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DirectoryWatcher::setOutputDirectory(const QString& dirPath)
+{
+  m_OutputDirectory = dirPath;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DirectoryWatcher::setNameFilters(const QStringList& nameFilters)
+{
+  m_NameFilters = nameFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DirectoryWatcher::setSettleMSecs(int value)
+{
+  m_SettleMSecs = qMax(0, value);
+  m_PollTimer->setInterval(qBound(100, m_SettleMSecs / 4, 1000));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DirectoryWatcher::setMaxInFlight(int value)
+{
+  m_MaxInFlight = qMax(1, value);
+  dispatchRuns();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DirectoryWatcher::setMaxBacklog(int value)
+{
+  m_MaxBacklog = qMax(1, value);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DirectoryWatcher::setProcessExistingFiles(bool value)
+{
+  m_ProcessExistingFiles = value;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool DirectoryWatcher::start(const QString& dirPath, QString& error)
+{
+  QFileInfo dirInfo(dirPath);
+  if(!dirInfo.isDir())
+  {
+    error = QString("'%1' is not a directory").arg(dirPath);
+    return false;
+  }
+  if(m_InputParameter.isEmpty())
+  {
+    error = QString("Choose the parameter that receives the new files");
+    return false;
+  }
+  if(!m_PipelineDir.isValid())
+  {
+    error = QString("Could not create a directory for the pipelines of the runs");
+    return false;
+  }
+
+  // Results written next to the inputs would come back as new input files, run after run
+  QString watchedDir = QDir::cleanPath(dirInfo.absoluteFilePath());
+  QString outputDir = outputDirectory();
+  if(!outputDir.isEmpty() && (outputDir == watchedDir || outputDir.startsWith(watchedDir + "/")))
+  {
+    error = QString("The output directory '%1' is inside the watched directory, choose another output directory").arg(outputDir);
+    return false;
+  }
+
+  stop();
+
+  m_Directory = dirInfo.absoluteFilePath();
+  m_Seen.clear();
+  m_Pending.clear();
+  if(!m_ProcessExistingFiles)
+  {
+    for(const QString& filePath : listFiles())
+    {
+      m_Seen.insert(filePath);
+    }
+  }
+
+  m_FileSystemWatcher->addPath(m_Directory);
+  setSettleMSecs(m_SettleMSecs);
+  m_PollTimer->start();
+  scanDirectory();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DirectoryWatcher::stop()
+{
+  if(!isWatching())
+  {
+    return;
+  }
+
+  m_PollTimer->stop();
+  m_FileSystemWatcher->removePath(m_Directory);
+
+  // Files that were not handed out yet are dropped, runs in flight still report back
+  for(int id : m_Backlog)
+  {
+    for(int i = 0; i < m_Runs.size(); i++)
+    {
+      if(m_Runs[i].id == id)
+      {
+        m_Runs.remove(i);
+        break;
+      }
+    }
+  }
+  m_Backlog.clear();
+  m_Pending.clear();
+  emit runsChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool DirectoryWatcher::isWatching() const
+{
+  return m_PollTimer->isActive();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString DirectoryWatcher::getDirectory() const
+{
+  return m_Directory;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList DirectoryWatcher::listFiles() const
+{
+  QStringList filePaths;
+  QDir dir(m_Directory);
+  for(const QFileInfo& fileInfo : dir.entryInfoList(m_NameFilters, QDir::Files | QDir::Readable, QDir::Time | QDir::Reversed))
+  {
+    // The results of earlier runs are never inputs, even if a pipeline wrote them here on its own
+    if(!m_OutputFiles.contains(fileInfo.absoluteFilePath()))
+    {
+      filePaths.push_back(fileInfo.absoluteFilePath());
+    }
+  }
+  return filePaths;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString DirectoryWatcher::outputDirectory() const
+{
+  if(m_OutputParameter.isEmpty())
+  {
+    return QString();
+  }
+  QString outputDir = m_OutputDirectory;
+  if(outputDir.isEmpty())
+  {
+    outputDir = QFileInfo(jsonValueAt(m_PipelineJson, m_OutputParameter).toString()).absolutePath();
+  }
+  return QDir::cleanPath(QFileInfo(outputDir).absoluteFilePath());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DirectoryWatcher::scanDirectory()
+{
+  if(!isWatching())
+  {
+    return;
+  }
+
+  qint64 now = m_Clock.elapsed();
+  QSet<QString> present;
+  bool queued = false;
+  for(const QString& filePath : listFiles())
+  {
+    present.insert(filePath);
+    if(m_Seen.contains(filePath))
+    {
+      continue;
+    }
+
+    QFileInfo fileInfo(filePath);
+    auto iter = m_Pending.find(filePath);
+    if(iter == m_Pending.end())
+    {
+      PendingFile pending;
+      pending.size = fileInfo.size();
+      pending.modified = fileInfo.lastModified();
+      pending.unchangedSinceMSecs = now;
+      m_Pending.insert(filePath, pending);
+      continue;
+    }
+
+    if(iter->size != fileInfo.size() || iter->modified != fileInfo.lastModified())
+    {
+      iter->size = fileInfo.size();
+      iter->modified = fileInfo.lastModified();
+      iter->unchangedSinceMSecs = now;
+      continue;
+    }
+
+    // Backpressure: settled files wait in the directory until the backlog has room
+    if(now - iter->unchangedSinceMSecs < m_SettleMSecs || m_Backlog.size() >= m_MaxBacklog)
+    {
+      continue;
+    }
+
+    // Writers on Windows keep the file locked until it is complete
+    QFile file(filePath);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+      continue;
+    }
+    file.close();
+
+    m_Pending.erase(iter);
+    m_Seen.insert(filePath);
+
+    Run run;
+    run.id = m_NextRunId++;
+    run.inputFilePath = filePath;
+    run.detectedMSecs = QDateTime::currentMSecsSinceEpoch();
+    m_Runs.push_back(run);
+    m_Backlog.enqueue(run.id);
+    queued = true;
+  }
+
+  // A file that is deleted and dropped in again under the same name is a new file
+  m_Seen.intersect(present);
+  for(auto iter = m_Pending.begin(); iter != m_Pending.end();)
+  {
+    if(present.contains(iter.key()))
+    {
+      ++iter;
+    }
+    else
+    {
+      iter = m_Pending.erase(iter);
+    }
+  }
+
+  if(queued)
+  {
+    emit runsChanged();
+  }
+  dispatchRuns();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString DirectoryWatcher::createRunPipeline(Run& run, QString& error)
+{
+  QJsonValue pipeline(m_PipelineJson);
+  if(!ParameterSweep::SetJsonValue(pipeline, m_InputParameter.split('/'), 0, QJsonValue(run.inputFilePath)))
+  {
+    error = QString("The pipeline has no file parameter '%1'").arg(m_InputParameter);
+    return QString();
+  }
+
+  if(!m_OutputParameter.isEmpty())
+  {
+    QFileInfo currentOutput(jsonValueAt(m_PipelineJson, m_OutputParameter).toString());
+    QString outputDir = outputDirectory();
+    QString fileName = QFileInfo(run.inputFilePath).completeBaseName();
+    if(!currentOutput.suffix().isEmpty())
+    {
+      fileName += "." + currentOutput.suffix();
+    }
+    run.outputFilePath = QDir(outputDir).filePath(fileName);
+    m_OutputFiles.insert(run.outputFilePath);
+    if(!ParameterSweep::SetJsonValue(pipeline, m_OutputParameter.split('/'), 0, QJsonValue(run.outputFilePath)))
+    {
+      error = QString("The pipeline has no file parameter '%1'").arg(m_OutputParameter);
+      return QString();
+    }
+  }
+
+  QString filePath = m_PipelineDir.filePath(QString("Run_%1.json").arg(run.id));
+  QSaveFile file(filePath);
+  if(!file.open(QIODevice::WriteOnly))
+  {
+    error = QString("Could not write the pipeline file '%1'").arg(filePath);
+    return QString();
+  }
+  file.write(QJsonDocument(pipeline.toObject()).toJson());
+  if(!file.commit())
+  {
+    error = QString("Could not write the pipeline file '%1'").arg(filePath);
+    return QString();
+  }
+  return filePath;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DirectoryWatcher::dispatchRuns()
+{
+  while(m_InFlightCount < m_MaxInFlight && !m_Backlog.isEmpty())
+  {
+    Run* run = findRun(m_Backlog.dequeue());
+    if(run == nullptr)
+    {
+      continue;
+    }
+
+    QString error;
+    QString pipelineFilePath = createRunPipeline(*run, error);
+    run->startedMSecs = QDateTime::currentMSecsSinceEpoch();
+    if(pipelineFilePath.isEmpty())
+    {
+      run->status = RunStatus::Failed;
+      run->finishedMSecs = run->startedMSecs;
+      run->errorCode = -1;
+      run->message = error;
+      m_FailedCount++;
+      emit runsChanged();
+      continue;
+    }
+
+    run->status = RunStatus::Running;
+    m_RunPipelineFiles.insert(run->id, pipelineFilePath);
+    m_InFlightCount++;
+
+    // The executor may report back before the signal returns, so nothing may use the run afterwards
+    int id = run->id;
+    QString inputFilePath = run->inputFilePath;
+    emit runsChanged();
+    emit runReady(id, inputFilePath, pipelineFilePath);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DirectoryWatcher::runFinished(int id, int errorCode, const QString& message)
+{
+  Run* run = findRun(id);
+  if(run == nullptr || run->status != RunStatus::Running)
+  {
+    return;
+  }
+
+  run->status = (errorCode < 0) ? RunStatus::Failed : RunStatus::Completed;
+  run->finishedMSecs = QDateTime::currentMSecsSinceEpoch();
+  run->errorCode = errorCode;
+  run->message = message;
+  if(errorCode < 0)
+  {
+    m_FailedCount++;
+  }
+  else
+  {
+    m_CompletedCount++;
+  }
+  m_InFlightCount--;
+  QFile::remove(m_RunPipelineFiles.take(id));
+
+  // Only finished runs are forgotten, they are the oldest anyway
+  while(m_Runs.size() > MaxRunHistory && (m_Runs.front().status == RunStatus::Completed || m_Runs.front().status == RunStatus::Failed))
+  {
+    m_Runs.pop_front();
+  }
+
+  emit runsChanged();
+  dispatchRuns();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DirectoryWatcher::Run* DirectoryWatcher::findRun(int id)
+{
+  for(Run& run : m_Runs)
+  {
+    if(run.id == id)
+    {
+      return &run;
+    }
+  }
+  return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<DirectoryWatcher::Run> DirectoryWatcher::getRuns() const
+{
+  return m_Runs;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int DirectoryWatcher::getInFlightCount() const
+{
+  return m_InFlightCount;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int DirectoryWatcher::getBacklogCount() const
+{
+  return m_Backlog.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int DirectoryWatcher::getPendingCount() const
+{
+  return m_Pending.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int DirectoryWatcher::getFinishedCount(RunStatus status) const
+{
+  return (status == RunStatus::Failed) ? m_FailedCount : m_CompletedCount;
+}
@@ -0,0 +1,331 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QDateTime>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QQueue>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QVector>
+
+class QFileSystemWatcher;
+class QTimer;
+
+/**
+ * @brief The DirectoryWatcher class binds the input file parameter of a pipeline to a directory. Every new
+ * file that matches the name filters is handed out as a copy of the pipeline that reads it, once the file's
+ * size and modification time stopped changing for the settle interval. The watcher does not execute the
+ * pipelines itself: runReady is emitted for at most the maximum number of runs in flight and the executor
+ * reports back with runFinished. Files that arrive while the backlog is full are left in the directory until
+ * there is room, so a slow pipeline never piles up an unbounded amount of work.
+ *
+ * Parameters are addressed as in ParameterSweep, e.g. "0/InputFile".
+ */
+class DirectoryWatcher : public QObject
+{
+  Q_OBJECT
+
+public:
+  enum class RunStatus : int
+  {
+    Queued,
+    Running,
+    Completed,
+    Failed
+  };
+
+  struct Run
+  {
+    int id = 0;
+    QString inputFilePath;
+    QString outputFilePath;
+    RunStatus status = RunStatus::Queued;
+    qint64 detectedMSecs = 0;
+    qint64 startedMSecs = 0;
+    qint64 finishedMSecs = 0;
+    int errorCode = 0;
+    QString message;
+  };
+
+  DirectoryWatcher(QObject* parent = nullptr);
+  ~DirectoryWatcher() override;
+
+  static const int DefaultSettleMSecs = 2000;
+  static const int DefaultMaxBacklog = 256;
+  static const int MaxRunHistory = 1000;
+
+  /**
+   * @brief FindFileParameters
+   * @param pipelineJson
+   * @return The paths of the string parameters whose key names a file or path, e.g. "0/InputFile"
+   */
+  static QStringList FindFileParameters(const QJsonObject& pipelineJson);
+
+  /**
+   * @brief StatusString
+   * @param status
+   * @return
+   */
+  static QString StatusString(RunStatus status);
+
+  /**
+   * @brief setPipelineFile Reads the pipeline, later changes of the file are not seen
+   * @param filePath
+   * @param error
+   * @return
+   */
+  bool setPipelineFile(const QString& filePath, QString& error);
+
+  /**
+   * @brief getPipelineJson
+   * @return
+   */
+  QJsonObject getPipelineJson() const;
+
+  /**
+   * @brief setInputParameter
+   * @param parameterPath The parameter that receives the path of each new file
+   * @param error
+   * @return
+   */
+  bool setInputParameter(const QString& parameterPath, QString& error);
+
+  /**
+   * @brief setOutputParameter Optional. Each run writes to the output directory, into a file named after
+   * the input file with the extension of the parameter's current value.
+   * @param parameterPath An empty path keeps the output parameter of the pipeline as it is
+   * @param error
+   * @return
+   */
+  bool setOutputParameter(const QString& parameterPath, QString& error);
+
+  /**
+   * @brief setOutputDirectory Defaults to the directory of the output parameter's current value
+   * @param dirPath
+   */
+  void setOutputDirectory(const QString& dirPath);
+
+  /**
+   * @brief setNameFilters Empty filters match every file
+   * @param nameFilters Wildcards, e.g. "*.ang"
+   */
+  void setNameFilters(const QStringList& nameFilters);
+
+  /**
+   * @brief setSettleMSecs
+   * @param value How long a file has to stay unchanged before it counts as fully written
+   */
+  void setSettleMSecs(int value);
+
+  /**
+   * @brief setMaxInFlight
+   * @param value The number of runs that may be handed out before one has finished
+   */
+  void setMaxInFlight(int value);
+
+  /**
+   * @brief setMaxBacklog
+   * @param value The number of settled files that may wait for a run
+   */
+  void setMaxBacklog(int value);
+
+  /**
+   * @brief setProcessExistingFiles
+   * @param value If false, files that are in the directory when the watch starts are ignored
+   */
+  void setProcessExistingFiles(bool value);
+
+  /**
+   * @brief start Refuses an output directory that is the watched directory or inside of it
+   * @param dirPath
+   * @param error
+   * @return
+   */
+  bool start(const QString& dirPath, QString& error);
+
+  /**
+   * @brief stop Stops handing out runs, runs in flight still report back
+   */
+  void stop();
+
+  /**
+   * @brief isWatching
+   * @return
+   */
+  bool isWatching() const;
+
+  /**
+   * @brief getDirectory
+   * @return
+   */
+  QString getDirectory() const;
+
+  /**
+   * @brief getRuns
+   * @return The most recent runs, oldest first
+   */
+  QVector<Run> getRuns() const;
+
+  /**
+   * @brief getInFlightCount
+   * @return
+   */
+  int getInFlightCount() const;
+
+  /**
+   * @brief getBacklogCount
+   * @return
+   */
+  int getBacklogCount() const;
+
+  /**
+   * @brief getPendingCount
+   * @return The number of files that are still being written or wait for room in the backlog
+   */
+  int getPendingCount() const;
+
+  /**
+   * @brief getFinishedCount
+   * @param status
+   * @return
+   */
+  int getFinishedCount(RunStatus status) const;
+
+public slots:
+  /**
+   * @brief runFinished Must be called once for every run that runReady handed out
+   * @param id
+   * @param errorCode
+   * @param message
+   */
+  void runFinished(int id, int errorCode, const QString& message);
+
+signals:
+  /**
+   * @brief runReady
+   * @param id
+   * @param inputFilePath
+   * @param pipelineFilePath A pipeline file that reads the input file. It is deleted after runFinished.
+   */
+  void runReady(int id, const QString& inputFilePath, const QString& pipelineFilePath);
+
+  /**
+   * @brief runsChanged Emitted when a run was handed out or finished
+   */
+  void runsChanged();
+
+protected slots:
+  /**
+   * @brief scanDirectory Picks up new files and hands out the ones that have settled
+   */
+  void scanDirectory();
+
+protected:
+  struct PendingFile
+  {
+    qint64 size = -1;
+    QDateTime modified;
+    qint64 unchangedSinceMSecs = 0;
+  };
+
+  /**
+   * @brief listFiles
+   * @return The absolute paths of the files in the directory that match the name filters
+   */
+  QStringList listFiles() const;
+
+  /**
+   * @brief outputDirectory
+   * @return The absolute directory the runs write their output file to, or an empty string without an output parameter
+   */
+  QString outputDirectory() const;
+
+  /**
+   * @brief dispatchRuns Hands out runs from the backlog while fewer than the maximum are in flight
+   */
+  void dispatchRuns();
+
+  /**
+   * @brief createRunPipeline
+   * @param run
+   * @param error
+   * @return The path of the pipeline file for the run, or an empty string
+   */
+  QString createRunPipeline(Run& run, QString& error);
+
+  /**
+   * @brief findRun
+   * @param id
+   * @return
+   */
+  Run* findRun(int id);
+
+private:
+  QJsonObject m_PipelineJson;
+  QString m_InputParameter;
+  QString m_OutputParameter;
+  QString m_OutputDirectory;
+  QStringList m_NameFilters;
+  int m_SettleMSecs = DefaultSettleMSecs;
+  int m_MaxInFlight = 1;
+  int m_MaxBacklog = DefaultMaxBacklog;
+  bool m_ProcessExistingFiles = false;
+
+  QString m_Directory;
+  QFileSystemWatcher* m_FileSystemWatcher = nullptr;
+  QTimer* m_PollTimer = nullptr;
+  QElapsedTimer m_Clock;
+  QTemporaryDir m_PipelineDir;
+
+  QSet<QString> m_Seen;
+  QSet<QString> m_OutputFiles;
+  QHash<QString, PendingFile> m_Pending;
+  QQueue<int> m_Backlog;
+  QVector<Run> m_Runs;
+  QHash<int, QString> m_RunPipelineFiles;
+  int m_NextRunId = 1;
+  int m_InFlightCount = 0;
+  int m_CompletedCount = 0;
+  int m_FailedCount = 0;
+
+  DirectoryWatcher(const DirectoryWatcher&) = delete; // Copy Constructor Not Implemented
+  void operator=(const DirectoryWatcher&) = delete;   // Move assignment Not Implemented
+};
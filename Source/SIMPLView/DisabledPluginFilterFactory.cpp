@@ -0,0 +1,122 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "DisabledPluginFilterFactory.h"
+
+#include <QtCore/QDebug>
+
+namespace
+{
+const QString k_DisabledGroup("Disabled Plugins");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DisabledPluginFilterFactory::DisabledPluginFilterFactory(const QString& pluginName, IFilterFactory::Pointer factory)
+: m_PluginName(pluginName)
+, m_Factory(factory)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DisabledPluginFilterFactory::~DisabledPluginFilterFactory() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer DisabledPluginFilterFactory::create() const
+{
+  qDebug() << "The plugin" << m_PluginName << "is disabled. Enable it in the Plugin Information dialog to use" << m_Factory->getFilterHumanLabel();
+  return AbstractFilter::NullPointer();
+}
+
+// -----------------------------------------------------------------------------
+// The filters of a disabled plugin are collected in one group of the filter library
+// -----------------------------------------------------------------------------
+QString DisabledPluginFilterFactory::getFilterGroup() const
+{
+  return k_DisabledGroup;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString DisabledPluginFilterFactory::getFilterSubGroup() const
+{
+  return m_PluginName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString DisabledPluginFilterFactory::getFilterHumanLabel() const
+{
+  return m_Factory->getFilterHumanLabel();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString DisabledPluginFilterFactory::getBrandingString() const
+{
+  return m_Factory->getBrandingString();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString DisabledPluginFilterFactory::getCompiledLibraryName() const
+{
+  return m_Factory->getCompiledLibraryName();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QUuid DisabledPluginFilterFactory::getUuid()
+{
+  return m_Factory->getUuid();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IFilterFactory::Pointer DisabledPluginFilterFactory::getOriginalFactory() const
+{
+  return m_Factory;
+}
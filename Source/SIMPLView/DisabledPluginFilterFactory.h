@@ -0,0 +1,91 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QString>
+#include <QtCore/QUuid>
+
+#include "SIMPLib/Filtering/IFilterFactory.hpp"
+
+/**
+ * @brief The DisabledPluginFilterFactory class takes the place of the filter factories of a plugin that was
+ * disabled while the application is running. The FilterManager can not forget a factory, so the filters
+ * are listed under their own group and no longer create instances. The original factory is kept so that
+ * enabling the plugin again simply puts it back.
+ */
+class DisabledPluginFilterFactory : public IFilterFactory
+{
+public:
+  SIMPL_SHARED_POINTERS(DisabledPluginFilterFactory)
+
+  static Pointer New(const QString& pluginName, IFilterFactory::Pointer factory)
+  {
+    Pointer sharedPtr(new DisabledPluginFilterFactory(pluginName, factory));
+    return sharedPtr;
+  }
+
+  ~DisabledPluginFilterFactory() override;
+
+  AbstractFilter::Pointer create() const override;
+
+  QString getFilterGroup() const override;
+
+  QString getFilterSubGroup() const override;
+
+  QString getFilterHumanLabel() const override;
+
+  QString getBrandingString() const override;
+
+  QString getCompiledLibraryName() const override;
+
+  QUuid getUuid() override;
+
+  /**
+   * @brief getOriginalFactory
+   * @return The factory that the plugin registered
+   */
+  IFilterFactory::Pointer getOriginalFactory() const;
+
+protected:
+  DisabledPluginFilterFactory(const QString& pluginName, IFilterFactory::Pointer factory);
+
+private:
+  QString m_PluginName;
+  IFilterFactory::Pointer m_Factory;
+
+  DisabledPluginFilterFactory(const DisabledPluginFilterFactory&) = delete; // Copy Constructor Not Implemented
+  void operator=(const DisabledPluginFilterFactory&) = delete;              // Move assignment Not Implemented
+};
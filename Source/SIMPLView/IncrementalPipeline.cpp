@@ -0,0 +1,334 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "IncrementalPipeline.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QMutexLocker>
+
+#include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+#include "SIMPLView/StageCache.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IncrementalPipeline::IncrementalPipeline() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IncrementalPipeline::~IncrementalPipeline() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool IncrementalPipeline::setPipelineFile(const QString& filePath, QString& error)
+{
+  QFile file(filePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    error = QString("Could not open the pipeline file '%1'").arg(filePath);
+    return false;
+  }
+
+  QJsonParseError parseError;
+  QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+  if(parseError.error != QJsonParseError::NoError || !doc.isObject())
+  {
+    error = QString("The pipeline file '%1' is not valid JSON: %2").arg(filePath, parseError.errorString());
+    return false;
+  }
+
+  m_PipelineFilePath = filePath;
+  m_StageKeys = StageCache::ComputeStageKeys(doc.object());
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList IncrementalPipeline::getStageKeys() const
+{
+  return m_StageKeys;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IncrementalPipeline::setMessageHandler(const MessageHandler& handler)
+{
+  m_MessageHandler = handler;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IncrementalPipeline::setCheckpointer(const PipelineCheckpointer::Pointer& checkpointer)
+{
+  m_Checkpointer = checkpointer;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineCheckpointer::Pointer IncrementalPipeline::getCheckpointer() const
+{
+  return m_Checkpointer;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IncrementalPipeline::setResumeFromCheckpoint(bool value)
+{
+  m_ResumeFromCheckpoint = value;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IncrementalPipeline::sendMessage(const PipelineMessage& msg) const
+{
+  if(m_MessageHandler)
+  {
+    m_MessageHandler(msg);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool IncrementalPipeline::execute(QString& error)
+{
+  m_Canceled = false;
+  m_ResumeIndex = -1;
+  m_ResumedFromCheckpoint = false;
+  m_ExecutedFilterCount = 0;
+  m_StoredSnapshotCount = 0;
+
+  QElapsedTimer timer;
+  timer.start();
+
+  JsonFilterParametersReader::Pointer jsonReader = JsonFilterParametersReader::New();
+  FilterPipeline::Pointer pipeline = jsonReader->readPipelineFromFile(m_PipelineFilePath);
+  if(nullptr == pipeline.get())
+  {
+    error = QString("Could not read the pipeline file '%1'").arg(m_PipelineFilePath);
+    return false;
+  }
+
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+  if(filters.size() != m_StageKeys.size())
+  {
+    error = QString("The pipeline file '%1' changed while it was being executed").arg(m_PipelineFilePath);
+    return false;
+  }
+
+  for(AbstractFilter::Pointer filter : filters)
+  {
+    QObject::connect(filter.get(), &AbstractFilter::filterGeneratedMessage, [this](const PipelineMessage& msg) { sendMessage(msg); });
+  }
+
+  // Catches invalid parameters before a snapshot is restored
+  int err = pipeline->preflightPipeline();
+  if(err < 0)
+  {
+    error = QString("The pipeline failed to preflight with error %1").arg(err);
+    return false;
+  }
+
+  StageCache* cache = StageCache::Instance();
+  bool fromCheckpoint = m_ResumeFromCheckpoint && m_Checkpointer.get() != nullptr;
+  DataContainerArray::Pointer dca;
+  if(fromCheckpoint)
+  {
+    m_ResumeIndex = PipelineCheckpointer::FindResumeIndex(m_Checkpointer->getDirectory(), m_StageKeys);
+    if(m_ResumeIndex >= 0)
+    {
+      dca = PipelineCheckpointer::Restore(m_Checkpointer->getDirectory(), m_StageKeys[m_ResumeIndex]);
+    }
+  }
+  else
+  {
+    m_ResumeIndex = cache->findResumeIndex(m_StageKeys);
+    if(m_ResumeIndex >= 0)
+    {
+      dca = cache->restore(m_StageKeys[m_ResumeIndex]);
+    }
+  }
+  if(dca.get() == nullptr)
+  {
+    // Evicted or unreadable since it was looked up
+    m_ResumeIndex = -1;
+    dca = DataContainerArray::New();
+  }
+  else
+  {
+    m_ResumedFromCheckpoint = fromCheckpoint;
+    sendMessage(PipelineMessage("IncrementalPipeline",
+                                QString("Resuming behind filter %1, %2%3").arg(m_ResumeIndex + 1).arg(filters[m_ResumeIndex]->getHumanLabel()).arg(fromCheckpoint ? " from its checkpoint" : ""),
+                                0, PipelineMessage::MessageType::StandardOutputMessage, m_ResumeIndex));
+  }
+
+  if(m_Checkpointer.get() != nullptr)
+  {
+    m_Checkpointer->setPipeline(filters, m_StageKeys);
+  }
+
+  for(int i = m_ResumeIndex + 1; i < filters.size() && err >= 0; i++)
+  {
+    AbstractFilter::Pointer filter = filters[i];
+    if(!filter->getEnabled())
+    {
+      continue;
+    }
+
+    {
+      QMutexLocker locker(&m_CurrentFilterMutex);
+      if(m_Canceled)
+      {
+        break;
+      }
+      m_CurrentFilter = filter;
+    }
+
+    PipelineMessage progress("IncrementalPipeline", QString("[%1/%2] %3").arg(i + 1).arg(filters.size()).arg(filter->getHumanLabel()), 0,
+                             PipelineMessage::MessageType::StatusMessageAndProgressValue, i);
+    progress.setProgressValue(100 * i / filters.size());
+    sendMessage(progress);
+
+    filter->setDataContainerArray(dca);
+    if(m_Checkpointer.get() != nullptr)
+    {
+      m_Checkpointer->beginFilter(filter.get());
+    }
+    filter->execute();
+    err = filter->getErrorCondition();
+    m_ExecutedFilterCount++;
+    if(m_Checkpointer.get() != nullptr)
+    {
+      m_Checkpointer->endFilter(filter.get());
+    }
+
+    {
+      QMutexLocker locker(&m_CurrentFilterMutex);
+      m_CurrentFilter = AbstractFilter::NullPointer();
+    }
+
+    if(err < 0)
+    {
+      error = QString("%1 failed with error %2").arg(filter->getHumanLabel()).arg(err);
+    }
+    else if(!m_Canceled && cache->store(m_StageKeys[i], dca))
+    {
+      m_StoredSnapshotCount++;
+    }
+  }
+
+  if(m_Checkpointer.get() != nullptr)
+  {
+    m_Checkpointer->finishRun();
+  }
+
+  if(m_Canceled && err >= 0)
+  {
+    error = QString("The pipeline was canceled");
+    err = -1;
+  }
+
+  for(AbstractFilter::Pointer filter : filters)
+  {
+    filter->setDataContainerArray(DataContainerArray::NullPointer());
+  }
+  m_WallTimeMSecs = timer.elapsed();
+  return err >= 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IncrementalPipeline::cancel()
+{
+  QMutexLocker locker(&m_CurrentFilterMutex);
+  m_Canceled = true;
+  if(m_CurrentFilter.get() != nullptr)
+  {
+    m_CurrentFilter->setCancel(true);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int IncrementalPipeline::getResumeIndex() const
+{
+  return m_ResumeIndex;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool IncrementalPipeline::getResumedFromCheckpoint() const
+{
+  return m_ResumedFromCheckpoint;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int IncrementalPipeline::getExecutedFilterCount() const
+{
+  return m_ExecutedFilterCount;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int IncrementalPipeline::getStoredSnapshotCount() const
+{
+  return m_StoredSnapshotCount;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 IncrementalPipeline::getWallTimeMSecs() const
+{
+  return m_WallTimeMSecs;
+}
@@ -0,0 +1,184 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include "SIMPLib/Common/PipelineMessage.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+#include "SIMPLView/PipelineCheckpointer.h"
+
+/**
+ * @brief The IncrementalPipeline class executes a pipeline file starting behind the last filter whose
+ * result is in the StageCache, and stores the result of every filter it executes in the cache. When only
+ * a parameter near the end of a long pipeline changed, only the filters from that point on run again.
+ * Filters in front of the resume point do not run at all, so files they write are not written again.
+ * With a PipelineCheckpointer the run writes checkpoints as well, and it can resume from the last checkpoint
+ * of an earlier run instead of from the cache.
+ */
+class IncrementalPipeline
+{
+public:
+  SIMPL_SHARED_POINTERS(IncrementalPipeline)
+
+  static Pointer New()
+  {
+    Pointer sharedPtr(new IncrementalPipeline());
+    return sharedPtr;
+  }
+
+  using MessageHandler = std::function<void(const PipelineMessage&)>;
+
+  virtual ~IncrementalPipeline();
+
+  /**
+   * @brief setPipelineFile
+   * @param filePath
+   * @param error
+   * @return
+   */
+  bool setPipelineFile(const QString& filePath, QString& error);
+
+  /**
+   * @brief getStageKeys
+   * @return The StageCache key of every filter in the pipeline
+   */
+  QStringList getStageKeys() const;
+
+  /**
+   * @brief setMessageHandler The handler is called on the executing thread
+   * @param handler
+   */
+  void setMessageHandler(const MessageHandler& handler);
+
+  /**
+   * @brief setCheckpointer
+   * @param checkpointer Decides which filters are checkpointed, may be null
+   */
+  void setCheckpointer(const PipelineCheckpointer::Pointer& checkpointer);
+
+  /**
+   * @brief getCheckpointer
+   * @return
+   */
+  PipelineCheckpointer::Pointer getCheckpointer() const;
+
+  /**
+   * @brief setResumeFromCheckpoint Resumes from the checkpoint directory of the checkpointer instead of the StageCache
+   * @param value
+   */
+  void setResumeFromCheckpoint(bool value);
+
+  /**
+   * @brief execute Runs the pipeline on the calling thread
+   * @param error Set when the pipeline could not run or a filter failed
+   * @return
+   */
+  bool execute(QString& error);
+
+  /**
+   * @brief cancel Stops the pipeline from another thread, the executing filter is asked to stop as well
+   */
+  void cancel();
+
+  /**
+   * @brief getResumeIndex
+   * @return The index of the filter whose cached result the last execution started from, or -1
+   */
+  int getResumeIndex() const;
+
+  /**
+   * @brief getResumedFromCheckpoint
+   * @return Whether the last execution started from a checkpoint rather than from the cache
+   */
+  bool getResumedFromCheckpoint() const;
+
+  /**
+   * @brief getExecutedFilterCount
+   * @return
+   */
+  int getExecutedFilterCount() const;
+
+  /**
+   * @brief getStoredSnapshotCount
+   * @return The number of filter results the last execution put into the cache
+   */
+  int getStoredSnapshotCount() const;
+
+  /**
+   * @brief getWallTimeMSecs
+   * @return
+   */
+  qint64 getWallTimeMSecs() const;
+
+protected:
+  IncrementalPipeline();
+
+  /**
+   * @brief sendMessage
+   * @param msg
+   */
+  void sendMessage(const PipelineMessage& msg) const;
+
+private:
+  QString m_PipelineFilePath;
+  QStringList m_StageKeys;
+  MessageHandler m_MessageHandler;
+  PipelineCheckpointer::Pointer m_Checkpointer;
+  bool m_ResumeFromCheckpoint = false;
+
+  int m_ResumeIndex = -1;
+  bool m_ResumedFromCheckpoint = false;
+  int m_ExecutedFilterCount = 0;
+  int m_StoredSnapshotCount = 0;
+  qint64 m_WallTimeMSecs = 0;
+
+  std::atomic<bool> m_Canceled{false};
+  QMutex m_CurrentFilterMutex;
+  AbstractFilter::Pointer m_CurrentFilter;
+
+  IncrementalPipeline(const IncrementalPipeline&) = delete; // Copy Constructor Not Implemented
+  void operator=(const IncrementalPipeline&) = delete;      // Move assignment Not Implemented
+};
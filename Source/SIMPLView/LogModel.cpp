@@ -0,0 +1,486 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "LogModel.h"
+
+#include <algorithm>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QSaveFile>
+#include <QtCore/QTextStream>
+#include <QtGui/QColor>
+
+#include "SIMPLView/SettingsStore.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+LogModel::LogModel(QObject* parent)
+: QAbstractListModel(parent)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+LogModel::~LogModel() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int LogModel::ReadRetentionLimit()
+{
+  int limit = SettingsStore::Instance()->value("Application Settings/Log Retention Lines", DefaultRetentionLimit).toInt();
+
+  QByteArray limitEnv = qgetenv("SIMPL_LOG_RETENTION_LINES");
+  if(!limitEnv.isEmpty())
+  {
+    limit = limitEnv.toInt();
+  }
+
+  return qMax(1000, limit);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogModel::WriteRetentionLimit(int limit)
+{
+  SettingsStore::Instance()->write([limit](SettingsWriter* prefs) {
+    prefs->beginGroup("Application Settings");
+    prefs->setValue("Log Retention Lines", limit);
+    prefs->endGroup();
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString LogModel::LevelName(Level level)
+{
+  switch(level)
+  {
+  case Level::Info:
+    return "INFO";
+  case Level::Status:
+    return "STATUS";
+  case Level::Warning:
+    return "WARNING";
+  case Level::Error:
+    return "ERROR";
+  }
+  return QString();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString LogModel::FormatEntry(const Entry& entry)
+{
+  return QString("%1 [%2] %3").arg(QDateTime::fromMSecsSinceEpoch(entry.timestamp).toString("hh:mm:ss.zzz"), LevelName(entry.level), entry.text);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogModel::append(Level level, const QString& text)
+{
+  Entry entry;
+  entry.timestamp = QDateTime::currentMSecsSinceEpoch();
+  entry.level = level;
+  entry.text = text;
+  append(QVector<Entry>{entry});
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogModel::append(const QVector<Entry>& entries)
+{
+  if(entries.isEmpty())
+  {
+    return;
+  }
+
+  // More lines than can be kept at once only leaves the newest ones
+  int first = 0;
+  if(entries.size() > m_RetentionLimit)
+  {
+    first = entries.size() - m_RetentionLimit;
+    m_DroppedCount += first;
+  }
+
+  int incoming = entries.size() - first;
+  int overflow = getEntryCount() + incoming - m_RetentionLimit;
+  if(overflow > 0)
+  {
+    dropOldest(overflow);
+  }
+
+  bool filtered = isFiltered();
+  std::vector<char> matches(static_cast<size_t>(incoming), 1);
+  int newRows = incoming;
+  if(filtered)
+  {
+    newRows = 0;
+    for(int i = 0; i < incoming; i++)
+    {
+      matches[i] = matchesFilter(entries[first + i]) ? 1 : 0;
+      newRows += matches[i];
+    }
+  }
+
+  int firstRow = rowCount();
+  if(newRows > 0)
+  {
+    beginInsertRows(QModelIndex(), firstRow, firstRow + newRows - 1);
+  }
+
+  for(int i = 0; i < incoming; i++)
+  {
+    qint64 sequence = m_NextSequence++;
+    if(m_Entries.size() < static_cast<size_t>(m_RetentionLimit))
+    {
+      m_Entries.push_back(entries[first + i]);
+    }
+    else
+    {
+      m_Entries[static_cast<size_t>(sequence % m_RetentionLimit)] = entries[first + i];
+    }
+
+    if(filtered && matches[i] != 0)
+    {
+      m_FilteredRows.push_back(sequence);
+    }
+  }
+
+  if(newRows > 0)
+  {
+    endInsertRows();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogModel::clear()
+{
+  beginResetModel();
+  m_Entries.clear();
+  m_Entries.shrink_to_fit();
+  m_FilteredRows.clear();
+  m_FirstSequence = 0;
+  m_NextSequence = 0;
+  endResetModel();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogModel::setRetentionLimit(int limit)
+{
+  limit = qMax(1, limit);
+  if(limit == m_RetentionLimit)
+  {
+    return;
+  }
+
+  beginResetModel();
+
+  // Lay the kept entries out from slot 0 again so that slot = sequence % limit holds for the new limit
+  qint64 keep = qMin(getEntryCount(), limit);
+  std::vector<Entry> entries;
+  entries.reserve(static_cast<size_t>(keep));
+  for(qint64 sequence = m_NextSequence - keep; sequence < m_NextSequence; sequence++)
+  {
+    entries.push_back(entryAt(sequence));
+  }
+
+  m_DroppedCount += getEntryCount() - keep;
+  m_Entries.swap(entries);
+  m_FirstSequence = 0;
+  m_NextSequence = keep;
+  m_RetentionLimit = limit;
+  rebuildFilteredRows();
+
+  endResetModel();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int LogModel::getRetentionLimit() const
+{
+  return m_RetentionLimit;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogModel::setFilter(const QString& text, Level minimumLevel)
+{
+  if(text == m_FilterText && minimumLevel == m_MinimumLevel)
+  {
+    return;
+  }
+
+  beginResetModel();
+  m_FilterText = text;
+  m_MinimumLevel = minimumLevel;
+  rebuildFilteredRows();
+  endResetModel();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool LogModel::isFiltered() const
+{
+  return !m_FilterText.isEmpty() || m_MinimumLevel != Level::Info;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int LogModel::find(const QString& text, int fromRow, bool backward) const
+{
+  int rows = rowCount();
+  if(text.isEmpty() || rows == 0)
+  {
+    return -1;
+  }
+
+  int step = backward ? -1 : 1;
+  for(int i = 1; i <= rows; i++)
+  {
+    int row = ((fromRow + step * i) % rows + rows) % rows;
+    if(entryAt(sequenceForRow(row)).text.contains(text, Qt::CaseInsensitive))
+    {
+      return row;
+    }
+  }
+  return -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int LogModel::getEntryCount() const
+{
+  return static_cast<int>(m_NextSequence - m_FirstSequence);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 LogModel::getDroppedCount() const
+{
+  return m_DroppedCount;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool LogModel::exportToFile(const QString& filePath, bool filteredOnly) const
+{
+  QSaveFile file(filePath);
+  if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+  {
+    return false;
+  }
+
+  // Written entry by entry, the whole log is never formatted into one string
+  QTextStream out(&file);
+  if(filteredOnly)
+  {
+    int rows = rowCount();
+    for(int row = 0; row < rows; row++)
+    {
+      out << FormatEntry(entryAt(sequenceForRow(row))) << "\n";
+    }
+  }
+  else
+  {
+    for(qint64 sequence = m_FirstSequence; sequence < m_NextSequence; sequence++)
+    {
+      out << FormatEntry(entryAt(sequence)) << "\n";
+    }
+  }
+  out.flush();
+
+  if(out.status() != QTextStream::Ok)
+  {
+    file.cancelWriting();
+    return false;
+  }
+  return file.commit();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int LogModel::rowCount(const QModelIndex& parent) const
+{
+  if(parent.isValid())
+  {
+    return 0;
+  }
+  return isFiltered() ? static_cast<int>(m_FilteredRows.size()) : getEntryCount();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVariant LogModel::data(const QModelIndex& index, int role) const
+{
+  if(!index.isValid() || index.row() >= rowCount())
+  {
+    return QVariant();
+  }
+
+  const Entry& entry = entryAt(sequenceForRow(index.row()));
+  if(role == Qt::DisplayRole)
+  {
+    return FormatEntry(entry);
+  }
+  if(role == Qt::ForegroundRole)
+  {
+    switch(entry.level)
+    {
+    case Level::Status:
+      return QColor(0, 90, 160);
+    case Level::Warning:
+      return QColor(200, 120, 0);
+    case Level::Error:
+      return QColor(200, 0, 0);
+    default:
+      return QVariant();
+    }
+  }
+  if(role == LevelRole)
+  {
+    return static_cast<int>(entry.level);
+  }
+  if(role == TimestampRole)
+  {
+    return QDateTime::fromMSecsSinceEpoch(entry.timestamp);
+  }
+  return QVariant();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const LogModel::Entry& LogModel::entryAt(qint64 sequence) const
+{
+  return m_Entries[static_cast<size_t>(sequence % m_RetentionLimit)];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 LogModel::sequenceForRow(int row) const
+{
+  return isFiltered() ? m_FilteredRows[static_cast<size_t>(row)] : m_FirstSequence + row;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool LogModel::matchesFilter(const Entry& entry) const
+{
+  if(static_cast<int>(entry.level) < static_cast<int>(m_MinimumLevel))
+  {
+    return false;
+  }
+  return m_FilterText.isEmpty() || entry.text.contains(m_FilterText, Qt::CaseInsensitive);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogModel::dropOldest(int count)
+{
+  count = qMin(count, getEntryCount());
+  if(count <= 0)
+  {
+    return;
+  }
+
+  qint64 firstKept = m_FirstSequence + count;
+  int removedRows = count;
+  if(isFiltered())
+  {
+    auto end = std::lower_bound(m_FilteredRows.begin(), m_FilteredRows.end(), firstKept);
+    removedRows = static_cast<int>(end - m_FilteredRows.begin());
+  }
+
+  if(removedRows > 0)
+  {
+    beginRemoveRows(QModelIndex(), 0, removedRows - 1);
+  }
+
+  if(isFiltered())
+  {
+    m_FilteredRows.erase(m_FilteredRows.begin(), m_FilteredRows.begin() + removedRows);
+  }
+  m_FirstSequence = firstKept;
+  m_DroppedCount += count;
+
+  if(removedRows > 0)
+  {
+    endRemoveRows();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogModel::rebuildFilteredRows()
+{
+  m_FilteredRows.clear();
+  if(!isFiltered())
+  {
+    return;
+  }
+
+  for(qint64 sequence = m_FirstSequence; sequence < m_NextSequence; sequence++)
+  {
+    if(matchesFilter(entryAt(sequence)))
+    {
+      m_FilteredRows.push_back(sequence);
+    }
+  }
+}
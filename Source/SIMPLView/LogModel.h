@@ -0,0 +1,235 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include <QtCore/QAbstractListModel>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+/**
+ * @brief The LogModel class keeps the most recent lines of pipeline output in a ring buffer of plain text
+ * entries tagged with a level. Once the retention limit is reached the oldest lines are dropped, so memory
+ * stays bounded no matter how long the application runs. The model can be filtered by text and minimum
+ * level without copying the entries; the rows of the model are the entries that pass the filter.
+ */
+class LogModel : public QAbstractListModel
+{
+  Q_OBJECT
+
+public:
+  enum class Level : int
+  {
+    Info = 0,
+    Status,
+    Warning,
+    Error
+  };
+
+  enum Roles
+  {
+    LevelRole = Qt::UserRole + 1,
+    TimestampRole
+  };
+
+  struct Entry
+  {
+    qint64 timestamp = 0;
+    Level level = Level::Info;
+    QString text;
+  };
+
+  static const int DefaultRetentionLimit = 100000;
+
+  LogModel(QObject* parent = nullptr);
+  ~LogModel() override;
+
+  /**
+   * @brief ReadRetentionLimit Reads the retention limit from the preferences, the SIMPL_LOG_RETENTION_LINES
+   * environment variable overrides it
+   * @return
+   */
+  static int ReadRetentionLimit();
+
+  /**
+   * @brief WriteRetentionLimit
+   * @param limit
+   */
+  static void WriteRetentionLimit(int limit);
+
+  /**
+   * @brief LevelName
+   * @param level
+   * @return The tag that is written in front of the lines of this level
+   */
+  static QString LevelName(Level level);
+
+  /**
+   * @brief FormatEntry
+   * @param entry
+   * @return The entry as a single line of text with time and level tag
+   */
+  static QString FormatEntry(const Entry& entry);
+
+  /**
+   * @brief append Adds a line stamped with the current time
+   * @param level
+   * @param text
+   */
+  void append(Level level, const QString& text);
+
+  /**
+   * @brief append Adds several entries with a single row insertion
+   * @param entries
+   */
+  void append(const QVector<Entry>& entries);
+
+  /**
+   * @brief clear Removes all entries
+   */
+  void clear();
+
+  /**
+   * @brief setRetentionLimit Drops the oldest entries if there are more than the new limit
+   * @param limit
+   */
+  void setRetentionLimit(int limit);
+
+  /**
+   * @brief getRetentionLimit
+   * @return
+   */
+  int getRetentionLimit() const;
+
+  /**
+   * @brief setFilter Only entries that contain the text, case insensitive, and are at least of the level are shown
+   * @param text
+   * @param minimumLevel
+   */
+  void setFilter(const QString& text, Level minimumLevel);
+
+  /**
+   * @brief isFiltered
+   * @return
+   */
+  bool isFiltered() const;
+
+  /**
+   * @brief find Searches the rows for the text, wrapping around at the ends
+   * @param text
+   * @param fromRow The row after which (or before which, searching backward) the search starts
+   * @param backward
+   * @return The row that contains the text, or -1
+   */
+  int find(const QString& text, int fromRow, bool backward) const;
+
+  /**
+   * @brief getEntryCount
+   * @return The number of entries that are kept, whether they pass the filter or not
+   */
+  int getEntryCount() const;
+
+  /**
+   * @brief getDroppedCount
+   * @return The number of entries that were dropped because of the retention limit
+   */
+  qint64 getDroppedCount() const;
+
+  /**
+   * @brief exportToFile Writes the entries line by line to the file
+   * @param filePath
+   * @param filteredOnly Only write the entries that pass the filter
+   * @return False if the file could not be written
+   */
+  bool exportToFile(const QString& filePath, bool filteredOnly) const;
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+protected:
+  /**
+   * @brief entryAt
+   * @param sequence
+   * @return The entry with the sequence number, which must still be kept
+   */
+  const Entry& entryAt(qint64 sequence) const;
+
+  /**
+   * @brief sequenceForRow
+   * @param row
+   * @return
+   */
+  qint64 sequenceForRow(int row) const;
+
+  /**
+   * @brief matchesFilter
+   * @param entry
+   * @return
+   */
+  bool matchesFilter(const Entry& entry) const;
+
+  /**
+   * @brief dropOldest Removes entries from the front of the buffer
+   * @param count
+   */
+  void dropOldest(int count);
+
+  /**
+   * @brief rebuildFilteredRows
+   */
+  void rebuildFilteredRows();
+
+private:
+  // Entries are numbered in the order they were added; the entry with sequence number s lives in slot
+  // s % m_RetentionLimit, so adding never moves the entries that are already there
+  std::vector<Entry> m_Entries;
+  qint64 m_FirstSequence = 0;
+  qint64 m_NextSequence = 0;
+  int m_RetentionLimit = DefaultRetentionLimit;
+  qint64 m_DroppedCount = 0;
+
+  QString m_FilterText;
+  Level m_MinimumLevel = Level::Info;
+
+  // The sequence numbers of the entries that pass the filter, only used while a filter is set
+  std::deque<qint64> m_FilteredRows;
+
+  LogModel(const LogModel&) = delete;       // Copy Constructor Not Implemented
+  void operator=(const LogModel&) = delete; // Move assignment Not Implemented
+};
@@ -0,0 +1,254 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "LogViewWidget.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtGui/QFontDatabase>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QMessageBox>
+#include <QtWidgets/QScrollBar>
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+LogViewWidget::LogViewWidget(QWidget* parent)
+: QWidget(parent)
+, m_LogModel(new LogModel(this))
+, m_LastExportPath(QDir::homePath() + QDir::separator() + "PipelineOutput.log")
+{
+  setupUi(this);
+  setupGui();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+LogViewWidget::~LogViewWidget() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogViewWidget::setupGui()
+{
+  m_LogModel->setRetentionLimit(LogModel::ReadRetentionLimit());
+
+  logView->setModel(m_LogModel);
+  logView->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+  retentionSpinBox->setValue(m_LogModel->getRetentionLimit());
+
+  // editingFinished so that typing a number does not drop lines on every key press
+  connect(retentionSpinBox, &QSpinBox::editingFinished, [=] {
+    if(retentionSpinBox->value() != m_LogModel->getRetentionLimit())
+    {
+      m_LogModel->setRetentionLimit(retentionSpinBox->value());
+      LogModel::WriteRetentionLimit(m_LogModel->getRetentionLimit());
+      updateSummary();
+    }
+  });
+
+  updateSummary();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogViewWidget::appendLine(LogModel::Level level, const QString& text)
+{
+  LogModel::Entry entry;
+  entry.timestamp = QDateTime::currentMSecsSinceEpoch();
+  entry.level = level;
+  entry.text = text;
+  appendEntries(QVector<LogModel::Entry>{entry});
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogViewWidget::appendEntries(const QVector<LogModel::Entry>& entries)
+{
+  QScrollBar* scrollBar = logView->verticalScrollBar();
+  bool followTail = (scrollBar->value() == scrollBar->maximum());
+
+  m_LogModel->append(entries);
+
+  if(followTail)
+  {
+    logView->scrollToBottom();
+  }
+  updateSummary();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+LogModel* LogViewWidget::getLogModel() const
+{
+  return m_LogModel;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogViewWidget::clearLog()
+{
+  m_LogModel->clear();
+  updateSummary();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogViewWidget::on_filterEdit_textChanged(const QString& text)
+{
+  Q_UNUSED(text)
+  applyFilter();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogViewWidget::on_levelCombo_currentIndexChanged(int index)
+{
+  Q_UNUSED(index)
+  applyFilter();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogViewWidget::on_searchEdit_returnPressed()
+{
+  findText(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogViewWidget::on_findPreviousBtn_clicked()
+{
+  findText(true);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogViewWidget::on_findNextBtn_clicked()
+{
+  findText(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogViewWidget::on_exportBtn_clicked()
+{
+  QString filePath = QFileDialog::getSaveFileName(this, tr("Export Pipeline Output"), m_LastExportPath, tr("Log File (*.log *.txt);;All Files (*.*)"));
+  if(filePath.isEmpty())
+  {
+    return;
+  }
+  m_LastExportPath = filePath;
+
+  bool filteredOnly = false;
+  if(m_LogModel->isFiltered())
+  {
+    filteredOnly = (QMessageBox::question(this, tr("Export Pipeline Output"), tr("Only export the lines that match the current filter?")) == QMessageBox::Yes);
+  }
+
+  if(!m_LogModel->exportToFile(filePath, filteredOnly))
+  {
+    QMessageBox::critical(this, tr("Export Pipeline Output"), tr("The pipeline output could not be written to\n%1").arg(QDir::toNativeSeparators(filePath)));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogViewWidget::on_clearBtn_clicked()
+{
+  clearLog();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogViewWidget::applyFilter()
+{
+  m_LogModel->setFilter(filterEdit->text(), static_cast<LogModel::Level>(levelCombo->currentIndex()));
+  logView->scrollToBottom();
+  updateSummary();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogViewWidget::findText(bool backward)
+{
+  int fromRow = logView->currentIndex().isValid() ? logView->currentIndex().row() : (backward ? m_LogModel->rowCount() : -1);
+  int row = m_LogModel->find(searchEdit->text(), fromRow, backward);
+  if(row < 0)
+  {
+    return;
+  }
+
+  QModelIndex index = m_LogModel->index(row);
+  logView->setCurrentIndex(index);
+  logView->scrollTo(index, QAbstractItemView::PositionAtCenter);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LogViewWidget::updateSummary()
+{
+  QString summary;
+  if(m_LogModel->isFiltered())
+  {
+    summary = tr("%1 of %2 lines").arg(m_LogModel->rowCount()).arg(m_LogModel->getEntryCount());
+  }
+  else
+  {
+    summary = tr("%1 lines").arg(m_LogModel->getEntryCount());
+  }
+  if(m_LogModel->getDroppedCount() > 0)
+  {
+    summary.append(tr(", %1 older lines dropped").arg(m_LogModel->getDroppedCount()));
+  }
+  summaryLabel->setText(summary);
+}
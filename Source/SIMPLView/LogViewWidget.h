@@ -0,0 +1,120 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtWidgets/QWidget>
+
+#include "SIMPLView/LogModel.h"
+
+//-- UIC generated Header
+#include "ui_LogViewWidget.h"
+
+/**
+ * @brief The LogViewWidget class shows the pipeline output kept by a LogModel. Only the rows that are
+ * visible are formatted and painted, so the cost of an update does not depend on the size of the log.
+ * The view follows new lines as long as it is scrolled to the bottom.
+ */
+class LogViewWidget : public QWidget, private Ui::LogViewWidget
+{
+  Q_OBJECT
+
+public:
+  LogViewWidget(QWidget* parent = nullptr);
+  ~LogViewWidget() override;
+
+  /**
+   * @brief appendLine
+   * @param level
+   * @param text
+   */
+  void appendLine(LogModel::Level level, const QString& text);
+
+  /**
+   * @brief appendEntries Adds several lines with a single view update
+   * @param entries
+   */
+  void appendEntries(const QVector<LogModel::Entry>& entries);
+
+  /**
+   * @brief getLogModel
+   * @return
+   */
+  LogModel* getLogModel() const;
+
+public slots:
+  /**
+   * @brief clearLog
+   */
+  void clearLog();
+
+protected slots:
+  void on_filterEdit_textChanged(const QString& text);
+  void on_levelCombo_currentIndexChanged(int index);
+  void on_searchEdit_returnPressed();
+  void on_findPreviousBtn_clicked();
+  void on_findNextBtn_clicked();
+  void on_exportBtn_clicked();
+  void on_clearBtn_clicked();
+
+protected:
+  /**
+   * @brief setupGui
+   */
+  void setupGui();
+
+  /**
+   * @brief applyFilter
+   */
+  void applyFilter();
+
+  /**
+   * @brief findText Selects the next row that contains the search text
+   * @param backward
+   */
+  void findText(bool backward);
+
+  /**
+   * @brief updateSummary
+   */
+  void updateSummary();
+
+private:
+  LogModel* m_LogModel = nullptr;
+  QString m_LastExportPath;
+
+  LogViewWidget(const LogViewWidget&) = delete;   // Copy Constructor Not Implemented
+  void operator=(const LogViewWidget&) = delete; // Move assignment Not Implemented
+};
@@ -0,0 +1,229 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "MemoryEstimator.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonArray>
+#include <QtCore/QSet>
+
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+
+#include "SIMPLView/ProcessStats.h"
+
+namespace
+{
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QHash<QString, qint64> declaredArrays(const DataContainerArray::Pointer& dca)
+{
+  QHash<QString, qint64> arrays;
+  if(dca.get() == nullptr)
+  {
+    return arrays;
+  }
+  for(DataContainer::Pointer dc : dca->getDataContainers())
+  {
+    for(AttributeMatrix::Pointer am : dc->getAttributeMatrices())
+    {
+      for(const QString& arrayName : am->getAttributeArrayNames())
+      {
+        arrays.insert(DataArrayPath(dc->getName(), am->getName(), arrayName).serialize("|"), MemoryEstimator::DeclaredBytes(am->getAttributeArray(arrayName)));
+      }
+    }
+  }
+  return arrays;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 totalBytes(const QHash<QString, qint64>& arrays)
+{
+  qint64 bytes = 0;
+  for(qint64 arrayBytes : arrays)
+  {
+    bytes += arrayBytes;
+  }
+  return bytes;
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MemoryEstimator::MemoryEstimator() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 MemoryEstimator::DeclaredBytes(const IDataArray::Pointer& array)
+{
+  if(array.get() == nullptr)
+  {
+    return 0;
+  }
+  return static_cast<qint64>(array->getNumberOfTuples()) * array->getNumberOfComponents() * array->getTypeSize();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MemoryEstimator::Estimate MemoryEstimator::EstimatePipeline(const QList<AbstractFilter::Pointer>& filters, const QVector<ArrayLiveness::DeadArray>& freedArrays)
+{
+  QHash<int, QStringList> freedBehind;
+  for(const ArrayLiveness::DeadArray& deadArray : freedArrays)
+  {
+    freedBehind[deadArray.filterIndex].push_back(deadArray.path.serialize("|"));
+  }
+
+  Estimate estimate;
+  QHash<QString, qint64> live;
+  QSet<QString> freed;
+  QSet<QString> deleted;
+  for(int i = 0; i < filters.size(); i++)
+  {
+    if(!filters[i]->getEnabled())
+    {
+      continue;
+    }
+
+    // The preflight frees nothing, so freed arrays are still declared by the filters behind their last use. Only a
+    // filter that deletes the array, e.g. DeleteData, makes way for another one of the same path, which is live again.
+    QHash<QString, qint64> output = declaredArrays(filters[i]->getDataContainerArray());
+    for(const QString& path : QSet<QString>(freed))
+    {
+      if(!output.contains(path))
+      {
+        deleted.insert(path);
+      }
+      else if(deleted.contains(path))
+      {
+        freed.remove(path);
+        deleted.remove(path);
+      }
+      else
+      {
+        output.remove(path);
+      }
+    }
+
+    // An array the filter resizes is held at the larger of its two sizes
+    QHash<QString, qint64> held = live;
+    for(auto iter = output.constBegin(); iter != output.constEnd(); ++iter)
+    {
+      held[iter.key()] = qMax(held.value(iter.key(), 0), iter.value());
+    }
+
+    for(const QString& path : freedBehind.value(i))
+    {
+      output.remove(path);
+      freed.insert(path);
+    }
+
+    Step step;
+    step.filterIndex = i;
+    step.filterLabel = filters[i]->getHumanLabel();
+    step.peakBytes = totalBytes(held);
+    step.bytesAfter = totalBytes(output);
+    if(step.peakBytes > estimate.peakBytes || estimate.peakStep < 0)
+    {
+      estimate.peakBytes = step.peakBytes;
+      estimate.peakStep = estimate.steps.size();
+    }
+    estimate.steps.push_back(step);
+    live = output;
+  }
+  return estimate;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString MemoryEstimator::Summary(const Estimate& estimate, qint64 availableBytes)
+{
+  if(estimate.peakStep < 0)
+  {
+    return QString("No memory estimate without a preflighted pipeline");
+  }
+
+  const Step& peak = estimate.steps[estimate.peakStep];
+  QString text = QString("Estimated peak memory %1 in filter %2, %3").arg(ProcessStats::FormatBytes(estimate.peakBytes)).arg(peak.filterIndex + 1).arg(peak.filterLabel);
+  if(availableBytes > 0)
+  {
+    text += QString(" (%1 available)").arg(ProcessStats::FormatBytes(availableBytes));
+  }
+  return text;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList MemoryEstimator::Timeline(const Estimate& estimate)
+{
+  QStringList lines;
+  for(const Step& step : estimate.steps)
+  {
+    lines.push_back(QString("%1 %2: %3 while executing, %4 after").arg(step.filterIndex + 1).arg(step.filterLabel).arg(ProcessStats::FormatBytes(step.peakBytes)).arg(ProcessStats::FormatBytes(step.bytesAfter)));
+  }
+  return lines;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject MemoryEstimator::ToJson(const Estimate& estimate, qint64 availableBytes)
+{
+  QJsonArray stepArray;
+  for(const Step& step : estimate.steps)
+  {
+    QJsonObject json;
+    json["Filter Index"] = step.filterIndex;
+    json["Human Label"] = step.filterLabel;
+    json["Peak Bytes"] = step.peakBytes;
+    json["Bytes After"] = step.bytesAfter;
+    stepArray.append(json);
+  }
+
+  QJsonObject json;
+  json["Steps"] = stepArray;
+  json["Peak Bytes"] = estimate.peakBytes;
+  json["Peak Filter Index"] = (estimate.peakStep >= 0) ? estimate.steps[estimate.peakStep].filterIndex : -1;
+  json["Available Bytes"] = availableBytes;
+  return json;
+}
@@ -0,0 +1,119 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+#include "SIMPLView/ArrayLiveness.h"
+
+/**
+ * @brief The MemoryEstimator class estimates the memory a pipeline run needs from the preflight
+ * DataContainerArray of each filter, which declares the tuples, components and type of every attribute array.
+ * While a filter executes its input and its output arrays are held at the same time; behind the filter the
+ * arrays the ArrayLiveness pass frees are gone. Geometry vertex and element lists, which are not attribute
+ * arrays, and the filters' own scratch memory are not counted.
+ */
+class MemoryEstimator
+{
+public:
+  struct Step
+  {
+    int filterIndex = -1;
+    QString filterLabel;
+    qint64 peakBytes = 0;
+    qint64 bytesAfter = 0;
+  };
+
+  struct Estimate
+  {
+    QVector<Step> steps;
+    qint64 peakBytes = 0;
+    int peakStep = -1;
+  };
+
+  /**
+   * @brief EstimatePipeline
+   * @param filters The preflighted filters in execution order, each holding its own preflight DataContainerArray
+   * @param freedArrays The arrays freed behind their last use, empty if every array is kept
+   * @return
+   */
+  static Estimate EstimatePipeline(const QList<AbstractFilter::Pointer>& filters, const QVector<ArrayLiveness::DeadArray>& freedArrays);
+
+  /**
+   * @brief DeclaredBytes Preflight arrays are not allocated, their size comes from the tuples and components
+   * they declare
+   * @param array
+   * @return
+   */
+  static qint64 DeclaredBytes(const IDataArray::Pointer& array);
+
+  /**
+   * @brief Summary
+   * @param estimate
+   * @param availableBytes 0 if it is not known
+   * @return One line with the peak, the filter that causes it and the available memory
+   */
+  static QString Summary(const Estimate& estimate, qint64 availableBytes);
+
+  /**
+   * @brief Timeline
+   * @param estimate
+   * @return One line per filter
+   */
+  static QStringList Timeline(const Estimate& estimate);
+
+  /**
+   * @brief ToJson
+   * @param estimate
+   * @param availableBytes
+   * @return
+   */
+  static QJsonObject ToJson(const Estimate& estimate, qint64 availableBytes);
+
+protected:
+  MemoryEstimator();
+
+private:
+  MemoryEstimator(const MemoryEstimator&) = delete;  // Copy Constructor Not Implemented
+  void operator=(const MemoryEstimator&) = delete;   // Move assignment Not Implemented
+};
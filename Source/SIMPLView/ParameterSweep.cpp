@@ -0,0 +1,759 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ParameterSweep.h"
+
+#include <thread>
+
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QProcess>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QThread>
+
+#include "SIMPLib/CoreFilters/DataContainerReader.h"
+#include "SIMPLib/CoreFilters/DataContainerWriter.h"
+#include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/OutputPathFilterParameter.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Filtering/FilterManager.h"
+
+namespace
+{
+// Grids grow quickly, so refuse ones that are clearly a typo
+const int k_MaxPointCount = 100000;
+
+// -----------------------------------------------------------------------------
+// Every point writes its own output files, otherwise they would overwrite each other. The filter's
+// own parameters say which of its keys name an output file or directory.
+// -----------------------------------------------------------------------------
+QStringList outputPathKeys(const QJsonObject& filterObject)
+{
+  QStringList keys;
+  IFilterFactory::Pointer factory = FilterManager::Instance()->getFactoryFromClassName(filterObject["Filter_Name"].toString());
+  if(nullptr == factory.get())
+  {
+    return keys;
+  }
+  // create() returns null for a deferred plugin that is used before it was activated
+  AbstractFilter::Pointer filter = factory->create();
+  if(nullptr == filter.get())
+  {
+    return keys;
+  }
+  for(FilterParameter::Pointer parameter : filter->getFilterParameters())
+  {
+    if(dynamic_cast<OutputFileFilterParameter*>(parameter.get()) != nullptr || dynamic_cast<OutputPathFilterParameter*>(parameter.get()) != nullptr)
+    {
+      keys.push_back(parameter->getPropertyName());
+    }
+  }
+  return keys;
+}
+
+// -----------------------------------------------------------------------------
+// Writes a filter the way the pipeline file writer does, so the runner's reader can create it again
+// -----------------------------------------------------------------------------
+QJsonObject filterJson(const AbstractFilter::Pointer& filter)
+{
+  QJsonObject filterObject;
+  filter->writeFilterParameters(filterObject);
+  filterObject["Filter_Name"] = filter->getNameOfClass();
+  filterObject["Filter_Human_Label"] = filter->getHumanLabel();
+  filterObject["Filter_Enabled"] = true;
+  return filterObject;
+}
+
+// -----------------------------------------------------------------------------
+// Builds a pipeline file from the filters of another one, in the given order
+// -----------------------------------------------------------------------------
+QJsonObject assemblePipeline(const QJsonObject& source, const QVector<QJsonObject>& filterObjects)
+{
+  QJsonObject pipeline;
+  for(int i = 0; i < filterObjects.size(); i++)
+  {
+    pipeline[QString::number(i)] = filterObjects[i];
+  }
+  QJsonObject builder = source["PipelineBuilder"].toObject();
+  builder["Number_Filters"] = filterObjects.size();
+  pipeline["PipelineBuilder"] = builder;
+  return pipeline;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool writePipelineFile(const QString& filePath, const QJsonObject& pipeline)
+{
+  QFile file(filePath);
+  if(!file.open(QIODevice::WriteOnly))
+  {
+    return false;
+  }
+  return file.write(QJsonDocument(pipeline).toJson()) > 0;
+}
+
+// -----------------------------------------------------------------------------
+// Executes a pipeline file in a HeadlessPipelineRunner process and waits for it, or kills it once
+// the sweep is canceled. The runner's JSON report is returned in report.
+// -----------------------------------------------------------------------------
+int runPipelineProcess(const QString& runnerExecutable, const QString& pipelineFilePath, int threads, const std::atomic<bool>& canceled, QString& message, QJsonObject& report)
+{
+  QString reportFilePath = pipelineFilePath + ".report.json";
+  QProcess process;
+  process.setStandardOutputFile(QProcess::nullDevice());
+  process.start(runnerExecutable, QStringList() << "--threads" << QString::number(threads) << "--json-report" << reportFilePath << pipelineFilePath);
+  if(!process.waitForStarted())
+  {
+    message = QString("The pipeline runner '%1' could not be started").arg(runnerExecutable);
+    return -1;
+  }
+  while(!process.waitForFinished(100))
+  {
+    if(canceled && process.state() != QProcess::NotRunning)
+    {
+      process.kill();
+      process.waitForFinished();
+      message = QString("Canceled");
+      return 0;
+    }
+  }
+
+  QFile reportFile(reportFilePath);
+  if(reportFile.open(QIODevice::ReadOnly))
+  {
+    report = QJsonDocument::fromJson(reportFile.readAll()).object();
+  }
+
+  if(process.exitStatus() == QProcess::CrashExit)
+  {
+    message = QString("The pipeline runner crashed");
+    return -1;
+  }
+  if(process.exitCode() == 0)
+  {
+    return 0;
+  }
+
+  // The runner prints each filter's errors as "Error (code): message", keep the first one
+  QStringList errorLines = QString::fromLocal8Bit(process.readAllStandardError()).split('\n', QString::SkipEmptyParts);
+  for(const QString& line : errorLines)
+  {
+    if(line.startsWith("Error ("))
+    {
+      message = line.mid(line.indexOf(": ") + 2).trimmed();
+      break;
+    }
+  }
+  if(message.isEmpty() && !errorLines.isEmpty())
+  {
+    message = errorLines.last().trimmed();
+  }
+  int errorCode = report["Error Code"].toInt();
+  return (errorCode < 0) ? errorCode : -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString pointOutputPath(const QString& filePath, int pointIndex)
+{
+  QFileInfo fi(filePath);
+  QString pointSuffix = QString("_sweep%1").arg(pointIndex);
+  if(fi.suffix().isEmpty())
+  {
+    return filePath + pointSuffix;
+  }
+  return fi.path() + "/" + fi.completeBaseName() + pointSuffix + "." + fi.suffix();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonValue parseScalar(const QString& text)
+{
+  bool ok = false;
+  qlonglong intValue = text.toLongLong(&ok);
+  if(ok)
+  {
+    return QJsonValue(static_cast<qint64>(intValue));
+  }
+  double doubleValue = text.toDouble(&ok);
+  if(ok)
+  {
+    return QJsonValue(doubleValue);
+  }
+  if(text == "true" || text == "false")
+  {
+    return QJsonValue(text == "true");
+  }
+  return QJsonValue(text);
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParameterSweep::ParameterSweep() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParameterSweep::~ParameterSweep() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ParameterSweep::ParseDimension(const QString& spec, Dimension& dimension, QString& error)
+{
+  int separator = spec.indexOf('=');
+  if(separator <= 0)
+  {
+    error = QString("'%1' is not of the form <filter index>/<parameter>=<values>").arg(spec);
+    return false;
+  }
+
+  dimension.path = spec.left(separator).trimmed();
+  return ParseValues(spec.mid(separator + 1), dimension.values, error);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ParameterSweep::ParseValues(const QString& text, QVector<QJsonValue>& values, QString& error)
+{
+  values.clear();
+  QString trimmed = text.trimmed();
+
+  QStringList range = trimmed.split(':');
+  if(range.size() == 3)
+  {
+    bool startOk = false;
+    bool stopOk = false;
+    bool stepOk = false;
+    double start = range[0].toDouble(&startOk);
+    double stop = range[1].toDouble(&stopOk);
+    double step = range[2].toDouble(&stepOk);
+    if(!startOk || !stopOk || !stepOk || step == 0.0 || (stop - start) / step < 0.0)
+    {
+      error = QString("'%1' is not a valid start:stop:step range").arg(trimmed);
+      return false;
+    }
+
+    // Stay with integers when the range is written with integers, so integer parameters accept the values
+    bool integral = !trimmed.contains('.') && !trimmed.contains('e', Qt::CaseInsensitive);
+    int count = static_cast<int>((stop - start) / step + 1.0e-9) + 1;
+    if(count > k_MaxPointCount)
+    {
+      error = QString("The range '%1' has too many values").arg(trimmed);
+      return false;
+    }
+    for(int i = 0; i < count; i++)
+    {
+      double value = start + i * step;
+      values.push_back(integral ? QJsonValue(static_cast<qint64>(value)) : QJsonValue(value));
+    }
+    return true;
+  }
+
+  QStringList tokens = trimmed.split(',', QString::SkipEmptyParts);
+  for(const QString& token : tokens)
+  {
+    values.push_back(parseScalar(token.trimmed()));
+  }
+  if(values.isEmpty())
+  {
+    error = QString("No values were given");
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ParameterSweep::setPipelineFile(const QString& filePath, QString& error)
+{
+  QFile file(filePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    error = QString("Could not open the pipeline file '%1'").arg(filePath);
+    return false;
+  }
+
+  QJsonParseError parseError;
+  QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+  if(parseError.error != QJsonParseError::NoError || !doc.isObject())
+  {
+    error = QString("'%1' is not a pipeline file: %2").arg(filePath).arg(parseError.errorString());
+    return false;
+  }
+
+  m_PipelineFilePath = QFileInfo(filePath).absoluteFilePath();
+  m_PipelineJson = doc.object();
+  m_FilterCount = m_PipelineJson["PipelineBuilder"].toObject()["Number_Filters"].toInt();
+  m_Dimensions.clear();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ParameterSweep::addDimension(const Dimension& dimension, QString& error)
+{
+  QStringList path = dimension.path.split('/');
+  bool ok = false;
+  int filterIndex = path[0].toInt(&ok);
+  if(!ok || filterIndex < 0 || filterIndex >= m_FilterCount || path.size() < 2)
+  {
+    error = QString("'%1' does not start with the index of a filter in the pipeline").arg(dimension.path);
+    return false;
+  }
+
+  // Setting the current value again proves that the path exists
+  QJsonValue pipeline(m_PipelineJson);
+  QJsonValue current = m_PipelineJson[path[0]];
+  for(int i = 1; i < path.size() && !current.isUndefined(); i++)
+  {
+    current = current.isArray() ? current.toArray().at(path[i].toInt()) : current.toObject().value(path[i]);
+  }
+  if(current.isUndefined() || !SetJsonValue(pipeline, path, 0, current))
+  {
+    error = QString("The pipeline has no parameter '%1'").arg(dimension.path);
+    return false;
+  }
+
+  m_Dimensions.push_back(dimension);
+  if(getPointCount() > k_MaxPointCount)
+  {
+    m_Dimensions.pop_back();
+    error = QString("The sweep would have more than %1 points").arg(k_MaxPointCount);
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<ParameterSweep::Dimension> ParameterSweep::getDimensions() const
+{
+  return m_Dimensions;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ParameterSweep::getPointCount() const
+{
+  if(m_Dimensions.isEmpty())
+  {
+    return 0;
+  }
+
+  int count = 1;
+  for(const Dimension& dimension : m_Dimensions)
+  {
+    count *= dimension.values.size();
+  }
+  return count;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ParameterSweep::getSharedPrefixLength() const
+{
+  int prefixLength = m_FilterCount;
+  for(const Dimension& dimension : m_Dimensions)
+  {
+    prefixLength = qMin(prefixLength, dimension.path.section('/', 0, 0).toInt());
+  }
+  return prefixLength;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweep::setMaxConcurrentPoints(int value)
+{
+  m_MaxConcurrentPoints = qMax(1, value);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweep::setRunnerExecutable(const QString& filePath)
+{
+  m_RunnerExecutable = filePath;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ParameterSweep::SetJsonValue(QJsonValue& node, const QStringList& path, int position, const QJsonValue& value)
+{
+  if(position == path.size())
+  {
+    node = value;
+    return true;
+  }
+
+  const QString& key = path[position];
+  if(node.isObject())
+  {
+    QJsonObject object = node.toObject();
+    if(!object.contains(key))
+    {
+      return false;
+    }
+    QJsonValue child = object.value(key);
+    if(!SetJsonValue(child, path, position + 1, value))
+    {
+      return false;
+    }
+    object.insert(key, child);
+    node = object;
+    return true;
+  }
+
+  if(node.isArray())
+  {
+    QJsonArray array = node.toArray();
+    bool ok = false;
+    int index = key.toInt(&ok);
+    if(!ok || index < 0 || index >= array.size())
+    {
+      return false;
+    }
+    QJsonValue child = array.at(index);
+    if(!SetJsonValue(child, path, position + 1, value))
+    {
+      return false;
+    }
+    array.replace(index, child);
+    node = array;
+    return true;
+  }
+
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject ParameterSweep::createPointPipeline(int pointIndex, PointResult& result) const
+{
+  QJsonValue pipeline(m_PipelineJson);
+
+  // The last dimension changes fastest
+  result.index = pointIndex;
+  result.values.resize(m_Dimensions.size());
+  int remainder = pointIndex;
+  for(int d = m_Dimensions.size() - 1; d >= 0; d--)
+  {
+    const Dimension& dimension = m_Dimensions[d];
+    result.values[d] = dimension.values[remainder % dimension.values.size()];
+    remainder /= dimension.values.size();
+    SetJsonValue(pipeline, dimension.path.split('/'), 0, result.values[d]);
+  }
+
+  QJsonObject pipelineObject = pipeline.toObject();
+  for(int i = getSharedPrefixLength(); i < m_FilterCount; i++)
+  {
+    QString filterKey = QString::number(i);
+    QJsonObject filterObject = pipelineObject[filterKey].toObject();
+    for(const QString& key : m_OutputPathKeys.value(i))
+    {
+      QString value = filterObject[key].toString();
+      if(!value.isEmpty())
+      {
+        QString outputPath = pointOutputPath(value, pointIndex);
+        filterObject[key] = outputPath;
+        result.outputFiles.push_back(outputPath);
+      }
+    }
+    pipelineObject[filterKey] = filterObject;
+  }
+  return pipelineObject;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ParameterSweep::execute(QString& error)
+{
+  int pointCount = getPointCount();
+  if(pointCount == 0)
+  {
+    error = QString("No parameters to sweep were given");
+    return false;
+  }
+  if(m_RunnerExecutable.isEmpty())
+  {
+    error = QString("No pipeline runner was given to execute the points");
+    return false;
+  }
+
+  m_Canceled = false;
+  m_FinishedPointCount = 0;
+  m_Results = QVector<PointResult>(pointCount);
+  m_PointPipelineFiles = QVector<QString>(pointCount);
+  m_PrefixWallTimeMSecs = 0;
+
+  QTemporaryDir workingDir;
+  if(!workingDir.isValid())
+  {
+    error = QString("Could not create a temporary directory for the point pipelines");
+    return false;
+  }
+
+  m_OutputPathKeys = QVector<QStringList>(m_FilterCount);
+  for(int i = getSharedPrefixLength(); i < m_FilterCount; i++)
+  {
+    m_OutputPathKeys[i] = outputPathKeys(m_PipelineJson[QString::number(i)].toObject());
+  }
+
+  // The running points share the cores instead of each starting a thread per core
+  int workerCount = qMin(m_MaxConcurrentPoints, pointCount);
+  int threads = qMax(1, QThread::idealThreadCount() / workerCount);
+
+  // The filters that all points have in common are executed once, in a runner of their own that
+  // writes their data to a file. Every point starts by reading that file instead.
+  int prefixLength = getSharedPrefixLength();
+  QVector<QJsonObject> pointPrefix;
+  if(prefixLength > 0)
+  {
+    QString sharedDataFilePath = workingDir.filePath("Shared.dream3d");
+    QVector<QJsonObject> prefixFilters;
+    for(int i = 0; i < prefixLength; i++)
+    {
+      prefixFilters.push_back(m_PipelineJson[QString::number(i)].toObject());
+    }
+    DataContainerWriter::Pointer writer = DataContainerWriter::New();
+    writer->setOutputFile(sharedDataFilePath);
+    writer->setWritePipeline(false);
+    writer->setWriteXdmfFile(false);
+    prefixFilters.push_back(filterJson(writer));
+
+    QString prefixFilePath = workingDir.filePath("Shared.json");
+    if(!writePipelineFile(prefixFilePath, assemblePipeline(m_PipelineJson, prefixFilters)))
+    {
+      error = QString("Could not write '%1'").arg(prefixFilePath);
+      return false;
+    }
+
+    QElapsedTimer prefixTimer;
+    prefixTimer.start();
+    QString message;
+    QJsonObject report;
+    int err = runPipelineProcess(m_RunnerExecutable, prefixFilePath, QThread::idealThreadCount(), m_Canceled, message, report);
+    m_PrefixWallTimeMSecs = prefixTimer.elapsed();
+    if(err < 0)
+    {
+      error = QString("The shared filters failed with error %1: %2").arg(err).arg(message);
+      return false;
+    }
+    if(m_Canceled)
+    {
+      error = QString("Canceled");
+      return false;
+    }
+
+    DataContainerReader::Pointer reader = DataContainerReader::New();
+    reader->setInputFile(sharedDataFilePath);
+    DataContainerArrayProxy proxy = reader->readDataContainerArrayStructure(sharedDataFilePath);
+    proxy.setAllFlags(Qt::Checked);
+    reader->setInputFileDataContainerArrayProxy(proxy);
+    pointPrefix.push_back(filterJson(reader));
+  }
+
+  // The points are written out as pipeline files and executed by the regular pipeline reader
+  for(int i = 0; i < pointCount; i++)
+  {
+    QJsonObject pointPipeline = createPointPipeline(i, m_Results[i]);
+    QVector<QJsonObject> pointFilters = pointPrefix;
+    for(int f = prefixLength; f < m_FilterCount; f++)
+    {
+      pointFilters.push_back(pointPipeline[QString::number(f)].toObject());
+    }
+    m_PointPipelineFiles[i] = workingDir.filePath(QString("Point_%1.json").arg(i));
+    if(!writePipelineFile(m_PointPipelineFiles[i], assemblePipeline(m_PipelineJson, pointFilters)))
+    {
+      error = QString("Could not write '%1'").arg(m_PointPipelineFiles[i]);
+      return false;
+    }
+  }
+
+  // Each worker thread hands the next point to a runner process and waits for it
+  std::atomic<int> nextPoint{0};
+  std::vector<std::thread> workers;
+  for(int w = 0; w < workerCount; w++)
+  {
+    workers.emplace_back([this, &nextPoint, pointCount, threads] {
+      for(int i = nextPoint++; i < pointCount; i = nextPoint++)
+      {
+        executePoint(i, threads);
+      }
+    });
+  }
+  for(std::thread& worker : workers)
+  {
+    worker.join();
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweep::executePoint(int pointIndex, int threads)
+{
+  PointResult& result = m_Results[pointIndex];
+  if(m_Canceled)
+  {
+    result.message = QString("Canceled");
+    m_FinishedPointCount++;
+    return;
+  }
+
+  QJsonObject report;
+  result.errorCode = runPipelineProcess(m_RunnerExecutable, m_PointPipelineFiles[pointIndex], threads, m_Canceled, result.message, report);
+  result.executed = !report.isEmpty();
+
+  // The time of the filters, without the runner's start up
+  for(const QJsonValue& filterReport : report["Filters"].toArray())
+  {
+    result.wallTimeMSecs += filterReport.toObject()["Wall Time MSecs"].toVariant().toLongLong();
+  }
+
+  // The tuple counts are what usually differs between points, e.g. the number of features found
+  QJsonObject tupleCounts = report["Tuple Counts"].toObject();
+  for(const QString& key : tupleCounts.keys())
+  {
+    result.tupleCounts.insert(key, tupleCounts[key].toVariant().toLongLong());
+  }
+  m_FinishedPointCount++;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweep::cancel()
+{
+  m_Canceled = true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ParameterSweep::getFinishedPointCount() const
+{
+  return m_FinishedPointCount;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<ParameterSweep::PointResult> ParameterSweep::getResults() const
+{
+  return m_Results;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ParameterSweep::getPrefixWallTimeMSecs() const
+{
+  return m_PrefixWallTimeMSecs;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject ParameterSweep::toJson() const
+{
+  QJsonObject json;
+  json["Pipeline"] = m_PipelineFilePath;
+  json["Shared Filters"] = getSharedPrefixLength();
+  json["Shared Filters Wall Time MSecs"] = m_PrefixWallTimeMSecs;
+
+  QJsonArray dimensions;
+  for(const Dimension& dimension : m_Dimensions)
+  {
+    QJsonObject dimensionJson;
+    dimensionJson["Path"] = dimension.path;
+    QJsonArray values;
+    for(const QJsonValue& value : dimension.values)
+    {
+      values.append(value);
+    }
+    dimensionJson["Values"] = values;
+    dimensions.append(dimensionJson);
+  }
+  json["Dimensions"] = dimensions;
+
+  QJsonArray points;
+  for(const PointResult& result : m_Results)
+  {
+    QJsonObject pointJson;
+    pointJson["Index"] = result.index;
+    QJsonArray values;
+    for(const QJsonValue& value : result.values)
+    {
+      values.append(value);
+    }
+    pointJson["Values"] = values;
+    pointJson["Error Code"] = result.errorCode;
+    pointJson["Message"] = result.message;
+    pointJson["Executed"] = result.executed;
+    pointJson["Wall Time MSecs"] = result.wallTimeMSecs;
+
+    QJsonObject tupleCounts;
+    for(QMap<QString, qint64>::const_iterator iter = result.tupleCounts.constBegin(); iter != result.tupleCounts.constEnd(); ++iter)
+    {
+      tupleCounts[iter.key()] = iter.value();
+    }
+    pointJson["Tuple Counts"] = tupleCounts;
+    pointJson["Output Files"] = QJsonArray::fromStringList(result.outputFiles);
+    points.append(pointJson);
+  }
+  json["Points"] = points;
+  return json;
+}
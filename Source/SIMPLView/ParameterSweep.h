@@ -0,0 +1,233 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonValue>
+#include <QtCore/QMap>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+
+/**
+ * @brief The ParameterSweep class executes one pipeline for every point of a grid of parameter values.
+ * The filters in front of the first swept filter produce the same data for every point, so they are
+ * executed once and written to a file that each point starts by reading. The shared filters and every
+ * point run in HeadlessPipelineRunner processes of their own, several points at a time, so a point that
+ * crashes or runs out of memory only fails itself.
+ *
+ * A parameter is addressed by the index of its filter in the pipeline file and the key that the filter
+ * writes for it, e.g. "3/MinAllowedFeatureSize". Values inside structured parameters are reached with
+ * further keys or array indices, e.g. "5/ArrayThresholds/0/Comparison Value".
+ */
+class ParameterSweep
+{
+public:
+  SIMPL_SHARED_POINTERS(ParameterSweep)
+
+  static Pointer New()
+  {
+    Pointer sharedPtr(new ParameterSweep());
+    return sharedPtr;
+  }
+
+  virtual ~ParameterSweep();
+
+  struct Dimension
+  {
+    QString path;
+    QVector<QJsonValue> values;
+  };
+
+  struct PointResult
+  {
+    int index = 0;
+    QVector<QJsonValue> values;
+    int errorCode = 0;
+    QString message;
+    bool executed = false;
+    qint64 wallTimeMSecs = 0;
+    QMap<QString, qint64> tupleCounts;
+    QStringList outputFiles;
+  };
+
+  /**
+   * @brief ParseDimension Parses "path=start:stop:step" or "path=value,value,..."
+   * @param spec
+   * @param dimension
+   * @param error
+   * @return
+   */
+  static bool ParseDimension(const QString& spec, Dimension& dimension, QString& error);
+
+  /**
+   * @brief ParseValues Parses "start:stop:step" or "value,value,..."
+   * @param text
+   * @param values
+   * @param error
+   * @return
+   */
+  static bool ParseValues(const QString& text, QVector<QJsonValue>& values, QString& error);
+
+  /**
+   * @brief setPipelineFile
+   * @param filePath
+   * @param error
+   * @return
+   */
+  bool setPipelineFile(const QString& filePath, QString& error);
+
+  /**
+   * @brief addDimension Checks that the path exists in the pipeline before adding it
+   * @param dimension
+   * @param error
+   * @return
+   */
+  bool addDimension(const Dimension& dimension, QString& error);
+
+  /**
+   * @brief getDimensions
+   * @return
+   */
+  QVector<Dimension> getDimensions() const;
+
+  /**
+   * @brief getPointCount
+   * @return The number of grid points
+   */
+  int getPointCount() const;
+
+  /**
+   * @brief getSharedPrefixLength
+   * @return The number of filters that are executed once for all points
+   */
+  int getSharedPrefixLength() const;
+
+  /**
+   * @brief setMaxConcurrentPoints
+   * @param value
+   */
+  void setMaxConcurrentPoints(int value);
+
+  /**
+   * @brief setRunnerExecutable
+   * @param filePath The HeadlessPipelineRunner that executes the shared filters and the points
+   */
+  void setRunnerExecutable(const QString& filePath);
+
+  /**
+   * @brief execute Runs the sweep on the calling thread until every point has finished
+   * @param error Set when the sweep could not run at all; failures of single points are in the results
+   * @return
+   */
+  bool execute(QString& error);
+
+  /**
+   * @brief cancel Stops the sweep from another thread
+   */
+  void cancel();
+
+  /**
+   * @brief getFinishedPointCount Can be called from another thread while the sweep runs
+   * @return
+   */
+  int getFinishedPointCount() const;
+
+  /**
+   * @brief getResults
+   * @return
+   */
+  QVector<PointResult> getResults() const;
+
+  /**
+   * @brief getPrefixWallTimeMSecs
+   * @return
+   */
+  qint64 getPrefixWallTimeMSecs() const;
+
+  /**
+   * @brief toJson
+   * @return The dimensions and the results of every point
+   */
+  QJsonObject toJson() const;
+
+  /**
+   * @brief SetJsonValue Replaces the value at path[position...] inside node
+   * @return False if the path does not exist
+   */
+  static bool SetJsonValue(QJsonValue& node, const QStringList& path, int position, const QJsonValue& value);
+
+protected:
+  ParameterSweep();
+
+  /**
+   * @brief createPointPipeline
+   * @param pointIndex
+   * @param result
+   * @return The pipeline file for the point
+   */
+  QJsonObject createPointPipeline(int pointIndex, PointResult& result) const;
+
+  /**
+   * @brief executePoint Runs the pipeline file of a single point and waits for it
+   * @param pointIndex
+   * @param threads The threads the point's runner may use
+   */
+  void executePoint(int pointIndex, int threads);
+
+private:
+  QString m_PipelineFilePath;
+  QJsonObject m_PipelineJson;
+  int m_FilterCount = 0;
+  QVector<Dimension> m_Dimensions;
+  int m_MaxConcurrentPoints = 1;
+  QString m_RunnerExecutable;
+  QVector<QStringList> m_OutputPathKeys;
+
+  QVector<PointResult> m_Results;
+  QVector<QString> m_PointPipelineFiles;
+  qint64 m_PrefixWallTimeMSecs = 0;
+
+  std::atomic<bool> m_Canceled{false};
+  std::atomic<int> m_FinishedPointCount{0};
+
+  ParameterSweep(const ParameterSweep&) = delete; // Copy Constructor Not Implemented
+  void operator=(const ParameterSweep&) = delete; // Move assignment Not Implemented
+};
@@ -0,0 +1,419 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ParameterSweepDialog.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QSaveFile>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QMessageBox>
+
+#include "SIMPLView/BatchQueue.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParameterSweepDialog::ParameterSweepDialog(const QString& pipelineFilePath, QWidget* parent)
+: QDialog(parent)
+, m_PipelineFilePath(pipelineFilePath)
+{
+  setupUi(this);
+  setupGui();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParameterSweepDialog::~ParameterSweepDialog()
+{
+  // The background task holds its own reference to the sweep, so it can finish after the dialog is gone
+  if(m_SweepWatcher.isRunning())
+  {
+    m_Sweep->cancel();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::setupGui()
+{
+  setWindowFlags(this->windowFlags() & ~Qt::WindowContextHelpButtonHint);
+
+  QFile file(m_PipelineFilePath);
+  if(file.open(QIODevice::ReadOnly))
+  {
+    m_PipelineJson = QJsonDocument::fromJson(file.readAll()).object();
+  }
+
+  int filterCount = m_PipelineJson["PipelineBuilder"].toObject()["Number_Filters"].toInt();
+  for(int i = 0; i < filterCount; i++)
+  {
+    QJsonObject filterObject = m_PipelineJson[QString::number(i)].toObject();
+    filterCombo->addItem(QString("%1: %2").arg(i).arg(filterObject["Filter_Human_Label"].toString()), i);
+  }
+
+  concurrencySpinBox->setValue(qMax(1, QThread::idealThreadCount() / 4));
+  dimensionsTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
+
+  m_ProgressTimer = new QTimer(this);
+  m_ProgressTimer->setInterval(250);
+  connect(m_ProgressTimer, &QTimer::timeout, this, &ParameterSweepDialog::updateProgress);
+  connect(&m_SweepWatcher, &QFutureWatcher<QString>::finished, this, &ParameterSweepDialog::sweepFinished);
+
+  resetSweep();
+  updateSummary();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::on_filterCombo_currentIndexChanged(int index)
+{
+  parameterCombo->clear();
+  if(index < 0)
+  {
+    return;
+  }
+
+  // Everything that is not bookkeeping of the pipeline file is a parameter of the filter
+  QJsonObject filterObject = m_PipelineJson[QString::number(filterCombo->itemData(index).toInt())].toObject();
+  for(const QString& key : filterObject.keys())
+  {
+    if(!key.startsWith("Filter_"))
+    {
+      parameterCombo->addItem(key);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::on_addDimensionBtn_clicked()
+{
+  ParameterSweep::Dimension dimension;
+  dimension.path = QString("%1/%2").arg(filterCombo->currentData().toInt()).arg(parameterCombo->currentText());
+
+  QString error;
+  if(!ParameterSweep::ParseValues(valuesLineEdit->text(), dimension.values, error) || !m_Sweep->addDimension(dimension, error))
+  {
+    QMessageBox::warning(this, tr("Parameter Sweep"), error);
+    return;
+  }
+
+  int row = dimensionsTable->rowCount();
+  dimensionsTable->insertRow(row);
+  dimensionsTable->setItem(row, 0, new QTableWidgetItem(dimension.path));
+  dimensionsTable->setItem(row, 1, new QTableWidgetItem(valuesLineEdit->text().trimmed()));
+  valuesLineEdit->clear();
+  updateSummary();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::on_removeDimensionBtn_clicked()
+{
+  QModelIndexList selectedRows = dimensionsTable->selectionModel()->selectedRows();
+  qSort(selectedRows);
+  for(int i = selectedRows.size() - 1; i >= 0; i--)
+  {
+    dimensionsTable->removeRow(selectedRows[i].row());
+  }
+  resetSweep();
+  updateSummary();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ParameterSweepDialog::resetSweep()
+{
+  m_Sweep = ParameterSweep::New();
+  QString error;
+  if(!m_Sweep->setPipelineFile(m_PipelineFilePath, error))
+  {
+    summaryLabel->setText(error);
+    return false;
+  }
+
+  for(int row = 0; row < dimensionsTable->rowCount(); row++)
+  {
+    ParameterSweep::Dimension dimension;
+    dimension.path = dimensionsTable->item(row, 0)->text();
+    if(!ParameterSweep::ParseValues(dimensionsTable->item(row, 1)->text(), dimension.values, error) || !m_Sweep->addDimension(dimension, error))
+    {
+      summaryLabel->setText(error);
+      return false;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::updateSummary()
+{
+  int pointCount = m_Sweep->getPointCount();
+  if(pointCount == 0)
+  {
+    summaryLabel->setText(tr("Add the parameters to sweep"));
+  }
+  else
+  {
+    summaryLabel->setText(tr("%1 points. The first %2 filters run once and are shared by all points.").arg(pointCount).arg(m_Sweep->getSharedPrefixLength()));
+  }
+  runBtn->setEnabled(pointCount > 0 && !m_SweepWatcher.isRunning());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::on_runBtn_clicked()
+{
+  if(!resetSweep())
+  {
+    return;
+  }
+
+  resultsTable->clear();
+  resultsTable->setRowCount(0);
+  progressBar->setMaximum(m_Sweep->getPointCount());
+  progressBar->setValue(0);
+  m_Sweep->setMaxConcurrentPoints(concurrencySpinBox->value());
+  m_Sweep->setRunnerExecutable(BatchQueue::RunnerExecutablePath());
+  setRunning(true);
+
+  ParameterSweep::Pointer sweep = m_Sweep;
+  m_SweepWatcher.setFuture(QtConcurrent::run([sweep] {
+    QString error;
+    sweep->execute(error);
+    return error;
+  }));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::on_cancelBtn_clicked()
+{
+  m_Sweep->cancel();
+  cancelBtn->setEnabled(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::setRunning(bool running)
+{
+  parametersGroupBox->setEnabled(!running);
+  concurrencySpinBox->setEnabled(!running);
+  runBtn->setEnabled(!running);
+  cancelBtn->setEnabled(running);
+  saveResultsBtn->setEnabled(!running && !m_Sweep->getResults().isEmpty());
+  if(running)
+  {
+    m_ProgressTimer->start();
+  }
+  else
+  {
+    m_ProgressTimer->stop();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::updateProgress()
+{
+  progressBar->setValue(m_Sweep->getFinishedPointCount());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::sweepFinished()
+{
+  if(m_RejectWhenFinished)
+  {
+    QDialog::reject();
+    return;
+  }
+
+  updateProgress();
+  setRunning(false);
+
+  QString error = m_SweepWatcher.result();
+  if(!error.isEmpty())
+  {
+    QMessageBox::warning(this, tr("Parameter Sweep"), error);
+    return;
+  }
+
+  fillResultsTable();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::fillResultsTable()
+{
+  QVector<ParameterSweep::PointResult> results = m_Sweep->getResults();
+  QVector<ParameterSweep::Dimension> dimensions = m_Sweep->getDimensions();
+  if(results.isEmpty())
+  {
+    return;
+  }
+
+  // Only the attribute matrices whose size differs between the points say something about the parameters
+  QStringList varyingCounts;
+  for(const ParameterSweep::PointResult& result : results)
+  {
+    for(const QString& key : result.tupleCounts.keys())
+    {
+      if(!varyingCounts.contains(key) && result.tupleCounts[key] != results.front().tupleCounts.value(key, -1))
+      {
+        varyingCounts.push_back(key);
+      }
+    }
+  }
+
+  QStringList headers;
+  headers << tr("#");
+  for(const ParameterSweep::Dimension& dimension : dimensions)
+  {
+    headers << dimension.path;
+  }
+  headers << tr("Status") << tr("Time (ms)") << varyingCounts << tr("Output Files");
+
+  resultsTable->setSortingEnabled(false);
+  resultsTable->setColumnCount(headers.size());
+  resultsTable->setHorizontalHeaderLabels(headers);
+  resultsTable->setRowCount(results.size());
+  for(int row = 0; row < results.size(); row++)
+  {
+    const ParameterSweep::PointResult& result = results[row];
+    int column = 0;
+
+    // Numbers go in as numbers so that sorting the columns orders them by value
+    QTableWidgetItem* indexItem = new QTableWidgetItem();
+    indexItem->setData(Qt::DisplayRole, result.index);
+    resultsTable->setItem(row, column++, indexItem);
+    for(const QJsonValue& value : result.values)
+    {
+      QTableWidgetItem* valueItem = new QTableWidgetItem();
+      valueItem->setData(Qt::DisplayRole, value.toVariant());
+      resultsTable->setItem(row, column++, valueItem);
+    }
+
+    QString status = tr("Completed");
+    if(result.errorCode < 0)
+    {
+      status = tr("Failed: %1").arg(result.message);
+    }
+    else if(!result.message.isEmpty())
+    {
+      status = result.message;
+    }
+    QTableWidgetItem* statusItem = new QTableWidgetItem(status);
+    statusItem->setToolTip(status);
+    resultsTable->setItem(row, column++, statusItem);
+
+    QTableWidgetItem* timeItem = new QTableWidgetItem();
+    timeItem->setData(Qt::DisplayRole, result.wallTimeMSecs);
+    resultsTable->setItem(row, column++, timeItem);
+
+    for(const QString& key : varyingCounts)
+    {
+      QTableWidgetItem* countItem = new QTableWidgetItem();
+      countItem->setData(Qt::DisplayRole, result.tupleCounts.value(key, 0));
+      resultsTable->setItem(row, column++, countItem);
+    }
+
+    QTableWidgetItem* outputItem = new QTableWidgetItem(result.outputFiles.join(", "));
+    outputItem->setToolTip(result.outputFiles.join("\n"));
+    resultsTable->setItem(row, column++, outputItem);
+  }
+  resultsTable->setSortingEnabled(true);
+  resultsTable->resizeColumnsToContents();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::on_saveResultsBtn_clicked()
+{
+  QString filePath = QFileDialog::getSaveFileName(this, tr("Save Sweep Results"), QString("SweepResults.json"), tr("Json File (*.json)"));
+  if(filePath.isEmpty())
+  {
+    return;
+  }
+
+  QSaveFile file(filePath);
+  if(!file.open(QIODevice::WriteOnly))
+  {
+    QMessageBox::warning(this, tr("Parameter Sweep"), tr("Could not write '%1'").arg(filePath));
+    return;
+  }
+  file.write(QJsonDocument(m_Sweep->toJson()).toJson());
+  file.commit();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::reject()
+{
+  // The runner processes are killed on cancel, the dialog closes once the sweep has noticed
+  if(m_SweepWatcher.isRunning())
+  {
+    m_Sweep->cancel();
+    m_RejectWhenFinished = true;
+    cancelBtn->setEnabled(false);
+    summaryLabel->setText(tr("Canceling..."));
+    return;
+  }
+  QDialog::reject();
+}
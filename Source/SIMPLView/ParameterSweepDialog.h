@@ -0,0 +1,126 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QJsonObject>
+
+#include <QtWidgets/QDialog>
+
+#include "SIMPLView/ParameterSweep.h"
+
+//-- UIC generated Header
+#include "ui_ParameterSweepDialog.h"
+
+class QTimer;
+
+/**
+ * @brief The ParameterSweepDialog class lets the user pick parameters of a pipeline and value ranges
+ * for them, runs the ParameterSweep in the background and compares the points in a table.
+ */
+class ParameterSweepDialog : public QDialog, private Ui::ParameterSweepDialog
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief ParameterSweepDialog
+   * @param pipelineFilePath The pipeline to sweep. The file has to exist until the dialog is closed.
+   * @param parent
+   */
+  ParameterSweepDialog(const QString& pipelineFilePath, QWidget* parent = nullptr);
+  ~ParameterSweepDialog() override;
+
+public slots:
+  void reject() override;
+
+protected slots:
+  void on_filterCombo_currentIndexChanged(int index);
+  void on_addDimensionBtn_clicked();
+  void on_removeDimensionBtn_clicked();
+  void on_runBtn_clicked();
+  void on_cancelBtn_clicked();
+  void on_saveResultsBtn_clicked();
+
+  /**
+   * @brief sweepFinished
+   */
+  void sweepFinished();
+
+  /**
+   * @brief updateProgress
+   */
+  void updateProgress();
+
+protected:
+  /**
+   * @brief setupGui
+   */
+  void setupGui();
+
+  /**
+   * @brief resetSweep Starts a new sweep with the dimensions in the table
+   * @return
+   */
+  bool resetSweep();
+
+  /**
+   * @brief updateSummary
+   */
+  void updateSummary();
+
+  /**
+   * @brief setRunning
+   * @param running
+   */
+  void setRunning(bool running);
+
+  /**
+   * @brief fillResultsTable
+   */
+  void fillResultsTable();
+
+private:
+  QString m_PipelineFilePath;
+  QJsonObject m_PipelineJson;
+  ParameterSweep::Pointer m_Sweep;
+  QFutureWatcher<QString> m_SweepWatcher;
+  QTimer* m_ProgressTimer = nullptr;
+  bool m_RejectWhenFinished = false;
+
+  ParameterSweepDialog(const ParameterSweepDialog&) = delete; // Copy Constructor Not Implemented
+  void operator=(const ParameterSweepDialog&) = delete;       // Move assignment Not Implemented
+};
@@ -0,0 +1,387 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineCheckpointer.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QStandardPaths>
+
+#include "SIMPLView/StageCache.h"
+
+namespace
+{
+const qint64 k_BytesPerMB = 1024 * 1024;
+const QString k_CheckpointSuffix(".dream3d");
+const QString k_PartialSuffix(".part");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineCheckpointer::PipelineCheckpointer()
+: m_Directory(DefaultDirectory())
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineCheckpointer::~PipelineCheckpointer()
+{
+  for(const QMetaObject::Connection& connection : m_Connections)
+  {
+    QObject::disconnect(connection);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineCheckpointer::DefaultDirectory()
+{
+  return QDir(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("Checkpoints");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineCheckpointer::FilePath(const QString& dirPath, const QString& key)
+{
+  return QDir(dirPath).filePath(key + k_CheckpointSuffix);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PipelineCheckpointer::FindResumeIndex(const QString& dirPath, const QStringList& keys)
+{
+  for(int i = keys.size() - 1; i >= 0; i--)
+  {
+    if(QFileInfo::exists(FilePath(dirPath, keys[i])))
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer PipelineCheckpointer::Restore(const QString& dirPath, const QString& key)
+{
+  return StageCache::ReadSnapshotFile(FilePath(dirPath, key));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PipelineCheckpointer::ClearDirectory(const QString& dirPath)
+{
+  QDir dir(dirPath);
+  int removed = 0;
+  for(const QString& fileName : dir.entryList(QStringList() << "*" + k_CheckpointSuffix << "*" + k_PartialSuffix, QDir::Files))
+  {
+    if(dir.remove(fileName) && fileName.endsWith(k_CheckpointSuffix))
+    {
+      removed++;
+    }
+  }
+  return removed;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineCheckpointer::setDirectory(const QString& dirPath)
+{
+  m_Directory = dirPath;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineCheckpointer::getDirectory() const
+{
+  return m_Directory;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineCheckpointer::setAfterMinutes(int minutes)
+{
+  m_AfterMinutes = qMax(0, minutes);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PipelineCheckpointer::getAfterMinutes() const
+{
+  return m_AfterMinutes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineCheckpointer::setSelectedIndices(const QSet<int>& indices)
+{
+  m_SelectedIndices = indices;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineCheckpointer::setArraySpiller(const ArraySpiller::Pointer& spiller)
+{
+  m_ArraySpiller = spiller;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineCheckpointer::isEnabled() const
+{
+  return m_AfterMinutes > 0 || !m_SelectedIndices.isEmpty();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineCheckpointer::attach(const QList<AbstractFilter::Pointer>& filters, const QStringList& keys)
+{
+  for(const QMetaObject::Connection& connection : m_Connections)
+  {
+    QObject::disconnect(connection);
+  }
+  m_Connections.clear();
+
+  setPipeline(filters, keys);
+
+  // Without a context object the connections are direct, the data has to be written before the next filter changes it
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    if(filter.get() == nullptr)
+    {
+      continue;
+    }
+    m_Connections.push_back(QObject::connect(filter.get(), &AbstractFilter::filterInProgress, [this](AbstractFilter* f) { beginFilter(f); }));
+    m_Connections.push_back(QObject::connect(filter.get(), &AbstractFilter::filterCompleted, [this](AbstractFilter* f) { endFilter(f); }));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineCheckpointer::setPipeline(const QList<AbstractFilter::Pointer>& filters, const QStringList& keys)
+{
+  m_Filters = filters;
+  m_Keys = keys;
+  m_LastCompletedIndex = -1;
+
+  QMutexLocker locker(&m_Mutex);
+  m_Checkpoints.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineCheckpointer::beginFilter(AbstractFilter* filter)
+{
+  Q_UNUSED(filter)
+
+  m_FilterTimer.start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineCheckpointer::endFilter(AbstractFilter* filter)
+{
+  qint64 filterMSecs = m_FilterTimer.isValid() ? m_FilterTimer.elapsed() : 0;
+
+  int index = -1;
+  for(int i = 0; i < m_Filters.size(); i++)
+  {
+    if(m_Filters[i].get() == filter)
+    {
+      index = i;
+      break;
+    }
+  }
+  if(index < 0 || filter->getErrorCondition() < 0 || filter->getCancel())
+  {
+    return;
+  }
+  m_LastCompletedIndex = index;
+
+  bool due = m_SelectedIndices.contains(index) || (m_AfterMinutes > 0 && filterMSecs >= m_AfterMinutes * 60 * 1000LL);
+  DataContainerArray::Pointer dca = filter->getDataContainerArray();
+  if(!due || index >= m_Keys.size() || dca.get() == nullptr)
+  {
+    return;
+  }
+
+  Checkpoint checkpoint;
+  checkpoint.filterIndex = index;
+  checkpoint.filterLabel = filter->getHumanLabel();
+  checkpoint.filePath = FilePath(m_Directory, m_Keys[index]);
+  checkpoint.filterMSecs = filterMSecs;
+
+  QElapsedTimer timer;
+  timer.start();
+
+  // A crash in the middle of the write must not leave a checkpoint behind that looks complete
+  QString partialPath = checkpoint.filePath + k_PartialSuffix;
+  bool written = QDir().mkpath(m_Directory) && StageCache::WriteSnapshotFile(dca, partialPath);
+  if(written && m_ArraySpiller.get() != nullptr)
+  {
+    // Reading all spilled arrays back at once would exceed the memory budget, they are added to the file one by one
+    int spilledArrays = m_ArraySpiller->visitSpilledArrays(dca, [partialPath](const QString& dataContainer, const AttributeMatrix::Pointer& am, const IDataArray::Pointer& array) {
+      return StageCache::AppendArrayToSnapshotFile(partialPath, dataContainer, am, array);
+    });
+    checkpoint.spilledArrays = qMax(0, spilledArrays);
+    written = spilledArrays >= 0;
+  }
+  if(written)
+  {
+    QFile::remove(checkpoint.filePath);
+    written = QFile::rename(partialPath, checkpoint.filePath);
+  }
+  else
+  {
+    QFile::remove(partialPath);
+  }
+
+  checkpoint.writeMSecs = timer.elapsed();
+  checkpoint.bytes = written ? QFileInfo(checkpoint.filePath).size() : 0;
+  checkpoint.written = written;
+
+  QMutexLocker locker(&m_Mutex);
+  m_Checkpoints.push_back(checkpoint);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineCheckpointer::finishRun()
+{
+  int lastEnabledIndex = -1;
+  for(int i = 0; i < m_Filters.size(); i++)
+  {
+    if(m_Filters[i]->getEnabled())
+    {
+      lastEnabledIndex = i;
+    }
+  }
+  if(lastEnabledIndex < 0 || m_LastCompletedIndex != lastEnabledIndex)
+  {
+    return;
+  }
+
+  // Includes the checkpoints of an earlier run that crashed and that this run resumed from
+  for(const QString& key : m_Keys)
+  {
+    QFile::remove(FilePath(m_Directory, key));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<PipelineCheckpointer::Checkpoint> PipelineCheckpointer::getCheckpoints() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_Checkpoints;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineCheckpointer::summary() const
+{
+  QVector<Checkpoint> checkpoints = getCheckpoints();
+  int written = 0;
+  qint64 bytes = 0;
+  qint64 writeMSecs = 0;
+  for(const Checkpoint& checkpoint : checkpoints)
+  {
+    written += checkpoint.written ? 1 : 0;
+    bytes += checkpoint.bytes;
+    writeMSecs += checkpoint.writeMSecs;
+  }
+
+  QString text = QString("Checkpoints: %1 of %2 written, %3 MB, %4 s writing on the pipeline thread")
+                     .arg(written)
+                     .arg(checkpoints.size())
+                     .arg(bytes / k_BytesPerMB)
+                     .arg(static_cast<double>(writeMSecs) / 1000.0, 0, 'f', 2);
+  return text;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject PipelineCheckpointer::toJson() const
+{
+  QJsonArray checkpointArray;
+  qint64 overheadMSecs = 0;
+  for(const Checkpoint& checkpoint : getCheckpoints())
+  {
+    QJsonObject json;
+    json["Filter Index"] = checkpoint.filterIndex;
+    json["Human Label"] = checkpoint.filterLabel;
+    json["File"] = checkpoint.filePath;
+    json["Bytes"] = checkpoint.bytes;
+    json["Filter MSecs"] = checkpoint.filterMSecs;
+    json["Write MSecs"] = checkpoint.writeMSecs;
+    json["Spilled Arrays"] = checkpoint.spilledArrays;
+    json["Written"] = checkpoint.written;
+    checkpointArray.append(json);
+    overheadMSecs += checkpoint.writeMSecs;
+  }
+
+  QJsonObject json;
+  json["Directory"] = m_Directory;
+  json["After Minutes"] = m_AfterMinutes;
+  json["Checkpoints"] = checkpointArray;
+  json["Pipeline Thread Overhead MSecs"] = overheadMSecs;
+  return json;
+}
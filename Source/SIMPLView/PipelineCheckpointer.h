@@ -0,0 +1,242 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QMetaObject>
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+#include "SIMPLView/ArraySpiller.h"
+
+/**
+ * @brief The PipelineCheckpointer class writes the DataContainerArray of a long pipeline run to a checkpoint file
+ * after selected filters, and after every filter that ran longer than a threshold. The file is written on the
+ * pipeline thread before the next filter starts: any filter may use HDF5, which is not built thread safe, so a
+ * write can not overlap a filter. Arrays that an ArraySpiller moved to scratch files are read back one at a time
+ * and added to the file behind the rest, so that the checkpoint holds the complete data without exceeding the
+ * memory budget.
+ *
+ * Checkpoints are named by the StageCache key of their filter, so a run resumes only from a checkpoint whose filter
+ * and every filter in front of it still have the same parameters. They live in a directory that survives the
+ * process and are removed when a run completes.
+ */
+class PipelineCheckpointer
+{
+public:
+  SIMPL_SHARED_POINTERS(PipelineCheckpointer)
+
+  static Pointer New()
+  {
+    Pointer sharedPtr(new PipelineCheckpointer());
+    return sharedPtr;
+  }
+
+  struct Checkpoint
+  {
+    int filterIndex = -1;
+    QString filterLabel;
+    QString filePath;
+    qint64 filterMSecs = 0;
+    qint64 writeMSecs = 0;
+    int spilledArrays = 0;
+    qint64 bytes = 0;
+    bool written = false;
+  };
+
+  virtual ~PipelineCheckpointer();
+
+  /**
+   * @brief DefaultDirectory
+   * @return The Checkpoints directory in the application's local data directory
+   */
+  static QString DefaultDirectory();
+
+  /**
+   * @brief FindResumeIndex
+   * @param dirPath
+   * @param keys The stage keys of a pipeline
+   * @return The index of the last filter that has a checkpoint in the directory, or -1
+   */
+  static int FindResumeIndex(const QString& dirPath, const QStringList& keys);
+
+  /**
+   * @brief Restore
+   * @param dirPath
+   * @param key
+   * @return The DataContainerArray of the checkpoint, or a null pointer if it can not be read
+   */
+  static DataContainerArray::Pointer Restore(const QString& dirPath, const QString& key);
+
+  /**
+   * @brief ClearDirectory Removes every checkpoint in the directory
+   * @param dirPath
+   * @return The number of checkpoints that were removed
+   */
+  static int ClearDirectory(const QString& dirPath);
+
+  /**
+   * @brief setDirectory
+   * @param dirPath
+   */
+  void setDirectory(const QString& dirPath);
+
+  /**
+   * @brief getDirectory
+   * @return
+   */
+  QString getDirectory() const;
+
+  /**
+   * @brief setAfterMinutes Checkpoints every filter that ran at least this long, 0 turns this off
+   * @param minutes
+   */
+  void setAfterMinutes(int minutes);
+
+  /**
+   * @brief getAfterMinutes
+   * @return
+   */
+  int getAfterMinutes() const;
+
+  /**
+   * @brief setSelectedIndices Checkpoints these filters however long they ran
+   * @param indices
+   */
+  void setSelectedIndices(const QSet<int>& indices);
+
+  /**
+   * @brief setArraySpiller The spiller whose arrays are included in the checkpoints, may be a null pointer
+   * @param spiller
+   */
+  void setArraySpiller(const ArraySpiller::Pointer& spiller);
+
+  /**
+   * @brief isEnabled
+   * @return Whether any filter may be checkpointed
+   */
+  bool isEnabled() const;
+
+  /**
+   * @brief attach Listens to the filters' filterInProgress and filterCompleted signals. Must not be called while
+   * the filters are executing.
+   * @param filters The filters of the pipeline in execution order
+   * @param keys The stage keys of the filters
+   */
+  void attach(const QList<AbstractFilter::Pointer>& filters, const QStringList& keys);
+
+  /**
+   * @brief setPipeline Starts a run without listening to the filters, for callers that call beginFilter and
+   * endFilter themselves
+   * @param filters
+   * @param keys
+   */
+  void setPipeline(const QList<AbstractFilter::Pointer>& filters, const QStringList& keys);
+
+  /**
+   * @brief beginFilter Starts timing the filter
+   * @param filter
+   */
+  void beginFilter(AbstractFilter* filter);
+
+  /**
+   * @brief endFilter Writes a checkpoint if the filter is due for one. Must be called after the ArraySpiller's endFilter.
+   * @param filter
+   */
+  void endFilter(AbstractFilter* filter);
+
+  /**
+   * @brief finishRun If the last enabled filter completed, the checkpoints of the run are removed since nothing
+   * needs to resume from them anymore.
+   */
+  void finishRun();
+
+  /**
+   * @brief getCheckpoints
+   * @return The checkpoints of the last run
+   */
+  QVector<Checkpoint> getCheckpoints() const;
+
+  /**
+   * @brief summary
+   * @return One line about the checkpoints of the last run and what they cost
+   */
+  QString summary() const;
+
+  /**
+   * @brief toJson
+   * @return
+   */
+  QJsonObject toJson() const;
+
+protected:
+  PipelineCheckpointer();
+
+  /**
+   * @brief FilePath
+   * @param dirPath
+   * @param key
+   * @return
+   */
+  static QString FilePath(const QString& dirPath, const QString& key);
+
+private:
+  QString m_Directory;
+  int m_AfterMinutes = 0;
+  QSet<int> m_SelectedIndices;
+  ArraySpiller::Pointer m_ArraySpiller;
+
+  QList<AbstractFilter::Pointer> m_Filters;
+  QStringList m_Keys;
+  QVector<QMetaObject::Connection> m_Connections;
+  QElapsedTimer m_FilterTimer;
+  int m_LastCompletedIndex = -1;
+
+  mutable QMutex m_Mutex;
+  QVector<Checkpoint> m_Checkpoints;
+
+  PipelineCheckpointer(const PipelineCheckpointer&) = delete; // Copy Constructor Not Implemented
+  void operator=(const PipelineCheckpointer&) = delete;       // Move assignment Not Implemented
+};
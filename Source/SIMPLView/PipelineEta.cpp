@@ -0,0 +1,354 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineEta.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QJsonArray>
+
+#include "SIMPLView/TimingHistory.h"
+
+namespace
+{
+// The first filters of a run say little about its speed
+const double k_MinScaleShare = 0.05;
+const double k_MinScale = 0.5;
+const double k_MaxScale = 2.0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineEta::PipelineEta() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineEta::~PipelineEta() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineEta::FormatDuration(qint64 msecs)
+{
+  qint64 secs = (msecs + 500) / 1000;
+  if(secs < 60)
+  {
+    return QString("%1 s").arg(secs);
+  }
+  if(secs < 3600)
+  {
+    return QString("%1 min %2 s").arg(secs / 60).arg(secs % 60);
+  }
+  return QString("%1 h %2 min").arg(secs / 3600).arg((secs % 3600) / 60);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineEta::setPipeline(const QList<AbstractFilter::Pointer>& filters)
+{
+  // The filters' structures are replaced by the executing data during a run
+  if(m_Running)
+  {
+    return;
+  }
+
+  TimingHistory* history = TimingHistory::Instance();
+  m_Steps.clear();
+  m_StepIndex.clear();
+  for(int i = 0; i < filters.size(); i++)
+  {
+    if(!filters[i]->getEnabled())
+    {
+      continue;
+    }
+
+    Step step;
+    step.filterIndex = i;
+    step.className = filters[i]->getNameOfClass();
+    step.filterLabel = filters[i]->getHumanLabel();
+    step.tuples = TimingHistory::SizeSignature(filters[i]->getDataContainerArray());
+    step.predictedMSecs = history->predictMSecs(step.className, step.tuples);
+    m_StepIndex.insert(i, m_Steps.size());
+    m_Steps.push_back(step);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineEta::start()
+{
+  // The history may have learned from a run since the pipeline was last preflighted
+  TimingHistory* history = TimingHistory::Instance();
+  for(Step& step : m_Steps)
+  {
+    step.predictedMSecs = history->predictMSecs(step.className, step.tuples);
+    step.wallMSecs = -1;
+  }
+  m_Running = true;
+  m_RunTimer.start();
+  m_LastFinishedMSecs = 0;
+  m_RunMSecs = 0;
+  m_EstimateAtStart = remainingMSecs();
+  m_LowerBoundAtStart = isLowerBound();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineEta::filterFinished(int filterIndex, qint64 wallMSecs)
+{
+  auto iter = m_StepIndex.constFind(filterIndex);
+  if(!m_Running || iter == m_StepIndex.constEnd() || m_Steps[iter.value()].wallMSecs >= 0)
+  {
+    return;
+  }
+  m_Steps[iter.value()].wallMSecs = wallMSecs;
+  m_LastFinishedMSecs = m_RunTimer.elapsed();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineEta::finishRun()
+{
+  if(!m_Running)
+  {
+    return;
+  }
+  m_Running = false;
+  m_RunMSecs = m_RunTimer.elapsed();
+
+  TimingHistory* history = TimingHistory::Instance();
+  for(const Step& step : m_Steps)
+  {
+    if(step.wallMSecs >= 0)
+    {
+      history->record(step.className, step.tuples, step.wallMSecs);
+    }
+  }
+  history->save();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineEta::isRunning() const
+{
+  return m_Running;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineEta::hasHistory() const
+{
+  for(const Step& step : m_Steps)
+  {
+    if(step.predictedMSecs >= 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineEta::isLowerBound() const
+{
+  for(const Step& step : m_Steps)
+  {
+    if(step.wallMSecs < 0 && step.predictedMSecs < 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double PipelineEta::runScale() const
+{
+  double totalPredicted = 0.0;
+  double donePredicted = 0.0;
+  double doneWall = 0.0;
+  for(const Step& step : m_Steps)
+  {
+    if(step.predictedMSecs < 0)
+    {
+      continue;
+    }
+    totalPredicted += step.predictedMSecs;
+    if(step.wallMSecs >= 0)
+    {
+      donePredicted += step.predictedMSecs;
+      doneWall += step.wallMSecs;
+    }
+  }
+
+  if(donePredicted <= 0.0 || donePredicted < k_MinScaleShare * totalPredicted)
+  {
+    return 1.0;
+  }
+  return qBound(k_MinScale, doneWall / donePredicted, k_MaxScale);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineEta::remainingMSecs() const
+{
+  if(!hasHistory())
+  {
+    return -1;
+  }
+
+  // Filters execute in order, so the first one that did not complete is the one executing now
+  double scale = runScale();
+  qint64 inCurrentMSecs = m_Running ? m_RunTimer.elapsed() - m_LastFinishedMSecs : 0;
+  bool current = true;
+  double remaining = 0.0;
+  for(const Step& step : m_Steps)
+  {
+    if(step.wallMSecs >= 0)
+    {
+      continue;
+    }
+    if(step.predictedMSecs >= 0)
+    {
+      double stepMSecs = scale * step.predictedMSecs;
+      remaining += current ? qMax(0.0, stepMSecs - inCurrentMSecs) : stepMSecs;
+    }
+    current = false;
+  }
+  return static_cast<qint64>(remaining);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double PipelineEta::getFractionDone() const
+{
+  qint64 remaining = remainingMSecs();
+  if(remaining < 0)
+  {
+    return 0.0;
+  }
+  qint64 elapsed = m_Running ? m_RunTimer.elapsed() : m_RunMSecs;
+  if(elapsed + remaining <= 0)
+  {
+    return 0.0;
+  }
+  return static_cast<double>(elapsed) / (elapsed + remaining);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<PipelineEta::Step> PipelineEta::getSteps() const
+{
+  return m_Steps;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineEta::statusText() const
+{
+  qint64 remaining = remainingMSecs();
+  if(remaining < 0)
+  {
+    return QString("No timing history for this pipeline yet");
+  }
+
+  QDateTime finish = QDateTime::currentDateTime().addMSecs(remaining);
+  QString finishText = finish.date() == QDate::currentDate() ? finish.toString("hh:mm") : finish.toString("ddd hh:mm");
+  if(isLowerBound())
+  {
+    return QString("At least %1 left, not before %2").arg(FormatDuration(remaining)).arg(finishText);
+  }
+  return QString("%1% done, about %2 left, finishes around %3").arg(static_cast<int>(getFractionDone() * 100.0)).arg(FormatDuration(remaining)).arg(finishText);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineEta::summary() const
+{
+  QString text = QString("The run took %1").arg(FormatDuration(m_RunMSecs));
+  if(m_EstimateAtStart < 0)
+  {
+    return text + ", its filters had no timing history";
+  }
+  double error = m_RunMSecs > 0 ? 100.0 * (m_EstimateAtStart - m_RunMSecs) / m_RunMSecs : 0.0;
+  return text + QString(", the estimate at its start was %1%2 (%3%4%)")
+                    .arg(m_LowerBoundAtStart ? "at least " : "")
+                    .arg(FormatDuration(m_EstimateAtStart))
+                    .arg(error >= 0.0 ? "+" : "")
+                    .arg(error, 0, 'f', 1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject PipelineEta::toJson() const
+{
+  QJsonArray steps;
+  for(const Step& step : m_Steps)
+  {
+    QJsonObject object;
+    object["Index"] = step.filterIndex;
+    object["Class Name"] = step.className;
+    object["Human Label"] = step.filterLabel;
+    object["Size Signature Tuples"] = step.tuples;
+    object["Predicted Wall Time MSecs"] = step.predictedMSecs;
+    object["Wall Time MSecs"] = step.wallMSecs;
+    steps.append(object);
+  }
+
+  QJsonObject json;
+  json["Estimate At Start MSecs"] = m_EstimateAtStart;
+  json["Estimate Is Lower Bound"] = m_LowerBoundAtStart;
+  json["Run Wall Time MSecs"] = m_RunMSecs;
+  json["History File"] = TimingHistory::Instance()->getFilePath();
+  json["Steps"] = steps;
+  return json;
+}
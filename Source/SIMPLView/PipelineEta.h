@@ -0,0 +1,183 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+/**
+ * @brief The PipelineEta class estimates when a run finishes. Before the run each enabled filter gets the
+ * wall time the TimingHistory predicts for its class and the size signature of its preflight structure. While
+ * the run goes on, the filters that completed tell how much faster or slower this run is than the history and
+ * the remaining predictions are scaled by that. Filters without a history count as taking no time, which makes
+ * the estimate a lower bound. When the run has finished its wall times are added to the history.
+ */
+class PipelineEta
+{
+public:
+  SIMPL_SHARED_POINTERS(PipelineEta)
+
+  static Pointer New()
+  {
+    return Pointer(new PipelineEta());
+  }
+
+  virtual ~PipelineEta();
+
+  struct Step
+  {
+    int filterIndex = -1;
+    QString className;
+    QString filterLabel;
+    qint64 tuples = 0;
+    qint64 predictedMSecs = -1;
+    qint64 wallMSecs = -1;
+  };
+
+  /**
+   * @brief FormatDuration
+   * @param msecs
+   * @return The duration rounded to what matters for an estimate, e.g. "1 h 12 min"
+   */
+  static QString FormatDuration(qint64 msecs);
+
+  /**
+   * @brief setPipeline Predicts the filters from their preflight structures. Ignored while a run is in progress.
+   * @param filters All filters of the pipeline, in order
+   */
+  void setPipeline(const QList<AbstractFilter::Pointer>& filters);
+
+  /**
+   * @brief start Must be called when the first filter starts executing
+   */
+  void start();
+
+  /**
+   * @brief filterFinished Reports a filter that completed without an error, repeated reports are ignored
+   * @param filterIndex The filter's index in the pipeline
+   * @param wallMSecs
+   */
+  void filterFinished(int filterIndex, qint64 wallMSecs);
+
+  /**
+   * @brief finishRun Adds the filters that completed to the TimingHistory and saves it
+   */
+  void finishRun();
+
+  /**
+   * @brief isRunning
+   * @return
+   */
+  bool isRunning() const;
+
+  /**
+   * @brief hasHistory
+   * @return Whether any filter of the pipeline has a prediction
+   */
+  bool hasHistory() const;
+
+  /**
+   * @brief isLowerBound
+   * @return Whether a filter that did not complete yet has no prediction
+   */
+  bool isLowerBound() const;
+
+  /**
+   * @brief remainingMSecs
+   * @return The expected time until the run finishes, or -1 if no filter has a prediction
+   */
+  qint64 remainingMSecs() const;
+
+  /**
+   * @brief getFractionDone
+   * @return The share of the expected run time that has passed, between 0 and 1
+   */
+  double getFractionDone() const;
+
+  /**
+   * @brief getSteps
+   * @return
+   */
+  QVector<Step> getSteps() const;
+
+  /**
+   * @brief statusText
+   * @return The remaining time and the time of day the run is expected to finish at
+   */
+  QString statusText() const;
+
+  /**
+   * @brief summary
+   * @return How long the last run took compared to the estimate at its start
+   */
+  QString summary() const;
+
+  /**
+   * @brief toJson
+   * @return
+   */
+  QJsonObject toJson() const;
+
+protected:
+  PipelineEta();
+
+  /**
+   * @brief runScale
+   * @return How much longer than predicted the filters of this run took so far
+   */
+  double runScale() const;
+
+private:
+  QVector<Step> m_Steps;
+  QHash<int, int> m_StepIndex;
+
+  bool m_Running = false;
+  QElapsedTimer m_RunTimer;
+  qint64 m_LastFinishedMSecs = 0;
+  qint64 m_RunMSecs = 0;
+  qint64 m_EstimateAtStart = -1;
+  bool m_LowerBoundAtStart = false;
+
+  PipelineEta(const PipelineEta&) = delete;     // Copy Constructor Not Implemented
+  void operator=(const PipelineEta&) = delete;  // Move assignment Not Implemented
+};
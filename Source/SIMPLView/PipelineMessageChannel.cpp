@@ -0,0 +1,213 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineMessageChannel.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineMessageChannel::PipelineMessageChannel() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineMessageChannel::~PipelineMessageChannel()
+{
+  delete m_Status.exchange(nullptr);
+  DeleteList(m_Lines.exchange(nullptr));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineMessageChannel::post(const PipelineMessage& msg)
+{
+  switch(msg.getType())
+  {
+  case PipelineMessage::MessageType::ProgressValue:
+    storeProgress(msg.getProgressValue());
+    break;
+  case PipelineMessage::MessageType::StatusMessageAndProgressValue:
+    storeProgress(msg.getProgressValue());
+    storeStatus(msg.generateStatusString());
+    break;
+  case PipelineMessage::MessageType::StatusMessage:
+    storeStatus(msg.generateStatusString());
+    storeLine(msg.getText(), msg.getType());
+    break;
+  case PipelineMessage::MessageType::StandardOutputMessage:
+  case PipelineMessage::MessageType::Warning:
+  case PipelineMessage::MessageType::Error:
+    storeLine(msg.getText(), msg.getType());
+    break;
+  default:
+    return false;
+  }
+  return markPending();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineMessageChannel::postProgress(int progressValue)
+{
+  storeProgress(progressValue);
+  return markPending();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineMessageChannel::postStatus(const QString& status)
+{
+  storeStatus(status);
+  return markPending();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineMessageChannel::postLine(const QString& line, PipelineMessage::MessageType type)
+{
+  storeLine(line, type);
+  return markPending();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineMessageChannel::storeProgress(int progressValue)
+{
+  m_Progress.store(static_cast<qint64>(static_cast<quint32>(progressValue)), std::memory_order_release);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineMessageChannel::storeStatus(const QString& status)
+{
+  Node* node = new Node;
+  node->text = status;
+  delete m_Status.exchange(node, std::memory_order_acq_rel);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineMessageChannel::storeLine(const QString& line, PipelineMessage::MessageType type)
+{
+  Node* node = new Node;
+  node->text = line;
+  node->type = type;
+  node->next = m_Lines.load(std::memory_order_relaxed);
+  while(!m_Lines.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+  {
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineMessageChannel::markPending()
+{
+  m_PostedCount.fetch_add(1, std::memory_order_relaxed);
+  return m_PendingCount.fetch_add(1, std::memory_order_acq_rel) == 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineMessageChannel::Batch PipelineMessageChannel::take()
+{
+  Batch batch;
+
+  // Reset the count first, anything posted after this point wakes the consumer up again
+  batch.messageCount = m_PendingCount.exchange(0, std::memory_order_acq_rel);
+
+  qint64 progress = m_Progress.exchange(-1, std::memory_order_acq_rel);
+  if(progress >= 0)
+  {
+    batch.hasProgress = true;
+    batch.progressValue = static_cast<int>(static_cast<quint32>(progress));
+  }
+
+  Node* status = m_Status.exchange(nullptr, std::memory_order_acq_rel);
+  if(nullptr != status)
+  {
+    batch.hasStatus = true;
+    batch.status = status->text;
+    delete status;
+  }
+
+  // The stack holds the newest line first
+  Node* node = m_Lines.exchange(nullptr, std::memory_order_acquire);
+  Node* reversed = nullptr;
+  while(nullptr != node)
+  {
+    Node* next = node->next;
+    node->next = reversed;
+    reversed = node;
+    node = next;
+  }
+  for(Node* line = reversed; nullptr != line; line = line->next)
+  {
+    batch.lines.push_back(line->text);
+    batch.lineTypes.push_back(line->type);
+  }
+  DeleteList(reversed);
+
+  return batch;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineMessageChannel::getPostedCount() const
+{
+  return m_PostedCount.load(std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineMessageChannel::DeleteList(Node* node)
+{
+  while(nullptr != node)
+  {
+    Node* next = node->next;
+    delete node;
+    node = next;
+  }
+}
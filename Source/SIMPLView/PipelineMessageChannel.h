@@ -0,0 +1,153 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Common/PipelineMessage.h"
+
+/**
+ * @brief The PipelineMessageChannel class carries the progress, status and standard output messages of an
+ * executing pipeline to the GUI thread without locks. Any thread may post; the GUI thread takes everything
+ * that arrived since the last time at display refresh rate. Progress and status are coalesced, so only the
+ * newest value is kept, while standard output, warning and error lines are kept in order and handed over as
+ * one batch.
+ */
+class PipelineMessageChannel
+{
+public:
+  // About one display frame
+  static const int RefreshIntervalMSecs = 16;
+
+  struct Batch
+  {
+    bool hasProgress = false;
+    int progressValue = 0;
+    bool hasStatus = false;
+    QString status;
+    QStringList lines;
+    QVector<PipelineMessage::MessageType> lineTypes;
+    int messageCount = 0;
+  };
+
+  PipelineMessageChannel();
+  virtual ~PipelineMessageChannel();
+
+  /**
+   * @brief post Can be called from any thread
+   * @param msg
+   * @return True if the channel was empty, i.e. the consumer has to be woken up
+   */
+  bool post(const PipelineMessage& msg);
+
+  /**
+   * @brief postProgress Can be called from any thread
+   * @param progressValue
+   * @return True if the channel was empty
+   */
+  bool postProgress(int progressValue);
+
+  /**
+   * @brief postStatus Can be called from any thread
+   * @param status
+   * @return True if the channel was empty
+   */
+  bool postStatus(const QString& status);
+
+  /**
+   * @brief postLine Can be called from any thread
+   * @param line
+   * @param type The kind of message the line came from
+   * @return True if the channel was empty
+   */
+  bool postLine(const QString& line, PipelineMessage::MessageType type = PipelineMessage::MessageType::StandardOutputMessage);
+
+  /**
+   * @brief take Must only be called by the single consumer
+   * @return Everything that was posted since the last call
+   */
+  Batch take();
+
+  /**
+   * @brief getPostedCount
+   * @return The number of messages posted over the lifetime of the channel
+   */
+  qint64 getPostedCount() const;
+
+protected:
+  struct Node
+  {
+    QString text;
+    PipelineMessage::MessageType type = PipelineMessage::MessageType::StandardOutputMessage;
+    Node* next = nullptr;
+  };
+
+  void storeProgress(int progressValue);
+  void storeStatus(const QString& status);
+  void storeLine(const QString& line, PipelineMessage::MessageType type);
+
+  /**
+   * @brief markPending Counts a message and reports whether it is the first one of a batch
+   * @return
+   */
+  bool markPending();
+
+  /**
+   * @brief DeleteList
+   * @param node
+   */
+  static void DeleteList(Node* node);
+
+private:
+  // Progress is stored with a "has value" bit so that a single exchange takes it
+  std::atomic<qint64> m_Progress{-1};
+
+  // The newest status only, an older one that was not taken yet is dropped by the producer that replaces it
+  std::atomic<Node*> m_Status{nullptr};
+
+  // Lines are pushed on a stack and reversed when taken, the consumer always takes the whole stack
+  std::atomic<Node*> m_Lines{nullptr};
+
+  std::atomic<int> m_PendingCount{0};
+  std::atomic<qint64> m_PostedCount{0};
+
+  PipelineMessageChannel(const PipelineMessageChannel&) = delete; // Copy Constructor Not Implemented
+  void operator=(const PipelineMessageChannel&) = delete;         // Move assignment Not Implemented
+};
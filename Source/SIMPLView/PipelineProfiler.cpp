@@ -0,0 +1,400 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineProfiler.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSaveFile>
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+
+#include "SIMPLView/ProcessStats.h"
+
+namespace
+{
+const int k_SampleIntervalMSecs = 10;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString csvField(QString text)
+{
+  if(text.contains(',') || text.contains('"'))
+  {
+    text.replace("\"", "\"\"");
+    return "\"" + text + "\"";
+  }
+  return text;
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineProfiler::PipelineProfiler(QObject* parent)
+: QObject(parent)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineProfiler::~PipelineProfiler()
+{
+  for(const QMetaObject::Connection& connection : m_Connections)
+  {
+    disconnect(connection);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineProfiler::AllocatedBytes(const DataContainerArray::Pointer& dca)
+{
+  if(dca.get() == nullptr)
+  {
+    return 0;
+  }
+
+  qint64 bytes = 0;
+  for(DataContainer::Pointer dc : dca->getDataContainers())
+  {
+    for(AttributeMatrix::Pointer am : dc->getAttributeMatrices())
+    {
+      for(const QString& arrayName : am->getAttributeArrayNames())
+      {
+        IDataArray::Pointer array = am->getAttributeArray(arrayName);
+        if(array.get() != nullptr)
+        {
+          bytes += static_cast<qint64>(array->getSize()) * array->getTypeSize();
+        }
+      }
+    }
+  }
+  return bytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfiler::attach(const QList<AbstractFilter::Pointer>& filters)
+{
+  QMutexLocker locker(&m_Mutex);
+  if(m_Running)
+  {
+    m_PendingFilters = filters;
+    m_HasPendingFilters = true;
+    return;
+  }
+  locker.unlock();
+
+  connectFilters(filters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfiler::connectFilters(const QList<AbstractFilter::Pointer>& filters)
+{
+  for(const QMetaObject::Connection& connection : m_Connections)
+  {
+    disconnect(connection);
+  }
+  m_Connections.clear();
+
+  // Direct connections, the measurements have to be taken on the thread that executes the filter
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    if(filter.get() == nullptr)
+    {
+      continue;
+    }
+    m_Connections.push_back(connect(filter.get(), &AbstractFilter::filterInProgress, this, [this](AbstractFilter* f) { beginFilter(f); }, Qt::DirectConnection));
+    m_Connections.push_back(connect(filter.get(), &AbstractFilter::filterCompleted, this, [this](AbstractFilter* f) { endFilter(f); }, Qt::DirectConnection));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfiler::beginFilter(AbstractFilter* filter)
+{
+  bool started = false;
+  {
+    QMutexLocker locker(&m_Mutex);
+    if(!m_Running)
+    {
+      // The first filter of a run
+      m_Running = true;
+      m_Profiles.clear();
+      m_WallUSecs.clear();
+      m_MaxWallUSecs = 0;
+      m_RunTimer.start();
+      started = true;
+    }
+    else if(m_CurrentFilter != nullptr)
+    {
+      closeCurrentFilter(m_CurrentFilter->getErrorCondition());
+    }
+
+    m_CurrentFilter = filter;
+    m_CurrentProfile = FilterProfile();
+    m_CurrentProfile.index = filter->getPipelineIndex();
+    m_CurrentProfile.className = filter->getNameOfClass();
+    m_CurrentProfile.humanLabel = filter->getHumanLabel();
+    m_CurrentProfile.residentBytesAtStart = ProcessStats::ResidentBytes();
+    m_CurrentProfile.threadCountAtStart = ProcessStats::ThreadCount();
+    m_CurrentAllocatedBytes = AllocatedBytes(filter->getDataContainerArray());
+    m_CurrentCpuMSecs = ProcessStats::CpuTimeMSecs();
+    m_Sampler.reset(new ProcessSampler(k_SampleIntervalMSecs));
+    m_Sampler->start();
+    m_CurrentProfile.startUSecs = m_RunTimer.nsecsElapsed() / 1000;
+  }
+
+  if(started)
+  {
+    emit runStarted();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfiler::endFilter(AbstractFilter* filter)
+{
+  {
+    QMutexLocker locker(&m_Mutex);
+    if(!m_Running || filter != m_CurrentFilter)
+    {
+      return;
+    }
+    m_CurrentProfile.allocatedBytes = AllocatedBytes(filter->getDataContainerArray()) - m_CurrentAllocatedBytes;
+    closeCurrentFilter(filter->getErrorCondition());
+  }
+
+  emit profileUpdated();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfiler::closeCurrentFilter(int errorCode)
+{
+  m_CurrentProfile.wallUSecs = m_RunTimer.nsecsElapsed() / 1000 - m_CurrentProfile.startUSecs;
+  m_CurrentProfile.cpuMSecs = ProcessStats::CpuTimeMSecs() - m_CurrentCpuMSecs;
+  m_Sampler->stop();
+  m_CurrentProfile.peakAddedThreadCount = qMax(0, m_Sampler->getPeakThreadCount() - m_CurrentProfile.threadCountAtStart);
+  m_CurrentProfile.peakResidentDeltaBytes = qMax<qint64>(0, m_Sampler->getPeakResidentBytes() - m_CurrentProfile.residentBytesAtStart);
+  m_CurrentProfile.residentBytesAtEnd = ProcessStats::ResidentBytes();
+  m_CurrentProfile.errorCode = errorCode;
+  m_Sampler.reset();
+
+  m_Profiles.push_back(m_CurrentProfile);
+  m_WallUSecs.insert(m_CurrentProfile.index, m_CurrentProfile.wallUSecs);
+  m_MaxWallUSecs = qMax(m_MaxWallUSecs, m_CurrentProfile.wallUSecs);
+  m_CurrentFilter = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfiler::finishRun()
+{
+  QList<AbstractFilter::Pointer> pendingFilters;
+  bool hasPendingFilters = false;
+  {
+    QMutexLocker locker(&m_Mutex);
+    if(!m_Running)
+    {
+      return;
+    }
+
+    // A canceled filter never reports that it completed
+    if(m_CurrentFilter != nullptr)
+    {
+      m_CurrentProfile.allocatedBytes = 0;
+      closeCurrentFilter(m_CurrentFilter->getErrorCondition());
+    }
+    m_Running = false;
+
+    pendingFilters.swap(m_PendingFilters);
+    hasPendingFilters = m_HasPendingFilters;
+    m_HasPendingFilters = false;
+  }
+
+  if(hasPendingFilters)
+  {
+    connectFilters(pendingFilters);
+  }
+
+  emit runFinished();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineProfiler::isRunning() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_Running;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<PipelineProfiler::FilterProfile> PipelineProfiler::getProfiles() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_Profiles;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double PipelineProfiler::getHeat(int filterIndex) const
+{
+  QMutexLocker locker(&m_Mutex);
+  if(!m_WallUSecs.contains(filterIndex))
+  {
+    return -1.0;
+  }
+  if(m_MaxWallUSecs <= 0)
+  {
+    return 0.0;
+  }
+  return static_cast<double>(m_WallUSecs.value(filterIndex)) / m_MaxWallUSecs;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineProfiler::exportCsv(const QString& filePath) const
+{
+  QVector<FilterProfile> profiles = getProfiles();
+
+  QSaveFile file(filePath);
+  if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+  {
+    return false;
+  }
+
+  QTextStream out(&file);
+  out << "Index,Filter,Class Name,Start (ms),Wall Time (ms),CPU Time (ms),Threads At Start,Peak Added Threads,Peak Memory Delta (bytes),Data Allocated (bytes),Error Code\n";
+  for(const FilterProfile& profile : profiles)
+  {
+    out << profile.index << "," << csvField(profile.humanLabel) << "," << csvField(profile.className) << "," << QString::number(profile.startUSecs / 1000.0, 'f', 3) << ","
+        << QString::number(profile.wallUSecs / 1000.0, 'f', 3) << "," << profile.cpuMSecs << "," << profile.threadCountAtStart << "," << profile.peakAddedThreadCount << "," << profile.peakResidentDeltaBytes << ","
+        << profile.allocatedBytes << "," << profile.errorCode << "\n";
+  }
+  out.flush();
+
+  if(out.status() != QTextStream::Ok)
+  {
+    file.cancelWriting();
+    return false;
+  }
+  return file.commit();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineProfiler::exportChromeTrace(const QString& filePath) const
+{
+  QVector<FilterProfile> profiles = getProfiles();
+
+  const double bytesPerMB = 1024.0 * 1024.0;
+  QJsonArray events;
+  for(const FilterProfile& profile : profiles)
+  {
+    QJsonObject args;
+    args["Index"] = profile.index;
+    args["Class Name"] = profile.className;
+    args["CPU Time MSecs"] = profile.cpuMSecs;
+    args["Threads At Start"] = profile.threadCountAtStart;
+    args["Peak Added Threads"] = profile.peakAddedThreadCount;
+    args["Peak Memory Delta Bytes"] = profile.peakResidentDeltaBytes;
+    args["Data Allocated Bytes"] = profile.allocatedBytes;
+    args["Error Code"] = profile.errorCode;
+
+    QJsonObject event;
+    event["name"] = profile.humanLabel;
+    event["cat"] = "filter";
+    event["ph"] = "X";
+    event["ts"] = profile.startUSecs;
+    event["dur"] = profile.wallUSecs;
+    event["pid"] = 1;
+    event["tid"] = 1;
+    event["args"] = args;
+    events.append(event);
+
+    // A counter track for the resident memory at the start and the end of each filter
+    QJsonObject startMemory;
+    startMemory["Resident MB"] = profile.residentBytesAtStart / bytesPerMB;
+    QJsonObject startCounter;
+    startCounter["name"] = "Memory";
+    startCounter["ph"] = "C";
+    startCounter["ts"] = profile.startUSecs;
+    startCounter["pid"] = 1;
+    startCounter["args"] = startMemory;
+    events.append(startCounter);
+
+    QJsonObject endMemory;
+    endMemory["Resident MB"] = profile.residentBytesAtEnd / bytesPerMB;
+    QJsonObject endCounter = startCounter;
+    endCounter["ts"] = profile.startUSecs + profile.wallUSecs;
+    endCounter["args"] = endMemory;
+    events.append(endCounter);
+  }
+
+  QJsonObject trace;
+  trace["traceEvents"] = events;
+  trace["displayTimeUnit"] = "ms";
+
+  QSaveFile file(filePath);
+  if(!file.open(QIODevice::WriteOnly))
+  {
+    return false;
+  }
+  file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+  return file.commit();
+}
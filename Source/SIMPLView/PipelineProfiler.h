@@ -0,0 +1,189 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <memory>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QMetaObject>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QVector>
+
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+class ProcessSampler;
+
+/**
+ * @brief The PipelineProfiler class records where the time and memory went while a window's pipeline
+ * executed. It listens to the filters' filterInProgress and filterCompleted signals on the thread that
+ * executes the pipeline and measures each filter's wall time, the CPU time of the process, the peak
+ * number of threads the process had on top of those it had when the filter started, the peak growth of
+ * the resident memory and the bytes added to the DataContainerArray. CPU time, threads and memory are
+ * process wide, so work done by other windows at the same time is included.
+ */
+class PipelineProfiler : public QObject
+{
+  Q_OBJECT
+
+public:
+  struct FilterProfile
+  {
+    int index = -1;
+    QString className;
+    QString humanLabel;
+    qint64 startUSecs = 0;
+    qint64 wallUSecs = 0;
+    qint64 cpuMSecs = 0;
+    int threadCountAtStart = 0;
+    int peakAddedThreadCount = 0;
+    qint64 residentBytesAtStart = 0;
+    qint64 residentBytesAtEnd = 0;
+    qint64 peakResidentDeltaBytes = 0;
+    qint64 allocatedBytes = 0;
+    int errorCode = 0;
+  };
+
+  PipelineProfiler(QObject* parent = nullptr);
+  ~PipelineProfiler() override;
+
+  /**
+   * @brief AllocatedBytes
+   * @param dca
+   * @return The bytes held by all attribute arrays of the DataContainerArray
+   */
+  static qint64 AllocatedBytes(const DataContainerArray::Pointer& dca);
+
+  /**
+   * @brief attach Listens to these filters from now on. While a run is in progress the filters are
+   * attached once it has finished.
+   * @param filters
+   */
+  void attach(const QList<AbstractFilter::Pointer>& filters);
+
+  /**
+   * @brief finishRun Must be called when the pipeline has finished or was canceled
+   */
+  void finishRun();
+
+  /**
+   * @brief isRunning
+   * @return
+   */
+  bool isRunning() const;
+
+  /**
+   * @brief getProfiles
+   * @return The filters of the current or the last run in the order they were executed
+   */
+  QVector<FilterProfile> getProfiles() const;
+
+  /**
+   * @brief getHeat
+   * @param filterIndex The filter's index in the pipeline
+   * @return The filter's wall time relative to the slowest filter of the last run, between 0 and 1, or -1
+   * if the filter was not executed
+   */
+  double getHeat(int filterIndex) const;
+
+  /**
+   * @brief exportCsv
+   * @param filePath
+   * @return False if the file could not be written
+   */
+  bool exportCsv(const QString& filePath) const;
+
+  /**
+   * @brief exportChromeTrace Writes the run in the Trace Event Format that chrome://tracing and Perfetto open
+   * @param filePath
+   * @return False if the file could not be written
+   */
+  bool exportChromeTrace(const QString& filePath) const;
+
+signals:
+  void runStarted();
+  void profileUpdated();
+  void runFinished();
+
+protected:
+  /**
+   * @brief beginFilter Called on the thread that executes the pipeline
+   * @param filter
+   */
+  void beginFilter(AbstractFilter* filter);
+
+  /**
+   * @brief endFilter Called on the thread that executes the pipeline
+   * @param filter
+   */
+  void endFilter(AbstractFilter* filter);
+
+  /**
+   * @brief closeCurrentFilter Finishes the measurement of the filter that is executing, m_Mutex must be held
+   * @param errorCode
+   */
+  void closeCurrentFilter(int errorCode);
+
+  /**
+   * @brief connectFilters
+   * @param filters
+   */
+  void connectFilters(const QList<AbstractFilter::Pointer>& filters);
+
+private:
+  mutable QMutex m_Mutex;
+  bool m_Running = false;
+  QElapsedTimer m_RunTimer;
+  QVector<FilterProfile> m_Profiles;
+  QHash<int, qint64> m_WallUSecs;
+  qint64 m_MaxWallUSecs = 0;
+
+  AbstractFilter* m_CurrentFilter = nullptr;
+  FilterProfile m_CurrentProfile;
+  qint64 m_CurrentCpuMSecs = 0;
+  qint64 m_CurrentAllocatedBytes = 0;
+  std::unique_ptr<ProcessSampler> m_Sampler;
+
+  QList<QMetaObject::Connection> m_Connections;
+  QList<AbstractFilter::Pointer> m_PendingFilters;
+  bool m_HasPendingFilters = false;
+
+  PipelineProfiler(const PipelineProfiler&) = delete; // Copy Constructor Not Implemented
+  void operator=(const PipelineProfiler&) = delete;   // Move assignment Not Implemented
+};
@@ -0,0 +1,230 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineProfilerWidget.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QMessageBox>
+
+#include "SIMPLView/ProcessStats.h"
+#include "SIMPLView/ProfilerItemDelegate.h"
+
+namespace
+{
+enum ProfileColumn
+{
+  IndexColumn = 0,
+  FilterColumn,
+  WallTimeColumn,
+  CpuTimeColumn,
+  ThreadsColumn,
+  PeakMemoryColumn,
+  AllocatedColumn,
+  ShareColumn
+};
+
+/**
+ * @brief The NumericItem class sorts by the value behind the formatted text
+ */
+class NumericItem : public QTableWidgetItem
+{
+public:
+  NumericItem(const QString& text, double value)
+  : QTableWidgetItem(text)
+  {
+    setData(Qt::UserRole, value);
+    setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+  }
+
+  bool operator<(const QTableWidgetItem& other) const override
+  {
+    return data(Qt::UserRole).toDouble() < other.data(Qt::UserRole).toDouble();
+  }
+};
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineProfilerWidget::PipelineProfilerWidget(PipelineProfiler* profiler, ProfilerItemDelegate* delegate, QWidget* parent)
+: QWidget(parent)
+, m_Profiler(profiler)
+, m_Delegate(delegate)
+, m_LastExportDirectory(QDir::homePath())
+{
+  setupUi(this);
+  setupGui();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineProfilerWidget::~PipelineProfilerWidget() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfilerWidget::setupGui()
+{
+  profileTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+  profileTable->horizontalHeader()->setSectionResizeMode(FilterColumn, QHeaderView::Interactive);
+  profileTable->sortByColumn(IndexColumn, Qt::AscendingOrder);
+
+  heatMapCheckBox->setChecked(m_Delegate->isHeatMapEnabled());
+
+  // The profiler signals from the thread that executes the pipeline, so these are queued
+  connect(m_Profiler, &PipelineProfiler::runStarted, this, &PipelineProfilerWidget::updateProfiles);
+  connect(m_Profiler, &PipelineProfiler::profileUpdated, this, &PipelineProfilerWidget::updateProfiles);
+  connect(m_Profiler, &PipelineProfiler::runFinished, this, &PipelineProfilerWidget::updateProfiles);
+
+  updateProfiles();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfilerWidget::updateProfiles()
+{
+  QVector<PipelineProfiler::FilterProfile> profiles = m_Profiler->getProfiles();
+
+  qint64 totalWallUSecs = 0;
+  qint64 totalCpuMSecs = 0;
+  for(const PipelineProfiler::FilterProfile& profile : profiles)
+  {
+    totalWallUSecs += profile.wallUSecs;
+    totalCpuMSecs += profile.cpuMSecs;
+  }
+
+  // Sorting is switched off while filling, otherwise rows move under the inserts
+  profileTable->setSortingEnabled(false);
+  profileTable->setRowCount(profiles.size());
+  for(int row = 0; row < profiles.size(); row++)
+  {
+    const PipelineProfiler::FilterProfile& profile = profiles[row];
+    double share = (totalWallUSecs > 0) ? 100.0 * profile.wallUSecs / totalWallUSecs : 0.0;
+
+    QTableWidgetItem* filterItem = new QTableWidgetItem(profile.humanLabel);
+    filterItem->setToolTip(profile.className);
+    if(profile.errorCode < 0)
+    {
+      filterItem->setForeground(QColor(200, 0, 0));
+    }
+
+    profileTable->setItem(row, IndexColumn, new NumericItem(QString::number(profile.index + 1), profile.index));
+    profileTable->setItem(row, FilterColumn, filterItem);
+    profileTable->setItem(row, WallTimeColumn, new NumericItem(FormatUSecs(profile.wallUSecs), profile.wallUSecs));
+    profileTable->setItem(row, CpuTimeColumn, new NumericItem(FormatUSecs(profile.cpuMSecs * 1000), profile.cpuMSecs));
+    profileTable->setItem(row, ThreadsColumn, new NumericItem(QString::number(profile.peakAddedThreadCount), profile.peakAddedThreadCount));
+    profileTable->setItem(row, PeakMemoryColumn, new NumericItem(ProcessStats::FormatBytes(profile.peakResidentDeltaBytes), profile.peakResidentDeltaBytes));
+    profileTable->setItem(row, AllocatedColumn, new NumericItem(ProcessStats::FormatBytes(profile.allocatedBytes), profile.allocatedBytes));
+    profileTable->setItem(row, ShareColumn, new NumericItem(QString("%1 %").arg(share, 0, 'f', 1), share));
+  }
+  profileTable->setSortingEnabled(true);
+
+  if(profiles.isEmpty())
+  {
+    summaryLabel->setText(m_Profiler->isRunning() ? tr("Running...") : tr("Execute the pipeline to profile it"));
+  }
+  else
+  {
+    summaryLabel->setText(tr("%1 filters, wall time %2, CPU time %3").arg(profiles.size()).arg(FormatUSecs(totalWallUSecs)).arg(FormatUSecs(totalCpuMSecs * 1000)));
+  }
+
+  m_Delegate->setHeatMapEnabled(heatMapCheckBox->isChecked());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfilerWidget::on_heatMapCheckBox_toggled(bool checked)
+{
+  m_Delegate->setHeatMapEnabled(checked);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfilerWidget::on_exportCsvBtn_clicked()
+{
+  QString filePath = QFileDialog::getSaveFileName(this, tr("Export Profile"), m_LastExportDirectory + QDir::separator() + "PipelineProfile.csv", tr("CSV File (*.csv);;All Files (*.*)"));
+  if(filePath.isEmpty())
+  {
+    return;
+  }
+  m_LastExportDirectory = QFileInfo(filePath).absolutePath();
+
+  if(!m_Profiler->exportCsv(filePath))
+  {
+    QMessageBox::critical(this, tr("Export Profile"), tr("The profile could not be written to\n%1").arg(QDir::toNativeSeparators(filePath)));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfilerWidget::on_exportTraceBtn_clicked()
+{
+  QString filePath = QFileDialog::getSaveFileName(this, tr("Export Trace"), m_LastExportDirectory + QDir::separator() + "PipelineTrace.json", tr("Trace File (*.json);;All Files (*.*)"));
+  if(filePath.isEmpty())
+  {
+    return;
+  }
+  m_LastExportDirectory = QFileInfo(filePath).absolutePath();
+
+  if(!m_Profiler->exportChromeTrace(filePath))
+  {
+    QMessageBox::critical(this, tr("Export Trace"), tr("The trace could not be written to\n%1").arg(QDir::toNativeSeparators(filePath)));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineProfilerWidget::FormatUSecs(qint64 usecs)
+{
+  if(usecs < 1000000)
+  {
+    return QString("%1 ms").arg(usecs / 1000.0, 0, 'f', 1);
+  }
+  qint64 secs = usecs / 1000000;
+  if(secs < 60)
+  {
+    return QString("%1 s").arg(usecs / 1000000.0, 0, 'f', 2);
+  }
+  return QString("%1:%2:%3").arg(secs / 3600).arg((secs / 60) % 60, 2, 10, QChar('0')).arg(secs % 60, 2, 10, QChar('0'));
+}
@@ -0,0 +1,89 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtWidgets/QWidget>
+
+#include "SIMPLView/PipelineProfiler.h"
+
+//-- UIC generated Header
+#include "ui_PipelineProfilerWidget.h"
+
+class ProfilerItemDelegate;
+
+/**
+ * @brief The PipelineProfilerWidget class lists the filters of the last run with their measurements in a
+ * sortable table, switches the heat map in the pipeline view and exports the run as CSV or Chrome trace.
+ */
+class PipelineProfilerWidget : public QWidget, private Ui::PipelineProfilerWidget
+{
+  Q_OBJECT
+
+public:
+  PipelineProfilerWidget(PipelineProfiler* profiler, ProfilerItemDelegate* delegate, QWidget* parent = nullptr);
+  ~PipelineProfilerWidget() override;
+
+protected slots:
+  void on_heatMapCheckBox_toggled(bool checked);
+  void on_exportCsvBtn_clicked();
+  void on_exportTraceBtn_clicked();
+
+  /**
+   * @brief updateProfiles Refills the table from the profiler
+   */
+  void updateProfiles();
+
+protected:
+  /**
+   * @brief setupGui
+   */
+  void setupGui();
+
+  /**
+   * @brief FormatUSecs
+   * @param usecs
+   * @return
+   */
+  static QString FormatUSecs(qint64 usecs);
+
+private:
+  PipelineProfiler* m_Profiler = nullptr;
+  ProfilerItemDelegate* m_Delegate = nullptr;
+  QString m_LastExportDirectory;
+
+  PipelineProfilerWidget(const PipelineProfilerWidget&) = delete; // Copy Constructor Not Implemented
+  void operator=(const PipelineProfilerWidget&) = delete;         // Move assignment Not Implemented
+};
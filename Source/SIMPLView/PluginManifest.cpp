@@ -0,0 +1,658 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PluginManifest.h"
+
+#include <memory>
+
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+
+#include "SIMPLib/Filtering/FilterManager.h"
+
+#include "SIMPLView/SIMPLViewApplication.h"
+
+namespace
+{
+const int k_ManifestVersion = 2;
+
+const QString k_Version("Version");
+const QString k_Plugins("Plugins");
+const QString k_FilePath("FilePath");
+const QString k_FileSize("FileSize");
+const QString k_LastModified("LastModified");
+const QString k_PluginName("PluginName");
+const QString k_FiltersKnown("FiltersKnown");
+const QString k_LoadTime("LoadTime");
+const QString k_Filters("Filters");
+const QString k_ClassName("ClassName");
+const QString k_Uuid("Uuid");
+const QString k_Group("Group");
+const QString k_SubGroup("SubGroup");
+const QString k_HumanLabel("HumanLabel");
+const QString k_BrandingString("BrandingString");
+const QString k_CompiledLibraryName("CompiledLibraryName");
+const QString k_DisplayName("DisplayName");
+const QString k_BaseName("BaseName");
+const QString k_PluginVersion("PluginVersion");
+const QString k_CompatibilityVersion("CompatibilityVersion");
+const QString k_Vendor("Vendor");
+const QString k_Url("URL");
+const QString k_Description("Description");
+const QString k_Copyright("Copyright");
+const QString k_License("License");
+const QString k_ThirdPartyLicenses("ThirdPartyLicenses");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PluginManifest::PluginManifest() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PluginManifest::~PluginManifest() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifest::DefaultFilePath()
+{
+  QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  return cacheDir + "/PluginManifest.json";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PluginManifest::FilterEntry PluginManifest::CreateFilterEntry(const QString& className, IFilterFactory::Pointer factory)
+{
+  FilterEntry entry;
+  entry.className = className;
+  entry.uuid = factory->getUuid();
+  entry.group = factory->getFilterGroup();
+  entry.subGroup = factory->getFilterSubGroup();
+  entry.humanLabel = factory->getFilterHumanLabel();
+  entry.brandingString = factory->getBrandingString();
+  entry.compiledLibraryName = factory->getCompiledLibraryName();
+  return entry;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PluginManifest::CopyPluginInfo(ISIMPLibPlugin* plugin, PluginEntry& entry)
+{
+  entry.displayName = plugin->getPluginDisplayName();
+  entry.baseName = plugin->getPluginBaseName();
+  entry.version = plugin->getVersion();
+  entry.compatibilityVersion = plugin->getCompatibilityVersion();
+  entry.vendor = plugin->getVendor();
+  entry.url = plugin->getURL();
+  entry.description = plugin->getDescription();
+  entry.copyright = plugin->getCopyright();
+  entry.license = plugin->getLicense();
+  entry.thirdPartyLicenses = plugin->getThirdPartyLicenses();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PluginManifest::readFile(const QString& filePath)
+{
+  m_Entries.clear();
+
+  QFile file(filePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return false;
+  }
+
+  QJsonParseError parseError;
+  QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+  if(parseError.error != QJsonParseError::NoError || !doc.isObject())
+  {
+    qDebug() << "Could not parse the plugin manifest" << filePath << ":" << parseError.errorString();
+    return false;
+  }
+
+  QJsonObject root = doc.object();
+  if(root[k_Version].toInt() != k_ManifestVersion)
+  {
+    return false;
+  }
+
+  QJsonArray plugins = root[k_Plugins].toArray();
+  for(const QJsonValue& pluginValue : plugins)
+  {
+    QJsonObject pluginObj = pluginValue.toObject();
+
+    PluginEntry entry;
+    entry.filePath = pluginObj[k_FilePath].toString();
+    entry.fileSize = static_cast<qint64>(pluginObj[k_FileSize].toDouble());
+    entry.lastModified = QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(pluginObj[k_LastModified].toDouble()));
+    entry.pluginName = pluginObj[k_PluginName].toString();
+    entry.filtersKnown = pluginObj[k_FiltersKnown].toBool();
+    entry.loadMSecs = static_cast<qint64>(pluginObj[k_LoadTime].toDouble());
+    entry.displayName = pluginObj[k_DisplayName].toString();
+    entry.baseName = pluginObj[k_BaseName].toString();
+    entry.version = pluginObj[k_PluginVersion].toString();
+    entry.compatibilityVersion = pluginObj[k_CompatibilityVersion].toString();
+    entry.vendor = pluginObj[k_Vendor].toString();
+    entry.url = pluginObj[k_Url].toString();
+    entry.description = pluginObj[k_Description].toString();
+    entry.copyright = pluginObj[k_Copyright].toString();
+    entry.license = pluginObj[k_License].toString();
+    QJsonObject licensesObj = pluginObj[k_ThirdPartyLicenses].toObject();
+    for(QJsonObject::const_iterator iter = licensesObj.constBegin(); iter != licensesObj.constEnd(); ++iter)
+    {
+      entry.thirdPartyLicenses.insert(iter.key(), iter.value().toString());
+    }
+
+    QJsonArray filters = pluginObj[k_Filters].toArray();
+    for(const QJsonValue& filterValue : filters)
+    {
+      QJsonObject filterObj = filterValue.toObject();
+
+      FilterEntry filterEntry;
+      filterEntry.className = filterObj[k_ClassName].toString();
+      filterEntry.uuid = QUuid(filterObj[k_Uuid].toString());
+      filterEntry.group = filterObj[k_Group].toString();
+      filterEntry.subGroup = filterObj[k_SubGroup].toString();
+      filterEntry.humanLabel = filterObj[k_HumanLabel].toString();
+      filterEntry.brandingString = filterObj[k_BrandingString].toString();
+      filterEntry.compiledLibraryName = filterObj[k_CompiledLibraryName].toString();
+      entry.filters.push_back(filterEntry);
+    }
+
+    m_Entries.insert(entry.filePath, entry);
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PluginManifest::writeFile(const QString& filePath) const
+{
+  QJsonArray plugins;
+  for(const PluginEntry& entry : m_Entries)
+  {
+    QJsonArray filters;
+    for(const FilterEntry& filterEntry : entry.filters)
+    {
+      QJsonObject filterObj;
+      filterObj[k_ClassName] = filterEntry.className;
+      filterObj[k_Uuid] = filterEntry.uuid.toString();
+      filterObj[k_Group] = filterEntry.group;
+      filterObj[k_SubGroup] = filterEntry.subGroup;
+      filterObj[k_HumanLabel] = filterEntry.humanLabel;
+      filterObj[k_BrandingString] = filterEntry.brandingString;
+      filterObj[k_CompiledLibraryName] = filterEntry.compiledLibraryName;
+      filters.push_back(filterObj);
+    }
+
+    QJsonObject pluginObj;
+    pluginObj[k_FilePath] = entry.filePath;
+    pluginObj[k_FileSize] = static_cast<double>(entry.fileSize);
+    pluginObj[k_LastModified] = static_cast<double>(entry.lastModified.toMSecsSinceEpoch());
+    pluginObj[k_PluginName] = entry.pluginName;
+    pluginObj[k_FiltersKnown] = entry.filtersKnown;
+    pluginObj[k_LoadTime] = static_cast<double>(entry.loadMSecs);
+    pluginObj[k_DisplayName] = entry.displayName;
+    pluginObj[k_BaseName] = entry.baseName;
+    pluginObj[k_PluginVersion] = entry.version;
+    pluginObj[k_CompatibilityVersion] = entry.compatibilityVersion;
+    pluginObj[k_Vendor] = entry.vendor;
+    pluginObj[k_Url] = entry.url;
+    pluginObj[k_Description] = entry.description;
+    pluginObj[k_Copyright] = entry.copyright;
+    pluginObj[k_License] = entry.license;
+    QJsonObject licensesObj;
+    for(QMap<QString, QString>::const_iterator iter = entry.thirdPartyLicenses.constBegin(); iter != entry.thirdPartyLicenses.constEnd(); ++iter)
+    {
+      licensesObj[iter.key()] = iter.value();
+    }
+    pluginObj[k_ThirdPartyLicenses] = licensesObj;
+    pluginObj[k_Filters] = filters;
+    plugins.push_back(pluginObj);
+  }
+
+  QJsonObject root;
+  root[k_Version] = k_ManifestVersion;
+  root[k_Plugins] = plugins;
+
+  QFileInfo fi(filePath);
+  QDir().mkpath(fi.absolutePath());
+
+  // Write to a temporary file and swap it in so that a crash never leaves a truncated manifest behind
+  QSaveFile file(filePath);
+  if(!file.open(QIODevice::WriteOnly))
+  {
+    qDebug() << "Could not write the plugin manifest" << filePath;
+    return false;
+  }
+  file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+  return file.commit();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PluginManifest::isCurrent(const QString& pluginFilePath) const
+{
+  if(!m_Entries.contains(pluginFilePath))
+  {
+    return false;
+  }
+
+  const PluginEntry& entry = m_Entries[pluginFilePath];
+  QFileInfo fi(pluginFilePath);
+  return fi.exists() && fi.size() == entry.fileSize && fi.lastModified().toMSecsSinceEpoch() == entry.lastModified.toMSecsSinceEpoch();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PluginManifest::contains(const QString& pluginFilePath) const
+{
+  return m_Entries.contains(pluginFilePath);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PluginManifest::PluginEntry PluginManifest::entry(const QString& pluginFilePath) const
+{
+  return m_Entries.value(pluginFilePath);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PluginManifest::insert(PluginEntry entry)
+{
+  QFileInfo fi(entry.filePath);
+  entry.fileSize = fi.size();
+  entry.lastModified = fi.lastModified();
+  m_Entries.insert(entry.filePath, entry);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PluginManifest::retain(const QStringList& pluginFilePaths)
+{
+  QStringList keys = m_Entries.keys();
+  for(const QString& key : keys)
+  {
+    if(!pluginFilePaths.contains(key))
+    {
+      m_Entries.remove(key);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PluginManifest::clear()
+{
+  m_Entries.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QList<PluginManifest::PluginEntry> PluginManifest::entries() const
+{
+  return m_Entries.values();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PluginManifestFilterFactory::PluginManifestFilterFactory(const QString& pluginFilePath, const PluginManifest::FilterEntry& entry)
+: m_PluginFilePath(pluginFilePath)
+, m_Entry(entry)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PluginManifestFilterFactory::~PluginManifestFilterFactory() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer PluginManifestFilterFactory::create() const
+{
+  if(!dream3dApp->activatePlugin(m_PluginFilePath))
+  {
+    return AbstractFilter::NullPointer();
+  }
+
+  // Activating the plugin registered its real factory under the same class name
+  IFilterFactory::Pointer factory = FilterManager::Instance()->getFactoryFromClassName(m_Entry.className);
+  if(nullptr == factory || nullptr != std::dynamic_pointer_cast<PluginManifestFilterFactory>(factory))
+  {
+    qDebug() << "Plugin" << m_PluginFilePath << "no longer provides the filter" << m_Entry.className;
+    return AbstractFilter::NullPointer();
+  }
+
+  return factory->create();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestFilterFactory::getFilterGroup() const
+{
+  return m_Entry.group;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestFilterFactory::getFilterSubGroup() const
+{
+  return m_Entry.subGroup;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestFilterFactory::getFilterHumanLabel() const
+{
+  return m_Entry.humanLabel;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestFilterFactory::getBrandingString() const
+{
+  return m_Entry.brandingString;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestFilterFactory::getCompiledLibraryName() const
+{
+  return m_Entry.compiledLibraryName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QUuid PluginManifestFilterFactory::getUuid()
+{
+  return m_Entry.uuid;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestFilterFactory::getPluginFilePath() const
+{
+  return m_PluginFilePath;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PluginManifestPlugin::PluginManifestPlugin(const PluginManifest::PluginEntry& entry, bool didLoad)
+: m_Entry(entry)
+, m_Location(entry.filePath)
+, m_DidLoad(didLoad)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PluginManifestPlugin::~PluginManifestPlugin() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PluginManifestPlugin::setPlugin(ISIMPLibPlugin* plugin)
+{
+  m_Plugin = plugin;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ISIMPLibPlugin* PluginManifestPlugin::getPlugin() const
+{
+  return m_Plugin;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestPlugin::getPluginFilePath() const
+{
+  return m_Entry.filePath;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestPlugin::getPluginFileName()
+{
+  return (m_Plugin != nullptr) ? m_Plugin->getPluginFileName() : m_Entry.pluginName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestPlugin::getPluginDisplayName()
+{
+  return (m_Plugin != nullptr) ? m_Plugin->getPluginDisplayName() : m_Entry.displayName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestPlugin::getPluginBaseName()
+{
+  return (m_Plugin != nullptr) ? m_Plugin->getPluginBaseName() : m_Entry.baseName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestPlugin::getVersion()
+{
+  return (m_Plugin != nullptr) ? m_Plugin->getVersion() : m_Entry.version;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestPlugin::getCompatibilityVersion()
+{
+  return (m_Plugin != nullptr) ? m_Plugin->getCompatibilityVersion() : m_Entry.compatibilityVersion;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestPlugin::getVendor()
+{
+  return (m_Plugin != nullptr) ? m_Plugin->getVendor() : m_Entry.vendor;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestPlugin::getURL()
+{
+  return (m_Plugin != nullptr) ? m_Plugin->getURL() : m_Entry.url;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestPlugin::getDescription()
+{
+  return (m_Plugin != nullptr) ? m_Plugin->getDescription() : m_Entry.description;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestPlugin::getCopyright()
+{
+  return (m_Plugin != nullptr) ? m_Plugin->getCopyright() : m_Entry.copyright;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestPlugin::getLicense()
+{
+  return (m_Plugin != nullptr) ? m_Plugin->getLicense() : m_Entry.license;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PluginManifestPlugin::getLocation()
+{
+  return (m_Plugin != nullptr) ? m_Plugin->getLocation() : m_Location;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PluginManifestPlugin::setLocation(QString filePath)
+{
+  m_Location = filePath;
+  if(m_Plugin != nullptr)
+  {
+    m_Plugin->setLocation(filePath);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QMap<QString, QString> PluginManifestPlugin::getThirdPartyLicenses()
+{
+  return (m_Plugin != nullptr) ? m_Plugin->getThirdPartyLicenses() : m_Entry.thirdPartyLicenses;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PluginManifestPlugin::getDidLoad()
+{
+  return (m_Plugin != nullptr) ? m_Plugin->getDidLoad() : m_DidLoad;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PluginManifestPlugin::setDidLoad(bool didLoad)
+{
+  m_DidLoad = didLoad;
+  if(m_Plugin != nullptr)
+  {
+    m_Plugin->setDidLoad(didLoad);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PluginManifestPlugin::writeSettings(QSettings& prefs)
+{
+  if(m_Plugin != nullptr)
+  {
+    m_Plugin->writeSettings(prefs);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PluginManifestPlugin::readSettings(QSettings& prefs)
+{
+  if(m_Plugin != nullptr)
+  {
+    m_Plugin->readSettings(prefs);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PluginManifestPlugin::registerFilterWidgets(FilterWidgetManager* fwm)
+{
+  // Loading the plugin registers its filter widgets along with its filters
+  if(m_Plugin == nullptr)
+  {
+    dream3dApp->activatePlugin(m_Entry.filePath);
+    return;
+  }
+  m_Plugin->registerFilterWidgets(fwm);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PluginManifestPlugin::registerFilters(FilterManager* fm)
+{
+  if(m_Plugin == nullptr)
+  {
+    dream3dApp->activatePlugin(m_Entry.filePath);
+    return;
+  }
+  m_Plugin->registerFilters(fm);
+}
@@ -0,0 +1,299 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QDateTime>
+#include <QtCore/QList>
+#include <QtCore/QMap>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QUuid>
+
+#include "SIMPLib/Filtering/IFilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+
+/**
+ * @brief The PluginManifest class is an on-disk record of what each plugin file provides: the plugin
+ * name and the class name, UUID, group and human label of every filter that it registers. Entries are
+ * keyed by the absolute plugin path and are only valid while the size and modification time of the
+ * plugin file match what was recorded, so rebuilding or replacing a plugin invalidates its entry.
+ */
+class PluginManifest
+{
+public:
+  PluginManifest();
+  virtual ~PluginManifest();
+
+  struct FilterEntry
+  {
+    QString className;
+    QUuid uuid;
+    QString group;
+    QString subGroup;
+    QString humanLabel;
+    QString brandingString;
+    QString compiledLibraryName;
+  };
+
+  struct PluginEntry
+  {
+    QString filePath;
+    qint64 fileSize = 0;
+    QDateTime lastModified;
+    QString pluginName;
+    // False when the plugin was disabled at the time it was recorded and its filters were never registered
+    bool filtersKnown = false;
+    qint64 loadMSecs = 0;
+    QList<FilterEntry> filters;
+
+    // What the plugin tells about itself, answered while the plugin is not loaded
+    QString displayName;
+    QString baseName;
+    QString version;
+    QString compatibilityVersion;
+    QString vendor;
+    QString url;
+    QString description;
+    QString copyright;
+    QString license;
+    QMap<QString, QString> thirdPartyLicenses;
+  };
+
+  /**
+   * @brief DefaultFilePath
+   * @return The location of the manifest in the user's cache directory
+   */
+  static QString DefaultFilePath();
+
+  /**
+   * @brief CreateFilterEntry Extracts the manifest information from a registered filter factory
+   * @param className
+   * @param factory
+   * @return
+   */
+  static FilterEntry CreateFilterEntry(const QString& className, IFilterFactory::Pointer factory);
+
+  /**
+   * @brief CopyPluginInfo Copies the descriptive information of a loaded plugin into its entry
+   * @param plugin
+   * @param entry
+   */
+  static void CopyPluginInfo(ISIMPLibPlugin* plugin, PluginEntry& entry);
+
+  /**
+   * @brief readFile Replaces the contents of this manifest with the contents of the file at filePath
+   * @param filePath
+   * @return false if the file does not exist or could not be parsed
+   */
+  bool readFile(const QString& filePath);
+
+  /**
+   * @brief writeFile
+   * @param filePath
+   * @return
+   */
+  bool writeFile(const QString& filePath) const;
+
+  /**
+   * @brief isCurrent
+   * @param pluginFilePath
+   * @return true if there is an entry for pluginFilePath that matches the file currently on disk
+   */
+  bool isCurrent(const QString& pluginFilePath) const;
+
+  /**
+   * @brief contains
+   * @param pluginFilePath
+   * @return
+   */
+  bool contains(const QString& pluginFilePath) const;
+
+  /**
+   * @brief entry
+   * @param pluginFilePath
+   * @return
+   */
+  PluginEntry entry(const QString& pluginFilePath) const;
+
+  /**
+   * @brief insert Adds or replaces the entry for entry.filePath. The size and modification time are taken from the file system.
+   * @param entry
+   */
+  void insert(PluginEntry entry);
+
+  /**
+   * @brief retain Drops the entries of every plugin file that is not in pluginFilePaths
+   * @param pluginFilePaths
+   */
+  void retain(const QStringList& pluginFilePaths);
+
+  /**
+   * @brief clear
+   */
+  void clear();
+
+  /**
+   * @brief entries
+   * @return
+   */
+  QList<PluginEntry> entries() const;
+
+private:
+  QMap<QString, PluginEntry> m_Entries;
+
+  PluginManifest(const PluginManifest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const PluginManifest&) = delete; // Move assignment Not Implemented
+};
+
+/**
+ * @brief The PluginManifestFilterFactory class stands in for the real filter factory of a plugin that
+ * has not been loaded yet. It answers all of the descriptive queries from the manifest so that the
+ * filter list and filter library can be populated, and loads the owning plugin the first time a filter
+ * instance is requested. Loading the plugin replaces this factory in the FilterManager with the real one.
+ */
+class PluginManifestFilterFactory : public IFilterFactory
+{
+public:
+  SIMPL_SHARED_POINTERS(PluginManifestFilterFactory)
+
+  static Pointer New(const QString& pluginFilePath, const PluginManifest::FilterEntry& entry)
+  {
+    Pointer sharedPtr(new PluginManifestFilterFactory(pluginFilePath, entry));
+    return sharedPtr;
+  }
+
+  ~PluginManifestFilterFactory() override;
+
+  AbstractFilter::Pointer create() const override;
+
+  QString getFilterGroup() const override;
+
+  QString getFilterSubGroup() const override;
+
+  QString getFilterHumanLabel() const override;
+
+  QString getBrandingString() const override;
+
+  QString getCompiledLibraryName() const override;
+
+  QUuid getUuid() override;
+
+  /**
+   * @brief getPluginFilePath
+   * @return The plugin file that provides this filter
+   */
+  QString getPluginFilePath() const;
+
+protected:
+  PluginManifestFilterFactory(const QString& pluginFilePath, const PluginManifest::FilterEntry& entry);
+
+private:
+  QString m_PluginFilePath;
+  PluginManifest::FilterEntry m_Entry;
+
+  PluginManifestFilterFactory(const PluginManifestFilterFactory&) = delete; // Copy Constructor Not Implemented
+  void operator=(const PluginManifestFilterFactory&) = delete;              // Move assignment Not Implemented
+};
+
+/**
+ * @brief The PluginManifestPlugin class stands in for a plugin that has not been loaded yet, so that the
+ * PluginManager, the windows and the plugin dialogs know every plugin from the start. The descriptive queries
+ * are answered from the manifest. Registering the filters or filter widgets loads the plugin, and once it is
+ * loaded every call is passed on to it.
+ */
+class PluginManifestPlugin : public ISIMPLibPlugin
+{
+public:
+  PluginManifestPlugin(const PluginManifest::PluginEntry& entry, bool didLoad);
+  ~PluginManifestPlugin() override;
+
+  /**
+   * @brief setPlugin Passes every call on to the loaded plugin from now on
+   * @param plugin
+   */
+  void setPlugin(ISIMPLibPlugin* plugin);
+
+  /**
+   * @brief getPlugin
+   * @return The loaded plugin, or nullptr while it is deferred
+   */
+  ISIMPLibPlugin* getPlugin() const;
+
+  /**
+   * @brief getPluginFilePath
+   * @return
+   */
+  QString getPluginFilePath() const;
+
+  QString getPluginFileName() override;
+  QString getPluginDisplayName() override;
+  QString getPluginBaseName() override;
+  QString getVersion() override;
+  QString getCompatibilityVersion() override;
+  QString getVendor() override;
+  QString getURL() override;
+  QString getLocation() override;
+  void setLocation(QString filePath) override;
+  QString getDescription() override;
+  QString getCopyright() override;
+  QString getLicense() override;
+  QMap<QString, QString> getThirdPartyLicenses() override;
+  bool getDidLoad() override;
+  void setDidLoad(bool didLoad) override;
+  void writeSettings(QSettings& prefs) override;
+  void readSettings(QSettings& prefs) override;
+
+  /**
+   * @brief registerFilterWidgets Loads the plugin, which registers its filter widgets and filters
+   * @param fwm
+   */
+  void registerFilterWidgets(FilterWidgetManager* fwm) override;
+
+  /**
+   * @brief registerFilters Loads the plugin, which registers its filter widgets and filters
+   * @param fm
+   */
+  void registerFilters(FilterManager* fm) override;
+
+private:
+  PluginManifest::PluginEntry m_Entry;
+  ISIMPLibPlugin* m_Plugin = nullptr;
+  QString m_Location;
+  bool m_DidLoad = false;
+
+  PluginManifestPlugin(const PluginManifestPlugin&) = delete; // Copy Constructor Not Implemented
+  void operator=(const PluginManifestPlugin&) = delete;       // Move assignment Not Implemented
+};
@@ -0,0 +1,318 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ProcessStats.h"
+
+#include <chrono>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QList>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#include <tlhelp32.h>
+#elif defined(Q_OS_MAC)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ProcessStats::ProcessStats() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ProcessStats::ResidentBytes()
+{
+#if defined(Q_OS_WIN)
+  PROCESS_MEMORY_COUNTERS counters;
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+  {
+    return static_cast<qint64>(counters.WorkingSetSize);
+  }
+  return 0;
+#elif defined(Q_OS_MAC)
+  mach_task_basic_info info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS)
+  {
+    return static_cast<qint64>(info.resident_size);
+  }
+  return 0;
+#else
+  QFile statm("/proc/self/statm");
+  if(!statm.open(QIODevice::ReadOnly))
+  {
+    return 0;
+  }
+  QList<QByteArray> fields = statm.readAll().split(' ');
+  if(fields.size() < 2)
+  {
+    return 0;
+  }
+  return fields[1].toLongLong() * static_cast<qint64>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ProcessStats::CpuTimeMSecs()
+{
+#if defined(Q_OS_WIN)
+  FILETIME creationTime;
+  FILETIME exitTime;
+  FILETIME kernelTime;
+  FILETIME userTime;
+  if(!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+  {
+    return 0;
+  }
+  // FILETIME counts 100 nanosecond intervals
+  quint64 kernel = (static_cast<quint64>(kernelTime.dwHighDateTime) << 32) | kernelTime.dwLowDateTime;
+  quint64 user = (static_cast<quint64>(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime;
+  return static_cast<qint64>((kernel + user) / 10000);
+#else
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) != 0)
+  {
+    return 0;
+  }
+  qint64 msecs = static_cast<qint64>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000;
+  msecs += static_cast<qint64>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000;
+  return msecs;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ProcessStats::ThreadCount()
+{
+#if defined(Q_OS_WIN)
+  HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+  if(snapshot == INVALID_HANDLE_VALUE)
+  {
+    return 0;
+  }
+  int count = 0;
+  DWORD processId = GetCurrentProcessId();
+  THREADENTRY32 entry;
+  entry.dwSize = sizeof(entry);
+  if(Thread32First(snapshot, &entry))
+  {
+    do
+    {
+      if(entry.th32OwnerProcessID == processId)
+      {
+        count++;
+      }
+    } while(Thread32Next(snapshot, &entry));
+  }
+  CloseHandle(snapshot);
+  return count;
+#elif defined(Q_OS_MAC)
+  thread_act_array_t threads;
+  mach_msg_type_number_t count = 0;
+  if(task_threads(mach_task_self(), &threads, &count) != KERN_SUCCESS)
+  {
+    return 0;
+  }
+  for(mach_msg_type_number_t i = 0; i < count; i++)
+  {
+    mach_port_deallocate(mach_task_self(), threads[i]);
+  }
+  vm_deallocate(mach_task_self(), reinterpret_cast<vm_address_t>(threads), sizeof(thread_act_t) * count);
+  return static_cast<int>(count);
+#else
+  QFile status("/proc/self/status");
+  if(!status.open(QIODevice::ReadOnly))
+  {
+    return 0;
+  }
+  for(const QByteArray& line : status.readAll().split('\n'))
+  {
+    if(line.startsWith("Threads:"))
+    {
+      return line.mid(8).trimmed().toInt();
+    }
+  }
+  return 0;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ProcessStats::AvailableMemoryBytes()
+{
+#if defined(Q_OS_WIN)
+  MEMORYSTATUSEX status;
+  status.dwLength = sizeof(status);
+  if(GlobalMemoryStatusEx(&status))
+  {
+    return static_cast<qint64>(status.ullAvailPhys);
+  }
+  return 0;
+#elif defined(Q_OS_MAC)
+  // Inactive pages are handed out before anything is swapped
+  vm_statistics64_data_t stats;
+  mach_msg_type_number_t count = HOST_VM_INFO64_COUNT;
+  if(host_statistics64(mach_host_self(), HOST_VM_INFO64, reinterpret_cast<host_info64_t>(&stats), &count) == KERN_SUCCESS)
+  {
+    return static_cast<qint64>(stats.free_count + stats.inactive_count) * static_cast<qint64>(vm_page_size);
+  }
+  return 0;
+#else
+  QFile meminfo("/proc/meminfo");
+  if(!meminfo.open(QIODevice::ReadOnly))
+  {
+    return 0;
+  }
+  for(const QByteArray& line : meminfo.readAll().split('\n'))
+  {
+    if(line.startsWith("MemAvailable:"))
+    {
+      return line.mid(13).trimmed().split(' ').first().toLongLong() * 1024;
+    }
+  }
+  return 0;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ProcessStats::FormatBytes(qint64 bytes)
+{
+  const double kiB = 1024.0;
+  if(qAbs(bytes) < kiB * kiB)
+  {
+    return QString("%1 KB").arg(bytes / kiB, 0, 'f', 1);
+  }
+  if(qAbs(bytes) < kiB * kiB * kiB)
+  {
+    return QString("%1 MB").arg(bytes / (kiB * kiB), 0, 'f', 1);
+  }
+  return QString("%1 GB").arg(bytes / (kiB * kiB * kiB), 0, 'f', 2);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ProcessSampler::ProcessSampler(int intervalMSecs)
+: m_IntervalMSecs(intervalMSecs)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ProcessSampler::~ProcessSampler()
+{
+  stop();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ProcessSampler::start()
+{
+  m_PeakResidentBytes = ProcessStats::ResidentBytes();
+  m_PeakThreadCount = ProcessStats::ThreadCount();
+  m_Running = true;
+  m_Thread = std::thread([this] {
+    while(m_Running)
+    {
+      sample();
+      std::this_thread::sleep_for(std::chrono::milliseconds(m_IntervalMSecs));
+    }
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ProcessSampler::stop()
+{
+  if(m_Thread.joinable())
+  {
+    m_Running = false;
+    m_Thread.join();
+    sample();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ProcessSampler::sample()
+{
+  qint64 resident = ProcessStats::ResidentBytes();
+  qint64 peakResident = m_PeakResidentBytes;
+  while(resident > peakResident && !m_PeakResidentBytes.compare_exchange_weak(peakResident, resident))
+  {
+  }
+
+  // The sampling thread is not one of the threads being measured
+  int threads = ProcessStats::ThreadCount() - (m_Running ? 1 : 0);
+  int peakThreads = m_PeakThreadCount;
+  while(threads > peakThreads && !m_PeakThreadCount.compare_exchange_weak(peakThreads, threads))
+  {
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ProcessSampler::getPeakResidentBytes() const
+{
+  return m_PeakResidentBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ProcessSampler::getPeakThreadCount() const
+{
+  return m_PeakThreadCount;
+}
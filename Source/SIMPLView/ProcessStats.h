@@ -0,0 +1,134 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+#include <QtCore/QString>
+#include <QtCore/QtGlobal>
+
+/**
+ * @brief The ProcessStats class reads resource usage of the running process: resident memory,
+ * CPU time and the number of threads. A value that can not be read on the platform is returned as 0.
+ */
+class ProcessStats
+{
+public:
+  /**
+   * @brief ResidentBytes
+   * @return The resident memory of this process in bytes
+   */
+  static qint64 ResidentBytes();
+
+  /**
+   * @brief CpuTimeMSecs
+   * @return The user and system CPU time that all threads of this process have used so far
+   */
+  static qint64 CpuTimeMSecs();
+
+  /**
+   * @brief ThreadCount
+   * @return The number of threads of this process
+   */
+  static int ThreadCount();
+
+  /**
+   * @brief AvailableMemoryBytes
+   * @return The physical memory of the machine that is available to new allocations without swapping
+   */
+  static qint64 AvailableMemoryBytes();
+
+  /**
+   * @brief FormatBytes
+   * @param bytes
+   * @return The bytes in KB, MB or GB, whichever reads best
+   */
+  static QString FormatBytes(qint64 bytes);
+
+protected:
+  ProcessStats();
+
+private:
+  ProcessStats(const ProcessStats&) = delete;   // Copy Constructor Not Implemented
+  void operator=(const ProcessStats&) = delete; // Move assignment Not Implemented
+};
+
+/**
+ * @brief The ProcessSampler class polls the resident memory and the thread count on a background
+ * thread so that the peaks while a single filter executes can be reported.
+ */
+class ProcessSampler
+{
+public:
+  ProcessSampler(int intervalMSecs = 5);
+  ~ProcessSampler();
+
+  /**
+   * @brief start Takes the first sample and starts polling
+   */
+  void start();
+
+  /**
+   * @brief stop Stops polling and takes a last sample
+   */
+  void stop();
+
+  /**
+   * @brief getPeakResidentBytes
+   * @return
+   */
+  qint64 getPeakResidentBytes() const;
+
+  /**
+   * @brief getPeakThreadCount
+   * @return The peak, not counting the sampling thread itself
+   */
+  int getPeakThreadCount() const;
+
+protected:
+  void sample();
+
+private:
+  int m_IntervalMSecs = 5;
+  std::atomic<bool> m_Running{false};
+  std::atomic<qint64> m_PeakResidentBytes{0};
+  std::atomic<int> m_PeakThreadCount{0};
+  std::thread m_Thread;
+
+  ProcessSampler(const ProcessSampler&) = delete;   // Copy Constructor Not Implemented
+  void operator=(const ProcessSampler&) = delete; // Move assignment Not Implemented
+};
@@ -0,0 +1,139 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ProfilerItemDelegate.h"
+
+#include <QtGui/QPainter>
+
+#include "SVWidgetsLib/Widgets/PipelineModel.h"
+#include "SVWidgetsLib/Widgets/SVPipelineView.h"
+
+#include "SIMPLView/PipelineProfiler.h"
+
+namespace
+{
+const int k_HeatStripWidth = 6;
+const int k_StageMarkRadius = 4;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ProfilerItemDelegate::ProfilerItemDelegate(SVPipelineView* view, PipelineProfiler* profiler)
+: PipelineItemDelegate(view)
+, m_View(view)
+, m_Profiler(profiler)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ProfilerItemDelegate::~ProfilerItemDelegate() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ProfilerItemDelegate::setHeatMapEnabled(bool enabled)
+{
+  m_HeatMapEnabled = enabled;
+  m_View->viewport()->update();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ProfilerItemDelegate::isHeatMapEnabled() const
+{
+  return m_HeatMapEnabled;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ProfilerItemDelegate::setStageStates(const QVector<StageState>& states)
+{
+  m_StageStates = states;
+  m_View->viewport()->update();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ProfilerItemDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+  PipelineItemDelegate::paint(painter, option, index);
+
+  StageState stageState = (index.row() < m_StageStates.size()) ? m_StageStates[index.row()] : StageState::None;
+  if(stageState != StageState::None)
+  {
+    // A filled dot for a cached result, an empty one for a result that the last edit invalidated
+    QPoint center(option.rect.right() - 3 * k_StageMarkRadius, option.rect.center().y());
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    if(stageState == StageState::Cached)
+    {
+      painter->setPen(Qt::NoPen);
+      painter->setBrush(QColor(0, 120, 215));
+    }
+    else
+    {
+      painter->setPen(QPen(QColor(150, 150, 150), 1.5));
+      painter->setBrush(Qt::NoBrush);
+    }
+    painter->drawEllipse(center, k_StageMarkRadius, k_StageMarkRadius);
+    painter->restore();
+  }
+
+  if(!m_HeatMapEnabled)
+  {
+    return;
+  }
+
+  double heat = m_Profiler->getHeat(index.row());
+  if(heat < 0.0)
+  {
+    return;
+  }
+
+  // Green for the fastest filters through yellow to red for the slowest one
+  QColor color = QColor::fromHsvF((1.0 - heat) / 3.0, 0.85, 0.9);
+
+  painter->save();
+  painter->fillRect(QRect(option.rect.left(), option.rect.top(), k_HeatStripWidth, option.rect.height()), color);
+  color.setAlphaF(0.25 * heat);
+  painter->fillRect(option.rect, color);
+  painter->restore();
+}
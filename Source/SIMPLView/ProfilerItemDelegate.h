@@ -0,0 +1,94 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QVector>
+
+#include "SVWidgetsLib/Widgets/PipelineItemDelegate.h"
+
+class PipelineProfiler;
+class SVPipelineView;
+
+/**
+ * @brief The ProfilerItemDelegate class paints the pipeline items as usual and, while the heat map is
+ * switched on, marks each executed filter with a color between green and red by how long it took
+ * compared to the slowest filter of the last run. It also marks the filters whose result is in the
+ * StageCache, and those whose cached result was invalidated by an edit of the pipeline.
+ */
+class ProfilerItemDelegate : public PipelineItemDelegate
+{
+  Q_OBJECT
+
+public:
+  enum class StageState : int
+  {
+    None = 0,
+    Cached,
+    Invalidated
+  };
+
+  ProfilerItemDelegate(SVPipelineView* view, PipelineProfiler* profiler);
+  ~ProfilerItemDelegate() override;
+
+  /**
+   * @brief setHeatMapEnabled
+   * @param enabled
+   */
+  void setHeatMapEnabled(bool enabled);
+
+  /**
+   * @brief isHeatMapEnabled
+   * @return
+   */
+  bool isHeatMapEnabled() const;
+
+  /**
+   * @brief setStageStates
+   * @param states One state per pipeline row
+   */
+  void setStageStates(const QVector<StageState>& states);
+
+  void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+private:
+  SVPipelineView* m_View = nullptr;
+  PipelineProfiler* m_Profiler = nullptr;
+  bool m_HeatMapEnabled = true;
+  QVector<StageState> m_StageStates;
+
+  ProfilerItemDelegate(const ProfilerItemDelegate&) = delete; // Copy Constructor Not Implemented
+  void operator=(const ProfilerItemDelegate&) = delete;       // Move assignment Not Implemented
+};
@@ -38,19 +38,35 @@
 #include <unistd.h>
 #endif
 
-#include <ctime>
+#include <algorithm>
+#include <memory>
 #include <iostream>
 
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QEventLoop>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutexLocker>
 #include <QtCore/QPluginLoader>
 #include <QtCore/QProcess>
 #include <QtCore/QThread>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QThreadPool>
+#include <QtCore/QTimer>
 
 #include <QtGui/QBitmap>
 #include <QtGui/QBitmap>
 #include <QtGui/QClipboard>
 #include <QtGui/QDesktopServices>
+#include <QtGui/QFontDatabase>
 #include <QtGui/QIcon>
 #include <QtGui/QScreen>
+#include <QtNetwork/QLocalServer>
+#include <QtNetwork/QLocalSocket>
 #include <QtWidgets/QFileDialog>
 #include <QtWidgets/QSplashScreen>
 
@@ -80,12 +96,23 @@
 #include "SVWidgetsLib/Widgets/SVStyle.h"
 
 #include "SIMPLView/AboutSIMPLView.h"
+#include "SIMPLView/BatchQueue.h"
+#include "SIMPLView/DisabledPluginFilterFactory.h"
 #include "SIMPLView/SIMPLView_UI.h"
 #include "SIMPLView/SIMPLViewVersion.h"
 #include "SIMPLView/SIMPLViewConstants.h"
+#include "SIMPLView/SettingsStore.h"
+#include "SIMPLView/StartupTracer.h"
+#include "SIMPLView/WorkerPool.h"
 
 #include "BrandedStrings.h"
 
+namespace
+{
+// The key that QtSRecentFileList::readList() reads the recent files from; they are written through the SettingsStore
+const QString k_RecentFilesKey("Recent Files");
+}
+
 namespace Detail
 {
 
@@ -104,6 +131,35 @@ void fillVersionData(UpdateCheck::SIMPLVersionData_t& data)
   data.buildDate = SIMPLView::Version::BuildDate();
   data.appName = BrandedStrings::ApplicationName;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void initFonts(const QStringList& fontList)
+{
+  int fontID(-1);
+
+  for(QStringList::const_iterator constIterator = fontList.constBegin(); constIterator != fontList.constEnd(); ++constIterator)
+  {
+    QFile res(*constIterator);
+    // qDebug() << "font path: " << res.fileName();
+    if(res.open(QIODevice::ReadOnly) == false)
+    {
+      qDebug() << "ERROR opening font resource: " << res.fileName();
+    }
+
+    else
+    {
+      fontID = QFontDatabase::addApplicationFontFromData(res.readAll());
+      // qDebug() << "loading font Id " << fontID;
+      if(fontID == -1)
+      {
+        qDebug() << "ERROR loading font id: " << fontID;
+      }
+      res.close();
+    }
+  }
+}
 }
 
 // -----------------------------------------------------------------------------
@@ -120,15 +176,16 @@ SIMPLViewApplication::SIMPLViewApplication(int& argc, char** argv)
   // Automatically check for updates at startup if the user has indicated that preference before
   checkForUpdatesAtStartup();
 
-  // Initialize the Default Stylesheet
-  SVStyle* style = SVStyle::Instance();
-  QString defaultLoadedThemePath = BrandedStrings::DefaultStyleDirectory + "/" + BrandedStrings::DefaultLoadedTheme + ".json";
-  style->loadStyleSheet(defaultLoadedThemePath);
-
-  readSettings();
+  {
+    StartupTraceScope traceScope("SIMPLViewApplication::readSettings");
+    readSettings();
+  }
 
   // Create the default menu bar
-  createDefaultMenuBar();
+  {
+    StartupTraceScope traceScope("SIMPLViewApplication::createDefaultMenuBar");
+    createDefaultMenuBar();
+  }
 
   // If on Mac, add custom actions to a dock menu
 #if defined(Q_OS_MAC)
@@ -139,6 +196,7 @@ SIMPLViewApplication::SIMPLViewApplication(int& argc, char** argv)
   QtSRecentFileList* recentsList = QtSRecentFileList::Instance();
   QObject::connect(recentsList, &QtSRecentFileList::fileListChanged, this, &SIMPLViewApplication::updateRecentFileList);
 
+  StartupTraceScope traceScope("QtSRecentFileList::readList");
   QSharedPointer<QtSSettings> prefs = QSharedPointer<QtSSettings>(new QtSSettings());
   QtSRecentFileList::Instance()->readList(prefs.data());
 }
@@ -148,6 +206,13 @@ SIMPLViewApplication::SIMPLViewApplication(int& argc, char** argv)
 // -----------------------------------------------------------------------------
 SIMPLViewApplication::~SIMPLViewApplication()
 {
+  // Stop the batch jobs before the plugins that their filters come from are unloaded
+  BatchQueue::Instance()->shutdown();
+  WorkerPool::Instance()->shutdown();
+
+  delete m_ReserveWindow;
+  m_ReserveWindow = nullptr;
+
   delete this->m_SplashScreen;
   this->m_SplashScreen = nullptr;
 
@@ -155,9 +220,18 @@ SIMPLViewApplication::~SIMPLViewApplication()
   {
     delete m_PluginLoaders[i];
   }
+  qDeleteAll(m_ManifestPlugins);
+  m_ManifestPlugins.clear();
 
   writeSettings();
 
+  // Everything still waiting in the settings store has to reach the file before we exit
+  SettingsStore* settingsStore = SettingsStore::Instance();
+  settingsStore->flush();
+  settingsStore->waitForFlush();
+  settingsStore->printStatistics();
+  SettingsStore::DeleteInstance();
+
   QtSSettings prefs;
   if(prefs.value("Program Mode", QString("")) == "Reset Preferences")
   {
@@ -204,9 +278,11 @@ bool SIMPLViewApplication::initialize(int argc, char* argv[])
 
   this->m_SplashScreen = new QSplashScreen(pixmap);
   this->m_SplashScreen->show();
+  QApplication::instance()->processEvents();
 
-  // start timer;
-  std::clock_t startClock = std::clock();
+  // Wall clock time, so that the time spent waiting on disk while loading plugins is counted
+  m_SplashTimer.start();
+  m_SplashStartUSecs = StartupTracer::Instance()->now();
 
   QDir dir(QApplication::applicationDirPath());
 
@@ -226,47 +302,274 @@ bool SIMPLViewApplication::initialize(int argc, char* argv[])
 #endif
   QApplication::addLibraryPath(dir.absolutePath());
 
-  QMetaObjectUtilities::RegisterMetaTypes();
+  // Listen before the slow part of the startup so that files opened in the meantime are not sent to a second process
+  if(SingleInstanceEnabled())
+  {
+    startSingleInstanceServer();
+  }
+
+  // The plugin libraries are instantiated on a worker thread while the main thread gets on with the
+  // startup work that does not depend on them. Only the registration of the plugins has to wait.
+  {
+    StartupTraceScope traceScope("SIMPLViewApplication::startLoadingPlugins");
+    startLoadingPlugins();
+  }
+
+  {
+    StartupTraceScope traceScope("QMetaObjectUtilities::RegisterMetaTypes");
+    QMetaObjectUtilities::RegisterMetaTypes();
+  }
+
+  // Load the theme from the preferences, or the default theme if there is none
+  {
+    StartupTraceScope traceScope("SIMPLViewApplication::loadTheme");
+    QString themeFilePath = m_StartupThemeFilePath;
+    if(themeFilePath.isEmpty())
+    {
+      themeFilePath = BrandedStrings::DefaultStyleDirectory + "/" + BrandedStrings::DefaultLoadedTheme + ".json";
+    }
+    loadTheme(themeFilePath);
+  }
+
+  {
+    StartupTraceScope traceScope("SIMPLViewApplication::loadFonts");
+    loadFonts();
+  }
 
   // Load application plugins.
-  QVector<ISIMPLibPlugin*> plugins = loadPlugins();
+  QVector<ISIMPLibPlugin*> plugins;
+  {
+    StartupTraceScope traceScope("SIMPLViewApplication::loadPlugins");
+    plugins = loadPlugins();
+  }
 
-  // give GUI components time to update before the mainwindow is shown
-  QApplication::instance()->processEvents();
+  // The splash screen stays up over the first window until the minimum duration of an official release has
+  // passed. Nothing waits on it, so the first window is shown as soon as it has been created.
+  int remainingSplashMSecs = 0;
   if(m_ShowSplash)
   {
-    //   delay(1);
-    // if official release, enforce the minimum duration for splash screen
     QString releaseType = QString::fromLatin1(SIMPLViewProj_RELEASE_TYPE);
     if(releaseType.compare("Official") == 0)
     {
-      double splashDuration = (std::clock() - startClock) / (double)CLOCKS_PER_SEC;
-      if(splashDuration < m_minSplashTime)
+      remainingSplashMSecs = static_cast<int>(std::max<qint64>(m_minSplashTime * 1000 - m_SplashTimer.elapsed(), 0));
+    }
+    this->m_SplashScreen->showMessage(QString(""), Qt::AlignVCenter | Qt::AlignRight, Qt::white);
+  }
+  QTimer::singleShot(remainingSplashMSecs, this, &SIMPLViewApplication::finishSplashScreen);
+
+  // Files that were handed over during the startup are opened once the first window is up
+  m_StartupFinished = true;
+  QTimer::singleShot(0, this, &SIMPLViewApplication::openPendingFiles);
+
+  scheduleReserveWindow();
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLViewApplication::SingleInstanceEnabled()
+{
+  QByteArray singleInstanceEnv = qgetenv("SIMPL_SINGLE_INSTANCE");
+  if(!singleInstanceEnv.isEmpty())
+  {
+    return (singleInstanceEnv != "0");
+  }
+
+  QtSSettings prefs;
+  prefs.beginGroup("Application Settings");
+  bool enabled = prefs.value("Single Instance", true).toBool();
+  prefs.endGroup();
+  return enabled;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString SIMPLViewApplication::SingleInstanceServerName()
+{
+  // Local socket names are shared by all of the users of a machine, so make the name unique per user
+  QByteArray userHash = QCryptographicHash::hash(QDir::homePath().toUtf8(), QCryptographicHash::Sha1).toHex().left(12);
+  return QString("%1-%2").arg(BrandedStrings::ApplicationName, QString::fromLatin1(userHash));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLViewApplication::SendFileToRunningInstance(const QString& filePath, int timeoutMSecs)
+{
+  QElapsedTimer timer;
+  timer.start();
+
+  QLocalSocket socket;
+  socket.connectToServer(SingleInstanceServerName());
+  if(!socket.waitForConnected(timeoutMSecs))
+  {
+    return false;
+  }
+
+  // The running instance has a different working directory
+  QByteArray message = QFileInfo(filePath).absoluteFilePath().toUtf8() + '\n';
+  socket.write(message);
+  if(!socket.waitForBytesWritten(timeoutMSecs))
+  {
+    return false;
+  }
+
+  // A single byte comes back once the file has been queued for opening
+  if(!socket.waitForReadyRead(timeoutMSecs) || socket.read(1) != "1")
+  {
+    qDebug() << "The running instance did not accept" << filePath;
+    return false;
+  }
+  socket.disconnectFromServer();
+
+  qDebug() << "Handed" << filePath << "to the running instance in" << timer.elapsed() << "ms";
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::startSingleInstanceServer()
+{
+  QString serverName = SingleInstanceServerName();
+
+  m_SingleInstanceServer = new QLocalServer(this);
+  m_SingleInstanceServer->setSocketOptions(QLocalServer::UserAccessOption);
+  if(!m_SingleInstanceServer->listen(serverName))
+  {
+    // A server that nobody answers on was left behind by a crashed instance
+    QLocalSocket probe;
+    probe.connectToServer(serverName);
+    if(probe.waitForConnected(100))
+    {
+      qDebug() << "Another instance is already serving" << serverName;
+      delete m_SingleInstanceServer;
+      m_SingleInstanceServer = nullptr;
+      return;
+    }
+
+    QLocalServer::removeServer(serverName);
+    if(!m_SingleInstanceServer->listen(serverName))
+    {
+      qDebug() << "Could not listen on" << serverName << ":" << m_SingleInstanceServer->errorString();
+      delete m_SingleInstanceServer;
+      m_SingleInstanceServer = nullptr;
+      return;
+    }
+  }
+
+  connect(m_SingleInstanceServer, &QLocalServer::newConnection, this, &SIMPLViewApplication::handleSingleInstanceConnection);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::handleSingleInstanceConnection()
+{
+  while(m_SingleInstanceServer->hasPendingConnections())
+  {
+    QLocalSocket* socket = m_SingleInstanceServer->nextPendingConnection();
+    connect(socket, &QLocalSocket::disconnected, socket, &QLocalSocket::deleteLater);
+    connect(socket, &QLocalSocket::readyRead, this, [this, socket] {
+      if(!socket->canReadLine())
       {
-        QString msg = QObject::tr("");
-        this->m_SplashScreen->showMessage(msg, Qt::AlignVCenter | Qt::AlignRight, Qt::white);
+        return;
+      }
+
+      QString filePath = QString::fromUtf8(socket->readLine()).trimmed();
+      socket->write("1");
+      socket->flush();
 
-        unsigned long extendedDuration = static_cast<unsigned long>((m_minSplashTime - splashDuration) * 1000);
-        QThread::msleep(extendedDuration);
+      qDebug() << "Received" << filePath << "from another launch";
+      m_PendingFileOpens.push_back(filePath);
+      if(m_StartupFinished)
+      {
+        // Answer the other process first; it is waiting to exit
+        QTimer::singleShot(0, this, &SIMPLViewApplication::openPendingFiles);
       }
-    }
-    this->m_SplashScreen->finish(nullptr);
+    });
   }
-  QApplication::instance()->processEvents();
+}
 
-  return true;
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::openPendingFiles()
+{
+  QStringList filePaths = m_PendingFileOpens;
+  m_PendingFileOpens.clear();
+  for(const QString& filePath : filePaths)
+  {
+    SIMPLView_UI* ui = newInstanceFromFile(filePath);
+    ui->raise();
+    ui->activateWindow();
+  }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-QVector<ISIMPLibPlugin*> SIMPLViewApplication::loadPlugins()
+void SIMPLViewApplication::finishSplashScreen()
+{
+  if(m_SplashScreen == nullptr || !m_SplashScreen->isVisible())
+  {
+    return;
+  }
+
+  // finish() waits until the window has been exposed so there is no gap between the splash and the window
+  m_SplashScreen->finish(m_ActiveWindow);
+
+  qDebug() << "Splash screen was shown for" << m_SplashTimer.elapsed() << "ms";
+  StartupTracer::Instance()->addSpan("Splash Screen", "Startup", m_SplashStartUSecs, StartupTracer::Instance()->now());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::loadFonts()
+{
+  // Load the default font from SIMPL
+  QString firaSansFontPath(":/SIMPL/fonts/FiraSans-Regular.ttf");
+  int id = QFontDatabase::addApplicationFont(firaSansFontPath);
+
+  /* On Linux builds this will always return -1 */
+  if(id >= 0)
+  {
+    QString family = QFontDatabase::applicationFontFamilies(id).at(0);
+
+    QFont defaultFont(family);
+    defaultFont.setPixelSize(12);
+    setFont(defaultFont);
+//    qDebug() << "Default Font Loaded: " << firaSansFontPath;
+  }
+  else
+  {
+    qDebug() << "ERROR LOADING DEFAULT FONT: " << firaSansFontPath;
+  }
+
+  // This is the single standard font that ships with the open-source version
+  {
+    QStringList fontList;
+    fontList << firaSansFontPath;
+    Detail::initFonts(fontList);
+  }
+
+  // Init any extra fonts that are needed by specialized versions of SIMPLView
+  Detail::initFonts(BrandedStrings::ExtraFonts);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList SIMPLViewApplication::findPluginFilePaths()
 {
   QStringList pluginDirs;
   pluginDirs << applicationDirPath();
 
   QDir aPluginDir = QDir(applicationDirPath());
-  qDebug() << "Loading " << BrandedStrings::ApplicationName << " Plugins....";
   QString thePath;
 
 #if defined(Q_OS_WIN)
@@ -338,115 +641,601 @@ QVector<ISIMPLibPlugin*> SIMPLViewApplication::loadPlugins()
   QByteArray pluginEnvPath = qgetenv("SIMPL_PLUGIN_PATH");
   qDebug() << "SIMPL_PLUGIN_PATH:" << pluginEnvPath;
 
-  char sep = ';';
-#if defined(Q_OS_WIN)
-  sep = ':';
-#endif
-  QList<QByteArray> envPaths = pluginEnvPath.split(sep);
-  foreach(QByteArray envPath, envPaths)
+  char sep = ';';
+#if defined(Q_OS_WIN)
+  sep = ':';
+#endif
+  QList<QByteArray> envPaths = pluginEnvPath.split(sep);
+  foreach(QByteArray envPath, envPaths)
+  {
+    if(envPath.size() > 0)
+    {
+      pluginDirs << QString::fromLatin1(envPath);
+    }
+  }
+
+  int dupes = pluginDirs.removeDuplicates();
+  qDebug() << "Removed " << dupes << " duplicate Plugin Paths";
+  QStringList pluginFilePaths;
+
+  foreach(QString pluginDirString, pluginDirs)
+  {
+    qDebug() << "Plugin Directory being Searched: " << pluginDirString;
+    aPluginDir = QDir(pluginDirString);
+    foreach(QString fileName, aPluginDir.entryList(QDir::Files))
+    {
+//   qDebug() << "File: " << fileName() << "\n";
+#ifdef QT_DEBUG
+      if(fileName.endsWith("_debug.guiplugin", Qt::CaseSensitive))
+#else
+      if(fileName.endsWith(".guiplugin", Qt::CaseSensitive)            // We want ONLY Release plugins
+         && !fileName.endsWith("_debug.guiplugin", Qt::CaseSensitive)) // so ignore these plugins
+#endif
+      {
+        pluginFilePaths << aPluginDir.absoluteFilePath(fileName);
+        // qWarning(aPluginDir.absoluteFilePath(fileName).toLatin1(), "%s");
+        // qDebug() << "Adding " << aPluginDir.absoluteFilePath(fileName)() << "\n";
+      }
+    }
+  }
+
+  return pluginFilePaths;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SIMPLViewApplication::PluginLoadRecord SIMPLViewApplication::LoadPluginFile(const QString& filePath)
+{
+  PluginLoadRecord record;
+  record.filePath = filePath;
+
+  StartupTraceScope traceScope("Load " + QFileInfo(filePath).fileName(), "Plugins");
+  QElapsedTimer timer;
+  timer.start();
+
+  record.loader = new QPluginLoader(filePath);
+  record.instance = record.loader->instance();
+  record.loadMSecs = timer.elapsed();
+
+  // Objects created on a pool thread would otherwise keep their affinity to that thread, so
+  // hand them over to the main thread where the plugin will be registered and used.
+  QThread* mainThread = QCoreApplication::instance()->thread();
+  if(QThread::currentThread() != mainThread)
+  {
+    if(record.instance != nullptr)
+    {
+      record.instance->moveToThread(mainThread);
+    }
+    record.loader->moveToThread(mainThread);
+  }
+
+  return record;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<SIMPLViewApplication::PluginLoadRecord> SIMPLViewApplication::LoadPluginFiles(const QStringList& filePaths)
+{
+  QVector<PluginLoadRecord> records;
+  for(const QString& filePath : filePaths)
+  {
+    records.push_back(LoadPluginFile(filePath));
+  }
+  return records;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<SIMPLViewApplication::PluginLoadRecord> SIMPLViewApplication::LoadPluginFilesConcurrently(const QStringList& filePaths)
+{
+  // The dynamic loader still serializes the static initializers of each library, but the plugin
+  // metadata scan, file I/O and dependency resolution of all the plugins overlap on the pool.
+  // QtConcurrent::blockingMapped keeps the results in the order of the input sequence.
+  return QtConcurrent::blockingMapped<QVector<PluginLoadRecord>>(filePaths, &SIMPLViewApplication::LoadPluginFile);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::registerPlugin(PluginLoadRecord& record, const QMap<QString, bool>& loadingMap)
+{
+  QPluginLoader* loader = record.loader;
+  QObject* plugin = record.instance;
+  QString path = record.filePath;
+  QString fileName = QFileInfo(path).fileName();
+
+  PluginManager* pluginManager = PluginManager::Instance();
+
+  // Plugins that were deferred through the manifest are registered after the splash screen is gone
+  bool splashVisible = (m_SplashScreen != nullptr && m_SplashScreen->isVisible());
+
+  qDebug() << "    Pointer: " << plugin << "\n";
+  if(plugin)
+  {
+    ISIMPLibPlugin* ipPlugin = qobject_cast<ISIMPLibPlugin*>(plugin);
+    if(ipPlugin)
+    {
+      QString pluginName = ipPlugin->getPluginFileName();
+      record.pluginName = pluginName;
+      if(loadingMap.value(pluginName, true) == true)
+      {
+        if(splashVisible)
+        {
+          QString msg = QObject::tr("Loading Plugin %1  ").arg(fileName);
+          this->m_SplashScreen->showMessage(msg, Qt::AlignVCenter | Qt::AlignRight, Qt::white);
+        }
+
+        StartupTraceScope traceScope("Register " + fileName, "Plugins");
+        QElapsedTimer timer;
+        timer.start();
+        // Remember which filters this plugin provides so that they can be written to the manifest
+        record.filterClassNames = registerPluginFilters(ipPlugin);
+        record.registerMSecs = timer.elapsed();
+        record.didRegister = true;
+      }
+      else
+      {
+        ipPlugin->setDidLoad(false);
+      }
+
+      ipPlugin->setLocation(path);
+
+      // A plugin that was deferred is already known to the PluginManager through its stand-in
+      PluginManifestPlugin* manifestPlugin = m_ManifestPlugins.value(path, nullptr);
+      if(manifestPlugin != nullptr)
+      {
+        manifestPlugin->setPlugin(ipPlugin);
+      }
+      else
+      {
+        pluginManager->addPlugin(ipPlugin);
+      }
+    }
+    m_PluginLoaders.push_back(loader);
+  }
+  else
+  {
+    if(splashVisible)
+    {
+      m_SplashScreen->hide();
+    }
+    QString message("The plugin did not load with the following error\n\n");
+    message.append(loader->errorString());
+    message.append("\n\n");
+    message.append("Possible causes include missing libraries that plugin depends on.");
+    QMessageBox box(QMessageBox::Critical, tr("Plugin Load Error"), tr(message.toStdString().c_str()));
+    box.setStandardButtons(QMessageBox::Ok | QMessageBox::Default);
+    box.setDefaultButton(QMessageBox::Ok);
+    box.setWindowFlags(box.windowFlags() | Qt::WindowStaysOnTopHint);
+    box.exec();
+    if(splashVisible)
+    {
+      m_SplashScreen->show();
+    }
+    delete loader;
+    record.loader = nullptr;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList SIMPLViewApplication::registerPluginFilters(ISIMPLibPlugin* plugin)
+{
+  FilterManager* filterManager = FilterManager::Instance();
+  FilterWidgetManager* fwm = FilterWidgetManager::Instance();
+
+  FilterManager::Collection factoriesBefore = filterManager->getFactories();
+  plugin->registerFilterWidgets(fwm);
+  plugin->registerFilters(filterManager);
+  plugin->setDidLoad(true);
+
+  QStringList classNames;
+  FilterManager::Collection factoriesAfter = filterManager->getFactories();
+  for(FilterManager::Collection::const_iterator iter = factoriesAfter.constBegin(); iter != factoriesAfter.constEnd(); ++iter)
+  {
+    if(factoriesBefore.value(iter.key()) != iter.value())
+    {
+      classNames.push_back(iter.key());
+    }
+  }
+
+  m_PluginFilterClassNames.insert(plugin->getPluginFileName(), classNames);
+  return classNames;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLViewApplication::registerPluginsFromManifest(const QStringList& pluginFilePaths)
+{
+  if(!m_PluginManifest.readFile(PluginManifest::DefaultFilePath()))
+  {
+    qDebug() << "No plugin manifest found at" << PluginManifest::DefaultFilePath();
+    return false;
+  }
+
+  for(const QString& path : pluginFilePaths)
+  {
+    if(!m_PluginManifest.isCurrent(path))
+    {
+      qDebug() << "The plugin manifest is out of date for" << path;
+      return false;
+    }
+
+    // A plugin that was disabled when the manifest was written never told us its filters
+    PluginManifest::PluginEntry entry = m_PluginManifest.entry(path);
+    if(m_PluginLoadingMap.value(entry.pluginName, true) && !entry.filtersKnown)
+    {
+      qDebug() << "The plugin manifest does not list the filters of" << path;
+      return false;
+    }
+  }
+
+  FilterManager* filterManager = FilterManager::Instance();
+  PluginManager* pluginManager = PluginManager::Instance();
+  for(const QString& path : pluginFilePaths)
+  {
+    PluginManifest::PluginEntry entry = m_PluginManifest.entry(path);
+
+    // The windows and the plugin dialogs see every plugin, loaded or not
+    PluginManifestPlugin* manifestPlugin = new PluginManifestPlugin(entry, m_PluginLoadingMap.value(entry.pluginName, true));
+    m_ManifestPlugins.insert(path, manifestPlugin);
+    pluginManager->addPlugin(manifestPlugin);
+
+    if(m_PluginLoadingMap.value(entry.pluginName, true))
+    {
+      QStringList classNames;
+      for(const PluginManifest::FilterEntry& filterEntry : entry.filters)
+      {
+        filterManager->addFilterFactory(filterEntry.className, PluginManifestFilterFactory::New(path, filterEntry));
+        classNames.push_back(filterEntry.className);
+      }
+      m_PluginFilterClassNames.insert(entry.pluginName, classNames);
+    }
+
+    QMutexLocker locker(&m_PluginActivationMutex);
+    m_DeferredPluginPaths.insert(path);
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::updatePluginManifest(const QStringList& pluginFilePaths, const QVector<PluginLoadRecord>& records)
+{
+  FilterManager* filterManager = FilterManager::Instance();
+
+  m_PluginManifest.retain(pluginFilePaths);
+  for(const PluginLoadRecord& record : records)
+  {
+    // Plugins that failed to load are left out so that the next launch loads them again and reports the error
+    if(record.loader == nullptr || record.instance == nullptr)
+    {
+      continue;
+    }
+
+    PluginManifest::PluginEntry entry;
+    entry.filePath = record.filePath;
+    entry.pluginName = record.pluginName;
+    entry.filtersKnown = record.didRegister;
+    entry.loadMSecs = record.loadMSecs + record.registerMSecs;
+    ISIMPLibPlugin* plugin = qobject_cast<ISIMPLibPlugin*>(record.instance);
+    if(plugin != nullptr)
+    {
+      PluginManifest::CopyPluginInfo(plugin, entry);
+    }
+    for(const QString& className : record.filterClassNames)
+    {
+      entry.filters.push_back(PluginManifest::CreateFilterEntry(className, filterManager->getFactoryFromClassName(className)));
+    }
+    m_PluginManifest.insert(entry);
+  }
+
+  m_PluginManifest.writeFile(PluginManifest::DefaultFilePath());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::printPluginLoadTimings(const QVector<PluginLoadRecord>& records)
+{
+  QVector<PluginLoadRecord> sorted = records;
+  std::sort(sorted.begin(), sorted.end(), [](const PluginLoadRecord& a, const PluginLoadRecord& b) {
+    return (a.loadMSecs + a.registerMSecs) > (b.loadMSecs + b.registerMSecs);
+  });
+
+  qDebug() << "Plugin Load Timings (ms):";
+  for(const PluginLoadRecord& record : sorted)
+  {
+    qDebug().noquote() << QString("  %1  load: %2  register: %3").arg(QFileInfo(record.filePath).fileName(), -40).arg(record.loadMSecs, 6).arg(record.registerMSecs, 6);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::startLoadingPlugins()
+{
+  qDebug() << "Loading " << BrandedStrings::ApplicationName << " Plugins....";
+  {
+    StartupTraceScope traceScope("SIMPLViewApplication::findPluginFilePaths");
+    m_PluginFilePaths = findPluginFilePaths();
+  }
+
+  QList<PluginProxy::Pointer> proxies = AboutPlugins::readPluginCache();
+  QMap<QString, bool> loadingMap;
+  for(QList<PluginProxy::Pointer>::iterator nameIter = proxies.begin(); nameIter != proxies.end(); nameIter++)
+  {
+    PluginProxy::Pointer proxy = *nameIter;
+    loadingMap.insert(proxy->getPluginName(), proxy->getEnabled());
+  }
+  m_PluginLoadingMap = loadingMap;
+
+  m_PluginLoadTimer.start();
+
+  // With a current manifest the filter list and library are populated without loading any plugin. Each
+  // plugin is then loaded the first time one of its filters is instantiated.
+  m_PluginsFromManifest = false;
+  if(m_UsePluginManifest)
+  {
+    StartupTraceScope traceScope("SIMPLViewApplication::registerPluginsFromManifest");
+    m_PluginsFromManifest = registerPluginsFromManifest(m_PluginFilePaths);
+  }
+
+  if(m_PluginsFromManifest)
+  {
+    return;
+  }
+
+  if(m_ParallelPluginLoading)
+  {
+    qDebug() << "Loading" << m_PluginFilePaths.size() << "plugins on" << QThreadPool::globalInstance()->maxThreadCount() << "threads";
+    m_PluginLoadFuture = QtConcurrent::run(&SIMPLViewApplication::LoadPluginFilesConcurrently, m_PluginFilePaths);
+  }
+  else
+  {
+    m_PluginLoadFuture = QtConcurrent::run(&SIMPLViewApplication::LoadPluginFiles, m_PluginFilePaths);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<ISIMPLibPlugin*> SIMPLViewApplication::loadPlugins()
+{
+  if(!m_PluginLoadTimer.isValid())
+  {
+    startLoadingPlugins();
+  }
+
+  FilterManager* filterManager = FilterManager::Instance();
+
+  // THIS IS A VERY IMPORTANT LINE: It will register all the known filters in the dream3d library. This
+  // will NOT however get filters from plugins. We are going to have to figure out how to compile filters
+  // into their own plugin and load the plugins from a command line.
+  {
+    StartupTraceScope traceScope("FilterManager::RegisterKnownFilters");
+    filterManager->RegisterKnownFilters(filterManager);
+  }
+
+  PluginManager* pluginManager = PluginManager::Instance();
+
+  if(m_PluginsFromManifest)
+  {
+    qint64 lastFullLoadMSecs = 0;
+    for(const PluginManifest::PluginEntry& entry : m_PluginManifest.entries())
+    {
+      lastFullLoadMSecs += entry.loadMSecs;
+    }
+    qDebug() << "Populated" << m_PluginFilePaths.size() << "plugins from the plugin manifest in" << m_PluginLoadTimer.elapsed() << "ms."
+             << "Loading them took" << lastFullLoadMSecs << "ms when the manifest was written.";
+    return pluginManager->getPluginsVector();
+  }
+
+  // Keep the splash screen responsive while the worker finishes instantiating the plugins
+  if(!m_PluginLoadFuture.isFinished())
+  {
+    StartupTraceScope traceScope("Wait For Plugin Files", "Plugins");
+    if(m_SplashScreen != nullptr)
+    {
+      QString msg = QObject::tr("Loading Plugins  ");
+      m_SplashScreen->showMessage(msg, Qt::AlignVCenter | Qt::AlignRight, Qt::white);
+    }
+
+    QFutureWatcher<QVector<PluginLoadRecord>> watcher;
+    QEventLoop eventLoop;
+    connect(&watcher, &QFutureWatcher<QVector<PluginLoadRecord>>::finished, &eventLoop, &QEventLoop::quit);
+    watcher.setFuture(m_PluginLoadFuture);
+    if(!watcher.isFinished())
+    {
+      eventLoop.exec();
+    }
+  }
+  QVector<PluginLoadRecord> records = m_PluginLoadFuture.result();
+  m_PluginLoadFuture = QFuture<QVector<PluginLoadRecord>>();
+
+  // Now that we have a sorted list of plugins, go ahead and add each to the toolbar and menu. Registration
+  // always happens here on the main thread and in the order of m_PluginFilePaths.
+  for(int i = 0; i < records.size(); i++)
+  {
+    qDebug() << "Plugin Being Loaded:" << records[i].filePath;
+    QApplication::instance()->processEvents();
+    registerPlugin(records[i], m_PluginLoadingMap);
+  }
+
+  printPluginLoadTimings(records);
+  qDebug() << "Total Plugin Loading Time:" << m_PluginLoadTimer.elapsed() << "ms" << (m_ParallelPluginLoading ? "(parallel)" : "(serial)");
+
+  updatePluginManifest(m_PluginFilePaths, records);
+
+  return pluginManager->getPluginsVector();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLViewApplication::activatePlugin(const QString& filePath)
+{
+  {
+    QMutexLocker locker(&m_PluginActivationMutex);
+    if(!m_DeferredPluginPaths.contains(filePath))
+    {
+      return true;
+    }
+  }
+
+  // The FilterManager and FilterWidgetManager are only ever modified on the main thread. Waiting for it here
+  // deadlocks whenever the main thread is itself waiting for this thread, e.g. while a batch queue, sweep or
+  // incremental run shuts down, so the plugin is only queued for activation and this filter is not created.
+  // Pipelines are handed to other threads after their plugins were activated on the main thread.
+  if(QThread::currentThread() != thread())
+  {
+    qWarning() << "The plugin" << filePath << "is needed on a worker thread before it was activated; it is activated for the next use";
+    QMetaObject::invokeMethod(this, "activatePlugin", Qt::QueuedConnection, Q_ARG(QString, filePath));
+    return false;
+  }
+
+  // Join the load if it was already prefetched; otherwise start it now and wait for just this plugin
+  prefetchPlugins(QStringList() << filePath);
+  QFuture<PluginLoadRecord> future;
+  {
+    QMutexLocker locker(&m_PluginActivationMutex);
+    future = m_PendingPluginLoads.value(filePath);
+  }
+  future.waitForFinished();
+
+  return finishPluginActivation(filePath);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::prefetchPlugins(const QStringList& filePaths)
+{
+  for(const QString& filePath : filePaths)
   {
-    if(envPath.size() > 0)
+    QMutexLocker locker(&m_PluginActivationMutex);
+    if(!m_DeferredPluginPaths.contains(filePath) || m_PendingPluginLoads.contains(filePath))
     {
-      pluginDirs << QString::fromLatin1(envPath);
+      continue;
     }
-  }
 
-  int dupes = pluginDirs.removeDuplicates();
-  qDebug() << "Removed " << dupes << " duplicate Plugin Paths";
-  QStringList pluginFilePaths;
+    QFuture<PluginLoadRecord> future = QtConcurrent::run(&SIMPLViewApplication::LoadPluginFile, filePath);
+    m_PendingPluginLoads.insert(filePath, future);
 
-  foreach(QString pluginDirString, pluginDirs)
+    QFutureWatcher<PluginLoadRecord>* watcher = new QFutureWatcher<PluginLoadRecord>(this);
+    connect(watcher, &QFutureWatcher<PluginLoadRecord>::finished, [=] {
+      finishPluginActivation(filePath);
+      watcher->deleteLater();
+    });
+    watcher->setFuture(future);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLViewApplication::finishPluginActivation(const QString& filePath)
+{
+  PluginLoadRecord record;
   {
-    qDebug() << "Plugin Directory being Searched: " << pluginDirString;
-    aPluginDir = QDir(pluginDirString);
-    foreach(QString fileName, aPluginDir.entryList(QDir::Files))
+    QMutexLocker locker(&m_PluginActivationMutex);
+    // Whoever gets here first registers the plugin; the other caller has nothing left to do
+    if(!m_DeferredPluginPaths.contains(filePath) || !m_PendingPluginLoads.contains(filePath))
     {
-//   qDebug() << "File: " << fileName() << "\n";
-#ifdef QT_DEBUG
-      if(fileName.endsWith("_debug.guiplugin", Qt::CaseSensitive))
-#else
-      if(fileName.endsWith(".guiplugin", Qt::CaseSensitive)            // We want ONLY Release plugins
-         && !fileName.endsWith("_debug.guiplugin", Qt::CaseSensitive)) // so ignore these plugins
-#endif
-      {
-        pluginFilePaths << aPluginDir.absoluteFilePath(fileName);
-        // qWarning(aPluginDir.absoluteFilePath(fileName).toLatin1(), "%s");
-        // qDebug() << "Adding " << aPluginDir.absoluteFilePath(fileName)() << "\n";
-      }
+      return true;
     }
+    record = m_PendingPluginLoads.take(filePath).result();
+    m_DeferredPluginPaths.remove(filePath);
   }
 
-  FilterManager* filterManager = FilterManager::Instance();
-  FilterWidgetManager* fwm = FilterWidgetManager::Instance();
+  qDebug() << "Activating Plugin:" << filePath;
+  registerPlugin(record, m_PluginLoadingMap);
+  qDebug() << "    load:" << record.loadMSecs << "ms  register:" << record.registerMSecs << "ms";
 
-  // THIS IS A VERY IMPORTANT LINE: It will register all the known filters in the dream3d library. This
-  // will NOT however get filters from plugins. We are going to have to figure out how to compile filters
-  // into their own plugin and load the plugins from a command line.
-  filterManager->RegisterKnownFilters(filterManager);
+  return (record.loader != nullptr);
+}
 
-  PluginManager* pluginManager = PluginManager::Instance();
-  QList<PluginProxy::Pointer> proxies = AboutPlugins::readPluginCache();
-  QMap<QString, bool> loadingMap;
-  for(QList<PluginProxy::Pointer>::iterator nameIter = proxies.begin(); nameIter != proxies.end(); nameIter++)
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::activatePlugins(const QStringList& filePaths)
+{
+  prefetchPlugins(filePaths);
+  for(const QString& filePath : filePaths)
   {
-    PluginProxy::Pointer proxy = *nameIter;
-    loadingMap.insert(proxy->getPluginName(), proxy->getEnabled());
+    activatePlugin(filePath);
   }
+}
 
-  // Now that we have a sorted list of plugins, go ahead and load them all from the
-  // file system and add each to the toolbar and menu
-  foreach(QString path, pluginFilePaths)
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString SIMPLViewApplication::pluginFilePathForFilter(const QString& className)
+{
+  IFilterFactory::Pointer factory = FilterManager::Instance()->getFactoryFromClassName(className);
+  PluginManifestFilterFactory::Pointer proxy = std::dynamic_pointer_cast<PluginManifestFilterFactory>(factory);
+  if(nullptr == proxy)
   {
-    qDebug() << "Plugin Being Loaded:" << path;
-    QApplication::instance()->processEvents();
-    QPluginLoader* loader = new QPluginLoader(path);
-    QFileInfo fi(path);
-    QString fileName = fi.fileName();
-    QObject* plugin = loader->instance();
-    qDebug() << "    Pointer: " << plugin << "\n";
-    if(plugin)
-    {
-      ISIMPLibPlugin* ipPlugin = qobject_cast<ISIMPLibPlugin*>(plugin);
-      if(ipPlugin)
-      {
-        QString pluginName = ipPlugin->getPluginFileName();
-        if(loadingMap.value(pluginName, true) == true)
-        {
-          QString msg = QObject::tr("Loading Plugin %1  ").arg(fileName);
-          this->m_SplashScreen->showMessage(msg, Qt::AlignVCenter | Qt::AlignRight, Qt::white);
-          // ISIMPLibPlugin::Pointer ipPluginPtr(ipPlugin);
-          ipPlugin->registerFilterWidgets(fwm);
-          ipPlugin->registerFilters(filterManager);
-          ipPlugin->setDidLoad(true);
-        }
-        else
-        {
-          ipPlugin->setDidLoad(false);
-        }
+    return QString();
+  }
+  return proxy->getPluginFilePath();
+}
 
-        ipPlugin->setLocation(path);
-        pluginManager->addPlugin(ipPlugin);
-      }
-      m_PluginLoaders.push_back(loader);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::activatePluginForFilter(const QString& className)
+{
+  QString filePath = pluginFilePathForFilter(className);
+  if(!filePath.isEmpty())
+  {
+    activatePlugin(filePath);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::activatePluginsForPipelineFile(const QString& filePath)
+{
+  {
+    QMutexLocker locker(&m_PluginActivationMutex);
+    if(m_DeferredPluginPaths.isEmpty())
+    {
+      return;
     }
-    else
+  }
+
+  // Only Json pipelines can be inspected cheaply. Filters from .dream3d files still activate their plugin
+  // when the reader instantiates them.
+  QFile file(filePath);
+  if(QFileInfo(filePath).suffix().compare("json", Qt::CaseInsensitive) != 0 || !file.open(QIODevice::ReadOnly))
+  {
+    return;
+  }
+
+  QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+  QJsonObject root = doc.object();
+
+  QStringList pluginFilePaths;
+  for(QJsonObject::const_iterator iter = root.constBegin(); iter != root.constEnd(); ++iter)
+  {
+    QString className = iter.value().toObject().value("Filter_Name").toString();
+    QString pluginFilePath = pluginFilePathForFilter(className);
+    if(!pluginFilePath.isEmpty() && !pluginFilePaths.contains(pluginFilePath))
     {
-      m_SplashScreen->hide();
-      QString message("The plugin did not load with the following error\n\n");
-      message.append(loader->errorString());
-      message.append("\n\n");
-      message.append("Possible causes include missing libraries that plugin depends on.");
-      QMessageBox box(QMessageBox::Critical, tr("Plugin Load Error"), tr(message.toStdString().c_str()));
-      box.setStandardButtons(QMessageBox::Ok | QMessageBox::Default);
-      box.setDefaultButton(QMessageBox::Ok);
-      box.setWindowFlags(box.windowFlags() | Qt::WindowStaysOnTopHint);
-      box.exec();
-      m_SplashScreen->show();
-      delete loader;
+      pluginFilePaths.push_back(pluginFilePath);
     }
   }
 
-  return pluginManager->getPluginsVector();
+  activatePlugins(pluginFilePaths);
 }
 
 // -----------------------------------------------------------------------------
@@ -513,8 +1302,7 @@ void SIMPLViewApplication::listenClearRecentFilesTriggered()
   recents->clear();
 
   // Write out the empty list
-  QSharedPointer<QtSSettings> prefs = QSharedPointer<QtSSettings>(new QtSSettings());
-  recents->writeList(prefs.data());
+  SettingsStore::Instance()->write([](SettingsWriter* prefs) { prefs->setValue(k_RecentFilesKey, QStringList()); });
 }
 
 // -----------------------------------------------------------------------------
@@ -538,10 +1326,8 @@ void SIMPLViewApplication::listenClearSIMPLViewCacheTriggered()
 
   if(response == QMessageBox::Yes)
   {
-    QSharedPointer<QtSSettings> prefs = QSharedPointer<QtSSettings>(new QtSSettings());
-
     // Set a flag in the preferences file, so that we know that we are in "Reset Preferences" mode
-    prefs->setValue("Program Mode", QString("Reset Preferences"));
+    SettingsStore::Instance()->write([](SettingsWriter* prefs) { prefs->setValue("Program Mode", QString("Reset Preferences")); });
 
     QMessageBox cacheClearedBox;
     QString title = QString("The cache has been cleared successfully. Please restart %1 for the changes to take effect.").arg(BrandedStrings::ApplicationName);
@@ -746,23 +1532,65 @@ void SIMPLViewApplication::versionCheckReply(UpdateCheckData* dataObj)
 // -----------------------------------------------------------------------------
 void SIMPLViewApplication::listenDisplayPluginInfoDialogTriggered()
 {
+  // Deferred plugins are listed by the stand-ins that the manifest put into the PluginManager
   AboutPlugins dialog(nullptr);
   dialog.exec();
 
   // Write cache on exit
   dialog.writePluginCache();
 
-  /* If any of the load checkboxes were changed, display a dialog warning
+  if(dialog.getLoadPreferencesDidChange() == false)
+  {
+    return;
+  }
+
+  // Apply the changed load checkboxes right away so that the data in the open windows is kept
+  QStringList refusedChanges;
+  QStringList shownClassNames;
+  QStringList hiddenClassNames;
+  QList<PluginProxy::Pointer> proxies = AboutPlugins::readPluginCache();
+  for(const PluginProxy::Pointer& proxy : proxies)
+  {
+    if(m_PluginLoadingMap.value(proxy->getPluginName(), true) == proxy->getEnabled())
+    {
+      continue;
+    }
+
+    QString errorMessage;
+    if(!setPluginEnabled(proxy->getPluginName(), proxy->getEnabled(), errorMessage))
+    {
+      refusedChanges.push_back(errorMessage);
+    }
+    else if(proxy->getEnabled())
+    {
+      shownClassNames << m_PluginFilterClassNames.value(proxy->getPluginName());
+    }
+    else
+    {
+      hiddenClassNames << m_PluginFilterClassNames.value(proxy->getPluginName());
+    }
+  }
+
+  for(SIMPLView_UI* instance : m_SIMPLViewInstances)
+  {
+    instance->updateFilterToolboxes(shownClassNames, hiddenClassNames);
+  }
+  if(m_ReserveWindow != nullptr)
+  {
+    m_ReserveWindow->updateFilterToolboxes(shownClassNames, hiddenClassNames);
+  }
+
+  /* If any of the changes could not be applied, display a dialog warning
   * the user that they must restart SIMPLView to see the changes.
   */
-  if(dialog.getLoadPreferencesDidChange() == true)
+  if(!refusedChanges.isEmpty())
   {
     QMessageBox msgBox;
     msgBox.setText(QString("%1 must be restarted to allow these changes to take effect.").arg(BrandedStrings::ApplicationName));
-    msgBox.setInformativeText("Restart?");
+    msgBox.setInformativeText(refusedChanges.join("\n") + "\n\nRestart?");
     msgBox.setWindowTitle("Restart Needed");
     msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
-    msgBox.setDefaultButton(QMessageBox::Yes);
+    msgBox.setDefaultButton(QMessageBox::No);
     int choice = msgBox.exec();
 
     if(choice == QMessageBox::Yes)
@@ -773,6 +1601,92 @@ void SIMPLViewApplication::listenDisplayPluginInfoDialogTriggered()
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLViewApplication::setPluginEnabled(const QString& pluginName, bool enabled, QString& errorMessage)
+{
+  ISIMPLibPlugin* plugin = nullptr;
+  for(ISIMPLibPlugin* loadedPlugin : PluginManager::Instance()->getPluginsVector())
+  {
+    if(loadedPlugin->getPluginFileName() == pluginName)
+    {
+      plugin = loadedPlugin;
+      break;
+    }
+  }
+  if(plugin == nullptr)
+  {
+    errorMessage = tr("The plugin %1 is not loaded.").arg(pluginName);
+    return false;
+  }
+
+  // A plugin that is still deferred has not registered anything that could be changed, so load just this one
+  PluginManifestPlugin* manifestPlugin = dynamic_cast<PluginManifestPlugin*>(plugin);
+  if(manifestPlugin != nullptr && manifestPlugin->getPlugin() == nullptr && !activatePlugin(manifestPlugin->getPluginFilePath()))
+  {
+    errorMessage = tr("The plugin %1 could not be loaded.").arg(pluginName);
+    return false;
+  }
+
+  FilterManager* filterManager = FilterManager::Instance();
+  QStringList classNames = m_PluginFilterClassNames.value(pluginName);
+
+  if(enabled)
+  {
+    if(!m_PluginFilterClassNames.contains(pluginName))
+    {
+      // The plugin was disabled at startup and has never registered its filters
+      classNames = registerPluginFilters(plugin);
+    }
+    else
+    {
+      // Put back the factories that were set aside when the plugin was disabled
+      for(const QString& className : classNames)
+      {
+        DisabledPluginFilterFactory::Pointer factory = std::dynamic_pointer_cast<DisabledPluginFilterFactory>(filterManager->getFactoryFromClassName(className));
+        if(nullptr != factory)
+        {
+          filterManager->addFilterFactory(className, factory->getOriginalFactory());
+        }
+      }
+      plugin->setDidLoad(true);
+    }
+    qDebug() << "Enabled plugin" << pluginName << "with" << classNames.size() << "filters";
+  }
+  else
+  {
+    // Filters that are sitting in a pipeline must stay usable
+    for(SIMPLView_UI* instance : m_SIMPLViewInstances)
+    {
+      QStringList pipelineClassNames = instance->getPipelineFilterClassNames();
+      for(const QString& className : classNames)
+      {
+        if(pipelineClassNames.contains(className))
+        {
+          QString windowName = instance->windowFilePath().isEmpty() ? QString("Untitled") : QFileInfo(instance->windowFilePath()).fileName();
+          errorMessage = tr("The plugin %1 can not be disabled because its filter %2 is used by the pipeline in %3.").arg(pluginName, className, windowName);
+          return false;
+        }
+      }
+    }
+
+    for(const QString& className : classNames)
+    {
+      IFilterFactory::Pointer factory = filterManager->getFactoryFromClassName(className);
+      if(nullptr != factory && nullptr == std::dynamic_pointer_cast<DisabledPluginFilterFactory>(factory))
+      {
+        filterManager->addFilterFactory(className, DisabledPluginFilterFactory::New(pluginName, factory));
+      }
+    }
+    plugin->setDidLoad(false);
+    qDebug() << "Disabled plugin" << pluginName << "with" << classNames.size() << "filters";
+  }
+
+  m_PluginLoadingMap.insert(pluginName, enabled);
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -803,13 +1717,24 @@ SIMPLView_UI* SIMPLViewApplication::newInstanceFromFile(const QString& filePath)
 // -----------------------------------------------------------------------------
 SIMPLView_UI* SIMPLViewApplication::getNewSIMPLViewInstance()
 {
-  PluginManager* pluginManager = PluginManager::Instance();
-  QVector<ISIMPLibPlugin*> plugins = pluginManager->getPluginsVector();
+  // Hand out the window that was built ahead of time if there is one
+  SIMPLView_UI* newInstance = m_ReserveWindow;
+  m_ReserveWindow = nullptr;
+  if(newInstance != nullptr)
+  {
+    newInstance->setReserved(false);
+    registerSIMPLViewWindow(newInstance);
+  }
+  else
+  {
+    PluginManager* pluginManager = PluginManager::Instance();
+    QVector<ISIMPLibPlugin*> plugins = pluginManager->getPluginsVector();
 
-  // Create new SIMPLView instance
-  SIMPLView_UI* newInstance = new SIMPLView_UI(nullptr);
-  newInstance->setLoadedPlugins(plugins);
-  newInstance->setAttribute(Qt::WA_DeleteOnClose);
+    // Create new SIMPLView instance
+    newInstance = new SIMPLView_UI(nullptr);
+    newInstance->setLoadedPlugins(plugins);
+    newInstance->setAttribute(Qt::WA_DeleteOnClose);
+  }
   newInstance->setWindowTitle("[*]Untitled Pipeline - " + BrandedStrings::ApplicationName);
 
   if (m_ActiveWindow)
@@ -821,9 +1746,70 @@ SIMPLView_UI* SIMPLViewApplication::getNewSIMPLViewInstance()
 
   connect(newInstance, SIGNAL(dream3dWindowChangedState(SIMPLView_UI*)), this, SLOT(dream3dWindowChanged(SIMPLView_UI*)));
 
+  scheduleReserveWindow();
+
   return newInstance;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::scheduleReserveWindow()
+{
+  if(!m_UseReserveWindow || !m_StartupFinished)
+  {
+    return;
+  }
+
+  if(m_ReserveWindowTimer == nullptr)
+  {
+    m_ReserveWindowTimer = new QTimer(this);
+    m_ReserveWindowTimer->setSingleShot(true);
+    m_ReserveWindowTimer->setInterval(1500);
+    connect(m_ReserveWindowTimer, &QTimer::timeout, this, &SIMPLViewApplication::buildReserveWindow);
+  }
+
+  // Restarting the timer keeps the build out of the way while windows are being opened in a burst
+  m_ReserveWindowTimer->start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::buildReserveWindow()
+{
+  if(!m_UseReserveWindow || m_ReserveWindow != nullptr || closingDown())
+  {
+    return;
+  }
+
+  // Building a window takes the main thread for a moment, so wait until the user is not in the middle of something
+  if(QApplication::mouseButtons() != Qt::NoButton || QApplication::activePopupWidget() != nullptr || QApplication::activeModalWidget() != nullptr)
+  {
+    scheduleReserveWindow();
+    return;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+
+  PluginManager* pluginManager = PluginManager::Instance();
+  QVector<ISIMPLibPlugin*> plugins = pluginManager->getPluginsVector();
+
+  // The window registers itself while it is constructed; the reserve window is only registered once it is handed out
+  m_BuildingReserveWindow = true;
+  SIMPLView_UI* window = new SIMPLView_UI(nullptr);
+  m_BuildingReserveWindow = false;
+
+  window->setReserved(true);
+  window->setLoadedPlugins(plugins);
+  window->setAttribute(Qt::WA_DeleteOnClose);
+  window->ensurePolished();
+
+  m_ReserveWindow = window;
+  qDebug() << "Built the reserve window in" << timer.elapsed() << "ms";
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -897,6 +1883,11 @@ QList<SIMPLView_UI*> SIMPLViewApplication::getSIMPLViewInstances()
 // -----------------------------------------------------------------------------
 void SIMPLViewApplication::registerSIMPLViewWindow(SIMPLView_UI* window)
 {
+  if(m_BuildingReserveWindow)
+  {
+    return;
+  }
+
   m_SIMPLViewInstances.push_back(window);
 }
 
@@ -957,26 +1948,32 @@ void SIMPLViewApplication::setActiveWindow(SIMPLView_UI* instance)
 // -----------------------------------------------------------------------------
 void SIMPLViewApplication::writeSettings()
 {
-  QSharedPointer<QtSSettings> prefs = QSharedPointer<QtSSettings>(new QtSSettings());
+  QStringList recentFiles = QtSRecentFileList::Instance()->fileList();
+  SettingsStore::Instance()->write([this, recentFiles](SettingsWriter* prefs) {
+    prefs->beginGroup("Application Settings");
 
-  prefs->beginGroup("Application Settings");
+    QString themeFilePath = m_ThemeCache.getCurrentThemeFilePath();
+    prefs->setValue("Theme File Path", themeFilePath);
+    prefs->setValue("Measure Theme Application", m_MeasureThemeApplication);
 
-  SVStyle* styles = SVStyle::Instance();
-  QString themeFilePath = styles->getCurrentThemeFilePath();
-  prefs->setValue("Theme File Path", themeFilePath);
+    prefs->setValue("Parallel Plugin Loading", m_ParallelPluginLoading);
+    prefs->setValue("Use Plugin Manifest", m_UsePluginManifest);
+    prefs->setValue("Reserve Window", m_UseReserveWindow);
 
-  #if defined SIMPL_RELATIVE_PATH_CHECK
-  SIMPLDataPathValidator* validator = SIMPLDataPathValidator::Instance();
-  QString dataDir = validator->getSIMPLDataDirectory();
-  prefs->setValue("Data Directory", dataDir);
-  #endif
+    #if defined SIMPL_RELATIVE_PATH_CHECK
+    SIMPLDataPathValidator* validator = SIMPLDataPathValidator::Instance();
+    QString dataDir = validator->getSIMPLDataDirectory();
+    prefs->setValue("Data Directory", dataDir);
+    #endif
 
-  prefs->endGroup();
+    prefs->endGroup();
 
+    prefs->setValue(k_RecentFilesKey, recentFiles);
+  });
+
+  // The bookmarks model opens the preferences file on its own
   BookmarksModel* model = BookmarksModel::Instance();
   model->writeBookmarksToPrefsFile();
-
-  QtSRecentFileList::Instance()->writeList(prefs.data());
 }
 
 // -----------------------------------------------------------------------------
@@ -988,12 +1985,44 @@ void SIMPLViewApplication::readSettings()
 
   prefs->beginGroup("Application Settings");
 
-  SVStyle* styles = SVStyle::Instance();
+  // The theme itself is loaded in initialize() so that it overlaps with the plugin loading
   QString themeFilePath = prefs->value("Theme File Path", QString()).toString();
   QFileInfo fi(themeFilePath);
   if (themeFilePath.isEmpty() == false && BrandedStrings::LoadedThemeNames.contains(fi.baseName()))
   {
-    styles->loadStyleSheet(themeFilePath);
+    m_StartupThemeFilePath = themeFilePath;
+  }
+
+  // Setting SIMPL_THEME_TIMING=1 reports how long every theme change takes to reach all of the open windows
+  m_MeasureThemeApplication = prefs->value("Measure Theme Application", false).toBool();
+  QByteArray themeTimingEnv = qgetenv("SIMPL_THEME_TIMING");
+  if(!themeTimingEnv.isEmpty())
+  {
+    m_MeasureThemeApplication = (themeTimingEnv != "0");
+  }
+
+  // Setting SIMPL_PLUGIN_MANIFEST=0 forces every plugin to load at startup, e.g. to compare against a warm manifest
+  m_UsePluginManifest = prefs->value("Use Plugin Manifest", true).toBool();
+  QByteArray manifestEnv = qgetenv("SIMPL_PLUGIN_MANIFEST");
+  if(!manifestEnv.isEmpty())
+  {
+    m_UsePluginManifest = (manifestEnv != "0");
+  }
+
+  // Setting SIMPL_RESERVE_WINDOW=0 stops a hidden window from being built ahead of time
+  m_UseReserveWindow = prefs->value("Reserve Window", true).toBool();
+  QByteArray reserveWindowEnv = qgetenv("SIMPL_RESERVE_WINDOW");
+  if(!reserveWindowEnv.isEmpty())
+  {
+    m_UseReserveWindow = (reserveWindowEnv != "0");
+  }
+
+  // The SIMPL_PARALLEL_PLUGIN_LOADING environment variable overrides the preference, which is handy for comparing startup times
+  m_ParallelPluginLoading = prefs->value("Parallel Plugin Loading", false).toBool();
+  QByteArray parallelEnv = qgetenv("SIMPL_PARALLEL_PLUGIN_LOADING");
+  if(!parallelEnv.isEmpty())
+  {
+    m_ParallelPluginLoading = (parallelEnv != "0");
   }
 
   #if defined SIMPL_RELATIVE_PATH_CHECK
@@ -1223,16 +2252,16 @@ void SIMPLViewApplication::createDefaultMenuBar()
 // -----------------------------------------------------------------------------
 QMenu* SIMPLViewApplication::createThemeMenu(QActionGroup* actionGroup, QWidget* parent)
 {
-  SVStyle* style = SVStyle::Instance();
-
   QMenu* menuThemes = new QMenu("Themes", parent);
 
+  QString currentThemeFilePath = m_ThemeCache.getCurrentThemeFilePath();
+
   QString themePath = ":/SIMPL/StyleSheets/Default.json";
   QAction* action = menuThemes->addAction("Default", [=] {
-    style->loadStyleSheet(themePath);
+    loadTheme(themePath);
   });
   action->setCheckable(true);
-  if(themePath == style->getCurrentThemeFilePath())
+  if(themePath == currentThemeFilePath)
   {
     action->setChecked(true);
   }
@@ -1243,10 +2272,10 @@ QMenu* SIMPLViewApplication::createThemeMenu(QActionGroup* actionGroup, QWidget*
   {
     QString themePath = BrandedStrings::DefaultStyleDirectory + QDir::separator() + themeNames[i] + ".json";
     QAction* action = menuThemes->addAction(themeNames[i], [=] {
-      style->loadStyleSheet(themePath);
+      loadTheme(themePath);
     });
     action->setCheckable(true);
-    if(themePath == style->getCurrentThemeFilePath())
+    if(themePath == currentThemeFilePath)
     {
       action->setChecked(true);
     }
@@ -1256,6 +2285,47 @@ QMenu* SIMPLViewApplication::createThemeMenu(QActionGroup* actionGroup, QWidget*
   return menuThemes;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::loadTheme(const QString& themeFilePath)
+{
+  if(!m_MeasureThemeApplication)
+  {
+    m_ThemeCache.applyTheme(themeFilePath);
+    return;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  bool cacheHit = m_ThemeCache.applyTheme(themeFilePath);
+  qint64 applyMSecs = timer.elapsed();
+
+  // Style changes are only polished and painted lazily, so force every open window through a full repaint
+  int widgetCount = 0;
+  for(SIMPLView_UI* instance : m_SIMPLViewInstances)
+  {
+    widgetCount += instance->findChildren<QWidget*>().size() + 1;
+    instance->ensurePolished();
+    instance->repaint();
+  }
+  if(m_DefaultMenuBar != nullptr)
+  {
+    m_DefaultMenuBar->repaint();
+  }
+  qint64 totalMSecs = timer.elapsed();
+
+  qDebug().noquote() << QString("Theme %1 (%2) applied in %3 ms, repainted %4 windows with %5 widgets in %6 ms. Cache hits: %7  misses: %8")
+                            .arg(QFileInfo(themeFilePath).fileName())
+                            .arg(cacheHit ? "cache hit" : "cache miss")
+                            .arg(applyMSecs)
+                            .arg(m_SIMPLViewInstances.size())
+                            .arg(widgetCount)
+                            .arg(totalMSecs - applyMSecs)
+                            .arg(m_ThemeCache.getHitCount())
+                            .arg(m_ThemeCache.getMissCount());
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -35,8 +35,14 @@
 
 #pragma once
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFuture>
+#include <QtCore/QMap>
+#include <QtCore/QMutex>
 #include <QtCore/QSet>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
 
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QMenuBar>
@@ -44,11 +50,16 @@
 
 #include "SVWidgetsLib/Dialogs/UpdateCheck.h"
 
+#include "SIMPLView/PluginManifest.h"
+#include "SIMPLView/ThemeCache.h"
+
 #define dream3dApp (static_cast<SIMPLViewApplication*>(qApp))
 
 class QSplashScreen;
 class SIMPLView_UI;
 class QPluginLoader;
+class QLocalServer;
+class QTimer;
 class ISIMPLibPlugin;
 class SIMPLViewToolbox;
 class SVPipelineFilterWidget;
@@ -99,6 +110,13 @@ public:
    */
   QMenu* createThemeMenu(QActionGroup *actionGroup, QWidget* parent = nullptr);
 
+  /**
+   * @brief loadTheme Applies a theme through the compiled theme cache. In the theme measurement mode the
+   * time it takes to re-polish and repaint every open window is reported as well.
+   * @param themeFilePath
+   */
+  void loadTheme(const QString& themeFilePath);
+
   QList<SIMPLView_UI*> getSIMPLViewInstances();
 
   void registerSIMPLViewWindow(SIMPLView_UI* window);
@@ -121,7 +139,81 @@ public:
    */
   QMenu* getRecentFilesMenu();
 
+  /**
+   * @brief activatePlugin Loads and registers a plugin whose filters were only populated from the plugin
+   * manifest at startup. Does nothing if the plugin has already been loaded. On the main thread the caller only
+   * waits for this one plugin. Any other thread never waits for the main thread: the activation is queued to the
+   * main thread and false is returned, so pipelines must have their plugins activated before they are handed over.
+   * @param filePath The plugin file
+   * @return false if the plugin could not be loaded, or was not loaded yet when called from another thread
+   */
+  Q_INVOKABLE bool activatePlugin(const QString& filePath);
+
+  /**
+   * @brief activatePlugins Loads all of the given plugins concurrently and returns once they are all registered
+   * @param filePaths
+   */
+  void activatePlugins(const QStringList& filePaths);
+
+  /**
+   * @brief activatePluginsForPipelineFile Loads the deferred plugins that provide the filters referenced by a
+   * pipeline file before the pipeline is read
+   * @param filePath
+   */
+  void activatePluginsForPipelineFile(const QString& filePath);
+
+  /**
+   * @brief prefetchPlugins Starts loading the given deferred plugins on the global thread pool. Each plugin is
+   * registered on the main thread as soon as its library has loaded; this never blocks.
+   * @param filePaths
+   */
+  void prefetchPlugins(const QStringList& filePaths);
+
+  /**
+   * @brief pluginFilePathForFilter
+   * @param className
+   * @return The deferred plugin that provides className, or an empty string if that filter is already available
+   */
+  QString pluginFilePathForFilter(const QString& className);
+
+  /**
+   * @brief setPluginEnabled Enables or disables a plugin while the application is running. Disabling is
+   * refused while the pipeline of any open window uses one of the filters of the plugin.
+   * @param pluginName
+   * @param enabled
+   * @param errorMessage Set to the reason when the change is refused
+   * @return
+   */
+  bool setPluginEnabled(const QString& pluginName, bool enabled, QString& errorMessage);
+
+  /**
+   * @brief SingleInstanceEnabled Whether files opened from the desktop are handed to an already running instance.
+   * Turned off with the "Single Instance" preference or SIMPL_SINGLE_INSTANCE=0.
+   * @return
+   */
+  static bool SingleInstanceEnabled();
+
+  /**
+   * @brief SingleInstanceServerName
+   * @return The local socket name, which is unique to the application and the user
+   */
+  static QString SingleInstanceServerName();
+
+  /**
+   * @brief SendFileToRunningInstance Asks a running instance to open filePath. This only needs a QCoreApplication.
+   * @param filePath
+   * @param timeoutMSecs
+   * @return True if a running instance accepted the file
+   */
+  static bool SendFileToRunningInstance(const QString& filePath, int timeoutMSecs = 2000);
+
 public slots:
+  /**
+   * @brief activatePluginForFilter Makes sure that the plugin providing className is loaded
+   * @param className
+   */
+  void activatePluginForFilter(const QString& className);
+
   void listenNewInstanceTriggered();
   void listenOpenPipelineTriggered();
   void listenClearRecentFilesTriggered();
@@ -146,6 +238,21 @@ public slots:
   void updateRecentFileList(const QString& file);
 
 protected:
+  /**
+   * @brief The PluginLoadRecord struct holds the outcome and the timings of loading a single plugin file.
+   */
+  struct PluginLoadRecord
+  {
+    QString filePath;
+    QPluginLoader* loader = nullptr;
+    QObject* instance = nullptr;
+    QString pluginName;
+    bool didRegister = false;
+    QStringList filterClassNames;
+    qint64 loadMSecs = 0;
+    qint64 registerMSecs = 0;
+  };
+
   // This is a set of all SIMPLView instances currently available
   QList<SIMPLView_UI*> m_SIMPLViewInstances;
 
@@ -157,13 +264,155 @@ protected:
   bool m_ShowSplash;
   QSplashScreen* m_SplashScreen;
   QVector<QPluginLoader*> m_PluginLoaders;
+  bool m_ParallelPluginLoading = false;
+  bool m_UsePluginManifest = true;
+  PluginManifest m_PluginManifest;
+  QMap<QString, bool> m_PluginLoadingMap;
+  QMap<QString, QStringList> m_PluginFilterClassNames;
+  QStringList m_PluginFilePaths;
+  bool m_PluginsFromManifest = false;
+  QFuture<QVector<PluginLoadRecord>> m_PluginLoadFuture;
+  QElapsedTimer m_PluginLoadTimer;
+  QElapsedTimer m_SplashTimer;
+  qint64 m_SplashStartUSecs = 0;
+  QString m_StartupThemeFilePath;
+  ThemeCache m_ThemeCache;
+  bool m_MeasureThemeApplication = false;
+  QLocalServer* m_SingleInstanceServer = nullptr;
+  bool m_StartupFinished = false;
+  QStringList m_PendingFileOpens;
+  bool m_UseReserveWindow = true;
+  bool m_BuildingReserveWindow = false;
+  SIMPLView_UI* m_ReserveWindow = nullptr;
+  QTimer* m_ReserveWindowTimer = nullptr;
+
+  // Guards the deferred plugin bookkeeping, which is queried from whichever thread instantiates a filter
+  QMutex m_PluginActivationMutex;
+  QSet<QString> m_DeferredPluginPaths;
+  QMap<QString, QFuture<PluginLoadRecord>> m_PendingPluginLoads;
+
+  // The stand-ins that the PluginManager lists for the plugins populated from the manifest, keyed by plugin file
+  QMap<QString, PluginManifestPlugin*> m_ManifestPlugins;
+
+  /**
+   * @brief startLoadingPlugins Finds the plugin files and, unless the plugin manifest is current, starts
+   * instantiating them on a worker thread so that the rest of the startup work can overlap with it
+   */
+  void startLoadingPlugins();
 
   /**
-   * @brief loadPlugins
+   * @brief loadPlugins Waits for the plugins started by startLoadingPlugins() and registers them on the main thread
    * @return
    */
   QVector<ISIMPLibPlugin*> loadPlugins();
 
+  /**
+   * @brief loadFonts Registers the default SIMPL font and any extra branded fonts with the application
+   */
+  void loadFonts();
+
+  /**
+   * @brief finishSplashScreen Closes the splash screen once the first window has been shown
+   */
+  void finishSplashScreen();
+
+  /**
+   * @brief findPluginFilePaths Searches the application, bundle and SIMPL_PLUGIN_PATH directories for plugin files
+   * @return The absolute paths of all plugin files that match the current build type
+   */
+  QStringList findPluginFilePaths();
+
+  /**
+   * @brief LoadPluginFile Instantiates the plugin at filePath. This is safe to call from a worker thread; the
+   * loader and the plugin instance are moved to the main thread before returning.
+   * @param filePath
+   * @return
+   */
+  static PluginLoadRecord LoadPluginFile(const QString& filePath);
+
+  /**
+   * @brief LoadPluginFiles Instantiates the plugins one after the other
+   * @param filePaths
+   * @return
+   */
+  static QVector<PluginLoadRecord> LoadPluginFiles(const QStringList& filePaths);
+
+  /**
+   * @brief LoadPluginFilesConcurrently Instantiates all of the plugins on the global thread pool. The records
+   * are returned in the same order as filePaths so that registration stays deterministic.
+   * @param filePaths
+   * @return
+   */
+  static QVector<PluginLoadRecord> LoadPluginFilesConcurrently(const QStringList& filePaths);
+
+  /**
+   * @brief registerPlugin Registers the filters and filter widgets of a loaded plugin on the main thread
+   * @param record
+   * @param loadingMap The enabled state of each plugin as read from the plugin cache
+   */
+  void registerPlugin(PluginLoadRecord& record, const QMap<QString, bool>& loadingMap);
+
+  /**
+   * @brief registerPluginFilters Registers the filter widgets and filters of a plugin
+   * @param plugin
+   * @return The class names of the filters that the plugin added
+   */
+  QStringList registerPluginFilters(ISIMPLibPlugin* plugin);
+
+  /**
+   * @brief startSingleInstanceServer Starts listening for files that later launches hand over
+   */
+  void startSingleInstanceServer();
+
+  /**
+   * @brief handleSingleInstanceConnection Reads the file path sent by another launch and opens it
+   */
+  void handleSingleInstanceConnection();
+
+  /**
+   * @brief openPendingFiles Opens the files that were handed over while this instance was still starting up
+   */
+  void openPendingFiles();
+
+  /**
+   * @brief scheduleReserveWindow Builds a new reserve window once the application has been idle for a moment
+   */
+  void scheduleReserveWindow();
+
+  /**
+   * @brief buildReserveWindow Constructs the hidden window that getNewSIMPLViewInstance() hands out next
+   */
+  void buildReserveWindow();
+
+  /**
+   * @brief registerPluginsFromManifest Populates the FilterManager with stand-in factories and the PluginManager
+   * with stand-in plugins for every plugin in pluginFilePaths without loading any of them. This only succeeds when the manifest has a current entry
+   * for every plugin file.
+   * @param pluginFilePaths
+   * @return false if the manifest is missing or out of date, in which case nothing was registered
+   */
+  bool registerPluginsFromManifest(const QStringList& pluginFilePaths);
+
+  /**
+   * @brief updatePluginManifest Records what each loaded plugin registered and writes the manifest to disk
+   * @param pluginFilePaths
+   * @param records
+   */
+  void updatePluginManifest(const QStringList& pluginFilePaths, const QVector<PluginLoadRecord>& records);
+
+  /**
+   * @brief finishPluginActivation Registers a deferred plugin once its library has been loaded. Main thread only.
+   * @param filePath
+   * @return
+   */
+  bool finishPluginActivation(const QString& filePath);
+
+  /**
+   * @brief printPluginLoadTimings Writes the per-plugin load and registration times, slowest first
+   * @param records
+   */
+  void printPluginLoadTimings(const QVector<PluginLoadRecord>& records);
+
   /**
    * @brief checkForUpdatesAtStartup
    */
@@ -49,5 +49,14 @@ namespace SIMPLView
     static const QString WhenToCheck("WhenToCheck");
     static const QString UpdateWebSite("http://dream3d.bluequartz.net/dream3d_version.json");
   }
+
+  namespace WorkerMessage
+  {
+    static const QString Type("Type");
+    static const QString Ready("Ready");
+    static const QString Execute("Execute");
+    static const QString PipelineMessage("Message");
+    static const QString Finished("Finished");
+  }
 }
 
@@ -36,12 +36,17 @@
 #include "SIMPLView_UI.h"
 
 //-- Qt Includes
+#include <QtConcurrent/QtConcurrentRun>
+
 #include <QtCore/QDateTime>
 #include <QtCore/QDir>
 #include <QtCore/QDirIterator>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QFileInfoList>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTimer>
 #include <QtCore/QMimeData>
 #include <QtCore/QProcess>
 #include <QtCore/QString>
@@ -50,12 +55,18 @@
 #include <QtGui/QClipboard>
 #include <QtGui/QCloseEvent>
 #include <QtGui/QDesktopServices>
+#include <QtWidgets/QAbstractButton>
+#include <QtWidgets/QAbstractItemView>
 #include <QtWidgets/QCheckBox>
+#include <QtWidgets/QInputDialog>
+#include <QtWidgets/QLabel>
 #include <QtWidgets/QFileDialog>
+#include <QtWidgets/QListView>
 #include <QtWidgets/QListWidget>
 #include <QtWidgets/QScrollBar>
 #include <QtWidgets/QShortcut>
 #include <QtWidgets/QToolButton>
+#include <QtWidgets/QTreeView>
 
 //-- SIMPLView Includes
 #include "SIMPLib/Common/Constants.h"
@@ -80,6 +91,7 @@
 #include "SVWidgetsLib/Widgets/PipelineListWidget.h"
 #include "SVWidgetsLib/Widgets/PipelineModel.h"
 #include "SVWidgetsLib/Widgets/SVStyle.h"
+#include "SVWidgetsLib/Widgets/StandardOutputWidget.h"
 #include "SVWidgetsLib/Widgets/StatusBarWidget.h"
 #include "SVWidgetsLib/Widgets/util/AddFilterCommand.h"
 #ifdef SIMPL_USE_QtWebEngine
@@ -100,13 +112,247 @@
 #endif
 
 #include "SIMPLView/AboutSIMPLView.h"
+#include "SIMPLView/ArrayLiveness.h"
+#include "SIMPLView/BackgroundPreflight.h"
+#include "SIMPLView/BatchQueueWidget.h"
+#include "SIMPLView/LogViewWidget.h"
+#include "SIMPLView/MemoryEstimator.h"
+#include "SIMPLView/ParameterSweepDialog.h"
+#include "SIMPLView/WatchDirectoryDialog.h"
+#include "SIMPLView/WorkerPool.h"
+#include "SIMPLView/WorkerProtocol.h"
+#include "SIMPLView/PipelineProfiler.h"
+#include "SIMPLView/PipelineProfilerWidget.h"
+#include "SIMPLView/ProcessStats.h"
+#include "SIMPLView/ProfilerItemDelegate.h"
 #include "SIMPLView/SIMPLView.h"
 #include "SIMPLView/SIMPLViewApplication.h"
 #include "SIMPLView/SIMPLViewConstants.h"
 #include "SIMPLView/SIMPLViewVersion.h"
+#include "SIMPLView/SettingsStore.h"
+#include "SIMPLView/StageCache.h"
+#include "SIMPLView/StartupTracer.h"
 
 #include "BrandedStrings.h"
 
+namespace
+{
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+LogModel::Level LogLevelForMessageType(PipelineMessage::MessageType type)
+{
+  switch(type)
+  {
+  case PipelineMessage::MessageType::StatusMessage:
+    return LogModel::Level::Status;
+  case PipelineMessage::MessageType::Warning:
+    return LogModel::Level::Warning;
+  case PipelineMessage::MessageType::Error:
+    return LogModel::Level::Error;
+  default:
+    return LogModel::Level::Info;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Hides or shows the rows of every item view in the toolbox that hold one of the filters. The toolboxes keep
+// the class name of a filter in Qt::UserRole. Returns false if one of the filters has no row in the toolbox.
+// -----------------------------------------------------------------------------
+bool SetToolboxFiltersHidden(QWidget* toolbox, const QStringList& classNames, bool hidden)
+{
+  QSet<QString> foundClassNames;
+  for(QAbstractItemView* view : toolbox->findChildren<QAbstractItemView*>())
+  {
+    QAbstractItemModel* model = view->model();
+    if(model == nullptr || model->rowCount() == 0)
+    {
+      continue;
+    }
+    QListView* listView = qobject_cast<QListView*>(view);
+    QTreeView* treeView = qobject_cast<QTreeView*>(view);
+
+    QList<QPersistentModelIndex> groupIndexes;
+    for(const QString& className : classNames)
+    {
+      QModelIndexList matches = model->match(model->index(0, 0), Qt::UserRole, className, -1, Qt::MatchExactly | Qt::MatchRecursive);
+      for(const QModelIndex& index : matches)
+      {
+        if(listView != nullptr)
+        {
+          listView->setRowHidden(index.row(), hidden);
+        }
+        else if(treeView != nullptr)
+        {
+          treeView->setRowHidden(index.row(), index.parent(), hidden);
+          if(index.parent().isValid())
+          {
+            groupIndexes.push_back(index.parent());
+          }
+        }
+        foundClassNames.insert(className);
+      }
+    }
+
+    // A group in the filter library is only shown while it has a visible filter
+    while(treeView != nullptr && !groupIndexes.isEmpty())
+    {
+      QModelIndex group = groupIndexes.takeFirst();
+      bool empty = true;
+      for(int row = 0; row < model->rowCount(group) && empty; row++)
+      {
+        empty = treeView->isRowHidden(row, group);
+      }
+      if(treeView->isRowHidden(group.row(), group.parent()) != empty)
+      {
+        treeView->setRowHidden(group.row(), group.parent(), empty);
+        if(group.parent().isValid())
+        {
+          groupIndexes.push_back(group.parent());
+        }
+      }
+    }
+  }
+
+  return foundClassNames.size() == QSet<QString>::fromList(classNames).size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ReadMemoryBudgetMB()
+{
+  qint64 budgetMB = SettingsStore::Instance()->value("Application Settings/Memory Budget MB", 0LL).toLongLong();
+
+  QByteArray budgetEnv = qgetenv("SIMPL_MEMORY_BUDGET_MB");
+  if(!budgetEnv.isEmpty())
+  {
+    budgetMB = budgetEnv.toLongLong();
+  }
+
+  return qMax(0LL, budgetMB);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WriteMemoryBudgetMB(qint64 budgetMB)
+{
+  SettingsStore::Instance()->write([budgetMB](SettingsWriter* prefs) {
+    prefs->beginGroup("Application Settings");
+    prefs->setValue("Memory Budget MB", budgetMB);
+    prefs->endGroup();
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ReadAlwaysUseWorkers()
+{
+  bool useWorkers = SettingsStore::Instance()->value("Application Settings/Execute In Worker Processes", false).toBool();
+
+  QByteArray useWorkersEnv = qgetenv("SIMPL_EXECUTE_IN_WORKERS");
+  if(!useWorkersEnv.isEmpty())
+  {
+    useWorkers = (useWorkersEnv != "0");
+  }
+
+  return useWorkers;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WriteAlwaysUseWorkers(bool useWorkers)
+{
+  SettingsStore::Instance()->write([useWorkers](SettingsWriter* prefs) {
+    prefs->beginGroup("Application Settings");
+    prefs->setValue("Execute In Worker Processes", useWorkers);
+    prefs->endGroup();
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ReadKeepAllArrays()
+{
+  bool keepAll = SettingsStore::Instance()->value("Application Settings/Keep All Arrays", false).toBool();
+
+  QByteArray keepAllEnv = qgetenv("SIMPL_KEEP_ALL_ARRAYS");
+  if(!keepAllEnv.isEmpty())
+  {
+    keepAll = (keepAllEnv != "0");
+  }
+
+  return keepAll;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WriteKeepAllArrays(bool keepAll)
+{
+  SettingsStore::Instance()->write([keepAll](SettingsWriter* prefs) {
+    prefs->beginGroup("Application Settings");
+    prefs->setValue("Keep All Arrays", keepAll);
+    prefs->endGroup();
+  });
+}
+
+// Marks a filter that a checkpoint is written after. The mark belongs to the filter object, so it follows the
+// filter when it is moved and is not saved with the pipeline.
+const char* k_CheckpointProperty = "SIMPLViewCheckpoint";
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ReadCheckpointAfterMinutes()
+{
+  int minutes = SettingsStore::Instance()->value("Application Settings/Checkpoint After Minutes", 0).toInt();
+
+  QByteArray minutesEnv = qgetenv("SIMPL_CHECKPOINT_AFTER_MINUTES");
+  if(!minutesEnv.isEmpty())
+  {
+    minutes = minutesEnv.toInt();
+  }
+
+  return qMax(0, minutes);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WriteCheckpointAfterMinutes(int minutes)
+{
+  SettingsStore::Instance()->write([minutes](SettingsWriter* prefs) {
+    prefs->beginGroup("Application Settings");
+    prefs->setValue("Checkpoint After Minutes", minutes);
+    prefs->endGroup();
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ReadCheckpointDirectory()
+{
+  QtSSettings prefs;
+  prefs.beginGroup("Application Settings");
+  QString dirPath = prefs.value("Checkpoint Directory", QString()).toString();
+  prefs.endGroup();
+
+  QByteArray dirEnv = qgetenv("SIMPL_CHECKPOINT_DIR");
+  if(!dirEnv.isEmpty())
+  {
+    dirPath = QString::fromLocal8Bit(dirEnv);
+  }
+
+  return dirPath.isEmpty() ? PipelineCheckpointer::DefaultDirectory() : dirPath;
+}
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -124,21 +370,33 @@ SIMPLView_UI::SIMPLView_UI(QWidget* parent)
 
   // Register all the known filterWidgets
   m_FilterWidgetManager = FilterWidgetManager::Instance();
-  m_FilterWidgetManager->RegisterKnownFilterWidgets();
+  {
+    StartupTraceScope traceScope("FilterWidgetManager::RegisterKnownFilterWidgets");
+    m_FilterWidgetManager->RegisterKnownFilterWidgets();
+  }
 
   // Calls the Parent Class to do all the Widget Initialization that were created
   // using the QDesigner program
-  m_Ui->setupUi(this);
+  {
+    StartupTraceScope traceScope("SIMPLView_UI::setupUi");
+    m_Ui->setupUi(this);
+  }
 
   dream3dApp->registerSIMPLViewWindow(this);
 
   // Do our own widget initializations
-  setupGui();
+  {
+    StartupTraceScope traceScope("SIMPLView_UI::setupGui");
+    setupGui();
+  }
 
   this->setAcceptDrops(true);
 
   // Read various settings
-  readSettings();
+  {
+    StartupTraceScope traceScope("SIMPLView_UI::readSettings");
+    readSettings();
+  }
   if(SIMPLView::DockWidgetSettings::HideDockSetting::OnError == IssuesWidget::GetHideDockSetting())
   {
     m_Ui->issuesDockWidget->setHidden(true);
@@ -157,7 +415,24 @@ SIMPLView_UI::SIMPLView_UI(QWidget* parent)
 // -----------------------------------------------------------------------------
 SIMPLView_UI::~SIMPLView_UI()
 {
-  writeSettings();
+  if(!m_Reserved)
+  {
+    writeSettings();
+  }
+
+  // The incremental execution runs on the window's pipeline copy, it has to stop before the window goes away
+  if(m_IncrementalPipeline.get() != nullptr)
+  {
+    m_IncrementalPipeline->cancel();
+    m_IncrementalWatcher->waitForFinished();
+  }
+
+  // Nobody is left to look at the result of the worker
+  if(m_WorkerRunId != 0)
+  {
+    disconnect(WorkerPool::Instance(), nullptr, this, nullptr);
+    WorkerPool::Instance()->cancel(m_WorkerRunId);
+  }
 
   dream3dApp->unregisterSIMPLViewWindow(this);
 
@@ -177,7 +452,10 @@ void SIMPLView_UI::resizeEvent(QResizeEvent* event)
   emit parentResized();
 
   // We need to write the window settings so that any new windows will open with these window settings
-  writeWindowSettings();
+  if(!m_Reserved)
+  {
+    writeWindowSettings();
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -220,15 +498,699 @@ bool SIMPLView_UI::savePipeline()
   QtSRecentFileList* list = QtSRecentFileList::Instance();
   list->addFile(filePath);
 
-  return true;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenSavePipelineAsTriggered()
+{
+  savePipelineAs();
+}
+
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenQueueBookmarksTriggered()
+{
+  BookmarksTreeView* bookmarksView = m_Ui->bookmarksWidget->getBookmarksTreeView();
+  BookmarksModel* model = BookmarksModel::Instance();
+
+  // Walk the selection depth first so that the pipelines of a folder are queued in the order they are shown
+  QStringList filePaths;
+  QModelIndexList indexes = bookmarksView->selectionModel()->selectedRows();
+  while(!indexes.isEmpty())
+  {
+    QModelIndex index = indexes.takeFirst();
+    if(model->hasChildren(index))
+    {
+      for(int row = model->rowCount(index) - 1; row >= 0; row--)
+      {
+        indexes.push_front(model->index(row, 0, index));
+      }
+      continue;
+    }
+
+    QString path = model->data(index, static_cast<int>(BookmarksModel::Roles::PathRole)).toString();
+    if(!path.isEmpty() && QFileInfo(path).isFile() && !filePaths.contains(path))
+    {
+      filePaths.push_back(path);
+    }
+  }
+
+  if(filePaths.isEmpty())
+  {
+    setStatusBarMessage(tr("Select the bookmarks or bookmark folders to add to the batch queue."));
+    return;
+  }
+
+  m_BatchQueueWidget->addPipelineFiles(filePaths);
+  m_BatchQueueDockWidget->show();
+  m_BatchQueueDockWidget->raise();
+  setStatusBarMessage(tr("Added %1 pipelines to the batch queue.").arg(filePaths.size()));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenParameterSweepTriggered()
+{
+  if(getPipelineModel()->rowCount() == 0)
+  {
+    setStatusBarMessage(tr("Add filters to the pipeline before sweeping its parameters."));
+    return;
+  }
+
+  // The sweep works on the pipeline as it is in the window, whether or not it has been saved
+  QTemporaryDir tempDir;
+  QString filePath = tempDir.filePath("ParameterSweep.json");
+  SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
+  if(!tempDir.isValid() || viewWidget->writePipeline(filePath) < 0)
+  {
+    QMessageBox::warning(this, tr("Parameter Sweep"), tr("The pipeline could not be written to a temporary file."));
+    return;
+  }
+
+  ParameterSweepDialog dialog(filePath, this);
+  dialog.exec();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenWatchDirectoryTriggered()
+{
+  // A running watch keeps its pipeline, it has to be stopped before the current pipeline can be watched
+  if(m_WatchDirectoryDialog != nullptr && m_WatchDirectoryDialog->isWatching())
+  {
+    m_WatchDirectoryDialog->show();
+    m_WatchDirectoryDialog->raise();
+    return;
+  }
+
+  if(getPipelineModel()->rowCount() == 0)
+  {
+    setStatusBarMessage(tr("Add filters to the pipeline before watching a directory with it."));
+    return;
+  }
+
+  QTemporaryDir tempDir;
+  QString filePath = tempDir.filePath("WatchDirectory.json");
+  SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
+  if(!tempDir.isValid() || viewWidget->writePipeline(filePath) < 0)
+  {
+    QMessageBox::warning(this, tr("Watch Directory"), tr("The pipeline could not be written to a temporary file."));
+    return;
+  }
+
+  delete m_WatchDirectoryDialog;
+  m_WatchDirectoryDialog = new WatchDirectoryDialog(filePath, this);
+  connect(m_WatchDirectoryDialog, &WatchDirectoryDialog::runMessage, this, &SIMPLView_UI::addStdOutputMessage);
+  m_WatchDirectoryDialog->show();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenExecuteIncrementallyTriggered()
+{
+  if(m_IncrementalPipeline.get() != nullptr)
+  {
+    m_IncrementalPipeline->cancel();
+    m_ActionExecuteIncrementally->setEnabled(false);
+    return;
+  }
+
+  executeIncrementally(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenResumeFromCheckpointTriggered()
+{
+  if(m_IncrementalPipeline.get() != nullptr)
+  {
+    setStatusBarMessage(tr("The pipeline is already executing incrementally."));
+    return;
+  }
+
+  if(PipelineCheckpointer::FindResumeIndex(ReadCheckpointDirectory(), computeStageKeys()) < 0)
+  {
+    QMessageBox::information(this, tr("Resume from Checkpoint"),
+                             tr("There is no checkpoint for this pipeline. A checkpoint is only used while the filter it was written after and every filter in front of it are unchanged."));
+    return;
+  }
+
+  executeIncrementally(true);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::executeIncrementally(bool fromCheckpoint)
+{
+  QString title = fromCheckpoint ? tr("Resume from Checkpoint") : tr("Execute Incrementally");
+  if(getPipelineModel()->rowCount() == 0)
+  {
+    setStatusBarMessage(tr("Add filters to the pipeline before executing it."));
+    return;
+  }
+
+  // Like the parameter sweep, the incremental execution works on a copy of the pipeline in the window
+  QSharedPointer<QTemporaryDir> tempDir(new QTemporaryDir);
+  QString filePath = tempDir->filePath("IncrementalPipeline.json");
+  SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
+  if(!tempDir->isValid() || viewWidget->writePipeline(filePath) < 0)
+  {
+    QMessageBox::warning(this, title, tr("The pipeline could not be written to a temporary file."));
+    return;
+  }
+
+  IncrementalPipeline::Pointer incremental = IncrementalPipeline::New();
+  QString error;
+  if(!incremental->setPipelineFile(filePath, error))
+  {
+    QMessageBox::warning(this, title, error);
+    return;
+  }
+  incremental->setCheckpointer(createCheckpointer());
+  incremental->setResumeFromCheckpoint(fromCheckpoint);
+
+  PipelineMessageChannel* channel = &m_MessageChannel;
+  QTimer* messageTimer = m_MessageTimer;
+  incremental->setMessageHandler([channel, messageTimer](const PipelineMessage& msg) {
+    if(channel->post(msg))
+    {
+      QMetaObject::invokeMethod(messageTimer, "start", Qt::QueuedConnection);
+    }
+  });
+
+  m_IncrementalPipeline = incremental;
+  m_LastStageKeys = incremental->getStageKeys();
+  m_ActionExecuteIncrementally->setText(tr("Cancel Incremental Execution"));
+  setStatusBarMessage(fromCheckpoint ? tr("Resuming the pipeline from its last checkpoint...") : tr("Executing the pipeline incrementally..."));
+
+  m_IncrementalWatcher->setFuture(QtConcurrent::run([incremental, tempDir] {
+    QString error;
+    incremental->execute(error);
+    return error;
+  }));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::incrementalExecutionFinished()
+{
+  m_MessageTimer->stop();
+  flushPipelineMessages();
+
+  IncrementalPipeline::Pointer incremental = m_IncrementalPipeline;
+  m_IncrementalPipeline.reset();
+  m_ActionExecuteIncrementally->setText(tr("Execute Incrementally"));
+  m_ActionExecuteIncrementally->setEnabled(true);
+
+  QString error = m_IncrementalWatcher->result();
+  logCheckpoints(incremental->getCheckpointer());
+  QString summary;
+  if(error.isEmpty())
+  {
+    summary = tr("Reused %1 filters from the %2, executed %3 in %4 s")
+                  .arg(incremental->getResumeIndex() + 1)
+                  .arg(incremental->getResumedFromCheckpoint() ? tr("checkpoint") : tr("stage cache"))
+                  .arg(incremental->getExecutedFilterCount())
+                  .arg(static_cast<double>(incremental->getWallTimeMSecs()) / 1000.0, 0, 'f', 2);
+    m_Ui->stdOutWidget->appendLine(LogModel::Level::Status, summary);
+  }
+  else
+  {
+    summary = error;
+    m_Ui->stdOutWidget->appendLine(LogModel::Level::Error, summary);
+  }
+  setStatusBarMessage(summary);
+
+  updateStageStates();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList SIMPLView_UI::computeStageKeys()
+{
+  // The keys are computed from the same JSON that an incremental execution would see
+  QTemporaryDir tempDir;
+  QString filePath = tempDir.filePath("StageKeys.json");
+  SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
+  if(!tempDir.isValid() || viewWidget->writePipeline(filePath) < 0)
+  {
+    return QStringList();
+  }
+
+  QFile file(filePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return QStringList();
+  }
+  return StageCache::ComputeStageKeys(QJsonDocument::fromJson(file.readAll()).object());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::updateStageStates()
+{
+  PipelineModel* model = getPipelineModel();
+  StageCache* cache = StageCache::Instance();
+  if(model->rowCount() == 0 || cache->getSnapshotCount() == 0)
+  {
+    m_ProfilerItemDelegate->setStageStates(QVector<ProfilerItemDelegate::StageState>());
+    return;
+  }
+
+  QStringList keys = computeStageKeys();
+  if(keys.isEmpty())
+  {
+    return;
+  }
+
+  int invalidated = 0;
+  QVector<ProfilerItemDelegate::StageState> states(model->rowCount(), ProfilerItemDelegate::StageState::None);
+  for(int i = 0; i < states.size() && i < keys.size(); i++)
+  {
+    if(cache->contains(keys[i]))
+    {
+      states[i] = ProfilerItemDelegate::StageState::Cached;
+    }
+    else if(i < m_LastStageKeys.size() && m_LastStageKeys[i] != keys[i] && cache->contains(m_LastStageKeys[i]))
+    {
+      states[i] = ProfilerItemDelegate::StageState::Invalidated;
+      invalidated++;
+    }
+  }
+  m_ProfilerItemDelegate->setStageStates(states);
+
+  if(invalidated > 0)
+  {
+    setStatusBarMessage(tr("The edit invalidated the cached results of %1 filters").arg(invalidated));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::backgroundPreflightFinished(FilterPipeline::Pointer pipeline, QVector<PipelineMessage> messages, int err)
+{
+  m_Ui->issuesWidget->clearIssues();
+  for(const PipelineMessage& msg : messages)
+  {
+    m_Ui->issuesWidget->processPipelineMessage(msg);
+  }
+
+  m_Ui->dataBrowserWidget->refreshData();
+  m_Ui->issuesWidget->displayCachedMessages();
+
+  // Without a pipeline only re-created filters were updated and the outcome of the preflight did not change
+  if(pipeline.get() != nullptr)
+  {
+    m_Ui->pipelineListWidget->preflightFinished(pipeline, err);
+  }
+
+  analyzePreflight();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenStageCacheBudgetTriggered()
+{
+  StageCache* cache = StageCache::Instance();
+  bool ok = false;
+  int budgetMB = QInputDialog::getInt(this, tr("Stage Cache"), tr("Memory budget for filter snapshots (MB):"), cache->getBudgetMB(), 0, 1024 * 1024, 256, &ok);
+  if(ok)
+  {
+    cache->setBudgetMB(budgetMB);
+    cache->writeSettings();
+    updateStageStates();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenStageCacheOnDiskToggled(bool onDisk)
+{
+  StageCache* cache = StageCache::Instance();
+  cache->setStorage(onDisk ? StageCache::Storage::Disk : StageCache::Storage::Memory);
+  cache->writeSettings();
+  updateStageStates();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenClearStageCacheTriggered()
+{
+  StageCache::Instance()->clear();
+  updateStageStates();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenMemoryBudgetTriggered()
+{
+  bool ok = false;
+  int budgetMB = QInputDialog::getInt(this, tr("Memory Budget"), tr("Memory for the arrays of a pipeline run, beyond which arrays are spilled to disk (MB, 0 = no budget):"),
+                                      static_cast<int>(m_ArraySpiller->getBudgetMB()), 0, 1024 * 1024 * 1024, 1024, &ok);
+  if(ok)
+  {
+    m_ArraySpiller->setBudgetMB(budgetMB);
+    WriteMemoryBudgetMB(budgetMB);
+    updateMemoryEstimate();
+
+    // Arrays of the last run that did not fit the old budget may fit the new one
+    if(!m_ArraySpiller->getArraysOnDisk().isEmpty())
+    {
+      int onDisk = m_ArraySpiller->restoreSpilledArrays();
+      m_Ui->dataBrowserWidget->refreshData();
+      setStatusBarMessage(tr("%1 arrays of the last run are still on disk").arg(onDisk));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenKeepAllArraysToggled(bool keepAll)
+{
+  m_ArrayLiveness->setKeepEverything(keepAll);
+  WriteKeepAllArrays(keepAll);
+  updateDroppedArrays(m_ArrayLiveness->getPlan());
+  updateMemoryEstimate();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::analyzePreflight()
+{
+  m_ArrayLiveness->analyze(getPipelineFilters());
+  updateDroppedArrays(m_ArrayLiveness->getPlan());
+  updateMemoryEstimate();
+  m_PipelineEta->setPipeline(getPipelineFilters());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLView_UI::exceedsAvailableMemory(qint64 availableBytes) const
+{
+  if(availableBytes <= 0 || m_MemoryEstimate.peakBytes <= availableBytes)
+  {
+    return false;
+  }
+
+  // The spiller keeps the arrays within a budget that fits
+  qint64 budgetBytes = m_ArraySpiller->getBudgetMB() * 1024 * 1024;
+  return budgetBytes <= 0 || budgetBytes > availableBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::updateMemoryEstimate()
+{
+  QVector<ArrayLiveness::DeadArray> freedArrays;
+  if(!m_ArrayLiveness->getKeepEverything())
+  {
+    freedArrays = m_ArrayLiveness->getPlan();
+  }
+  m_MemoryEstimate = MemoryEstimator::EstimatePipeline(getPipelineFilters(), freedArrays);
+
+  qint64 availableBytes = ProcessStats::AvailableMemoryBytes();
+  QString text = MemoryEstimator::Summary(m_MemoryEstimate, availableBytes);
+  if(exceedsAvailableMemory(availableBytes))
+  {
+    text = tr("Warning: %1. The run is likely to swap or fail.").arg(text);
+  }
+  m_Ui->memoryEstimateLabel->setText(text);
+  m_Ui->memoryEstimateLabel->setToolTip(MemoryEstimator::Timeline(m_MemoryEstimate).join("\n"));
+  m_Ui->memoryEstimateLabel->setVisible(m_MemoryEstimate.peakStep >= 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::updateEta()
+{
+  if(!m_PipelineEta->isRunning())
+  {
+    return;
+  }
+
+  for(const PipelineProfiler::FilterProfile& profile : m_Profiler->getProfiles())
+  {
+    if(profile.errorCode >= 0)
+    {
+      m_PipelineEta->filterFinished(profile.index, profile.wallUSecs / 1000);
+    }
+  }
+  m_EtaLabel->setText(m_PipelineEta->statusText());
+  m_EtaLabel->show();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::updateDroppedArrays(const QVector<ArrayLiveness::DeadArray>& deadArrays)
+{
+  m_Ui->droppedArraysList->clear();
+  bool visible = !m_ArrayLiveness->getKeepEverything() && !deadArrays.isEmpty();
+  m_Ui->droppedArraysLabel->setVisible(visible);
+  m_Ui->droppedArraysList->setVisible(visible);
+  if(!visible)
+  {
+    return;
+  }
+
+  for(const ArrayLiveness::DeadArray& deadArray : deadArrays)
+  {
+    QListWidgetItem* item = new QListWidgetItem(deadArray.path.serialize("/"), m_Ui->droppedArraysList);
+    item->setToolTip(tr("Freed after filter %1, %2 (%3 bytes)").arg(deadArray.filterIndex + 1).arg(deadArray.filterLabel).arg(deadArray.bytes));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenCheckpointSelectedFiltersTriggered()
+{
+  SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
+  QModelIndexList selectedIndexes = viewWidget->selectionModel()->selectedRows();
+  if(selectedIndexes.isEmpty())
+  {
+    setStatusBarMessage(tr("Select the filters in the pipeline that a checkpoint should be written after."));
+    return;
+  }
+
+  // Toggles the selection as a whole, a mixed selection is marked
+  PipelineModel* model = getPipelineModel();
+  bool allMarked = true;
+  for(const QModelIndex& index : selectedIndexes)
+  {
+    AbstractFilter::Pointer filter = model->filter(index);
+    allMarked = allMarked && filter.get() != nullptr && filter->property(k_CheckpointProperty).toBool();
+  }
+  for(const QModelIndex& index : selectedIndexes)
+  {
+    AbstractFilter::Pointer filter = model->filter(index);
+    if(filter.get() != nullptr)
+    {
+      filter->setProperty(k_CheckpointProperty, allMarked ? QVariant() : QVariant(true));
+    }
+  }
+  attachCheckpointer();
+
+  int markedCount = 0;
+  for(const AbstractFilter::Pointer& filter : getPipelineFilters())
+  {
+    markedCount += filter->property(k_CheckpointProperty).toBool() ? 1 : 0;
+  }
+  setStatusBarMessage(tr("A checkpoint is written after %1 selected filters").arg(markedCount));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenCheckpointAfterMinutesTriggered()
+{
+  bool ok = false;
+  int minutes = QInputDialog::getInt(this, tr("Checkpoint Long Filters"), tr("Write a checkpoint after every filter that runs at least this long (minutes, 0 = never):"),
+                                     ReadCheckpointAfterMinutes(), 0, 7 * 24 * 60, 1, &ok);
+  if(ok)
+  {
+    WriteCheckpointAfterMinutes(minutes);
+    attachCheckpointer();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenClearCheckpointsTriggered()
+{
+  int removed = PipelineCheckpointer::ClearDirectory(ReadCheckpointDirectory());
+  setStatusBarMessage(tr("Removed %1 checkpoints").arg(removed));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenExecuteInWorkerTriggered()
+{
+  if(m_WorkerRunId != 0)
+  {
+    WorkerPool::Instance()->cancel(m_WorkerRunId);
+    return;
+  }
+
+  if(getPipelineModel()->rowCount() == 0)
+  {
+    setStatusBarMessage(tr("Add filters to the pipeline before executing it."));
+    return;
+  }
+
+  QTemporaryDir tempDir;
+  QString filePath = tempDir.filePath("WorkerPipeline.json");
+  SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
+  QFile file(filePath);
+  if(!tempDir.isValid() || viewWidget->writePipeline(filePath) < 0 || !file.open(QIODevice::ReadOnly))
+  {
+    QMessageBox::warning(this, tr("Execute in Worker Process"), tr("The pipeline could not be written to a temporary file."));
+    return;
+  }
+  QJsonObject pipelineJson = QJsonDocument::fromJson(file.readAll()).object();
+
+  m_Ui->issuesWidget->clearIssues();
+  m_Ui->pipelineListWidget->setProgressValue(0);
+  m_ActionExecuteInWorker->setText(tr("Cancel Worker Execution"));
+  setStatusBarMessage(tr("Executing the pipeline in a worker process..."));
+  m_WorkerRunTimer.start();
+  m_WorkerRunId = WorkerPool::Instance()->execute(pipelineJson, true);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenAlwaysUseWorkersToggled(bool useWorkers)
+{
+  WriteAlwaysUseWorkers(useWorkers);
+  if(useWorkers)
+  {
+    WorkerPool::Instance()->warmUp();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenWorkerProcessesTriggered()
+{
+  WorkerPool* workerPool = WorkerPool::Instance();
+  bool ok = false;
+  int workerCount = QInputDialog::getInt(this, tr("Worker Processes"), tr("Number of worker processes that are kept ready with their plugins loaded:"), workerPool->getWorkerCount(), 1,
+                                         QThread::idealThreadCount(), 1, &ok);
+  if(ok)
+  {
+    workerPool->setWorkerCount(workerCount);
+    workerPool->warmUp();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::workerRunMessage(int id, const PipelineMessage& msg)
+{
+  if(id != m_WorkerRunId)
+  {
+    return;
+  }
+
+  if(msg.getType() == PipelineMessage::MessageType::Error || msg.getType() == PipelineMessage::MessageType::Warning)
+  {
+    m_Ui->issuesWidget->processPipelineMessage(msg);
+  }
+  processPipelineMessage(msg);
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void SIMPLView_UI::listenSavePipelineAsTriggered()
+void SIMPLView_UI::workerRunFinished(int id, int errorCode, const QString& message, const QJsonObject& arrays)
 {
-  savePipelineAs();
+  if(id != m_WorkerRunId)
+  {
+    return;
+  }
+  m_WorkerRunId = 0;
+
+  m_MessageTimer->stop();
+  flushPipelineMessages();
+  m_ActionExecuteInWorker->setText(tr("Execute in Worker Process"));
+  m_Ui->pipelineListWidget->setProgressValue(0);
+
+  // The arrays are filled into a copy of the structure that the preflight built for the last enabled filter,
+  // which is where the data browser looks for the result of the pipeline
+  PipelineModel* model = getPipelineModel();
+  AbstractFilter::Pointer lastFilter;
+  for(int i = model->rowCount() - 1; i >= 0 && lastFilter.get() == nullptr; i--)
+  {
+    AbstractFilter::Pointer filter = model->filter(model->index(i, PipelineItem::PipelineItemData::Contents));
+    if(filter.get() != nullptr && filter->getEnabled())
+    {
+      lastFilter = filter;
+    }
+  }
+
+  int importedArrays = 0;
+  QString importError;
+  if(errorCode >= 0 && lastFilter.get() != nullptr && lastFilter->getDataContainerArray().get() != nullptr)
+  {
+    DataContainerArray::Pointer dca = lastFilter->getDataContainerArray()->deepCopy(true);
+    importedArrays = WorkerProtocol::ImportArrays(arrays, dca, importError);
+    lastFilter->setDataContainerArray(dca);
+    m_Ui->dataBrowserWidget->filterActivated(lastFilter);
+  }
+
+  QString summary;
+  if(errorCode < 0)
+  {
+    summary = message.isEmpty() ? tr("The worker process failed with error %1").arg(errorCode) : message;
+    m_Ui->stdOutWidget->appendLine(LogModel::Level::Error, summary);
+  }
+  else
+  {
+    summary = tr("Executed in a worker process in %1 s, %2 arrays returned")
+                  .arg(static_cast<double>(m_WorkerRunTimer.elapsed()) / 1000.0, 0, 'f', 2)
+                  .arg(importedArrays);
+    m_Ui->stdOutWidget->appendLine(LogModel::Level::Status, summary);
+  }
+  if(!importError.isEmpty())
+  {
+    m_Ui->stdOutWidget->appendLine(LogModel::Level::Warning, importError);
+  }
+  m_Ui->issuesWidget->displayCachedMessages();
+  setStatusBarMessage(summary);
+
+  // The next edit preflights from scratch, but not now, that would replace the arrays in the data browser
+  if(m_BackgroundPreflight != nullptr)
+  {
+    m_BackgroundPreflight->invalidate();
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -397,14 +1359,13 @@ void SIMPLView_UI::readSettings()
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::readWindowSettings()
 {
-  QSharedPointer<QtSSettings> prefs = QSharedPointer<QtSSettings>(new QtSSettings());
+  // The window settings are written through the store, which also has the ones that have not reached the file yet
+  SettingsStore* store = SettingsStore::Instance();
 
-  bool ok = false;
-  prefs->beginGroup("WindowSettings");
-  if(prefs->contains(QString("MainWindowGeometry")))
+  QByteArray geo_data = store->value("WindowSettings/MainWindowGeometry", QByteArray()).toByteArray();
+  if(!geo_data.isEmpty())
   {
-    QByteArray geo_data = prefs->value("MainWindowGeometry", QByteArray());
-    ok = restoreGeometry(geo_data);
+    bool ok = restoreGeometry(geo_data);
     if(!ok)
     {
       qDebug() << "Error Restoring the Window Geometry"
@@ -412,13 +1373,11 @@ void SIMPLView_UI::readWindowSettings()
     }
   }
 
-  if(prefs->contains(QString("MainWindowState")))
+  QByteArray layout_data = store->value("WindowSettings/MainWindowState", QByteArray()).toByteArray();
+  if(!layout_data.isEmpty())
   {
-    QByteArray layout_data = prefs->value("MainWindowState", QByteArray());
     restoreState(layout_data);
   }
-
-  prefs->endGroup();
 }
 
 // -----------------------------------------------------------------------------
@@ -464,15 +1423,15 @@ void SIMPLView_UI::writeVersionCheckSettings()
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::writeWindowSettings()
 {
-  QSharedPointer<QtSSettings> prefs = QSharedPointer<QtSSettings>(new QtSSettings());
-
-  prefs->beginGroup("WindowSettings");
+  // This runs on every resize and dock move, so let the store coalesce the writes
   QByteArray geo_data = saveGeometry();
   QByteArray layout_data = saveState();
-  prefs->setValue(QString("MainWindowGeometry"), geo_data);
-  prefs->setValue(QString("MainWindowState"), layout_data);
-
-  prefs->endGroup();
+  SettingsStore::Instance()->write([geo_data, layout_data](SettingsWriter* prefs) {
+    prefs->beginGroup("WindowSettings");
+    prefs->setValue(QString("MainWindowGeometry"), geo_data);
+    prefs->setValue(QString("MainWindowState"), layout_data);
+    prefs->endGroup();
+  });
 }
 
 // -----------------------------------------------------------------------------
@@ -495,8 +1454,25 @@ void SIMPLView_UI::setupGui()
 
   SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
 
-  PipelineItemDelegate* delegate = new PipelineItemDelegate(viewWidget);
-  viewWidget->setItemDelegate(delegate);
+  // The profiler's delegate paints the heat map of the last run over the usual pipeline items
+  m_Profiler = new PipelineProfiler(this);
+  m_ProfilerItemDelegate = new ProfilerItemDelegate(viewWidget, m_Profiler);
+  viewWidget->setItemDelegate(m_ProfilerItemDelegate);
+
+  // The status bar counts down to the end of a run, from the timings of earlier runs
+  m_PipelineEta = PipelineEta::New();
+  m_EtaLabel = new QLabel(this);
+  m_EtaLabel->hide();
+  statusBar()->addPermanentWidget(m_EtaLabel);
+  m_EtaTimer = new QTimer(this);
+  m_EtaTimer->setInterval(1000);
+  connect(m_EtaTimer, &QTimer::timeout, this, &SIMPLView_UI::updateEta);
+  connect(m_Profiler, &PipelineProfiler::runStarted, this, [=] {
+    m_PipelineEta->start();
+    m_EtaTimer->start();
+    updateEta();
+  });
+  connect(m_Profiler, &PipelineProfiler::profileUpdated, this, &SIMPLView_UI::updateEta);
 
   // Create the model
   PipelineModel* model = new PipelineModel(this);
@@ -507,7 +1483,78 @@ void SIMPLView_UI::setupGui()
   // Set the IssuesWidget as a PipelineMessageObserver Object.
   viewWidget->addPipelineMessageObserver(m_Ui->issuesWidget);
 
-  createSIMPLViewMenuSystem();
+  // Edits are preflighted on a worker thread instead of by the view while the user is still typing
+  if(BackgroundPreflight::ReadEnabled())
+  {
+    m_BackgroundPreflight = new BackgroundPreflight(viewWidget, this);
+    connect(m_BackgroundPreflight, &BackgroundPreflight::preflightFinished, this, &SIMPLView_UI::backgroundPreflightFinished);
+    viewWidget->blockPreflightSignals(true);
+  }
+
+  m_MessageTimer = new QTimer(this);
+  m_MessageTimer->setSingleShot(true);
+  m_MessageTimer->setInterval(PipelineMessageChannel::RefreshIntervalMSecs);
+  connect(m_MessageTimer, &QTimer::timeout, this, &SIMPLView_UI::flushPipelineMessages);
+
+  // Keeps the arrays of a run within the memory budget. Spills and refills show up in the status bar while the
+  // pipeline runs and are listed in the log once it has finished.
+  m_ArraySpiller = ArraySpiller::New();
+  m_ArraySpiller->setBudgetMB(ReadMemoryBudgetMB());
+  PipelineMessageChannel* channel = &m_MessageChannel;
+  QTimer* messageTimer = m_MessageTimer;
+  m_ArraySpiller->setActivityHandler([channel, messageTimer](const QString& activity) {
+    if(channel->postStatus(activity))
+    {
+      QMetaObject::invokeMethod(messageTimer, "start", Qt::QueuedConnection);
+    }
+  });
+
+  // Frees the arrays of a run that no later filter uses. The data browser lists them under the structure.
+  m_ArrayLiveness = ArrayLiveness::New();
+  m_ArrayLiveness->setKeepEverything(ReadKeepAllArrays());
+  updateDroppedArrays(QVector<ArrayLiveness::DeadArray>());
+  m_Ui->memoryEstimateLabel->hide();
+
+  m_IncrementalWatcher = new QFutureWatcher<QString>(this);
+  connect(m_IncrementalWatcher, &QFutureWatcher<QString>::finished, this, &SIMPLView_UI::incrementalExecutionFinished);
+
+  // The pool is shared by all windows. Its workers load the plugins when they start, so it is started
+  // before the first pipeline needs it if every execution goes to a worker.
+  WorkerPool* workerPool = WorkerPool::Instance();
+  connect(workerPool, &WorkerPool::runMessage, this, &SIMPLView_UI::workerRunMessage);
+  connect(workerPool, &WorkerPool::runFinished, this, &SIMPLView_UI::workerRunFinished);
+  if(ReadAlwaysUseWorkers())
+  {
+    workerPool->warmUp();
+  }
+
+  // Edits come in bursts while a parameter is typed, the stage markers only follow once it settles
+  m_StageStateTimer = new QTimer(this);
+  m_StageStateTimer->setSingleShot(true);
+  m_StageStateTimer->setInterval(300);
+  connect(m_StageStateTimer, &QTimer::timeout, this, &SIMPLView_UI::updateStageStates);
+
+  // The batch queue is shared by all windows, each window only gets a view of it
+  m_BatchQueueDockWidget = new QDockWidget(tr("Batch Queue"), this);
+  m_BatchQueueDockWidget->setObjectName("batchQueueDockWidget");
+  m_BatchQueueWidget = new BatchQueueWidget(m_BatchQueueDockWidget);
+  m_BatchQueueDockWidget->setWidget(m_BatchQueueWidget);
+  addDockWidget(Qt::BottomDockWidgetArea, m_BatchQueueDockWidget);
+  tabifyDockWidget(m_Ui->stdOutDockWidget, m_BatchQueueDockWidget);
+  m_BatchQueueDockWidget->hide();
+
+  m_ProfilerDockWidget = new QDockWidget(tr("Profiler"), this);
+  m_ProfilerDockWidget->setObjectName("profilerDockWidget");
+  m_ProfilerWidget = new PipelineProfilerWidget(m_Profiler, m_ProfilerItemDelegate, m_ProfilerDockWidget);
+  m_ProfilerDockWidget->setWidget(m_ProfilerWidget);
+  addDockWidget(Qt::BottomDockWidgetArea, m_ProfilerDockWidget);
+  tabifyDockWidget(m_Ui->stdOutDockWidget, m_ProfilerDockWidget);
+  m_ProfilerDockWidget->hide();
+
+  {
+    StartupTraceScope traceScope("SIMPLView_UI::createSIMPLViewMenuSystem");
+    createSIMPLViewMenuSystem();
+  }
 
   // Hook up the signals from the various docks to the PipelineViewWidget that will either add a filter
   // or load an entire pipeline into the view
@@ -515,10 +1562,16 @@ void SIMPLView_UI::setupGui()
 
   // This will set the initial list of filters in the FilterListToolboxWidget
   // Tell the Filter Library that we have more Filters (potentially)
-  m_Ui->filterLibraryWidget->refreshFilterGroups();
+  {
+    StartupTraceScope traceScope("FilterLibraryToolboxWidget::refreshFilterGroups");
+    m_Ui->filterLibraryWidget->refreshFilterGroups();
+  }
 
   // Read the toolbox settings and update the filter list
-  m_Ui->filterListWidget->loadFilterList();
+  {
+    StartupTraceScope traceScope("FilterListToolboxWidget::loadFilterList");
+    m_Ui->filterListWidget->loadFilterList();
+  }
 
   tabifyDockWidget(m_Ui->filterListDockWidget, m_Ui->filterLibraryDockWidget);
   tabifyDockWidget(m_Ui->filterLibraryDockWidget, m_Ui->bookmarksDockWidget);
@@ -552,6 +1605,8 @@ void SIMPLView_UI::setupGui()
   connectDockWidgetSignalsSlots(m_Ui->issuesDockWidget);
   connectDockWidgetSignalsSlots(m_Ui->pipelineDockWidget);
   connectDockWidgetSignalsSlots(m_Ui->stdOutDockWidget);
+  connectDockWidgetSignalsSlots(m_BatchQueueDockWidget);
+  connectDockWidgetSignalsSlots(m_ProfilerDockWidget);
 
   m_Ui->bookmarksDockWidget->installEventFilter(this);
   m_Ui->dataBrowserDockWidget->installEventFilter(this);
@@ -560,6 +1615,42 @@ void SIMPLView_UI::setupGui()
   m_Ui->issuesDockWidget->installEventFilter(this);
   m_Ui->pipelineDockWidget->installEventFilter(this);
   m_Ui->stdOutDockWidget->installEventFilter(this);
+  m_BatchQueueDockWidget->installEventFilter(this);
+  m_ProfilerDockWidget->installEventFilter(this);
+
+  // The dock's Start button executes the pipeline view directly, which would bypass the worker processes
+  // and the memory check. Its clicked signal, however the button was triggered, comes here instead, and the
+  // PipelineListWidget's own slot still handles its Cancel.
+  m_StartPipelineButton = m_Ui->pipelineListWidget->findChild<QAbstractButton*>("startPipelineBtn");
+  if(m_StartPipelineButton == nullptr || !disconnect(m_StartPipelineButton, nullptr, m_Ui->pipelineListWidget, nullptr))
+  {
+    qCritical() << "The pipeline dock's Start button was not found; it bypasses the worker processes and the memory check";
+    m_StartPipelineButton = nullptr;
+  }
+  else
+  {
+    connect(m_StartPipelineButton, &QAbstractButton::clicked, this, &SIMPLView_UI::listenStartPipelineClicked);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenStartPipelineClicked()
+{
+  if(m_Ui->pipelineListWidget->getPipelineView()->isPipelineCurrentlyRunning())
+  {
+    QMetaObject::invokeMethod(m_Ui->pipelineListWidget, "on_startPipelineBtn_clicked");
+  }
+  else if(m_WorkerRunId != 0)
+  {
+    // The button is not turned into Cancel for a worker run, a second click cancels it
+    listenExecuteInWorkerTriggered();
+  }
+  else
+  {
+    executePipeline();
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -610,6 +1701,28 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   m_ActionCheckForUpdates = new QAction("Check For Updates", this);
   m_ActionPluginInformation = new QAction("Plugin Information", this);
   m_ActionClearCache = new QAction("Reset Preferences", this);
+  m_ActionQueueBookmarks = new QAction("Add to Batch Queue", this);
+  m_ActionParameterSweep = new QAction("Parameter Sweep...", this);
+  m_ActionWatchDirectory = new QAction("Watch Directory...", this);
+  m_ActionExecuteIncrementally = new QAction("Execute Incrementally", this);
+  m_ActionStageCacheBudget = new QAction("Snapshot Budget...", this);
+  m_ActionStageCacheOnDisk = new QAction("Keep Snapshots on Disk", this);
+  m_ActionStageCacheOnDisk->setCheckable(true);
+  m_ActionStageCacheOnDisk->setChecked(StageCache::Instance()->getStorage() == StageCache::Storage::Disk);
+  m_ActionClearStageCache = new QAction("Clear Stage Cache", this);
+  m_ActionMemoryBudget = new QAction("Memory Budget...", this);
+  m_ActionKeepAllArrays = new QAction("Keep All Arrays", this);
+  m_ActionKeepAllArrays->setCheckable(true);
+  m_ActionKeepAllArrays->setChecked(ReadKeepAllArrays());
+  m_ActionExecuteInWorker = new QAction("Execute in Worker Process", this);
+  m_ActionAlwaysUseWorkers = new QAction("Always Execute in Worker Processes", this);
+  m_ActionAlwaysUseWorkers->setCheckable(true);
+  m_ActionAlwaysUseWorkers->setChecked(ReadAlwaysUseWorkers());
+  m_ActionWorkerProcesses = new QAction("Worker Processes...", this);
+  m_ActionCheckpointSelectedFilters = new QAction("Checkpoint After Selected Filters", this);
+  m_ActionCheckpointAfterMinutes = new QAction("Checkpoint Long Filters...", this);
+  m_ActionResumeFromCheckpoint = new QAction("Resume from Checkpoint", this);
+  m_ActionClearCheckpoints = new QAction("Clear Checkpoints", this);
 
   // SIMPLView_UI Actions
   connect(m_ActionNew, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenNewInstanceTriggered);
@@ -623,6 +1736,22 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   connect(m_ActionShowSIMPLViewHelp, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenShowSIMPLViewHelpTriggered);
   connect(m_ActionPluginInformation, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenDisplayPluginInfoDialogTriggered);
   connect(m_ActionClearCache, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenClearSIMPLViewCacheTriggered);
+  connect(m_ActionQueueBookmarks, &QAction::triggered, this, &SIMPLView_UI::listenQueueBookmarksTriggered);
+  connect(m_ActionParameterSweep, &QAction::triggered, this, &SIMPLView_UI::listenParameterSweepTriggered);
+  connect(m_ActionWatchDirectory, &QAction::triggered, this, &SIMPLView_UI::listenWatchDirectoryTriggered);
+  connect(m_ActionExecuteIncrementally, &QAction::triggered, this, &SIMPLView_UI::listenExecuteIncrementallyTriggered);
+  connect(m_ActionStageCacheBudget, &QAction::triggered, this, &SIMPLView_UI::listenStageCacheBudgetTriggered);
+  connect(m_ActionStageCacheOnDisk, &QAction::toggled, this, &SIMPLView_UI::listenStageCacheOnDiskToggled);
+  connect(m_ActionClearStageCache, &QAction::triggered, this, &SIMPLView_UI::listenClearStageCacheTriggered);
+  connect(m_ActionMemoryBudget, &QAction::triggered, this, &SIMPLView_UI::listenMemoryBudgetTriggered);
+  connect(m_ActionKeepAllArrays, &QAction::toggled, this, &SIMPLView_UI::listenKeepAllArraysToggled);
+  connect(m_ActionExecuteInWorker, &QAction::triggered, this, &SIMPLView_UI::listenExecuteInWorkerTriggered);
+  connect(m_ActionAlwaysUseWorkers, &QAction::toggled, this, &SIMPLView_UI::listenAlwaysUseWorkersToggled);
+  connect(m_ActionWorkerProcesses, &QAction::triggered, this, &SIMPLView_UI::listenWorkerProcessesTriggered);
+  connect(m_ActionCheckpointSelectedFilters, &QAction::triggered, this, &SIMPLView_UI::listenCheckpointSelectedFiltersTriggered);
+  connect(m_ActionCheckpointAfterMinutes, &QAction::triggered, this, &SIMPLView_UI::listenCheckpointAfterMinutesTriggered);
+  connect(m_ActionResumeFromCheckpoint, &QAction::triggered, this, &SIMPLView_UI::listenResumeFromCheckpointTriggered);
+  connect(m_ActionClearCheckpoints, &QAction::triggered, this, &SIMPLView_UI::listenClearCheckpointsTriggered);
 
   m_ActionNew->setShortcut(QKeySequence::New);
   m_ActionOpen->setShortcut(QKeySequence::Open);
@@ -690,16 +1819,42 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   m_MenuView->addAction(m_Ui->issuesDockWidget->toggleViewAction());
   m_MenuView->addAction(m_Ui->stdOutDockWidget->toggleViewAction());
   m_MenuView->addAction(m_Ui->dataBrowserDockWidget->toggleViewAction());
+  m_MenuView->addAction(m_BatchQueueDockWidget->toggleViewAction());
+  m_MenuView->addAction(m_ProfilerDockWidget->toggleViewAction());
 
   // Create Bookmarks Menu
   m_SIMPLViewMenu->addMenu(m_MenuBookmarks);
   m_MenuBookmarks->addAction(actionAddBookmark);
   m_MenuBookmarks->addSeparator();
   m_MenuBookmarks->addAction(actionNewFolder);
+  m_MenuBookmarks->addSeparator();
+  m_MenuBookmarks->addAction(m_ActionQueueBookmarks);
 
   // Create Pipeline Menu
   m_SIMPLViewMenu->addMenu(m_MenuPipeline);
   m_MenuPipeline->addAction(actionClearPipeline);
+  m_MenuPipeline->addSeparator();
+  m_MenuPipeline->addAction(m_ActionParameterSweep);
+  m_MenuPipeline->addAction(m_ActionWatchDirectory);
+  m_MenuPipeline->addSeparator();
+  m_MenuPipeline->addAction(m_ActionExecuteIncrementally);
+  QMenu* stageCacheMenu = m_MenuPipeline->addMenu(tr("Stage Cache"));
+  stageCacheMenu->addAction(m_ActionStageCacheBudget);
+  stageCacheMenu->addAction(m_ActionStageCacheOnDisk);
+  stageCacheMenu->addSeparator();
+  stageCacheMenu->addAction(m_ActionClearStageCache);
+  m_MenuPipeline->addAction(m_ActionMemoryBudget);
+  m_MenuPipeline->addAction(m_ActionKeepAllArrays);
+  QMenu* checkpointMenu = m_MenuPipeline->addMenu(tr("Checkpoints"));
+  checkpointMenu->addAction(m_ActionCheckpointSelectedFilters);
+  checkpointMenu->addAction(m_ActionCheckpointAfterMinutes);
+  checkpointMenu->addSeparator();
+  checkpointMenu->addAction(m_ActionResumeFromCheckpoint);
+  checkpointMenu->addAction(m_ActionClearCheckpoints);
+  m_MenuPipeline->addSeparator();
+  m_MenuPipeline->addAction(m_ActionExecuteInWorker);
+  m_MenuPipeline->addAction(m_ActionAlwaysUseWorkers);
+  m_MenuPipeline->addAction(m_ActionWorkerProcesses);
 
   // Create Help Menu
   m_SIMPLViewMenu->addMenu(m_MenuHelp);
@@ -751,9 +1906,12 @@ void SIMPLView_UI::connectSignalsSlots()
   connect(docRequester, SIGNAL(showFilterDocUrl(const QUrl&)), this, SLOT(showFilterHelpUrl(const QUrl&)));
 
   /* Filter Library Widget Connections */
+  // The plugin that provides the filter has to be loaded before the pipeline view instantiates the filter
+  connect(m_Ui->filterLibraryWidget, &FilterLibraryToolboxWidget::filterItemDoubleClicked, dream3dApp, &SIMPLViewApplication::activatePluginForFilter);
   connect(m_Ui->filterLibraryWidget, &FilterLibraryToolboxWidget::filterItemDoubleClicked, pipelineView, &SVPipelineView::addFilterFromClassName);
 
   /* Filter List Widget Connections */
+  connect(m_Ui->filterListWidget, &FilterListToolboxWidget::filterItemDoubleClicked, dream3dApp, &SIMPLViewApplication::activatePluginForFilter);
   connect(m_Ui->filterListWidget, &FilterListToolboxWidget::filterItemDoubleClicked, pipelineView, &SVPipelineView::addFilterFromClassName);
 
   /* Bookmarks Widget Connections */
@@ -770,6 +1928,12 @@ void SIMPLView_UI::connectSignalsSlots()
   connect(pipelineView, &SVPipelineView::filterParametersChanged, [=] (AbstractFilter::Pointer filter) {
     m_Ui->dataBrowserWidget->filterActivated(filter);
     markDocumentAsDirty();
+
+    // Checkpoints are named after the parameters
+    if(m_Checkpointer.get() != nullptr)
+    {
+      attachCheckpointer();
+    }
   });
   connect(pipelineView, &SVPipelineView::clearDataStructureWidgetTriggered, [=] { m_Ui->dataBrowserWidget->filterActivated(AbstractFilter::NullPointer()); });
   connect(pipelineView, &SVPipelineView::filterInputWidgetNeedsCleared, this, &SIMPLView_UI::clearFilterInputWidget);
@@ -782,9 +1946,10 @@ void SIMPLView_UI::connectSignalsSlots()
     m_Ui->dataBrowserWidget->refreshData();
     m_Ui->issuesWidget->displayCachedMessages();
     m_Ui->pipelineListWidget->preflightFinished(pipeline, err);
+    analyzePreflight();
   });
 
-  connect(pipelineView, &SVPipelineView::pipelineHasMessage, this, &SIMPLView_UI::processPipelineMessage);
+  connect(pipelineView, &SVPipelineView::pipelineHasMessage, this, &SIMPLView_UI::processPipelineViewMessage);
   connect(pipelineView, &SVPipelineView::pipelineFinished, this, &SIMPLView_UI::pipelineDidFinish);
   connect(pipelineView, &SVPipelineView::pipelineFilePathUpdated, this, &SIMPLView_UI::setWindowFilePath);
 
@@ -825,11 +1990,228 @@ void SIMPLView_UI::showDockWidget(QDockWidget* dockWidget)
   dockWidget->raise();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList SIMPLView_UI::getPipelineFilterClassNames()
+{
+  QStringList classNames;
+
+  PipelineModel* model = getPipelineModel();
+  for(int i = 0; i < model->rowCount(); i++)
+  {
+    QModelIndex index = model->index(i, PipelineItem::PipelineItemData::Contents);
+    AbstractFilter::Pointer filter = model->filter(index);
+    if(filter.get() != nullptr)
+    {
+      classNames.push_back(filter->getNameOfClass());
+    }
+  }
+
+  return classNames;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QList<AbstractFilter::Pointer> SIMPLView_UI::getPipelineFilters()
+{
+  QList<AbstractFilter::Pointer> filters;
+
+  PipelineModel* model = getPipelineModel();
+  for(int i = 0; i < model->rowCount(); i++)
+  {
+    QModelIndex index = model->index(i, PipelineItem::PipelineItemData::Contents);
+    AbstractFilter::Pointer filter = model->filter(index);
+    if(filter.get() != nullptr)
+    {
+      filters.push_back(filter);
+    }
+  }
+  return filters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::attachFilterObservers()
+{
+  // Most pipeline changes are parameter edits, which leave the observers attached to the right filters
+  QList<AbstractFilter::Pointer> filters = getPipelineFilters();
+  if(filters == m_ObservedFilters)
+  {
+    return;
+  }
+  m_ObservedFilters = filters;
+
+  m_Profiler->attach(filters);
+  // Dead arrays are freed before the spiller measures what is left
+  m_ArrayLiveness->attach(filters);
+  m_ArraySpiller->attach(filters);
+  attachCheckpointer();
+  attachMessageChannel(filters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::attachMessageChannel(const QList<AbstractFilter::Pointer>& filters)
+{
+  for(const QMetaObject::Connection& connection : m_MessageConnections)
+  {
+    disconnect(connection);
+  }
+  m_MessageConnections.clear();
+
+  // Direct connections, so a filter that reports per slice does not queue an event on the GUI thread for every message.
+  // Only the messages of an executing filter are posted; the preflight reports through the issues table.
+  PipelineMessageChannel* channel = &m_MessageChannel;
+  QTimer* messageTimer = m_MessageTimer;
+  std::atomic<AbstractFilter*>* executingFilter = &m_ExecutingFilter;
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    AbstractFilter* f = filter.get();
+    m_MessageConnections.push_back(connect(f, &AbstractFilter::filterInProgress, this, [executingFilter](AbstractFilter* started) { *executingFilter = started; }, Qt::DirectConnection));
+    m_MessageConnections.push_back(connect(f, &AbstractFilter::filterCompleted, this, [executingFilter](AbstractFilter* completed) {
+      AbstractFilter* expected = completed;
+      executingFilter->compare_exchange_strong(expected, nullptr);
+    }, Qt::DirectConnection));
+    m_MessageConnections.push_back(connect(f, &AbstractFilter::filterGeneratedMessage, this, [f, channel, messageTimer, executingFilter](const PipelineMessage& msg) {
+      if(*executingFilter == f && channel->post(msg))
+      {
+        QMetaObject::invokeMethod(messageTimer, "start", Qt::QueuedConnection);
+      }
+    }, Qt::DirectConnection));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineCheckpointer::Pointer SIMPLView_UI::createCheckpointer()
+{
+  QSet<int> selectedIndices;
+  QList<AbstractFilter::Pointer> filters = getPipelineFilters();
+  for(int i = 0; i < filters.size(); i++)
+  {
+    if(filters[i]->property(k_CheckpointProperty).toBool())
+    {
+      selectedIndices.insert(i);
+    }
+  }
+
+  PipelineCheckpointer::Pointer checkpointer = PipelineCheckpointer::New();
+  checkpointer->setDirectory(ReadCheckpointDirectory());
+  checkpointer->setAfterMinutes(ReadCheckpointAfterMinutes());
+  checkpointer->setSelectedIndices(selectedIndices);
+  checkpointer->setArraySpiller(m_ArraySpiller);
+  return checkpointer;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::attachCheckpointer()
+{
+  // The stage keys are only worth writing the pipeline out for when something is checkpointed
+  PipelineCheckpointer::Pointer checkpointer = createCheckpointer();
+  if(checkpointer->isEnabled())
+  {
+    checkpointer->attach(getPipelineFilters(), computeStageKeys());
+    m_Checkpointer = checkpointer;
+  }
+  else
+  {
+    m_Checkpointer.reset();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::logCheckpoints(const PipelineCheckpointer::Pointer& checkpointer)
+{
+  QVector<PipelineCheckpointer::Checkpoint> checkpoints = checkpointer.get() != nullptr ? checkpointer->getCheckpoints() : QVector<PipelineCheckpointer::Checkpoint>();
+  if(checkpoints.isEmpty())
+  {
+    return;
+  }
+
+  bool failed = false;
+  for(const PipelineCheckpointer::Checkpoint& checkpoint : checkpoints)
+  {
+    failed = failed || !checkpoint.written;
+  }
+  m_Ui->stdOutWidget->appendLine(failed ? LogModel::Level::Warning : LogModel::Level::Status, checkpointer->summary());
+  for(const PipelineCheckpointer::Checkpoint& checkpoint : checkpoints)
+  {
+    m_Ui->stdOutWidget->appendLine(LogModel::Level::Info, QString("  filter %1 %2  %3 (%4 bytes, %5 spilled arrays, write %6 ms)")
+                                                              .arg(checkpoint.filterIndex + 1)
+                                                              .arg(checkpoint.filterLabel)
+                                                              .arg(checkpoint.written ? checkpoint.filePath : QString("not written"))
+                                                              .arg(checkpoint.bytes)
+                                                              .arg(checkpoint.spilledArrays)
+                                                              .arg(checkpoint.writeMSecs));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::refreshFilterToolboxes()
+{
+  m_Ui->filterLibraryWidget->refreshFilterGroups();
+  m_Ui->filterListWidget->loadFilterList();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::updateFilterToolboxes(const QStringList& shownClassNames, const QStringList& hiddenClassNames)
+{
+  // Only a plugin that registers its filters for the first time adds rows that the toolboxes do not have yet
+  QList<QWidget*> toolboxes = {m_Ui->filterLibraryWidget, m_Ui->filterListWidget};
+  for(QWidget* toolbox : toolboxes)
+  {
+    bool found = SetToolboxFiltersHidden(toolbox, hiddenClassNames, true);
+    found = SetToolboxFiltersHidden(toolbox, shownClassNames, false) && found;
+    if(!found)
+    {
+      refreshFilterToolboxes();
+      return;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::setReserved(bool reserved)
+{
+  m_Reserved = reserved;
+  if(!m_Reserved)
+  {
+    // The visible windows may have been moved or rearranged since this one was built
+    readWindowSettings();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLView_UI::isReserved() const
+{
+  return m_Reserved;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 int SIMPLView_UI::openPipeline(const QString& filePath)
 {
+  // Load any plugins that the pipeline needs and that were deferred at startup, all at once
+  dream3dApp->activatePluginsForPipelineFile(filePath);
+
   SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
   int err = pipelineView->openPipeline(filePath);
   if (err >= 0)
@@ -840,6 +2222,14 @@ int SIMPLView_UI::openPipeline(const QString& filePath)
       QModelIndex index = model->index(0, PipelineItem::PipelineItemData::Contents);
       pipelineView->selectionModel()->select(index, QItemSelectionModel::ClearAndSelect);
     }
+    attachFilterObservers();
+
+    // Files the pipeline reads may have changed since the same pipeline was last preflighted
+    if(m_BackgroundPreflight != nullptr)
+    {
+      m_BackgroundPreflight->invalidate();
+      m_BackgroundPreflight->schedule();
+    }
   }
 
   QFileInfo fi(filePath);
@@ -856,6 +2246,7 @@ int SIMPLView_UI::openPipeline(const QString& filePath)
 void SIMPLView_UI::handlePipelineChanges()
 {
   markDocumentAsDirty();
+  attachFilterObservers();
 
   SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
   QModelIndexList selectedIndexes = pipelineView->selectionModel()->selectedRows();
@@ -880,6 +2271,29 @@ void SIMPLView_UI::handlePipelineChanges()
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::executePipeline()
 {
+  qint64 availableBytes = ProcessStats::AvailableMemoryBytes();
+  if(exceedsAvailableMemory(availableBytes))
+  {
+    QMessageBox::StandardButton button =
+        QMessageBox::warning(this, tr("Not Enough Memory"),
+                             tr("%1. Set a memory budget to spill arrays to disk, or execute the pipeline anyway?").arg(MemoryEstimator::Summary(m_MemoryEstimate, availableBytes)),
+                             QMessageBox::Yes | QMessageBox::No, QMessageBox::No);
+    if(button != QMessageBox::Yes)
+    {
+      return;
+    }
+  }
+
+  if(m_ActionAlwaysUseWorkers->isChecked())
+  {
+    if(m_WorkerRunId == 0)
+    {
+      listenExecuteInWorkerTriggered();
+    }
+    return;
+  }
+
+  attachFilterObservers();
   m_Ui->pipelineListWidget->getPipelineView()->executePipeline();
 }
 
@@ -937,31 +2351,47 @@ void SIMPLView_UI::populateMenus(QObject* plugin)
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::processPipelineMessage(const PipelineMessage& msg)
 {
-  if(msg.getType() == PipelineMessage::MessageType::ProgressValue)
+  // Filters that report progress per slice send far more messages than can be shown, so the
+  // widgets are only updated once per display refresh with whatever arrived in between
+  if(m_MessageChannel.post(msg))
   {
-    float progValue = static_cast<float>(msg.getProgressValue()) / 100;
-    m_Ui->pipelineListWidget->setProgressValue(progValue);
+    m_MessageTimer->start();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::processPipelineViewMessage(const PipelineMessage& msg)
+{
+  // The view passes the filters' messages on as well, those are in the channel already
+  if(!msg.getFilterClassName().isEmpty())
+  {
+    return;
   }
-  else if(msg.getType() == PipelineMessage::MessageType::StatusMessageAndProgressValue)
+  processPipelineMessage(msg);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::flushPipelineMessages()
+{
+  PipelineMessageChannel::Batch batch = m_MessageChannel.take();
+
+  if(batch.hasProgress)
   {
-    float progValue = static_cast<float>(msg.getProgressValue()) / 100;
+    float progValue = static_cast<float>(batch.progressValue) / 100;
     m_Ui->pipelineListWidget->setProgressValue(progValue);
-
-    if(nullptr != this->statusBar())
-    {
-      this->statusBar()->showMessage(msg.generateStatusString());
-    }
   }
-  else if(msg.getType() == PipelineMessage::MessageType::StandardOutputMessage || msg.getType() == PipelineMessage::MessageType::StatusMessage)
+
+  if(batch.hasStatus && nullptr != this->statusBar())
   {
-    if(msg.getType() == PipelineMessage::MessageType::StatusMessage)
-    {
-      if(nullptr != this->statusBar())
-      {
-        this->statusBar()->showMessage(msg.generateStatusString());
-      }
-    }
+    this->statusBar()->showMessage(batch.status);
+  }
 
+  if(!batch.lines.isEmpty())
+  {
     // Allow status messages to open the standard output widget
     if(SIMPLView::DockWidgetSettings::HideDockSetting::OnStatusAndError == StandardOutputWidget::GetHideDockSetting())
     {
@@ -974,10 +2404,15 @@ void SIMPLView_UI::processPipelineMessage(const PipelineMessage& msg)
       m_Ui->issuesDockWidget->setVisible(true);
     }
 
-    QString text = "<span style=\" color:#000000;\" >";
-    text.append(msg.getText());
-    text.append("</span>");
-    m_Ui->stdOutWidget->appendText(text);
+    qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+    QVector<LogModel::Entry> entries(batch.lines.size());
+    for(int i = 0; i < batch.lines.size(); i++)
+    {
+      entries[i].timestamp = timestamp;
+      entries[i].level = LogLevelForMessageType(batch.lineTypes[i]);
+      entries[i].text = batch.lines[i];
+    }
+    m_Ui->stdOutWidget->appendEntries(entries);
   }
 }
 
@@ -986,6 +2421,39 @@ void SIMPLView_UI::processPipelineMessage(const PipelineMessage& msg)
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::pipelineDidFinish()
 {
+  // Show the last messages of the pipeline before it is reported as finished
+  m_MessageTimer->stop();
+  flushPipelineMessages();
+
+  // Spilled arrays go back before the data browser shows the result, also when the budget was turned off during the run
+  m_ArraySpiller->finishRun();
+  if(m_ArraySpiller->getBudgetMB() > 0 || !m_ArraySpiller->getEvents().isEmpty())
+  {
+    QString summary = m_ArraySpiller->summary();
+    bool complete = m_ArraySpiller->getDroppedArrays().isEmpty() && m_ArraySpiller->getArraysOnDisk().isEmpty();
+    LogModel::Level level = complete ? LogModel::Level::Status : LogModel::Level::Warning;
+    m_Ui->stdOutWidget->appendLine(level, summary);
+    for(const ArraySpiller::Event& event : m_ArraySpiller->getEvents())
+    {
+      m_Ui->stdOutWidget->appendLine(LogModel::Level::Info, QString("  %1 ms  filter %2  %3 %4 (%5 bytes, %6 ms)")
+                                                                .arg(event.timeMSecs)
+                                                                .arg(event.filterIndex + 1)
+                                                                .arg(event.spill ? "spill " : "refill")
+                                                                .arg(event.arrayPath)
+                                                                .arg(event.bytes)
+                                                                .arg(event.ioMSecs));
+    }
+    setStatusBarMessage(summary);
+  }
+
+  m_ArrayLiveness->finishRun();
+  QVector<ArrayLiveness::DeadArray> droppedArrays = m_ArrayLiveness->getDroppedArrays();
+  if(!droppedArrays.isEmpty())
+  {
+    m_Ui->stdOutWidget->appendLine(LogModel::Level::Status, m_ArrayLiveness->summary());
+    updateDroppedArrays(droppedArrays);
+  }
+
   // Re-enable FilterListToolboxWidget signals - resume adding filters
   m_Ui->filterListWidget->blockSignals(false);
 
@@ -1008,7 +2476,33 @@ void SIMPLView_UI::pipelineDidFinish()
     m_Ui->dataBrowserWidget->filterActivated(AbstractFilter::NullPointer());
   }
 
+  // The filter the profiler closes when a run was canceled did not complete, so it is left out of the history
+  if(m_PipelineEta->isRunning())
+  {
+    updateEta();
+    m_PipelineEta->finishRun();
+    m_EtaTimer->stop();
+    m_EtaLabel->hide();
+    m_Ui->stdOutWidget->appendLine(LogModel::Level::Info, m_PipelineEta->summary());
+  }
+
+  m_Profiler->finishRun();
+
+  if(m_Checkpointer.get() != nullptr)
+  {
+    m_Checkpointer->finishRun();
+    logCheckpoints(m_Checkpointer);
+  }
+
   m_Ui->pipelineListWidget->pipelineFinished();
+
+  // The view does not preflight again after the run while its preflight is blocked, and the run may have written
+  // files that the filters read
+  if(m_BackgroundPreflight != nullptr)
+  {
+    m_BackgroundPreflight->invalidate();
+    m_BackgroundPreflight->schedule();
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -1171,6 +2665,15 @@ void SIMPLView_UI::clearFilterInputWidget()
 void SIMPLView_UI::markDocumentAsDirty()
 {
   setWindowModified(true);
+
+  // Any edit may have changed the filters whose results are in the stage cache
+  m_StageStateTimer->start();
+
+  // Every edit that dirties the document needs a preflight as well
+  if(m_BackgroundPreflight != nullptr)
+  {
+    m_BackgroundPreflight->schedule();
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -1209,10 +2712,7 @@ void SIMPLView_UI::setStatusBarMessage(const QString& msg)
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::addStdOutputMessage(const QString& msg)
 {
-  QString text = "<span style=\" color:#000000;\" >";
-  text.append(msg);
-  text.append("</span>");
-  m_Ui->stdOutWidget->appendText(text);
+  m_Ui->stdOutWidget->appendLine(LogModel::Level::Info, msg);
 }
 
 // -----------------------------------------------------------------------------
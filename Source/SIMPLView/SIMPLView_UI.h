@@ -37,8 +37,12 @@
 
 #pragma once
 
+#include <atomic>
 
 //-- Qt Includes
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QJsonObject>
 #include <QtCore/QObject>
 #include <QtCore/QString>
 #include <QtCore/QList>
@@ -60,6 +64,14 @@
 //-- UIC generated Header
 #include "ui_SIMPLView_UI.h"
 
+#include "SIMPLView/ArrayLiveness.h"
+#include "SIMPLView/ArraySpiller.h"
+#include "SIMPLView/IncrementalPipeline.h"
+#include "SIMPLView/MemoryEstimator.h"
+#include "SIMPLView/PipelineCheckpointer.h"
+#include "SIMPLView/PipelineEta.h"
+#include "SIMPLView/PipelineMessageChannel.h"
+
 
 class ISIMPLibPlugin;
 class FilterLibraryToolboxWidget;
@@ -68,6 +80,7 @@ class FilterListWidget;
 class UpdateCheckDialog;
 class UpdateCheckData;
 class UpdateCheck;
+class QAbstractButton;
 class QToolButton;
 class AboutSIMPLView;
 class StatusBarWidget;
@@ -76,6 +89,14 @@ class PipelineModel;
 class PipelineListWidget;
 class SVPipelineViewWidget;
 class SIMPLViewMenuItems;
+class BackgroundPreflight;
+class BatchQueueWidget;
+class WatchDirectoryDialog;
+class PipelineProfiler;
+class PipelineProfilerWidget;
+class ProfilerItemDelegate;
+class QTimer;
+class QLabel;
 
 /**
 * @class SIMPLView_UI SIMPLView_UI Applications/SIMPLView/SIMPLView_UI.h
@@ -142,6 +163,38 @@ class SIMPLView_UI : public QMainWindow
      */
     void showDockWidget(QDockWidget* dockWidget);
 
+    /**
+     * @brief getPipelineFilterClassNames
+     * @return The class names of all of the filters in the pipeline of this window
+     */
+    QStringList getPipelineFilterClassNames();
+
+    /**
+     * @brief refreshFilterToolboxes Rebuilds the filter list and filter library after plugins were enabled or disabled
+     */
+    void refreshFilterToolboxes();
+
+    /**
+     * @brief updateFilterToolboxes Shows and hides just the filters of plugins that were enabled or disabled. The
+     * toolboxes are only rebuilt when one of the shown filters is not in them yet.
+     * @param shownClassNames
+     * @param hiddenClassNames
+     */
+    void updateFilterToolboxes(const QStringList& shownClassNames, const QStringList& hiddenClassNames);
+
+    /**
+     * @brief setReserved A reserved window is built ahead of time and kept hidden until the next new window is
+     * requested. It does not write its settings, so it can not overwrite the layout of the visible windows.
+     * @param reserved
+     */
+    void setReserved(bool reserved);
+
+    /**
+     * @brief isReserved
+     * @return
+     */
+    bool isReserved() const;
+
   public slots:
     /**
     * @brief setFilterBeingDragged
@@ -182,8 +235,175 @@ class SIMPLView_UI : public QMainWindow
      */
     void listenSavePipelineAsTriggered();
 
+    /**
+     * @brief listenQueueBookmarksTriggered Adds the selected bookmarks, and every bookmark inside the
+     * selected folders, to the batch queue
+     */
+    void listenQueueBookmarksTriggered();
+
+    /**
+     * @brief listenParameterSweepTriggered Opens the parameter sweep dialog for the pipeline of this window
+     */
+    void listenParameterSweepTriggered();
+
+    /**
+     * @brief listenWatchDirectoryTriggered Opens the watch directory dialog for the pipeline of this window
+     */
+    void listenWatchDirectoryTriggered();
+
+    /**
+     * @brief listenExecuteIncrementallyTriggered Executes the pipeline starting behind the last filter whose result
+     * is in the stage cache, or cancels such an execution
+     */
+    void listenExecuteIncrementallyTriggered();
+
+    /**
+     * @brief listenStageCacheBudgetTriggered
+     */
+    void listenStageCacheBudgetTriggered();
+
+    /**
+     * @brief listenStageCacheOnDiskToggled
+     * @param onDisk
+     */
+    void listenStageCacheOnDiskToggled(bool onDisk);
+
+    /**
+     * @brief listenClearStageCacheTriggered
+     */
+    void listenClearStageCacheTriggered();
+
+    /**
+     * @brief listenMemoryBudgetTriggered
+     */
+    void listenMemoryBudgetTriggered();
+
+    /**
+     * @brief listenKeepAllArraysToggled
+     * @param keepAll Whether arrays stay in the DataContainerArray after their last use
+     */
+    void listenKeepAllArraysToggled(bool keepAll);
+
+    /**
+     * @brief listenExecuteInWorkerTriggered Executes the pipeline in a worker process, or cancels that execution
+     */
+    void listenExecuteInWorkerTriggered();
+
+    /**
+     * @brief listenStartPipelineClicked Executes the pipeline as the Execute action does, or cancels the running one
+     */
+    void listenStartPipelineClicked();
+
+    /**
+     * @brief listenAlwaysUseWorkersToggled
+     * @param useWorkers Whether executePipeline() goes to a worker process
+     */
+    void listenAlwaysUseWorkersToggled(bool useWorkers);
+
+    /**
+     * @brief listenWorkerProcessesTriggered
+     */
+    void listenWorkerProcessesTriggered();
+
+    /**
+     * @brief listenCheckpointSelectedFiltersTriggered Marks the selected filters to write a checkpoint after, or
+     * removes the mark when every selected filter has it
+     */
+    void listenCheckpointSelectedFiltersTriggered();
+
+    /**
+     * @brief listenCheckpointAfterMinutesTriggered
+     */
+    void listenCheckpointAfterMinutesTriggered();
+
+    /**
+     * @brief listenResumeFromCheckpointTriggered Executes the pipeline starting behind its last checkpoint
+     */
+    void listenResumeFromCheckpointTriggered();
+
+    /**
+     * @brief listenClearCheckpointsTriggered
+     */
+    void listenClearCheckpointsTriggered();
+
   protected:
 
+    /**
+     * @brief attachFilterObservers Lets the profiler, the array liveness pass, the array spiller and the checkpointer listen to the filters that are in the pipeline now.
+     * Nothing is done while the pipeline holds the same filters in the same order as the last time.
+     */
+    void attachFilterObservers();
+
+    /**
+     * @brief attachMessageChannel Posts the messages that the filters generate while they execute straight into the message
+     * channel, on the thread that executes them
+     * @param filters
+     */
+    void attachMessageChannel(const QList<AbstractFilter::Pointer>& filters);
+
+    /**
+     * @brief updateDroppedArrays Lists the arrays under the data browser
+     * @param deadArrays The arrays the next run frees or the last run freed
+     */
+    void updateDroppedArrays(const QVector<ArrayLiveness::DeadArray>& deadArrays);
+
+    /**
+     * @brief analyzePreflight Finds the arrays a run frees and estimates its memory from the preflight structures
+     */
+    void analyzePreflight();
+
+    /**
+     * @brief updateMemoryEstimate Shows the estimated peak memory of a run under the pipeline
+     */
+    void updateMemoryEstimate();
+
+    /**
+     * @brief updateEta Shows in the status bar when the run in progress is expected to finish
+     */
+    void updateEta();
+
+    /**
+     * @brief exceedsAvailableMemory
+     * @param availableBytes
+     * @return Whether the estimated peak does not fit into the available memory and is not spilled either
+     */
+    bool exceedsAvailableMemory(qint64 availableBytes) const;
+
+    /**
+     * @brief getPipelineFilters
+     * @return The filters of the pipeline in this window, in order
+     */
+    QList<AbstractFilter::Pointer> getPipelineFilters();
+
+    /**
+     * @brief createCheckpointer
+     * @return A checkpointer set up from the preferences and the filters marked in this window
+     */
+    PipelineCheckpointer::Pointer createCheckpointer();
+
+    /**
+     * @brief attachCheckpointer Lets a checkpointer listen to the filters if any filter may be checkpointed
+     */
+    void attachCheckpointer();
+
+    /**
+     * @brief logCheckpoints Writes the checkpoints of the last run to the output
+     * @param checkpointer
+     */
+    void logCheckpoints(const PipelineCheckpointer::Pointer& checkpointer);
+
+    /**
+     * @brief computeStageKeys
+     * @return The StageCache keys of the pipeline in this window, empty if it could not be written
+     */
+    QStringList computeStageKeys();
+
+    /**
+     * @brief executeIncrementally
+     * @param fromCheckpoint Resumes from the last checkpoint instead of the stage cache
+     */
+    void executeIncrementally(bool fromCheckpoint);
+
     /**
      * @brief populateMenus This is a planned API that plugins would use to add Menus to the main application
      * @param plugin
@@ -284,6 +504,52 @@ class SIMPLView_UI : public QMainWindow
      */
     void processPipelineMessage(const PipelineMessage& msg);
 
+    /**
+     * @brief processPipelineViewMessage Takes the messages of the pipeline itself from the pipeline view. The filters' own
+     * messages were already posted by attachMessageChannel.
+     * @param msg
+     */
+    void processPipelineViewMessage(const PipelineMessage& msg);
+
+    /**
+     * @brief flushPipelineMessages Applies the pipeline messages that arrived since the last display refresh
+     */
+    void flushPipelineMessages();
+
+    /**
+     * @brief incrementalExecutionFinished
+     */
+    void incrementalExecutionFinished();
+
+    /**
+     * @brief workerRunMessage
+     * @param id
+     * @param msg
+     */
+    void workerRunMessage(int id, const PipelineMessage& msg);
+
+    /**
+     * @brief workerRunFinished Copies the arrays of the worker into the data browser
+     * @param id
+     * @param errorCode
+     * @param message
+     * @param arrays
+     */
+    void workerRunFinished(int id, int errorCode, const QString& message, const QJsonObject& arrays);
+
+    /**
+     * @brief updateStageStates Marks the filters whose result is cached, and those whose cached result was invalidated
+     */
+    void updateStageStates();
+
+    /**
+     * @brief backgroundPreflightFinished Shows the issues and data structure of a preflight that ran on a worker thread
+     * @param pipeline
+     * @param messages
+     * @param err
+     */
+    void backgroundPreflightFinished(FilterPipeline::Pointer pipeline, QVector<PipelineMessage> messages, int err);
+
     /**
     * @brief setFilterInputWidget
     * @param widget
@@ -329,9 +595,43 @@ class SIMPLView_UI : public QMainWindow
 //    StatusBarWidget*                        m_StatusBar = nullptr;
 
     QString                                 m_LastOpenedFilePath;
+    bool                                    m_Reserved = false;
+
+    PipelineMessageChannel                  m_MessageChannel;
+    QTimer*                                 m_MessageTimer = nullptr;
+    QVector<QMetaObject::Connection>        m_MessageConnections;
+    QList<AbstractFilter::Pointer>          m_ObservedFilters;
+    std::atomic<AbstractFilter*>            m_ExecutingFilter{nullptr};
 
     FilterInputWidget*                      m_FilterInputWidget = nullptr;
 
+    QDockWidget*                            m_BatchQueueDockWidget = nullptr;
+    BatchQueueWidget*                       m_BatchQueueWidget = nullptr;
+    WatchDirectoryDialog*                   m_WatchDirectoryDialog = nullptr;
+
+    PipelineProfiler*                       m_Profiler = nullptr;
+    ProfilerItemDelegate*                   m_ProfilerItemDelegate = nullptr;
+    QDockWidget*                            m_ProfilerDockWidget = nullptr;
+    PipelineProfilerWidget*                 m_ProfilerWidget = nullptr;
+
+    IncrementalPipeline::Pointer            m_IncrementalPipeline;
+    QFutureWatcher<QString>*                m_IncrementalWatcher = nullptr;
+    QStringList                             m_LastStageKeys;
+    QTimer*                                 m_StageStateTimer = nullptr;
+
+    int                                     m_WorkerRunId = 0;
+    QElapsedTimer                           m_WorkerRunTimer;
+    QAbstractButton*                        m_StartPipelineButton = nullptr;
+
+    BackgroundPreflight*                    m_BackgroundPreflight = nullptr;
+    ArraySpiller::Pointer                   m_ArraySpiller;
+    ArrayLiveness::Pointer                  m_ArrayLiveness;
+    MemoryEstimator::Estimate               m_MemoryEstimate;
+    PipelineCheckpointer::Pointer           m_Checkpointer;
+    PipelineEta::Pointer                    m_PipelineEta;
+    QLabel*                                 m_EtaLabel = nullptr;
+    QTimer*                                 m_EtaTimer = nullptr;
+
     QMenu*                                  m_MenuFile = nullptr;
     QMenu*                                  m_MenuEdit = nullptr;
     QMenu*                                  m_MenuView = nullptr;
@@ -357,6 +657,22 @@ class SIMPLView_UI : public QMainWindow
     QAction*                                m_ActionClearCache = nullptr;
     QAction*                                m_ActionSetDataFolder = nullptr;
     QAction*                                m_ActionShowDataFolder = nullptr;
+    QAction*                                m_ActionQueueBookmarks = nullptr;
+    QAction*                                m_ActionParameterSweep = nullptr;
+    QAction*                                m_ActionWatchDirectory = nullptr;
+    QAction*                                m_ActionExecuteIncrementally = nullptr;
+    QAction*                                m_ActionStageCacheBudget = nullptr;
+    QAction*                                m_ActionStageCacheOnDisk = nullptr;
+    QAction*                                m_ActionClearStageCache = nullptr;
+    QAction*                                m_ActionMemoryBudget = nullptr;
+    QAction*                                m_ActionKeepAllArrays = nullptr;
+    QAction*                                m_ActionExecuteInWorker = nullptr;
+    QAction*                                m_ActionAlwaysUseWorkers = nullptr;
+    QAction*                                m_ActionWorkerProcesses = nullptr;
+    QAction*                                m_ActionCheckpointSelectedFilters = nullptr;
+    QAction*                                m_ActionCheckpointAfterMinutes = nullptr;
+    QAction*                                m_ActionResumeFromCheckpoint = nullptr;
+    QAction*                                m_ActionClearCheckpoints = nullptr;
 
     QActionGroup*                           m_ThemeActionGroup = nullptr;
 
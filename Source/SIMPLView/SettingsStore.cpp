@@ -0,0 +1,459 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "SettingsStore.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSaveFile>
+#include <QtCore/QTimer>
+
+#include "SVWidgetsLib/QtSupport/QtSSettings.h"
+
+namespace
+{
+// How long writes are collected before they are written to the preferences file
+const int k_FlushDelayMSecs = 2000;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool isSameOrInside(const QStringList& path, const QStringList& other)
+{
+  return path.size() >= other.size() && path.mid(0, other.size()) == other;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void applyChange(QJsonObject& object, const SettingsChange& change, int depth)
+{
+  const QString& key = change.path[depth];
+  if(depth == change.path.size() - 1)
+  {
+    if(change.removed)
+    {
+      object.remove(key);
+    }
+    else
+    {
+      object.insert(key, change.value);
+    }
+    return;
+  }
+
+  if(change.removed && !object.value(key).isObject())
+  {
+    return;
+  }
+  QJsonObject child = object.value(key).toObject();
+  applyChange(child, change, depth + 1);
+  object.insert(key, child);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool readPreferencesFile(const QString& filePath, QJsonObject& root)
+{
+  QFile file(filePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    // There is no preferences file before the first write
+    root = QJsonObject();
+    return true;
+  }
+  QByteArray contents = file.readAll();
+  file.close();
+
+  QJsonParseError parseError;
+  QJsonDocument doc = QJsonDocument::fromJson(contents, &parseError);
+  if(!contents.trimmed().isEmpty() && parseError.error != QJsonParseError::NoError)
+  {
+    qDebug() << "The preferences file" << filePath << "could not be parsed:" << parseError.errorString();
+    return false;
+  }
+  root = doc.object();
+  return true;
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SettingsWriter::SettingsWriter() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SettingsWriter::~SettingsWriter() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SettingsWriter::beginGroup(const QString& prefix)
+{
+  m_Groups.push_back(prefix);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SettingsWriter::endGroup()
+{
+  if(!m_Groups.isEmpty())
+  {
+    m_Groups.pop_back();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SettingsWriter::setValue(const QString& key, const QVariant& value)
+{
+  SettingsChange change;
+  change.path = m_Groups;
+  change.path.push_back(key);
+  change.value = EncodeValue(value);
+  m_Changes.push_back(change);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SettingsWriter::setValue(const QString& key, const QJsonObject& object)
+{
+  SettingsChange change;
+  change.path = m_Groups;
+  change.path.push_back(key);
+  change.value = object;
+  m_Changes.push_back(change);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SettingsWriter::remove(const QString& key)
+{
+  SettingsChange change;
+  change.path = m_Groups;
+  change.path.push_back(key);
+  change.removed = true;
+  m_Changes.push_back(change);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonValue SettingsWriter::EncodeValue(const QVariant& value)
+{
+  if(value.type() == QVariant::ByteArray)
+  {
+    return QString::fromLatin1(value.toByteArray().toBase64());
+  }
+  if(value.type() == QVariant::StringList)
+  {
+    QJsonArray array;
+    for(const QString& str : value.toStringList())
+    {
+      array.push_back(str);
+    }
+    return array;
+  }
+  return QJsonValue::fromVariant(value);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVariant SettingsWriter::DecodeValue(const QJsonValue& value, int type)
+{
+  if(type == QVariant::ByteArray)
+  {
+    return QByteArray::fromBase64(value.toString().toLatin1());
+  }
+  if(type == QVariant::StringList)
+  {
+    QStringList list;
+    for(const QJsonValue& element : value.toArray())
+    {
+      list.push_back(element.toString());
+    }
+    return list;
+  }
+
+  QVariant variant = value.toVariant();
+  if(type != QVariant::Invalid && variant.canConvert(type))
+  {
+    variant.convert(type);
+  }
+  return variant;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<SettingsChange> SettingsWriter::getChanges() const
+{
+  return m_Changes;
+}
+
+SettingsStore* SettingsStore::self = nullptr;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SettingsStore::SettingsStore()
+{
+  m_FilePath = QtSSettings().fileName();
+  readPreferencesFile(m_FilePath, m_Contents);
+
+  m_FlushPool.setMaxThreadCount(1);
+
+  m_FlushTimer = new QTimer();
+  m_FlushTimer->setSingleShot(true);
+  m_FlushTimer->setInterval(k_FlushDelayMSecs);
+  QObject::connect(m_FlushTimer, &QTimer::timeout, [this] { flush(); });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SettingsStore::~SettingsStore()
+{
+  flush();
+  waitForFlush();
+  delete m_FlushTimer;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SettingsStore* SettingsStore::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new SettingsStore();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SettingsStore::DeleteInstance()
+{
+  delete self;
+  self = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SettingsStore::write(const WriterFunction& writer)
+{
+  m_LogicalWriteCount++;
+
+  SettingsWriter settingsWriter;
+  writer(&settingsWriter);
+  QVector<SettingsChange> changes = settingsWriter.getChanges();
+  if(changes.isEmpty())
+  {
+    return;
+  }
+
+  for(const SettingsChange& change : changes)
+  {
+    AddChange(m_PendingChanges, change);
+  }
+  {
+    QMutexLocker locker(&m_ContentsMutex);
+    ApplyChanges(m_Contents, changes);
+  }
+
+  if(!m_FlushTimer->isActive())
+  {
+    m_FlushTimer->start();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVariant SettingsStore::value(const QString& keyPath, const QVariant& defaultValue) const
+{
+  QStringList path = keyPath.split('/');
+
+  QMutexLocker locker(&m_ContentsMutex);
+  QJsonObject group = m_Contents;
+  for(int i = 0; i < path.size() - 1; i++)
+  {
+    group = group.value(path[i]).toObject();
+  }
+  if(!group.contains(path.back()))
+  {
+    return defaultValue;
+  }
+  return SettingsWriter::DecodeValue(group.value(path.back()), defaultValue.userType());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SettingsStore::flush()
+{
+  m_FlushTimer->stop();
+
+  if(m_PendingChanges.isEmpty())
+  {
+    return;
+  }
+
+  QVector<SettingsChange> changes = m_PendingChanges;
+  m_PendingChanges.clear();
+
+  QString filePath = m_FilePath;
+  QAtomicInt* physicalWriteCount = &m_PhysicalWriteCount;
+  QtConcurrent::run(&m_FlushPool, [filePath, changes, physicalWriteCount] {
+    if(MergeIntoFile(filePath, changes))
+    {
+      physicalWriteCount->ref();
+    }
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SettingsStore::waitForFlush()
+{
+  m_FlushPool.waitForDone();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SettingsStore::hasPendingWrites() const
+{
+  return !m_PendingChanges.isEmpty();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SettingsStore::getLogicalWriteCount() const
+{
+  return m_LogicalWriteCount;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SettingsStore::getPhysicalWriteCount() const
+{
+  return m_PhysicalWriteCount.load();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SettingsStore::printStatistics() const
+{
+  int physicalWrites = getPhysicalWriteCount();
+  qDebug() << "Settings writes:" << m_LogicalWriteCount << "requested," << physicalWrites << "written to" << m_FilePath << ","
+           << (m_LogicalWriteCount - physicalWrites) << "avoided";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SettingsStore::ApplyChanges(QJsonObject& root, const QVector<SettingsChange>& changes)
+{
+  for(const SettingsChange& change : changes)
+  {
+    if(!change.path.isEmpty())
+    {
+      applyChange(root, change, 0);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SettingsStore::AddChange(QVector<SettingsChange>& changes, const SettingsChange& change)
+{
+  // A change replaces everything at or below its path; a later change inside a removed group has to stay behind it
+  for(int i = changes.size() - 1; i >= 0; i--)
+  {
+    if(isSameOrInside(changes[i].path, change.path))
+    {
+      changes.remove(i);
+    }
+  }
+  changes.push_back(change);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SettingsStore::MergeIntoFile(const QString& filePath, const QVector<SettingsChange>& changes)
+{
+  // Re-read the file so that anything written to it directly in the meantime is kept
+  QJsonObject root;
+  if(!readPreferencesFile(filePath, root))
+  {
+    qDebug() << "Not writing the preferences because" << filePath << "could not be parsed";
+    return false;
+  }
+
+  ApplyChanges(root, changes);
+
+  // QSaveFile writes next to the target and renames over it only once everything has been written
+  QSaveFile saveFile(filePath);
+  if(!saveFile.open(QIODevice::WriteOnly))
+  {
+    qDebug() << "Could not write the preferences to" << filePath;
+    return false;
+  }
+  saveFile.write(QJsonDocument(root).toJson());
+  return saveFile.commit();
+}
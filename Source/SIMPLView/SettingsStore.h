@@ -0,0 +1,236 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <functional>
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonValue>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+
+class QTimer;
+
+/**
+ * @brief The SettingsChange struct is one value that was set, or one key or group that was removed
+ */
+struct SettingsChange
+{
+  QStringList path;
+  QJsonValue value;
+  bool removed = false;
+};
+
+/**
+ * @brief The SettingsWriter class is handed to the writers of the SettingsStore. It has the writing half of the
+ * QtSSettings interface and encodes values the way QtSSettings stores them in the preferences file, but it only
+ * records the changes in memory.
+ */
+class SettingsWriter
+{
+public:
+  SettingsWriter();
+  virtual ~SettingsWriter();
+
+  void beginGroup(const QString& prefix);
+  void endGroup();
+
+  /**
+   * @brief setValue Byte arrays are stored Base64 encoded and string lists as Json arrays, like QtSSettings does
+   * @param key
+   * @param value
+   */
+  void setValue(const QString& key, const QVariant& value);
+  void setValue(const QString& key, const QJsonObject& object);
+
+  /**
+   * @brief remove Removes the key, or the whole group if the key names one
+   * @param key
+   */
+  void remove(const QString& key);
+
+  /**
+   * @brief EncodeValue
+   * @param value
+   * @return The value as QtSSettings writes it to the preferences file
+   */
+  static QJsonValue EncodeValue(const QVariant& value);
+
+  /**
+   * @brief DecodeValue Reverses EncodeValue
+   * @param value
+   * @param type The type to decode to
+   * @return
+   */
+  static QVariant DecodeValue(const QJsonValue& value, int type);
+
+  /**
+   * @brief getChanges
+   * @return The changes in the order they were made
+   */
+  QVector<SettingsChange> getChanges() const;
+
+private:
+  QStringList m_Groups;
+  QVector<SettingsChange> m_Changes;
+
+  SettingsWriter(const SettingsWriter&) = delete; // Copy Constructor Not Implemented
+  void operator=(const SettingsWriter&) = delete; // Move assignment Not Implemented
+};
+
+/**
+ * @brief The SettingsStore class sits in front of the preferences file and turns the many small preference writes
+ * of the application into one physical write every few seconds. A writer only records its changes in memory;
+ * removals are recorded as explicitly as values. A background thread later applies the pending changes to the
+ * current preferences file and replaces it atomically, so a crash can never leave a half written file. Values
+ * written in this session can be read back from the store at any time without waiting for that write.
+ */
+class SettingsStore
+{
+public:
+  using WriterFunction = std::function<void(SettingsWriter*)>;
+
+  virtual ~SettingsStore();
+
+  /**
+   * @brief Instance
+   * @return
+   */
+  static SettingsStore* Instance();
+
+  /**
+   * @brief DeleteInstance Writes everything that is still pending, waits for it and deletes the store
+   */
+  static void DeleteInstance();
+
+  /**
+   * @brief write Records the values that writer sets and the keys it removes. Must be called from the main thread.
+   * @param writer
+   */
+  void write(const WriterFunction& writer);
+
+  /**
+   * @brief value Reads a value from the preferences as they are with every write of this session applied, so
+   * nothing has to wait for the file to be written
+   * @param keyPath The groups and the key, separated by '/'
+   * @param defaultValue Returned if there is no such key; its type is the type of the result
+   * @return
+   */
+  QVariant value(const QString& keyPath, const QVariant& defaultValue) const;
+
+  /**
+   * @brief flush Starts writing the pending changes to the preferences file on the flush thread
+   */
+  void flush();
+
+  /**
+   * @brief waitForFlush Blocks until every flush that was started has reached the file. Only needed before
+   * the file is written directly or at shutdown.
+   */
+  void waitForFlush();
+
+  /**
+   * @brief hasPendingWrites
+   * @return
+   */
+  bool hasPendingWrites() const;
+
+  /**
+   * @brief getLogicalWriteCount
+   * @return The number of writes the application asked for
+   */
+  int getLogicalWriteCount() const;
+
+  /**
+   * @brief getPhysicalWriteCount
+   * @return The number of times the preferences file was actually replaced
+   */
+  int getPhysicalWriteCount() const;
+
+  /**
+   * @brief printStatistics
+   */
+  void printStatistics() const;
+
+  /**
+   * @brief ApplyChanges Applies the changes in order to the contents of a preferences file
+   * @param root
+   * @param changes
+   */
+  static void ApplyChanges(QJsonObject& root, const QVector<SettingsChange>& changes);
+
+  /**
+   * @brief AddChange Adds a change to a list of pending changes, dropping the earlier changes it overrides
+   * @param changes
+   * @param change
+   */
+  static void AddChange(QVector<SettingsChange>& changes, const SettingsChange& change);
+
+protected:
+  SettingsStore();
+
+  /**
+   * @brief MergeIntoFile Applies the changes to the preferences file at filePath and replaces it atomically
+   * @param filePath
+   * @param changes
+   * @return
+   */
+  static bool MergeIntoFile(const QString& filePath, const QVector<SettingsChange>& changes);
+
+private:
+  static SettingsStore* self;
+
+  QString m_FilePath;
+  // The preferences file as it was read at startup with every change of this session applied
+  QJsonObject m_Contents;
+  mutable QMutex m_ContentsMutex;
+  QVector<SettingsChange> m_PendingChanges;
+  QTimer* m_FlushTimer = nullptr;
+
+  // A single thread so that the flushes reach the file in order
+  QThreadPool m_FlushPool;
+
+  int m_LogicalWriteCount = 0;
+  QAtomicInt m_PhysicalWriteCount;
+
+  SettingsStore(const SettingsStore&) = delete;  // Copy Constructor Not Implemented
+  void operator=(const SettingsStore&) = delete;  // Move assignment Not Implemented
+};
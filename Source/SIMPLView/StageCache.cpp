@@ -0,0 +1,548 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "StageCache.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QLockFile>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QStandardPaths>
+
+#include "H5Support/H5ScopedSentinel.h"
+#include "H5Support/QH5Utilities.h"
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/CoreFilters/DataContainerReader.h"
+#include "SIMPLib/CoreFilters/DataContainerWriter.h"
+#include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/OutputPathFilterParameter.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Filtering/FilterManager.h"
+
+#include "SIMPLView/PipelineProfiler.h"
+#include "SIMPLView/SettingsStore.h"
+
+StageCache* StageCache::self = nullptr;
+
+namespace
+{
+// Checkpoints are written from a background thread, HDF5 may not be built thread safe
+QMutex s_SnapshotFileMutex;
+
+// -----------------------------------------------------------------------------
+// The parameters of a filter that name files it writes. Those change with every execution and must not
+// invalidate the filter's own snapshot.
+// -----------------------------------------------------------------------------
+QStringList outputPathKeys(const QJsonObject& filterObject)
+{
+  QStringList keys;
+  IFilterFactory::Pointer factory = FilterManager::Instance()->getFactoryFromClassName(filterObject["Filter_Name"].toString());
+  if(nullptr == factory.get())
+  {
+    return keys;
+  }
+  // Snapshots are keyed on worker threads, where a deferred plugin is not activated
+  AbstractFilter::Pointer filter = factory->create();
+  if(nullptr == filter.get())
+  {
+    return keys;
+  }
+  for(FilterParameter::Pointer parameter : filter->getFilterParameters())
+  {
+    if(dynamic_cast<OutputFileFilterParameter*>(parameter.get()) != nullptr || dynamic_cast<OutputPathFilterParameter*>(parameter.get()) != nullptr)
+    {
+      keys.push_back(parameter->getPropertyName());
+    }
+  }
+  return keys;
+}
+
+// -----------------------------------------------------------------------------
+// Adds the size and modification time of every existing file that a parameter value names
+// -----------------------------------------------------------------------------
+void addInputFiles(QCryptographicHash& hash, const QJsonValue& value)
+{
+  if(value.isString())
+  {
+    QFileInfo fi(value.toString());
+    if(fi.isAbsolute() && fi.isFile())
+    {
+      hash.addData(QString("%1:%2:%3").arg(fi.absoluteFilePath()).arg(fi.size()).arg(fi.lastModified().toMSecsSinceEpoch()).toUtf8());
+    }
+  }
+  else if(value.isArray())
+  {
+    for(const QJsonValue& element : value.toArray())
+    {
+      addInputFiles(hash, element);
+    }
+  }
+  else if(value.isObject())
+  {
+    QJsonObject object = value.toObject();
+    for(auto iter = object.begin(); iter != object.end(); ++iter)
+    {
+      addInputFiles(hash, iter.value());
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Removes the scratch directories of sessions that ended without cleaning up. Every session holds a lock
+// file next to its directory, QLockFile can take over the lock once the process that wrote it is gone.
+// -----------------------------------------------------------------------------
+void removeStaleScratchDirectories(const QString& baseDirectory)
+{
+  QDir baseDir(baseDirectory);
+  for(const QString& name : baseDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+  {
+    bool ok = false;
+    qint64 pid = name.toLongLong(&ok);
+    if(!ok || pid == QCoreApplication::applicationPid())
+    {
+      continue;
+    }
+    QLockFile lockFile(baseDir.filePath(name + ".lock"));
+    lockFile.setStaleLockTime(0);
+    if(lockFile.tryLock(0))
+    {
+      QDir(baseDir.filePath(name)).removeRecursively();
+      lockFile.unlock();
+    }
+  }
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StageCache::StageCache()
+{
+  // The index of the scratch files only lives in memory, so files of an earlier session are of no use.
+  // Other instances of the application may be running, so each process keeps its files in a directory
+  // of its own and only removes the directories of processes that are gone.
+  QString baseDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/StageCache";
+  QDir().mkpath(baseDirectory);
+  QString pid = QString::number(QCoreApplication::applicationPid());
+  m_LockFile.reset(new QLockFile(baseDirectory + "/" + pid + ".lock"));
+  m_LockFile->setStaleLockTime(0);
+  m_LockFile->tryLock(0);
+  removeStaleScratchDirectories(baseDirectory);
+
+  m_ScratchDirectory = baseDirectory + "/" + pid;
+  QDir(m_ScratchDirectory).removeRecursively();
+  QDir().mkpath(m_ScratchDirectory);
+
+  readSettings();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StageCache::~StageCache()
+{
+  clear();
+  QDir(m_ScratchDirectory).removeRecursively();
+  m_LockFile->unlock();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StageCache* StageCache::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new StageCache();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList StageCache::ComputeStageKeys(const QJsonObject& pipelineJson)
+{
+  QStringList keys;
+  int filterCount = pipelineJson["PipelineBuilder"].toObject()["Number_Filters"].toInt();
+
+  // Each key chains in the one before it, so it stands for the filter and everything upstream of it
+  QByteArray previousKey;
+  for(int i = 0; i < filterCount; i++)
+  {
+    QJsonObject filterObject = pipelineJson[QString::number(i)].toObject();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(previousKey);
+    hash.addData(QJsonDocument(filterObject).toJson(QJsonDocument::Compact));
+
+    // A file the filter reads may have been replaced on disk without any parameter changing
+    QStringList outputKeys = outputPathKeys(filterObject);
+    for(auto iter = filterObject.begin(); iter != filterObject.end(); ++iter)
+    {
+      if(!outputKeys.contains(iter.key()))
+      {
+        addInputFiles(hash, iter.value());
+      }
+    }
+    previousKey = hash.result().toHex();
+    keys.push_back(QString::fromLatin1(previousKey));
+  }
+  return keys;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool StageCache::contains(const QString& key) const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_Snapshots.contains(key);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int StageCache::findResumeIndex(const QStringList& keys) const
+{
+  QMutexLocker locker(&m_Mutex);
+  for(int i = keys.size() - 1; i >= 0; i--)
+  {
+    if(m_Snapshots.contains(keys[i]))
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer StageCache::restore(const QString& key)
+{
+  Snapshot snapshot;
+  {
+    QMutexLocker locker(&m_Mutex);
+    auto iter = m_Snapshots.find(key);
+    if(iter == m_Snapshots.end())
+    {
+      return DataContainerArray::NullPointer();
+    }
+    iter->lastUsed = ++m_UseCounter;
+    snapshot = iter.value();
+  }
+
+  // The copy is made outside of the lock, the shared pointer keeps the snapshot alive even if it is evicted meanwhile
+  if(snapshot.dca.get() != nullptr)
+  {
+    return snapshot.dca->deepCopy(false);
+  }
+  return ReadSnapshotFile(snapshot.filePath);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool StageCache::store(const QString& key, const DataContainerArray::Pointer& dca)
+{
+  Storage storage = Storage::Memory;
+  qint64 budgetBytes = 0;
+  qint64 fileNumber = 0;
+  {
+    QMutexLocker locker(&m_Mutex);
+    storage = m_Storage;
+    budgetBytes = static_cast<qint64>(m_BudgetMB) * 1024 * 1024;
+    fileNumber = ++m_UseCounter;
+  }
+
+  Snapshot snapshot;
+  if(storage == Storage::Memory)
+  {
+    snapshot.bytes = PipelineProfiler::AllocatedBytes(dca);
+    if(snapshot.bytes > budgetBytes)
+    {
+      return false;
+    }
+    snapshot.dca = dca->deepCopy(false);
+  }
+  else
+  {
+    snapshot.filePath = QString("%1/%2_%3.dream3d").arg(m_ScratchDirectory, key).arg(fileNumber);
+    if(!WriteSnapshotFile(dca, snapshot.filePath))
+    {
+      QFile::remove(snapshot.filePath);
+      return false;
+    }
+    snapshot.bytes = QFileInfo(snapshot.filePath).size();
+    if(snapshot.bytes > budgetBytes)
+    {
+      QFile::remove(snapshot.filePath);
+      return false;
+    }
+  }
+
+  QMutexLocker locker(&m_Mutex);
+  auto iter = m_Snapshots.find(key);
+  if(iter != m_Snapshots.end())
+  {
+    m_UsedBytes -= iter->bytes;
+    Release(iter.value());
+    m_Snapshots.erase(iter);
+  }
+  evict(snapshot.bytes);
+  snapshot.lastUsed = ++m_UseCounter;
+  m_Snapshots.insert(key, snapshot);
+  m_UsedBytes += snapshot.bytes;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StageCache::evict(qint64 bytes)
+{
+  qint64 budgetBytes = static_cast<qint64>(m_BudgetMB) * 1024 * 1024;
+  while(!m_Snapshots.isEmpty() && m_UsedBytes + bytes > budgetBytes)
+  {
+    auto oldest = m_Snapshots.begin();
+    for(auto iter = m_Snapshots.begin(); iter != m_Snapshots.end(); ++iter)
+    {
+      if(iter->lastUsed < oldest->lastUsed)
+      {
+        oldest = iter;
+      }
+    }
+    m_UsedBytes -= oldest->bytes;
+    Release(oldest.value());
+    m_Snapshots.erase(oldest);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StageCache::clear()
+{
+  QMutexLocker locker(&m_Mutex);
+  for(const Snapshot& snapshot : m_Snapshots)
+  {
+    Release(snapshot);
+  }
+  m_Snapshots.clear();
+  m_UsedBytes = 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StageCache::Release(const Snapshot& snapshot)
+{
+  if(!snapshot.filePath.isEmpty())
+  {
+    QFile::remove(snapshot.filePath);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StageCache::setBudgetMB(int budgetMB)
+{
+  QMutexLocker locker(&m_Mutex);
+  m_BudgetMB = qMax(0, budgetMB);
+  evict(0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int StageCache::getBudgetMB() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_BudgetMB;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StageCache::setStorage(Storage storage)
+{
+  if(storage == getStorage())
+  {
+    return;
+  }
+  clear();
+
+  QMutexLocker locker(&m_Mutex);
+  m_Storage = storage;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StageCache::Storage StageCache::getStorage() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_Storage;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 StageCache::getUsedBytes() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_UsedBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int StageCache::getSnapshotCount() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_Snapshots.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StageCache::readSettings()
+{
+  SettingsStore* store = SettingsStore::Instance();
+  m_BudgetMB = store->value("Application Settings/Stage Cache Budget MB", m_BudgetMB).toInt();
+  QString storage = store->value("Application Settings/Stage Cache Storage", QString("Memory")).toString();
+
+  QByteArray budgetEnv = qgetenv("SIMPL_STAGE_CACHE_BUDGET_MB");
+  if(!budgetEnv.isEmpty())
+  {
+    m_BudgetMB = budgetEnv.toInt();
+  }
+  QByteArray storageEnv = qgetenv("SIMPL_STAGE_CACHE_STORAGE");
+  if(!storageEnv.isEmpty())
+  {
+    storage = QString::fromLatin1(storageEnv);
+  }
+
+  m_BudgetMB = qMax(0, m_BudgetMB);
+  m_Storage = (storage.compare("Disk", Qt::CaseInsensitive) == 0) ? Storage::Disk : Storage::Memory;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StageCache::writeSettings() const
+{
+  int budgetMB = getBudgetMB();
+  QString storage = (getStorage() == Storage::Disk) ? "Disk" : "Memory";
+  SettingsStore::Instance()->write([budgetMB, storage](SettingsWriter* prefs) {
+    prefs->beginGroup("Application Settings");
+    prefs->setValue("Stage Cache Budget MB", budgetMB);
+    prefs->setValue("Stage Cache Storage", storage);
+    prefs->endGroup();
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool StageCache::WriteSnapshotFile(const DataContainerArray::Pointer& dca, const QString& filePath)
+{
+  QMutexLocker locker(&s_SnapshotFileMutex);
+  DataContainerWriter::Pointer writer = DataContainerWriter::New();
+  writer->setDataContainerArray(dca);
+  writer->setOutputFile(filePath);
+  writer->setWritePipeline(false);
+  writer->setWriteXdmfFile(false);
+  writer->execute();
+  return writer->getErrorCondition() >= 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool StageCache::AppendArrayToSnapshotFile(const QString& filePath, const QString& dataContainer, const AttributeMatrix::Pointer& attributeMatrix, const IDataArray::Pointer& array)
+{
+  QMutexLocker locker(&s_SnapshotFileMutex);
+  hid_t fileId = QH5Utilities::openFile(filePath, false);
+  if(fileId < 0)
+  {
+    return false;
+  }
+  H5ScopedFileSentinel sentinel(&fileId, true);
+
+  // The DataContainerWriter lays the file out as DataContainers/<data container>/<attribute matrix>/<array>
+  QString groupPath = QString("%1/%2/%3").arg(SIMPL::StringConstants::DataContainerGroupName, dataContainer, attributeMatrix->getName());
+  hid_t attributeMatrixId = H5Gopen(fileId, groupPath.toLatin1().constData(), H5P_DEFAULT);
+  if(attributeMatrixId < 0)
+  {
+    return false;
+  }
+  sentinel.addGroupId(&attributeMatrixId);
+  return array->writeH5Data(attributeMatrixId, attributeMatrix->getTupleDimensions()) >= 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer StageCache::ReadSnapshotFile(const QString& filePath)
+{
+  if(!QFileInfo::exists(filePath))
+  {
+    return DataContainerArray::NullPointer();
+  }
+
+  QMutexLocker locker(&s_SnapshotFileMutex);
+  DataContainerReader::Pointer reader = DataContainerReader::New();
+  reader->setInputFile(filePath);
+  DataContainerArrayProxy proxy = reader->readDataContainerArrayStructure(filePath);
+  proxy.setAllFlags(Qt::Checked);
+  reader->setInputFileDataContainerArrayProxy(proxy);
+  reader->setDataContainerArray(DataContainerArray::New());
+  reader->execute();
+  if(reader->getErrorCondition() < 0)
+  {
+    return DataContainerArray::NullPointer();
+  }
+  return reader->getDataContainerArray();
+}
@@ -0,0 +1,231 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <memory>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QMap>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+
+class QLockFile;
+
+/**
+ * @brief The StageCache class keeps snapshots of the DataContainerArray as it was after a filter executed,
+ * so that a pipeline can be executed again starting behind the last filter that did not change. A snapshot
+ * is keyed by a hash over the parameters of its filter and of every filter in front of it, so a key can
+ * only match when the whole upstream part of the pipeline is the same. The size and modification time of
+ * every existing file that a filter's parameters name, other than its output files, are hashed as well, so
+ * replacing an input file on disk invalidates the filter and everything downstream of it.
+ *
+ * Snapshots are held in memory or written to scratch files. When the budget is exceeded the snapshots that
+ * were used least recently are evicted. The cache is shared by all windows and may be used from any thread.
+ */
+class StageCache
+{
+public:
+  enum class Storage : int
+  {
+    Memory = 0,
+    Disk
+  };
+
+  virtual ~StageCache();
+
+  /**
+   * @brief Instance
+   * @return
+   */
+  static StageCache* Instance();
+
+  /**
+   * @brief ComputeStageKeys
+   * @param pipelineJson The contents of a pipeline file
+   * @return One key per filter in the pipeline, which also covers the input files the filters read
+   */
+  static QStringList ComputeStageKeys(const QJsonObject& pipelineJson);
+
+  /**
+   * @brief contains
+   * @param key
+   * @return
+   */
+  bool contains(const QString& key) const;
+
+  /**
+   * @brief findResumeIndex
+   * @param keys The stage keys of a pipeline
+   * @return The index of the last filter whose snapshot is cached, or -1
+   */
+  int findResumeIndex(const QStringList& keys) const;
+
+  /**
+   * @brief restore
+   * @param key
+   * @return A copy of the snapshot that the caller may modify, or a null pointer if there is none
+   */
+  DataContainerArray::Pointer restore(const QString& key);
+
+  /**
+   * @brief store Copies the DataContainerArray into the cache, evicting older snapshots to stay within the budget
+   * @param key
+   * @param dca
+   * @return False if the snapshot is larger than the budget or could not be written
+   */
+  bool store(const QString& key, const DataContainerArray::Pointer& dca);
+
+  /**
+   * @brief clear Drops every snapshot
+   */
+  void clear();
+
+  /**
+   * @brief setBudgetMB
+   * @param budgetMB
+   */
+  void setBudgetMB(int budgetMB);
+
+  /**
+   * @brief getBudgetMB
+   * @return
+   */
+  int getBudgetMB() const;
+
+  /**
+   * @brief setStorage Changing the storage drops every snapshot
+   * @param storage
+   */
+  void setStorage(Storage storage);
+
+  /**
+   * @brief getStorage
+   * @return
+   */
+  Storage getStorage() const;
+
+  /**
+   * @brief getUsedBytes
+   * @return
+   */
+  qint64 getUsedBytes() const;
+
+  /**
+   * @brief getSnapshotCount
+   * @return
+   */
+  int getSnapshotCount() const;
+
+  /**
+   * @brief writeSettings Must be called from the main thread
+   */
+  void writeSettings() const;
+
+  /**
+   * @brief WriteSnapshotFile Writes a DataContainerArray to a .dream3d file, callable from any thread
+   * @param dca
+   * @param filePath
+   * @return
+   */
+  static bool WriteSnapshotFile(const DataContainerArray::Pointer& dca, const QString& filePath);
+
+  /**
+   * @brief AppendArrayToSnapshotFile Adds an array that was not in the DataContainerArray when the snapshot
+   * file was written to its attribute matrix in the file, callable from any thread
+   * @param filePath
+   * @param dataContainer
+   * @param attributeMatrix The attribute matrix the array belongs to, which must be in the file
+   * @param array
+   * @return
+   */
+  static bool AppendArrayToSnapshotFile(const QString& filePath, const QString& dataContainer, const AttributeMatrix::Pointer& attributeMatrix, const IDataArray::Pointer& array);
+
+  /**
+   * @brief ReadSnapshotFile
+   * @param filePath
+   * @return
+   */
+  static DataContainerArray::Pointer ReadSnapshotFile(const QString& filePath);
+
+protected:
+  StageCache();
+
+  struct Snapshot
+  {
+    DataContainerArray::Pointer dca;
+    QString filePath;
+    qint64 bytes = 0;
+    qint64 lastUsed = 0;
+  };
+
+  /**
+   * @brief readSettings
+   */
+  void readSettings();
+
+  /**
+   * @brief evict Drops least recently used snapshots until bytes more fit into the budget, m_Mutex must be held
+   * @param bytes
+   */
+  void evict(qint64 bytes);
+
+  /**
+   * @brief Release Frees the memory or the scratch file of a snapshot
+   * @param snapshot
+   */
+  static void Release(const Snapshot& snapshot);
+
+private:
+  static StageCache* self;
+
+  mutable QMutex m_Mutex;
+  QMap<QString, Snapshot> m_Snapshots;
+  qint64 m_UsedBytes = 0;
+  qint64 m_UseCounter = 0;
+
+  int m_BudgetMB = 4096;
+  Storage m_Storage = Storage::Memory;
+  QString m_ScratchDirectory;
+  std::unique_ptr<QLockFile> m_LockFile;
+
+  StageCache(const StageCache&) = delete;     // Copy Constructor Not Implemented
+  void operator=(const StageCache&) = delete; // Move assignment Not Implemented
+};
@@ -0,0 +1,224 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "StartupTracer.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSaveFile>
+#include <QtCore/QThread>
+
+StartupTracer* StartupTracer::self = nullptr;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StartupTracer::StartupTracer()
+{
+  m_Clock.start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StartupTracer::~StartupTracer() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StartupTracer* StartupTracer::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new StartupTracer();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StartupTracer::setOutputFilePath(const QString& filePath)
+{
+  QMutexLocker locker(&m_Mutex);
+  m_OutputFilePath = filePath;
+  m_Enabled = !filePath.isEmpty();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString StartupTracer::getOutputFilePath() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_OutputFilePath;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool StartupTracer::isEnabled() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_Enabled;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 StartupTracer::now() const
+{
+  return m_Clock.nsecsElapsed() / 1000;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StartupTracer::addSpan(const QString& name, const QString& category, qint64 startUSecs, qint64 endUSecs)
+{
+  QMutexLocker locker(&m_Mutex);
+  if(!m_Enabled)
+  {
+    return;
+  }
+
+  QThread* thread = QThread::currentThread();
+  if(!m_ThreadIds.contains(thread))
+  {
+    m_ThreadIds.insert(thread, m_ThreadIds.size() + 1);
+  }
+
+  Span span;
+  span.name = name;
+  span.category = category;
+  span.startUSecs = startUSecs;
+  span.durationUSecs = endUSecs - startUSecs;
+  span.threadId = m_ThreadIds.value(thread);
+  m_Spans.push_back(span);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool StartupTracer::writeFile()
+{
+  QMutexLocker locker(&m_Mutex);
+  if(!m_Enabled)
+  {
+    return false;
+  }
+  m_Enabled = false;
+
+  const qint64 pid = QCoreApplication::applicationPid();
+
+  QJsonArray events;
+  for(QHash<QThread*, int>::const_iterator iter = m_ThreadIds.constBegin(); iter != m_ThreadIds.constEnd(); ++iter)
+  {
+    bool isMainThread = (QCoreApplication::instance() != nullptr && iter.key() == QCoreApplication::instance()->thread());
+
+    QJsonObject args;
+    args["name"] = isMainThread ? QString("Main Thread") : QString("Worker %1").arg(iter.value());
+
+    QJsonObject event;
+    event["name"] = QString("thread_name");
+    event["ph"] = QString("M");
+    event["pid"] = pid;
+    event["tid"] = iter.value();
+    event["args"] = args;
+    events.push_back(event);
+  }
+
+  for(const Span& span : m_Spans)
+  {
+    QJsonObject event;
+    event["name"] = span.name;
+    event["cat"] = span.category;
+    event["ph"] = QString("X");
+    event["ts"] = span.startUSecs;
+    event["dur"] = span.durationUSecs;
+    event["pid"] = pid;
+    event["tid"] = span.threadId;
+    events.push_back(event);
+  }
+
+  QJsonObject root;
+  root["traceEvents"] = events;
+  root["displayTimeUnit"] = QString("ms");
+
+  QSaveFile file(m_OutputFilePath);
+  if(!file.open(QIODevice::WriteOnly))
+  {
+    qDebug() << "Could not open the startup trace file" << m_OutputFilePath;
+    return false;
+  }
+  file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+  bool didWrite = file.commit();
+  qDebug() << "Startup trace with" << m_Spans.size() << "spans written to" << m_OutputFilePath;
+
+  m_Spans.clear();
+  return didWrite;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StartupTraceScope::StartupTraceScope(const QString& name, const QString& category)
+: m_Name(name)
+, m_Category(category)
+{
+  StartupTracer* tracer = StartupTracer::Instance();
+  if(tracer->isEnabled())
+  {
+    m_StartUSecs = tracer->now();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StartupTraceScope::~StartupTraceScope()
+{
+  if(m_StartUSecs < 0)
+  {
+    return;
+  }
+
+  StartupTracer* tracer = StartupTracer::Instance();
+  tracer->addSpan(m_Name, m_Category, m_StartUSecs, tracer->now());
+}
@@ -0,0 +1,145 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+class QThread;
+
+/**
+ * @brief The StartupTracer class records wall-clock spans for the phases of the application startup and
+ * writes them as a Chrome trace (chrome://tracing or https://ui.perfetto.dev). Nothing is recorded unless an
+ * output file has been set, so the instrumentation costs nothing in a normal launch. Spans may be recorded
+ * from any thread.
+ */
+class StartupTracer
+{
+public:
+  virtual ~StartupTracer();
+
+  /**
+   * @brief Instance The clock starts when this is first called, which should be as early in main() as possible
+   * @return
+   */
+  static StartupTracer* Instance();
+
+  /**
+   * @brief setOutputFilePath Enables tracing
+   * @param filePath The Chrome trace Json file that is written by writeFile()
+   */
+  void setOutputFilePath(const QString& filePath);
+
+  /**
+   * @brief getOutputFilePath
+   * @return
+   */
+  QString getOutputFilePath() const;
+
+  /**
+   * @brief isEnabled
+   * @return
+   */
+  bool isEnabled() const;
+
+  /**
+   * @brief now
+   * @return Microseconds since the tracer was created
+   */
+  qint64 now() const;
+
+  /**
+   * @brief addSpan Records a completed span on the calling thread
+   * @param name
+   * @param category
+   * @param startUSecs As returned by now()
+   * @param endUSecs As returned by now()
+   */
+  void addSpan(const QString& name, const QString& category, qint64 startUSecs, qint64 endUSecs);
+
+  /**
+   * @brief writeFile Writes all of the recorded spans and stops tracing
+   * @return
+   */
+  bool writeFile();
+
+protected:
+  StartupTracer();
+
+private:
+  struct Span
+  {
+    QString name;
+    QString category;
+    qint64 startUSecs = 0;
+    qint64 durationUSecs = 0;
+    int threadId = 0;
+  };
+
+  static StartupTracer* self;
+
+  QElapsedTimer m_Clock;
+  QString m_OutputFilePath;
+  bool m_Enabled = false;
+
+  mutable QMutex m_Mutex;
+  QVector<Span> m_Spans;
+  QHash<QThread*, int> m_ThreadIds;
+
+  StartupTracer(const StartupTracer&) = delete;  // Copy Constructor Not Implemented
+  void operator=(const StartupTracer&) = delete; // Move assignment Not Implemented
+};
+
+/**
+ * @brief The StartupTraceScope class records a span from its construction until it goes out of scope
+ */
+class StartupTraceScope
+{
+public:
+  StartupTraceScope(const QString& name, const QString& category = QString("Startup"));
+  ~StartupTraceScope();
+
+private:
+  QString m_Name;
+  QString m_Category;
+  qint64 m_StartUSecs = -1;
+
+  StartupTraceScope(const StartupTraceScope&) = delete; // Copy Constructor Not Implemented
+  void operator=(const StartupTraceScope&) = delete;    // Move assignment Not Implemented
+};
@@ -53,6 +53,7 @@
 #include "SVStyle.h"
 #include "StyleSheetEditor.h"
 #include "BrandedStrings.h"
+#include "SIMPLViewApplication.h"
 
 #include "SVWidgetsLib/QtSupport/QtSStyles.h"
 
@@ -100,8 +101,8 @@ void StyleSheetEditor::on_reloadButton_stateChanged(int state)
 void StyleSheetEditor::qssFileChanged(const QString& filePath)
 {
   qDebug() << "Changed: " << filePath;
-  SVStyle* style = SVStyle::Instance();
-  style->loadStyleSheet(m_Ui->jsonFilePath->text());
+  // The compiled theme is keyed on the file contents, so an edited theme is always parsed again
+  dream3dApp->loadTheme(m_Ui->jsonFilePath->text());
 }
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,367 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ThemeCache.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMetaMethod>
+#include <QtCore/QMetaProperty>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+
+#include <QtWidgets/QApplication>
+
+#include "SVWidgetsLib/Widgets/SVStyle.h"
+
+namespace
+{
+const quint32 k_CompiledThemeMagic = 0x53565448; // "SVTH"
+// Bump this whenever the layout of a compiled theme file changes
+const qint32 k_CompiledThemeVersion = 1;
+
+// -----------------------------------------------------------------------------
+// Collects every string in the theme that names an existing file, e.g. the CSS template
+// -----------------------------------------------------------------------------
+void collectReferencedFiles(const QJsonValue& value, const QDir& themeDir, QStringList& filePaths)
+{
+  if(value.isObject())
+  {
+    QJsonObject object = value.toObject();
+    for(QJsonObject::const_iterator iter = object.constBegin(); iter != object.constEnd(); ++iter)
+    {
+      collectReferencedFiles(iter.value(), themeDir, filePaths);
+    }
+  }
+  else if(value.isArray())
+  {
+    for(const QJsonValue& element : value.toArray())
+    {
+      collectReferencedFiles(element, themeDir, filePaths);
+    }
+  }
+  else if(value.isString())
+  {
+    QString str = value.toString();
+    if(str.isEmpty() || str.startsWith('#'))
+    {
+      return;
+    }
+    QFileInfo fi(QDir::isAbsolutePath(str) ? str : themeDir.absoluteFilePath(str));
+    if(fi.isFile())
+    {
+      filePaths.push_back(fi.absoluteFilePath());
+    }
+  }
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ThemeCache::ThemeCache() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ThemeCache::~ThemeCache() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ThemeCache::DefaultDirectoryPath()
+{
+  QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  return cacheDir + "/ThemeCache";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ThemeCache::ComputeThemeKey(const QString& themeFilePath)
+{
+  QFile themeFile(themeFilePath);
+  if(!themeFile.open(QIODevice::ReadOnly))
+  {
+    return QString();
+  }
+  QByteArray themeContents = themeFile.readAll();
+
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(QByteArray::number(k_CompiledThemeVersion));
+  hash.addData(QT_VERSION_STR);
+  hash.addData(themeContents);
+
+  QJsonDocument doc = QJsonDocument::fromJson(themeContents);
+  QStringList referencedFiles;
+  if(doc.isObject())
+  {
+    collectReferencedFiles(doc.object(), QFileInfo(themeFilePath).absoluteDir(), referencedFiles);
+  }
+  referencedFiles.removeDuplicates();
+  referencedFiles.sort();
+  for(const QString& filePath : referencedFiles)
+  {
+    QFile file(filePath);
+    if(file.open(QIODevice::ReadOnly))
+    {
+      hash.addData(filePath.toUtf8());
+      hash.addData(&file);
+    }
+  }
+
+  return QString::fromLatin1(hash.result().toHex());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ThemeCache::applyTheme(const QString& themeFilePath)
+{
+  QString key = ComputeThemeKey(themeFilePath);
+
+  CompiledTheme theme;
+  bool found = false;
+  if(!key.isEmpty())
+  {
+    if(m_Themes.contains(key))
+    {
+      theme = m_Themes.value(key);
+      found = true;
+    }
+    else if(readCompiledTheme(key, theme))
+    {
+      m_Themes.insert(key, theme);
+      found = true;
+    }
+  }
+
+  m_CurrentThemeFilePath = themeFilePath;
+
+  if(!found)
+  {
+    m_MissCount++;
+    SVStyle::Instance()->loadStyleSheet(themeFilePath);
+    if(!key.isEmpty())
+    {
+      theme = compileCurrentTheme();
+      m_Themes.insert(key, theme);
+      writeCompiledTheme(key, theme);
+    }
+    return false;
+  }
+
+  m_HitCount++;
+
+  // Restore the values that the widgets read back from SVStyle before they are re-polished
+  restoreStyleState(theme, themeFilePath);
+
+  if(QApplication::palette() != theme.palette)
+  {
+    QApplication::setPalette(theme.palette);
+  }
+
+  // Re-applying the same style sheet would still re-polish every widget
+  if(qApp->styleSheet() != theme.styleSheet)
+  {
+    qApp->setStyleSheet(theme.styleSheet);
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ThemeCache::getCurrentThemeFilePath() const
+{
+  return m_CurrentThemeFilePath;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ThemeCache::clear()
+{
+  m_Themes.clear();
+  QDir dir(DefaultDirectoryPath());
+  if(dir.exists())
+  {
+    dir.removeRecursively();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ThemeCache::getHitCount() const
+{
+  return m_HitCount;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ThemeCache::getMissCount() const
+{
+  return m_MissCount;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ThemeCache::CompiledTheme ThemeCache::compileCurrentTheme() const
+{
+  CompiledTheme theme;
+  theme.styleSheet = qApp->styleSheet();
+  theme.palette = QApplication::palette();
+
+  // SVStyle keeps the colors and fonts of the theme as properties that widgets query while painting
+  SVStyle* style = SVStyle::Instance();
+  const QMetaObject* metaObject = style->metaObject();
+  for(int i = QObject::staticMetaObject.propertyCount(); i < metaObject->propertyCount(); i++)
+  {
+    QMetaProperty property = metaObject->property(i);
+    if(property.isReadable() && property.isWritable())
+    {
+      theme.styleProperties.insert(QString::fromLatin1(property.name()), property.read(style));
+    }
+  }
+  for(const QByteArray& name : style->dynamicPropertyNames())
+  {
+    theme.styleProperties.insert(QString::fromLatin1(name), style->property(name.constData()));
+  }
+
+  return theme;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ThemeCache::restoreStyleState(const CompiledTheme& theme, const QString& themeFilePath) const
+{
+  SVStyle* style = SVStyle::Instance();
+
+  // SVStyle::loadStyleSheet() starts every theme from a clean slate, so values that only the previous theme set must go
+  for(const QByteArray& name : style->dynamicPropertyNames())
+  {
+    if(!theme.styleProperties.contains(QString::fromLatin1(name)))
+    {
+      style->setProperty(name.constData(), QVariant());
+    }
+  }
+
+  for(QVariantMap::const_iterator iter = theme.styleProperties.constBegin(); iter != theme.styleProperties.constEnd(); ++iter)
+  {
+    style->setProperty(iter.key().toLatin1().constData(), iter.value());
+  }
+
+  // The compiled theme may have been built from another copy of the same file, so record the path that was asked for
+  const QMetaObject* metaObject = style->metaObject();
+  int pathIndex = metaObject->indexOfProperty("CurrentThemeFilePath");
+  if(pathIndex >= 0 && metaObject->property(pathIndex).isWritable())
+  {
+    metaObject->property(pathIndex).write(style, themeFilePath);
+  }
+
+  // Let everything that listens to SVStyle know about the new theme, just as a full load would
+  int signalIndex = metaObject->indexOfSignal(QMetaObject::normalizedSignature("styleSheetLoaded(QString)").constData());
+  if(signalIndex >= 0)
+  {
+    metaObject->method(signalIndex).invoke(style, Qt::DirectConnection, Q_ARG(QString, themeFilePath));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ThemeCache::readCompiledTheme(const QString& key, CompiledTheme& theme) const
+{
+  QFile file(DefaultDirectoryPath() + "/" + key + ".theme");
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return false;
+  }
+
+  QDataStream in(&file);
+  in.setVersion(QDataStream::Qt_5_6);
+
+  quint32 magic = 0;
+  qint32 version = 0;
+  in >> magic >> version;
+  if(magic != k_CompiledThemeMagic || version != k_CompiledThemeVersion)
+  {
+    return false;
+  }
+
+  in >> theme.styleSheet >> theme.palette >> theme.styleProperties;
+  if(in.status() != QDataStream::Ok)
+  {
+    qDebug() << "Could not read the compiled theme" << file.fileName();
+    return false;
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ThemeCache::writeCompiledTheme(const QString& key, const CompiledTheme& theme) const
+{
+  QDir().mkpath(DefaultDirectoryPath());
+
+  // QSaveFile only replaces the old file once everything has been written
+  QSaveFile file(DefaultDirectoryPath() + "/" + key + ".theme");
+  if(!file.open(QIODevice::WriteOnly))
+  {
+    qDebug() << "Could not write the compiled theme" << file.fileName();
+    return false;
+  }
+
+  QDataStream out(&file);
+  out.setVersion(QDataStream::Qt_5_6);
+  out << k_CompiledThemeMagic << k_CompiledThemeVersion;
+  out << theme.styleSheet << theme.palette << theme.styleProperties;
+
+  return file.commit();
+}
@@ -0,0 +1,124 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QVariantMap>
+
+#include <QtGui/QPalette>
+
+/**
+ * @brief The ThemeCache class keeps the fully resolved result of SVStyle::loadStyleSheet() for each theme
+ * so that switching to a theme that has been loaded before only needs a single QApplication::setStyleSheet().
+ * Compiled themes are keyed by a hash of the contents of the theme Json file and of every file it refers to,
+ * so an edited theme is never served stale. They are kept in memory and in the user's cache directory.
+ */
+class ThemeCache
+{
+public:
+  ThemeCache();
+  virtual ~ThemeCache();
+
+  /**
+   * @brief DefaultDirectoryPath
+   * @return The directory that compiled themes are written to
+   */
+  static QString DefaultDirectoryPath();
+
+  /**
+   * @brief ComputeThemeKey Hashes the theme Json file and every file that it refers to
+   * @param themeFilePath
+   * @return The hex encoded hash, or an empty string if the theme file can not be read
+   */
+  static QString ComputeThemeKey(const QString& themeFilePath);
+
+  /**
+   * @brief applyTheme Applies the compiled theme if there is one, otherwise loads the theme through
+   * SVStyle and compiles it for the next time
+   * @param themeFilePath
+   * @return True if the theme was applied from the cache
+   */
+  bool applyTheme(const QString& themeFilePath);
+
+  /**
+   * @brief getCurrentThemeFilePath SVStyle only knows about themes that it has parsed itself, so the
+   * path of the theme that was applied last is tracked here
+   * @return
+   */
+  QString getCurrentThemeFilePath() const;
+
+  /**
+   * @brief clear Removes all compiled themes from memory and from disk
+   */
+  void clear();
+
+  int getHitCount() const;
+  int getMissCount() const;
+
+private:
+  struct CompiledTheme
+  {
+    QString styleSheet;
+    QPalette palette;
+    QVariantMap styleProperties;
+  };
+
+  QHash<QString, CompiledTheme> m_Themes;
+  QString m_CurrentThemeFilePath;
+  int m_HitCount = 0;
+  int m_MissCount = 0;
+
+  /**
+   * @brief compileCurrentTheme Captures the state that SVStyle::loadStyleSheet() left behind
+   * @return
+   */
+  CompiledTheme compileCurrentTheme() const;
+
+  /**
+   * @brief restoreStyleState Puts SVStyle into the state that SVStyle::loadStyleSheet() would have left it in
+   * for this theme, so that code reading the theme back from SVStyle can not tell a cache hit from a full load
+   * @param theme
+   * @param themeFilePath
+   */
+  void restoreStyleState(const CompiledTheme& theme, const QString& themeFilePath) const;
+
+  bool readCompiledTheme(const QString& key, CompiledTheme& theme) const;
+  bool writeCompiledTheme(const QString& key, const CompiledTheme& theme) const;
+
+  ThemeCache(const ThemeCache&) = delete;     // Copy Constructor Not Implemented
+  void operator=(const ThemeCache&) = delete;   // Move assignment Not Implemented
+};
@@ -0,0 +1,290 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "TimingHistory.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QLockFile>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+
+TimingHistory* TimingHistory::self = nullptr;
+
+namespace
+{
+const int k_FileVersion = 1;
+
+// How far each new run moves the remembered time towards its own
+const double k_Weight = 0.5;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int sizeBucket(qint64 tuples)
+{
+  int bucket = 0;
+  while(tuples > 0)
+  {
+    tuples >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString entryKey(const QString& className, int bucket)
+{
+  return QString("%1/%2").arg(className).arg(bucket);
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TimingHistory::TimingHistory()
+{
+  m_FilePath = qgetenv("SIMPL_TIMING_HISTORY");
+  if(m_FilePath.isEmpty())
+  {
+    m_FilePath = QDir(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("TimingHistory.json");
+  }
+
+  m_Entries = readFile();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TimingHistory::~TimingHistory() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TimingHistory* TimingHistory::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new TimingHistory();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 TimingHistory::SizeSignature(const DataContainerArray::Pointer& dca)
+{
+  qint64 tuples = 0;
+  if(dca.get() == nullptr)
+  {
+    return tuples;
+  }
+  for(DataContainer::Pointer dc : dca->getDataContainers())
+  {
+    for(AttributeMatrix::Pointer am : dc->getAttributeMatrices())
+    {
+      tuples = qMax(tuples, static_cast<qint64>(am->getNumberOfTuples()));
+    }
+  }
+  return tuples;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 TimingHistory::predictMSecs(const QString& className, qint64 tuples) const
+{
+  // Inputs just across a bucket boundary are still close enough to scale from
+  int bucket = sizeBucket(tuples);
+  for(int candidate : {bucket, bucket - 1, bucket + 1})
+  {
+    auto iter = m_Entries.constFind(entryKey(className, candidate));
+    if(iter == m_Entries.constEnd())
+    {
+      continue;
+    }
+    const Entry& entry = iter.value();
+    if(entry.tuples <= 0.0 || tuples <= 0)
+    {
+      return static_cast<qint64>(entry.wallMSecs);
+    }
+    return static_cast<qint64>(entry.wallMSecs * static_cast<double>(tuples) / entry.tuples);
+  }
+  return -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TimingHistory::record(const QString& className, qint64 tuples, qint64 wallMSecs)
+{
+  Sample sample;
+  sample.key = entryKey(className, sizeBucket(tuples));
+  sample.tuples = tuples;
+  sample.wallMSecs = wallMSecs;
+  AddSample(m_Entries[sample.key], tuples, wallMSecs);
+  m_Unsaved.push_back(sample);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TimingHistory::AddSample(Entry& entry, qint64 tuples, qint64 wallMSecs)
+{
+  if(entry.samples == 0)
+  {
+    entry.wallMSecs = wallMSecs;
+    entry.tuples = tuples;
+  }
+  else
+  {
+    entry.wallMSecs += k_Weight * (wallMSecs - entry.wallMSecs);
+    entry.tuples += k_Weight * (tuples - entry.tuples);
+  }
+  entry.samples++;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool TimingHistory::save()
+{
+  if(m_Unsaved.isEmpty())
+  {
+    return true;
+  }
+
+  // Another process may have saved its own runs since this one read the file
+  QDir().mkpath(QFileInfo(m_FilePath).absolutePath());
+  QLockFile lockFile(m_FilePath + ".lock");
+  if(!lockFile.lock())
+  {
+    return false;
+  }
+  QHash<QString, Entry> merged = readFile();
+  for(const Sample& sample : m_Unsaved)
+  {
+    AddSample(merged[sample.key], sample.tuples, sample.wallMSecs);
+  }
+
+  QJsonObject entries;
+  for(auto iter = merged.constBegin(); iter != merged.constEnd(); ++iter)
+  {
+    QJsonObject entry;
+    entry["Samples"] = iter.value().samples;
+    entry["Wall Time MSecs"] = iter.value().wallMSecs;
+    entry["Tuples"] = iter.value().tuples;
+    entries[iter.key()] = entry;
+  }
+
+  QJsonObject root;
+  root["Version"] = k_FileVersion;
+  root["Entries"] = entries;
+
+  QSaveFile file(m_FilePath);
+  if(!file.open(QIODevice::WriteOnly))
+  {
+    return false;
+  }
+  file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+  if(!file.commit())
+  {
+    return false;
+  }
+  m_Entries = merged;
+  m_Unsaved.clear();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TimingHistory::clear()
+{
+  m_Entries.clear();
+  m_Unsaved.clear();
+  QFile::remove(m_FilePath);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString TimingHistory::getFilePath() const
+{
+  return m_FilePath;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QHash<QString, TimingHistory::Entry> TimingHistory::readFile() const
+{
+  QHash<QString, Entry> result;
+  QFile file(m_FilePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return result;
+  }
+
+  QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+  if(root["Version"].toInt() != k_FileVersion)
+  {
+    return result;
+  }
+
+  QJsonObject entries = root["Entries"].toObject();
+  for(auto iter = entries.constBegin(); iter != entries.constEnd(); ++iter)
+  {
+    QJsonObject object = iter.value().toObject();
+    Entry entry;
+    entry.samples = object["Samples"].toInt();
+    entry.wallMSecs = object["Wall Time MSecs"].toDouble();
+    entry.tuples = object["Tuples"].toDouble();
+    if(entry.samples > 0)
+    {
+      result.insert(iter.key(), entry);
+    }
+  }
+  return result;
+}
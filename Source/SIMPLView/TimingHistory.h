@@ -0,0 +1,145 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+
+/**
+ * @brief The TimingHistory class remembers how long each filter took in earlier runs. The wall times are
+ * kept per filter class and input size signature, the power of two bucket of the largest attribute matrix
+ * the filter sees, and are scaled linearly with the tuples within a bucket. Each new run moves the
+ * remembered time halfway towards the new one, so the history follows a machine that got faster or
+ * a filter that changed. The history is shared by all windows and written to TimingHistory.json in the
+ * application's data directory, or to the file SIMPL_TIMING_HISTORY names. Several processes may share the
+ * file, so saving re-reads it under a lock and adds only the runs this process recorded since its last save.
+ * Only use it from one thread.
+ */
+class TimingHistory
+{
+public:
+  virtual ~TimingHistory();
+
+  /**
+   * @brief Instance
+   * @return
+   */
+  static TimingHistory* Instance();
+
+  /**
+   * @brief SizeSignature
+   * @param dca
+   * @return The tuples of the largest attribute matrix in the DataContainerArray
+   */
+  static qint64 SizeSignature(const DataContainerArray::Pointer& dca);
+
+  /**
+   * @brief predictMSecs
+   * @param className
+   * @param tuples The size signature of the filter's input
+   * @return The expected wall time of the filter, or -1 if it was never timed on inputs of about this size
+   */
+  qint64 predictMSecs(const QString& className, qint64 tuples) const;
+
+  /**
+   * @brief record Adds the wall time of a filter that completed
+   * @param className
+   * @param tuples
+   * @param wallMSecs
+   */
+  void record(const QString& className, qint64 tuples, qint64 wallMSecs);
+
+  /**
+   * @brief save Merges the runs recorded since the last save into the file, if there are any
+   * @return False if the file could not be written
+   */
+  bool save();
+
+  /**
+   * @brief clear Forgets every timing
+   */
+  void clear();
+
+  /**
+   * @brief getFilePath
+   * @return
+   */
+  QString getFilePath() const;
+
+protected:
+  TimingHistory();
+
+  struct Entry
+  {
+    int samples = 0;
+    double wallMSecs = 0.0;
+    double tuples = 0.0;
+  };
+
+  struct Sample
+  {
+    QString key;
+    qint64 tuples = 0;
+    qint64 wallMSecs = 0;
+  };
+
+  /**
+   * @brief readFile
+   * @return The entries in the history file
+   */
+  QHash<QString, Entry> readFile() const;
+
+  /**
+   * @brief AddSample Moves the entry towards a new run
+   * @param entry
+   * @param tuples
+   * @param wallMSecs
+   */
+  static void AddSample(Entry& entry, qint64 tuples, qint64 wallMSecs);
+
+private:
+  static TimingHistory* self;
+
+  QString m_FilePath;
+  QHash<QString, Entry> m_Entries;
+  QVector<Sample> m_Unsaved;
+
+  TimingHistory(const TimingHistory&) = delete;  // Copy Constructor Not Implemented
+  void operator=(const TimingHistory&) = delete; // Move assignment Not Implemented
+};
@@ -0,0 +1,292 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "WatchDirectoryDialog.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QMessageBox>
+
+#include "SIMPLView/WorkerPool.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+WatchDirectoryDialog::WatchDirectoryDialog(const QString& pipelineFilePath, QWidget* parent)
+: QDialog(parent)
+{
+  setupUi(this);
+
+  m_Watcher = new DirectoryWatcher(this);
+  QString error;
+  if(!m_Watcher->setPipelineFile(pipelineFilePath, error))
+  {
+    statusLabel->setText(error);
+  }
+
+  setupGui();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+WatchDirectoryDialog::~WatchDirectoryDialog()
+{
+  // Nobody is left to report the runs to
+  WorkerPool* workerPool = WorkerPool::Instance();
+  for(int workerRunId : m_WorkerRuns.keys())
+  {
+    workerPool->cancel(workerRunId);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchDirectoryDialog::setupGui()
+{
+  setWindowFlags(this->windowFlags() & ~Qt::WindowContextHelpButtonHint);
+
+  QStringList fileParameters = DirectoryWatcher::FindFileParameters(m_Watcher->getPipelineJson());
+  inputParameterCombo->addItems(fileParameters);
+  outputParameterCombo->addItem(QString());
+  outputParameterCombo->addItems(fileParameters);
+
+  // Readers usually call the parameter InputFile or InputPath and writers OutputFile
+  for(int i = 0; i < fileParameters.size(); i++)
+  {
+    if(fileParameters[i].contains("Input", Qt::CaseInsensitive))
+    {
+      inputParameterCombo->setCurrentIndex(i);
+      break;
+    }
+  }
+  for(int i = fileParameters.size() - 1; i >= 0; i--)
+  {
+    if(fileParameters[i].contains("Output", Qt::CaseInsensitive))
+    {
+      outputParameterCombo->setCurrentIndex(i + 1);
+      break;
+    }
+  }
+
+  settleSpinBox->setValue(DirectoryWatcher::DefaultSettleMSecs);
+  maxInFlightSpinBox->setValue(WorkerPool::Instance()->getWorkerCount());
+  runsTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
+
+  connect(m_Watcher, &DirectoryWatcher::runReady, this, &WatchDirectoryDialog::queueRun);
+  connect(m_Watcher, &DirectoryWatcher::runsChanged, this, &WatchDirectoryDialog::updateRuns);
+  connect(WorkerPool::Instance(), &WorkerPool::runFinished, this, &WatchDirectoryDialog::workerRunFinished);
+
+  setWatching(false);
+  updateRuns();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool WatchDirectoryDialog::isWatching() const
+{
+  return m_Watcher->isWatching();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchDirectoryDialog::reject()
+{
+  // The watch goes on in the background
+  hide();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchDirectoryDialog::on_selectDirectoryBtn_clicked()
+{
+  QString dirPath = QFileDialog::getExistingDirectory(this, tr("Select the Directory to Watch"), directoryEdit->text());
+  if(!dirPath.isEmpty())
+  {
+    directoryEdit->setText(dirPath);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchDirectoryDialog::on_selectOutputDirectoryBtn_clicked()
+{
+  QString dirPath = QFileDialog::getExistingDirectory(this, tr("Select the Output Directory"), outputDirectoryEdit->text());
+  if(!dirPath.isEmpty())
+  {
+    outputDirectoryEdit->setText(dirPath);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchDirectoryDialog::on_startBtn_clicked()
+{
+  QString error;
+  if(!m_Watcher->setInputParameter(inputParameterCombo->currentText(), error) || !m_Watcher->setOutputParameter(outputParameterCombo->currentText(), error))
+  {
+    QMessageBox::warning(this, tr("Watch Directory"), error);
+    return;
+  }
+
+  m_Watcher->setOutputDirectory(outputDirectoryEdit->text());
+  m_Watcher->setNameFilters(nameFiltersEdit->text().split(' ', QString::SkipEmptyParts));
+  m_Watcher->setSettleMSecs(settleSpinBox->value());
+  m_Watcher->setMaxInFlight(maxInFlightSpinBox->value());
+  m_Watcher->setProcessExistingFiles(processExistingCheckBox->isChecked());
+  if(!m_Watcher->start(directoryEdit->text(), error))
+  {
+    QMessageBox::warning(this, tr("Watch Directory"), error);
+    return;
+  }
+
+  setWatching(true);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchDirectoryDialog::on_stopBtn_clicked()
+{
+  m_Watcher->stop();
+  setWatching(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchDirectoryDialog::setWatching(bool watching)
+{
+  watchGroupBox->setEnabled(!watching);
+  startBtn->setEnabled(!watching);
+  stopBtn->setEnabled(watching);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchDirectoryDialog::queueRun(int id, const QString& inputFilePath, const QString& pipelineFilePath)
+{
+  Q_UNUSED(inputFilePath)
+
+  // The pool's workers keep their plugins loaded between runs, so a file does not pay for loading them
+  QFile file(pipelineFilePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    m_Watcher->runFinished(id, -1, tr("The pipeline file of the run could not be read"));
+    return;
+  }
+  QJsonObject pipelineJson = QJsonDocument::fromJson(file.readAll()).object();
+
+  int workerRunId = WorkerPool::Instance()->execute(pipelineJson, false);
+  m_WorkerRuns.insert(workerRunId, id);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchDirectoryDialog::workerRunFinished(int workerRunId, int errorCode, const QString& message, const QJsonObject& arrays)
+{
+  Q_UNUSED(arrays)
+
+  if(!m_WorkerRuns.contains(workerRunId))
+  {
+    return;
+  }
+
+  int runId = m_WorkerRuns.take(workerRunId);
+  for(const DirectoryWatcher::Run& run : m_Watcher->getRuns())
+  {
+    if(run.id == runId)
+    {
+      double seconds = (QDateTime::currentMSecsSinceEpoch() - run.startedMSecs) / 1000.0;
+      QString result = (errorCode < 0) ? tr("failed with error %1 %2").arg(errorCode).arg(message) : tr("done in %1 s").arg(seconds, 0, 'f', 1);
+      emit runMessage(tr("Watch: %1 %2").arg(QFileInfo(run.inputFilePath).fileName(), result));
+      break;
+    }
+  }
+  m_Watcher->runFinished(runId, errorCode, message);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchDirectoryDialog::updateRuns()
+{
+  QVector<DirectoryWatcher::Run> runs = m_Watcher->getRuns();
+
+  // Newest first, that is where the activity is
+  runsTable->setRowCount(runs.size());
+  for(int i = 0; i < runs.size(); i++)
+  {
+    const DirectoryWatcher::Run& run = runs[runs.size() - 1 - i];
+    double seconds = 0.0;
+    if(run.finishedMSecs > 0)
+    {
+      seconds = (run.finishedMSecs - run.startedMSecs) / 1000.0;
+    }
+    else if(run.startedMSecs > 0)
+    {
+      seconds = (QDateTime::currentMSecsSinceEpoch() - run.startedMSecs) / 1000.0;
+    }
+
+    runsTable->setItem(i, 0, new QTableWidgetItem(QFileInfo(run.inputFilePath).fileName()));
+    runsTable->setItem(i, 1, new QTableWidgetItem(DirectoryWatcher::StatusString(run.status)));
+    runsTable->setItem(i, 2, new QTableWidgetItem(QString::number(seconds, 'f', 1)));
+    runsTable->setItem(i, 3, new QTableWidgetItem(run.outputFilePath));
+    runsTable->setItem(i, 4, new QTableWidgetItem(run.message));
+    runsTable->item(i, 0)->setToolTip(run.inputFilePath);
+  }
+
+  QString state = m_Watcher->isWatching() ? tr("Watching %1").arg(m_Watcher->getDirectory()) : tr("Not watching");
+  statusLabel->setText(tr("%1 - %2 being written, %3 waiting, %4 in flight, %5 completed, %6 failed")
+                           .arg(state)
+                           .arg(m_Watcher->getPendingCount())
+                           .arg(m_Watcher->getBacklogCount())
+                           .arg(m_Watcher->getInFlightCount())
+                           .arg(m_Watcher->getFinishedCount(DirectoryWatcher::RunStatus::Completed))
+                           .arg(m_Watcher->getFinishedCount(DirectoryWatcher::RunStatus::Failed)));
+}
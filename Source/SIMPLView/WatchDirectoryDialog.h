@@ -0,0 +1,127 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QMap>
+
+#include <QtWidgets/QDialog>
+
+#include "SIMPLView/DirectoryWatcher.h"
+
+//-- UIC generated Header
+#include "ui_WatchDirectoryDialog.h"
+
+/**
+ * @brief The WatchDirectoryDialog class binds a file parameter of a window's pipeline to a directory and
+ * executes a run in the WorkerPool for every new file. Closing the dialog only hides it, the watch goes on
+ * until it is stopped or the window is closed.
+ */
+class WatchDirectoryDialog : public QDialog, private Ui::WatchDirectoryDialog
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief WatchDirectoryDialog
+   * @param pipelineFilePath The pipeline to run for each file. It is read once, the file may go away afterwards.
+   * @param parent
+   */
+  WatchDirectoryDialog(const QString& pipelineFilePath, QWidget* parent = nullptr);
+  ~WatchDirectoryDialog() override;
+
+  /**
+   * @brief isWatching
+   * @return
+   */
+  bool isWatching() const;
+
+public slots:
+  void reject() override;
+
+signals:
+  /**
+   * @brief runMessage Reports every run that finished
+   * @param message
+   */
+  void runMessage(const QString& message);
+
+protected slots:
+  void on_selectDirectoryBtn_clicked();
+  void on_selectOutputDirectoryBtn_clicked();
+  void on_startBtn_clicked();
+  void on_stopBtn_clicked();
+
+  /**
+   * @brief queueRun Hands a run of the watcher to the worker pool
+   * @param id
+   * @param inputFilePath
+   * @param pipelineFilePath
+   */
+  void queueRun(int id, const QString& inputFilePath, const QString& pipelineFilePath);
+
+  /**
+   * @brief workerRunFinished Reports the worker runs that finished back to the watcher
+   * @param workerRunId
+   * @param errorCode
+   * @param message
+   * @param arrays
+   */
+  void workerRunFinished(int workerRunId, int errorCode, const QString& message, const QJsonObject& arrays);
+
+  /**
+   * @brief updateRuns
+   */
+  void updateRuns();
+
+protected:
+  /**
+   * @brief setupGui
+   */
+  void setupGui();
+
+  /**
+   * @brief setWatching
+   * @param watching
+   */
+  void setWatching(bool watching);
+
+private:
+  DirectoryWatcher* m_Watcher = nullptr;
+  QMap<int, int> m_WorkerRuns;
+
+  WatchDirectoryDialog(const WatchDirectoryDialog&) = delete; // Copy Constructor Not Implemented
+  void operator=(const WatchDirectoryDialog&) = delete;       // Move assignment Not Implemented
+};
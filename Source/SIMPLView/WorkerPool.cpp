@@ -0,0 +1,528 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "WorkerPool.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTimer>
+
+#include <QtNetwork/QLocalServer>
+#include <QtNetwork/QLocalSocket>
+
+#include "SIMPLView/SIMPLViewConstants.h"
+#include "SIMPLView/SettingsStore.h"
+#include "SIMPLView/WorkerProtocol.h"
+
+WorkerPool* WorkerPool::self = nullptr;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+WorkerPool::WorkerPool(QObject* parent)
+: QObject(parent)
+{
+  readSettings();
+
+  m_Server = new QLocalServer(this);
+  QString serverName = QString("SIMPLView-Workers-%1").arg(QCoreApplication::applicationPid());
+  QLocalServer::removeServer(serverName);
+  m_Server->listen(serverName);
+  connect(m_Server, &QLocalServer::newConnection, this, &WorkerPool::workerConnected);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+WorkerPool::~WorkerPool()
+{
+  shutdown();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+WorkerPool* WorkerPool::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new WorkerPool();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString WorkerPool::WorkerExecutablePath()
+{
+  QByteArray executableEnv = qgetenv("SIMPL_WORKER_EXECUTABLE");
+  if(!executableEnv.isEmpty())
+  {
+    return QString::fromLocal8Bit(executableEnv);
+  }
+
+  return ToolExecutablePath("PipelineWorker");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString WorkerPool::ToolExecutablePath(const QString& toolName)
+{
+#if defined(Q_OS_WIN)
+  QString executableName = toolName + ".exe";
+#else
+  QString executableName = toolName;
+#endif
+
+  QDir appDir(QCoreApplication::applicationDirPath());
+#if defined(Q_OS_MAC)
+  // Inside an .app package the tools are installed next to the package
+  if(appDir.dirName() == "MacOS" && !QFileInfo(appDir.filePath(executableName)).exists())
+  {
+    appDir.cd("../../..");
+  }
+#endif
+  return appDir.filePath(executableName);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WorkerPool::warmUp()
+{
+  m_ShuttingDown = false;
+  int activeWorkers = 0;
+  for(Worker* worker : m_Workers)
+  {
+    if(!worker->retiring)
+    {
+      activeWorkers++;
+    }
+  }
+  for(int i = activeWorkers; i < m_WorkerCount; i++)
+  {
+    startWorker();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int WorkerPool::execute(const QJsonObject& pipelineJson, bool returnArrays)
+{
+  QueuedRun run;
+  run.id = m_NextRunId++;
+  run.pipelineJson = pipelineJson;
+  run.returnArrays = returnArrays;
+  m_Queue.enqueue(run);
+
+  // The run starts from the event loop, so that the caller knows its id before any signal about it arrives
+  QTimer::singleShot(0, this, [this] {
+    warmUp();
+    dispatchRuns();
+  });
+  return run.id;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WorkerPool::cancel(int id)
+{
+  for(int i = 0; i < m_Queue.size(); i++)
+  {
+    if(m_Queue[i].id == id)
+    {
+      m_Queue.removeAt(i);
+      emit runFinished(id, -1, tr("Canceled before a worker started the pipeline"), QJsonObject());
+      return;
+    }
+  }
+
+  // Killing is safe here, nothing but the worker's own memory is lost
+  for(Worker* worker : m_Workers)
+  {
+    if(worker->runId == id)
+    {
+      worker->canceled = true;
+      worker->process->kill();
+      return;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WorkerPool::shutdown()
+{
+  m_ShuttingDown = true;
+  while(!m_Queue.isEmpty())
+  {
+    emit runFinished(m_Queue.dequeue().id, -1, tr("The worker pool was shut down"), QJsonObject());
+  }
+
+  // Each worker removes itself from m_Workers when its process is reported as finished
+  QVector<Worker*> workers = m_Workers;
+  for(Worker* worker : workers)
+  {
+    worker->process->kill();
+    worker->process->waitForFinished(1000);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int WorkerPool::getIdleWorkerCount() const
+{
+  int count = 0;
+  for(Worker* worker : m_Workers)
+  {
+    if(worker->idle)
+    {
+      count++;
+    }
+  }
+  return count;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WorkerPool::setWorkerCount(int value)
+{
+  m_WorkerCount = qMax(1, value);
+  writeSettings();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int WorkerPool::getWorkerCount() const
+{
+  return m_WorkerCount;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WorkerPool::setRunsPerWorker(int value)
+{
+  m_RunsPerWorker = qMax(1, value);
+  writeSettings();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int WorkerPool::getRunsPerWorker() const
+{
+  return m_RunsPerWorker;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WorkerPool::startWorker()
+{
+  Worker* worker = new Worker;
+  worker->process = new QProcess(this);
+  worker->process->setProcessChannelMode(QProcess::ForwardedChannels);
+  m_Workers.push_back(worker);
+
+  connect(worker->process, &QProcess::started, this, [worker] { worker->processId = worker->process->processId(); });
+  connect(worker->process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished), this,
+          [this, worker](int exitCode, QProcess::ExitStatus exitStatus) { workerExited(worker, exitCode, exitStatus); });
+  connect(worker->process, &QProcess::errorOccurred, this, [this, worker](QProcess::ProcessError error) {
+    if(error == QProcess::FailedToStart)
+    {
+      workerExited(worker, -1, QProcess::CrashExit);
+    }
+  });
+
+  worker->process->start(WorkerExecutablePath(), QStringList() << "--server" << m_Server->fullServerName());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WorkerPool::dispatchRuns()
+{
+  for(Worker* worker : m_Workers)
+  {
+    if(m_Queue.isEmpty())
+    {
+      return;
+    }
+    if(!worker->idle)
+    {
+      continue;
+    }
+
+    QueuedRun run = m_Queue.dequeue();
+    worker->idle = false;
+    worker->canceled = false;
+    worker->runId = run.id;
+
+    QJsonObject message;
+    message[SIMPLView::WorkerMessage::Type] = SIMPLView::WorkerMessage::Execute;
+    message["Id"] = run.id;
+    message["Pipeline"] = run.pipelineJson;
+    if(run.returnArrays)
+    {
+      message["Array Directory"] = arrayDirectory(run.id);
+    }
+    send(worker, message);
+    emit runStarted(run.id, worker->processId);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WorkerPool::workerConnected()
+{
+  while(m_Server->hasPendingConnections())
+  {
+    QLocalSocket* socket = m_Server->nextPendingConnection();
+
+    // The first message of a worker is Ready with its process id, which pairs the socket with the process
+    connect(socket, &QLocalSocket::readyRead, this, [this, socket] {
+      for(Worker* worker : m_Workers)
+      {
+        if(worker->socket == socket)
+        {
+          readWorker(worker);
+          return;
+        }
+      }
+
+      QByteArray buffer = socket->peek(socket->bytesAvailable());
+      QJsonObject message;
+      if(!WorkerProtocol::TakeMessage(buffer, message))
+      {
+        return;
+      }
+      for(Worker* worker : m_Workers)
+      {
+        if(worker->socket == nullptr && worker->processId == message["Process Id"].toVariant().toLongLong())
+        {
+          worker->socket = socket;
+          readWorker(worker);
+          return;
+        }
+      }
+      socket->abort();
+      socket->deleteLater();
+    });
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WorkerPool::readWorker(Worker* worker)
+{
+  worker->buffer.append(worker->socket->readAll());
+  QJsonObject message;
+  while(WorkerProtocol::TakeMessage(worker->buffer, message))
+  {
+    handleMessage(worker, message);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WorkerPool::handleMessage(Worker* worker, const QJsonObject& message)
+{
+  QString type = message[SIMPLView::WorkerMessage::Type].toString();
+  if(type == SIMPLView::WorkerMessage::Ready)
+  {
+    if(worker->runCount >= m_RunsPerWorker)
+    {
+      retireWorker(worker);
+      return;
+    }
+    worker->idle = true;
+    dispatchRuns();
+  }
+  else if(type == SIMPLView::WorkerMessage::PipelineMessage && worker->runId != 0)
+  {
+    emit runMessage(worker->runId, WorkerProtocol::MessageFromJson(message["Message"].toObject()));
+  }
+  else if(type == SIMPLView::WorkerMessage::Finished && worker->runId != 0)
+  {
+    int runId = worker->runId;
+    worker->runId = 0;
+    worker->runCount++;
+    emit runFinished(runId, message["Error Code"].toInt(), message["Message"].toString(), message["Arrays"].toObject());
+    QDir(arrayDirectory(runId)).removeRecursively();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WorkerPool::workerExited(Worker* worker, int exitCode, QProcess::ExitStatus exitStatus)
+{
+  int index = m_Workers.indexOf(worker);
+  if(index < 0)
+  {
+    return;
+  }
+  m_Workers.remove(index);
+
+  bool wasReady = (worker->socket != nullptr);
+  if(worker->runId != 0)
+  {
+    QString message;
+    if(worker->canceled)
+    {
+      message = tr("Canceled");
+    }
+    else if(exitStatus == QProcess::CrashExit)
+    {
+      message = tr("The worker process crashed while executing the pipeline");
+    }
+    else
+    {
+      message = tr("The worker process exited with code %1 while executing the pipeline").arg(exitCode);
+    }
+    emit runFinished(worker->runId, -1, message, QJsonObject());
+
+    // A killed worker may have written some of the arrays already
+    QDir(arrayDirectory(worker->runId)).removeRecursively();
+  }
+
+  if(worker->socket != nullptr)
+  {
+    worker->socket->abort();
+    worker->socket->deleteLater();
+  }
+  worker->process->disconnect(this);
+  worker->process->deleteLater();
+  delete worker;
+
+  if(m_ShuttingDown)
+  {
+    return;
+  }
+
+  // A worker that never got as far as loading its plugins would fail the same way again
+  if(!wasReady)
+  {
+    while(!m_Queue.isEmpty())
+    {
+      emit runFinished(m_Queue.dequeue().id, -1, tr("The worker process %1 could not be started").arg(WorkerExecutablePath()), QJsonObject());
+    }
+    return;
+  }
+
+  warmUp();
+  dispatchRuns();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WorkerPool::retireWorker(Worker* worker)
+{
+  // The worker quits when the connection goes away. Its replacement loads the plugins in the meantime.
+  worker->retiring = true;
+  worker->idle = false;
+  worker->socket->disconnectFromServer();
+  warmUp();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString WorkerPool::arrayDirectory(int runId) const
+{
+  return m_ArrayDirectory.filePath(QString("Run_%1").arg(runId));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WorkerPool::send(Worker* worker, const QJsonObject& message)
+{
+  worker->socket->write(WorkerProtocol::Frame(message));
+  worker->socket->flush();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WorkerPool::readSettings()
+{
+  SettingsStore* store = SettingsStore::Instance();
+  m_WorkerCount = store->value("Application Settings/Worker Processes", m_WorkerCount).toInt();
+  m_RunsPerWorker = store->value("Application Settings/Worker Runs Before Restart", m_RunsPerWorker).toInt();
+
+  QByteArray workerCountEnv = qgetenv("SIMPL_WORKER_PROCESSES");
+  if(!workerCountEnv.isEmpty())
+  {
+    m_WorkerCount = workerCountEnv.toInt();
+  }
+  QByteArray runsPerWorkerEnv = qgetenv("SIMPL_WORKER_RUNS_BEFORE_RESTART");
+  if(!runsPerWorkerEnv.isEmpty())
+  {
+    m_RunsPerWorker = runsPerWorkerEnv.toInt();
+  }
+
+  m_WorkerCount = qMax(1, m_WorkerCount);
+  m_RunsPerWorker = qMax(1, m_RunsPerWorker);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WorkerPool::writeSettings()
+{
+  int workerCount = m_WorkerCount;
+  int runsPerWorker = m_RunsPerWorker;
+  SettingsStore::Instance()->write([workerCount, runsPerWorker](SettingsWriter* prefs) {
+    prefs->beginGroup("Application Settings");
+    prefs->setValue("Worker Processes", workerCount);
+    prefs->setValue("Worker Runs Before Restart", runsPerWorker);
+    prefs->endGroup();
+  });
+}
@@ -0,0 +1,243 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QProcess>
+#include <QtCore/QQueue>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Common/PipelineMessage.h"
+
+class QLocalServer;
+class QLocalSocket;
+
+/**
+ * @brief The WorkerPool class executes pipelines in PipelineWorker processes, so that a filter that crashes or leaks
+ * only takes its worker down. The workers load the plugins when they start and are kept running between pipelines;
+ * each one is replaced after a number of runs so that heap fragmentation does not pile up. Messages come back over a
+ * local socket, the arrays of a finished pipeline through memory-mapped files in a directory of the pool. The pool
+ * removes a run's files once the run finished, whether the worker reported back or was killed.
+ */
+class WorkerPool : public QObject
+{
+  Q_OBJECT
+
+public:
+  ~WorkerPool() override;
+
+  static const int DefaultWorkerCount = 2;
+  static const int DefaultRunsPerWorker = 20;
+
+  /**
+   * @brief Instance
+   * @return
+   */
+  static WorkerPool* Instance();
+
+  /**
+   * @brief WorkerExecutablePath
+   * @return The PipelineWorker next to the application, or the one given by SIMPL_WORKER_EXECUTABLE
+   */
+  static QString WorkerExecutablePath();
+
+  /**
+   * @brief ToolExecutablePath
+   * @param toolName The name of the tool without the platform's executable suffix
+   * @return The tool that is installed next to the application
+   */
+  static QString ToolExecutablePath(const QString& toolName);
+
+  /**
+   * @brief warmUp Starts workers until the pool holds getWorkerCount() of them
+   */
+  void warmUp();
+
+  /**
+   * @brief execute Queues a pipeline for the next idle worker
+   * @param pipelineJson The pipeline as it is written to a pipeline file
+   * @param returnArrays Whether the arrays are sent back when the pipeline finished
+   * @return The id of the run
+   */
+  int execute(const QJsonObject& pipelineJson, bool returnArrays);
+
+  /**
+   * @brief cancel Drops a queued run, or kills the worker that executes it. Either way runFinished follows.
+   * @param id
+   */
+  void cancel(int id);
+
+  /**
+   * @brief shutdown Kills all workers. Running pipelines are reported as failed.
+   */
+  void shutdown();
+
+  /**
+   * @brief getIdleWorkerCount
+   * @return The number of workers that have loaded their plugins and wait for a pipeline
+   */
+  int getIdleWorkerCount() const;
+
+  void setWorkerCount(int value);
+  int getWorkerCount() const;
+
+  void setRunsPerWorker(int value);
+  int getRunsPerWorker() const;
+
+signals:
+  /**
+   * @brief runStarted
+   * @param id
+   * @param processId The worker that executes the run
+   */
+  void runStarted(int id, qint64 processId);
+
+  /**
+   * @brief runMessage Forwards the messages of the filters and the progress of the pipeline
+   * @param id
+   * @param msg
+   */
+  void runMessage(int id, const PipelineMessage& msg);
+
+  /**
+   * @brief runFinished
+   * @param id
+   * @param errorCode
+   * @param message
+   * @param arrays The manifest to pass to WorkerProtocol::ImportArrays. Its files are removed as soon as the
+   * signal returns, so the arrays have to be imported by a direct connection.
+   */
+  void runFinished(int id, int errorCode, const QString& message, const QJsonObject& arrays);
+
+protected:
+  WorkerPool(QObject* parent = nullptr);
+
+  struct Worker
+  {
+    QProcess* process = nullptr;
+    QLocalSocket* socket = nullptr;
+    QByteArray buffer;
+    qint64 processId = 0;
+    int runId = 0;
+    int runCount = 0;
+    bool idle = false;
+    bool retiring = false;
+    bool canceled = false;
+  };
+
+  struct QueuedRun
+  {
+    int id = 0;
+    QJsonObject pipelineJson;
+    bool returnArrays = true;
+  };
+
+  /**
+   * @brief startWorker
+   */
+  void startWorker();
+
+  /**
+   * @brief dispatchRuns Hands queued runs to idle workers
+   */
+  void dispatchRuns();
+
+  /**
+   * @brief workerConnected Pairs a new connection with the process that sent it
+   */
+  void workerConnected();
+
+  /**
+   * @brief readWorker
+   * @param worker
+   */
+  void readWorker(Worker* worker);
+
+  /**
+   * @brief handleMessage
+   * @param worker
+   * @param message
+   */
+  void handleMessage(Worker* worker, const QJsonObject& message);
+
+  /**
+   * @brief workerExited
+   * @param worker
+   * @param exitCode
+   * @param exitStatus
+   */
+  void workerExited(Worker* worker, int exitCode, QProcess::ExitStatus exitStatus);
+
+  /**
+   * @brief retireWorker Lets a worker quit once it has no run anymore
+   * @param worker
+   */
+  void retireWorker(Worker* worker);
+
+  /**
+   * @brief arrayDirectory
+   * @param runId
+   * @return The directory that the worker writes the arrays of the run to
+   */
+  QString arrayDirectory(int runId) const;
+
+  /**
+   * @brief send
+   * @param worker
+   * @param message
+   */
+  void send(Worker* worker, const QJsonObject& message);
+
+  void readSettings();
+  void writeSettings();
+
+private:
+  static WorkerPool* self;
+
+  QLocalServer* m_Server = nullptr;
+  QTemporaryDir m_ArrayDirectory;
+  QVector<Worker*> m_Workers;
+  QQueue<QueuedRun> m_Queue;
+  int m_NextRunId = 1;
+  int m_WorkerCount = DefaultWorkerCount;
+  int m_RunsPerWorker = DefaultRunsPerWorker;
+  bool m_ShuttingDown = false;
+
+  WorkerPool(const WorkerPool&) = delete;        // Copy Constructor Not Implemented
+  void operator=(const WorkerPool&) = delete;    // Move assignment Not Implemented
+};
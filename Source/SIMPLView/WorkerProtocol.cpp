@@ -0,0 +1,293 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "WorkerProtocol.h"
+
+#include <cstring>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
+#include <QtCore/QtEndian>
+
+namespace
+{
+qint64 arrayBytes(const IDataArray::Pointer& array)
+{
+  return static_cast<qint64>(array->getSize()) * array->getTypeSize();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool readArrayFile(const QString& filePath, const IDataArray::Pointer& array, qint64 bytes)
+{
+  QFile file(filePath);
+  const uchar* mapped = (file.open(QIODevice::ReadOnly) && file.size() >= bytes) ? file.map(0, bytes) : nullptr;
+  if(mapped == nullptr)
+  {
+    return false;
+  }
+  std::memcpy(array->getVoidPointer(0), mapped, static_cast<size_t>(bytes));
+  file.unmap(const_cast<uchar*>(mapped));
+  return true;
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+WorkerProtocol::WorkerProtocol() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QByteArray WorkerProtocol::Frame(const QJsonObject& message)
+{
+  QByteArray payload = QJsonDocument(message).toJson(QJsonDocument::Compact);
+  QByteArray frame(4, Qt::Uninitialized);
+  qToBigEndian<quint32>(static_cast<quint32>(payload.size()), reinterpret_cast<uchar*>(frame.data()));
+  return frame + payload;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool WorkerProtocol::TakeMessage(QByteArray& buffer, QJsonObject& message)
+{
+  if(buffer.size() < 4)
+  {
+    return false;
+  }
+  int length = static_cast<int>(qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(buffer.constData())));
+  if(buffer.size() < 4 + length)
+  {
+    return false;
+  }
+
+  message = QJsonDocument::fromJson(buffer.mid(4, length)).object();
+  buffer.remove(0, 4 + length);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject WorkerProtocol::MessageToJson(const PipelineMessage& msg)
+{
+  QJsonObject json;
+  json["Class Name"] = msg.getFilterClassName();
+  json["Human Label"] = msg.getFilterHumanLabel();
+  json["Text"] = msg.getText();
+  json["Code"] = msg.getCode();
+  json["Message Type"] = static_cast<int>(msg.getType());
+  json["Pipeline Index"] = msg.getPipelineIndex();
+  json["Progress"] = msg.getProgressValue();
+  return json;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineMessage WorkerProtocol::MessageFromJson(const QJsonObject& json)
+{
+  PipelineMessage msg(json["Class Name"].toString(), json["Text"].toString(), json["Code"].toInt(), static_cast<PipelineMessage::MessageType>(json["Message Type"].toInt()),
+                      json["Pipeline Index"].toInt(-1));
+  msg.setFilterHumanLabel(json["Human Label"].toString());
+  msg.setProgressValue(json["Progress"].toInt());
+  return msg;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject WorkerProtocol::ExportArrays(const DataContainerArray::Pointer& dca, const QString& dirPath, QString& error)
+{
+  if(!QDir().mkpath(dirPath))
+  {
+    error = QString("The directory '%1' for the arrays could not be created").arg(dirPath);
+    return QJsonObject();
+  }
+  QDir dir(dirPath);
+
+  QJsonArray matrices;
+  qint64 totalBytes = 0;
+  int fileCounter = 0;
+  for(DataContainer::Pointer dc : dca->getDataContainers())
+  {
+    for(AttributeMatrix::Pointer am : dc->getAttributeMatrices())
+    {
+      QJsonArray tupleDims;
+      for(size_t dim : am->getTupleDimensions())
+      {
+        tupleDims.append(static_cast<qint64>(dim));
+      }
+
+      QJsonArray arrayEntries;
+      for(const QString& arrayName : am->getAttributeArrayNames())
+      {
+        IDataArray::Pointer array = am->getAttributeArray(arrayName);
+        qint64 bytes = arrayBytes(array);
+        if(bytes > 0 && array->getVoidPointer(0) == nullptr)
+        {
+          continue;
+        }
+
+        QJsonObject entry;
+        entry["Data Array Name"] = arrayName;
+        entry["Type"] = array->getTypeAsString();
+        entry["Tuples"] = static_cast<qint64>(array->getNumberOfTuples());
+        entry["Bytes"] = bytes;
+
+        // An empty array, e.g. of a feature matrix without features, has no file but still tells its size
+        if(bytes > 0)
+        {
+          QString fileName = QString("Array_%1.raw").arg(fileCounter++);
+          QFile file(dir.filePath(fileName));
+          uchar* mapped = nullptr;
+          if(file.open(QIODevice::ReadWrite | QIODevice::Truncate) && file.resize(bytes))
+          {
+            mapped = file.map(0, bytes);
+          }
+          if(mapped == nullptr)
+          {
+            error = QString("The file for %1 bytes of '%2' could not be written: %3").arg(bytes).arg(arrayName).arg(file.errorString());
+            return QJsonObject();
+          }
+          std::memcpy(mapped, array->getVoidPointer(0), static_cast<size_t>(bytes));
+          file.unmap(mapped);
+          file.close();
+          entry["File"] = fileName;
+        }
+        arrayEntries.append(entry);
+        totalBytes += bytes;
+      }
+
+      QJsonObject matrix;
+      matrix["Data Container Name"] = dc->getName();
+      matrix["Attribute Matrix Name"] = am->getName();
+      matrix["Tuple Dimensions"] = tupleDims;
+      matrix["Arrays"] = arrayEntries;
+      matrices.append(matrix);
+    }
+  }
+
+  QJsonObject manifest;
+  manifest["Matrices"] = matrices;
+  manifest["Bytes"] = totalBytes;
+  manifest["Directory"] = dir.absolutePath();
+  return manifest;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int WorkerProtocol::ImportArrays(const QJsonObject& manifest, const DataContainerArray::Pointer& dca, QString& error)
+{
+  if(manifest["Directory"].toString().isEmpty())
+  {
+    return 0;
+  }
+
+  QDir dir(manifest["Directory"].toString());
+  int imported = 0;
+  QStringList failedArrays;
+  for(const QJsonValue& matrixValue : manifest["Matrices"].toArray())
+  {
+    QJsonObject matrix = matrixValue.toObject();
+    DataContainer::Pointer dc = dca->getDataContainer(matrix["Data Container Name"].toString());
+    AttributeMatrix::Pointer am = (dc.get() != nullptr) ? dc->getAttributeMatrix(matrix["Attribute Matrix Name"].toString()) : AttributeMatrix::NullPointer();
+    if(am.get() == nullptr)
+    {
+      continue;
+    }
+
+    // The preflight may not know the final number of tuples, e.g. for feature attribute matrices
+    QVector<size_t> tupleDims;
+    for(const QJsonValue& dim : matrix["Tuple Dimensions"].toArray())
+    {
+      tupleDims.push_back(static_cast<size_t>(dim.toVariant().toLongLong()));
+    }
+    am->setTupleDimensions(tupleDims);
+
+    QSet<QString> importedArrays;
+    for(const QJsonValue& entryValue : matrix["Arrays"].toArray())
+    {
+      QJsonObject entry = entryValue.toObject();
+      QString arrayName = entry["Data Array Name"].toString();
+      IDataArray::Pointer array = am->getAttributeArray(arrayName);
+      if(array.get() == nullptr)
+      {
+        continue;
+      }
+
+      qint64 bytes = entry["Bytes"].toVariant().toLongLong();
+      bool filled = false;
+      if(array->getTypeAsString() == entry["Type"].toString())
+      {
+        array->resizeTuples(static_cast<size_t>(entry["Tuples"].toVariant().toLongLong()));
+        filled = (arrayBytes(array) == bytes) && (bytes == 0 || readArrayFile(dir.filePath(entry["File"].toString()), array, bytes));
+      }
+      if(filled)
+      {
+        importedArrays.insert(arrayName);
+        imported++;
+      }
+      else
+      {
+        failedArrays.push_back(arrayName);
+      }
+    }
+
+    // The other arrays still have the preflight's number of tuples. They either failed above or the worker
+    // no longer had them, e.g. because they were freed behind their last use.
+    for(const QString& arrayName : am->getAttributeArrayNames())
+    {
+      if(!importedArrays.contains(arrayName))
+      {
+        am->removeAttributeArray(arrayName);
+      }
+    }
+  }
+
+  if(!failedArrays.isEmpty())
+  {
+    error = QString("%1 arrays of the worker could not be imported and were removed: %2").arg(failedArrays.size()).arg(failedArrays.join(", "));
+  }
+  return imported;
+}
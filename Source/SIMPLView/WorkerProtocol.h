@@ -0,0 +1,110 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+#include "SIMPLib/Common/PipelineMessage.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+
+/**
+ * @brief The WorkerProtocol class holds what the GUI and the PipelineWorker processes both need to talk to each
+ * other. Messages are JSON objects, each framed by its length. The arrays of a finished pipeline travel through
+ * memory-mapped files, one per array, in a directory that the GUI hands out with the pipeline and removes once it
+ * copied the arrays out or the worker died. A manifest in the Finished message describes the files.
+ */
+class WorkerProtocol
+{
+public:
+  /**
+   * @brief Frame
+   * @param message
+   * @return The message as it is written to the socket
+   */
+  static QByteArray Frame(const QJsonObject& message);
+
+  /**
+   * @brief TakeMessage Removes the first complete message from the data read so far
+   * @param buffer
+   * @param message
+   * @return False while the buffer does not hold a complete message
+   */
+  static bool TakeMessage(QByteArray& buffer, QJsonObject& message);
+
+  /**
+   * @brief MessageToJson
+   * @param msg
+   * @return
+   */
+  static QJsonObject MessageToJson(const PipelineMessage& msg);
+
+  /**
+   * @brief MessageFromJson
+   * @param json
+   * @return
+   */
+  static PipelineMessage MessageFromJson(const QJsonObject& json);
+
+  /**
+   * @brief ExportArrays Copies every attribute array into a file of its own
+   * @param dca
+   * @param dirPath The directory for the files, it is created if needed
+   * @param error
+   * @return The manifest, empty if a file could not be written
+   */
+  static QJsonObject ExportArrays(const DataContainerArray::Pointer& dca, const QString& dirPath, QString& error);
+
+  /**
+   * @brief ImportArrays Fills the arrays of the manifest into a structure that already holds them, e.g. a copy of the
+   * preflight result. Arrays of the manifest that the structure does not hold are skipped. Every other array of a
+   * matrix in the manifest that could not be filled, e.g. one with a different type, is removed from its matrix, so
+   * that no array is left with the preflight's number of tuples.
+   * @param manifest
+   * @param dca
+   * @param error Names the arrays of the manifest that could not be filled
+   * @return The number of arrays that were filled
+   */
+  static int ImportArrays(const QJsonObject& manifest, const DataContainerArray::Pointer& dca, QString& error);
+
+protected:
+  WorkerProtocol();
+
+private:
+  WorkerProtocol(const WorkerProtocol&) = delete;  // Copy Constructor Not Implemented
+  void operator=(const WorkerProtocol&) = delete;  // Move assignment Not Implemented
+};
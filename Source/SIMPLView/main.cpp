@@ -39,13 +39,17 @@
 #include <QtCore/QString>
 #include <QtCore/QDirIterator>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QTimer>
 
-#include <QtGui/QFontDatabase>
+#include <QtGui/QWindow>
+
+#include <functional>
 
 #include "BrandedStrings.h"
 #include "SIMPLView.h"
 #include "SIMPLViewApplication.h"
 #include "SIMPLView_UI.h"
+#include "StartupTracer.h"
 #include "StyleSheetEditor.h"
 
 #include "SVWidgetsLib/QtSupport/QtSStyles.h"
@@ -66,48 +70,55 @@
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void InitFonts(const QStringList& fontList)
+void InitStyleSheetEditor()
 {
-  int fontID(-1);
+  //SVStyle* style = SVStyle::Instance();
 
-  for(QStringList::const_iterator constIterator = fontList.constBegin(); constIterator != fontList.constEnd(); ++constIterator)
+  StyleSheetEditor* styleSheetEditor = new StyleSheetEditor(nullptr);
+  styleSheetEditor->show();
+}
+
+/**
+ * @brief The FirstFrameObserver class calls back once the window it watches is first exposed. Qt paints
+ * and flushes the first frame of a widget window while it handles that expose event, so the callback
+ * runs on the next pass through the event loop, when that frame is on screen.
+ */
+class FirstFrameObserver : public QObject
+{
+public:
+  FirstFrameObserver(std::function<void()> callback, QObject* parent)
+  : QObject(parent)
+  , m_Callback(std::move(callback))
   {
-    QFile res(*constIterator);
-    // qDebug() << "font path: " << res.fileName();
-    if(res.open(QIODevice::ReadOnly) == false)
-    {
-      qDebug() << "ERROR opening font resource: " << res.fileName();
-    }
+  }
 
-    else
+  bool eventFilter(QObject* watched, QEvent* event) override
+  {
+    QWindow* window = qobject_cast<QWindow*>(watched);
+    if(event->type() == QEvent::Expose && m_Callback && window != nullptr && window->isExposed())
     {
-      fontID = QFontDatabase::addApplicationFontFromData(res.readAll());
-      // qDebug() << "loading font Id " << fontID;
-      if(fontID == -1)
-      {
-        qDebug() << "ERROR loading font id: " << fontID;
-      }
-      res.close();
+      std::function<void()> callback = m_Callback;
+      m_Callback = nullptr;
+      window->removeEventFilter(this);
+      QTimer::singleShot(0, this, [this, callback] {
+        callback();
+        deleteLater();
+      });
     }
+    return QObject::eventFilter(watched, event);
   }
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void InitStyleSheetEditor()
-{
-  //SVStyle* style = SVStyle::Instance();
 
-  StyleSheetEditor* styleSheetEditor = new StyleSheetEditor(nullptr);
-  styleSheetEditor->show();
-}
+private:
+  std::function<void()> m_Callback;
+};
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 int main(int argc, char* argv[])
 {
+  // Start the startup clock as early as possible so every span is relative to process start
+  qint64 startupUSecs = StartupTracer::Instance()->now();
 #ifdef Q_OS_X11
   // Using motif style gives us test failures (and its ugly).
   // Using cleanlooks style gives us errors when using valgrind (Trolltech's bug #179200)
@@ -121,6 +132,37 @@ int main(int argc, char* argv[])
   qDebug() << "argv[0]: " << absPathExe;
   qDebug() << "    cwd: " << cwd;
 
+  // Pull out "--startup-trace <file>", "--new-instance" and "--quit-after-startup" and collect any remaining positional arguments
+  QString launchDir = cwd;
+  bool forceNewInstance = false;
+  bool quitAfterStartup = false;
+  QStringList positionalArgs;
+  for(int i = 1; i < argc; i++)
+  {
+    QString arg = QString::fromLocal8Bit(argv[i]);
+    if(arg == "--new-instance")
+    {
+      forceNewInstance = true;
+    }
+    else if(arg == "--quit-after-startup")
+    {
+      // Used by the StartupBenchmark tool, which launches the application many times in a row
+      quitAfterStartup = true;
+    }
+    else if(arg == "--startup-trace" && i + 1 < argc)
+    {
+      StartupTracer::Instance()->setOutputFilePath(QString::fromLocal8Bit(argv[++i]));
+    }
+    else if(arg.startsWith("--startup-trace="))
+    {
+      StartupTracer::Instance()->setOutputFilePath(arg.mid(16));
+    }
+    else
+    {
+      positionalArgs.push_back(arg);
+    }
+  }
+
 #ifdef Q_OS_WIN
   // Somewhere Visual Studio wants to set the Current Working Directory (cwd)
   // to the subfolder BUILD/Applications/SIMPLView instead of our true binary
@@ -145,11 +187,33 @@ int main(int argc, char* argv[])
   QCoreApplication::setOrganizationName(BrandedStrings::OrganizationName);
   QCoreApplication::setApplicationName(BrandedStrings::ApplicationName);
 
+  // A file opened from the desktop goes to the instance that is already running, which saves this
+  // process the whole startup. Only a QCoreApplication is needed to talk to the running instance.
+  if(positionalArgs.size() == 1 && !forceNewInstance)
+  {
+    QCoreApplication handOffApp(argc, argv);
+    if(SIMPLViewApplication::SingleInstanceEnabled())
+    {
+      QString filePath = QDir(launchDir).absoluteFilePath(positionalArgs[0]);
+      if(SIMPLViewApplication::SendFileToRunningInstance(filePath))
+      {
+        return 0;
+      }
+    }
+  }
+
+  StartupTracer::Instance()->addSpan("Pre-Application", "Startup", startupUSecs, StartupTracer::Instance()->now());
+
+  qint64 appUSecs = StartupTracer::Instance()->now();
   SIMPLViewApplication qtapp(argc, argv);
+  StartupTracer::Instance()->addSpan("SIMPLViewApplication::SIMPLViewApplication", "Startup", appUSecs, StartupTracer::Instance()->now());
 
-  if(!qtapp.initialize(argc, argv))
   {
-    return 1;
+    StartupTraceScope traceScope("SIMPLViewApplication::initialize");
+    if(!qtapp.initialize(argc, argv))
+    {
+      return 1;
+    }
   }
 
 #if defined(Q_OS_MAC)
@@ -160,55 +224,54 @@ int main(int argc, char* argv[])
 
   setlocale(LC_NUMERIC, "C");
 
-  // Load the default font from SIMPL
-  QString firaSansFontPath(":/SIMPL/fonts/FiraSans-Regular.ttf");
-  int id = QFontDatabase::addApplicationFont(firaSansFontPath);
-
-  /* On Linux builds this will always return -1 */
-  if(id >= 0)
-  {
-    QString family = QFontDatabase::applicationFontFamilies(id).at(0);
-
-    QFont defaultFont(family);
-    defaultFont.setPixelSize(12);
-    qApp->setFont(defaultFont);
-//    qDebug() << "Default Font Loaded: " << firaSansFontPath;
-  }
-  else
-  {
-    qDebug() << "ERROR LOADING DEFAULT FONT: " << firaSansFontPath;
-  }
-
-  // This is the single standard font that ships with the open-source version
-  {
-    QStringList fontList;
-    fontList << firaSansFontPath;
-    InitFonts(fontList);
-  }
-
-  // Init any extra fonts that are needed by specialized versions of SIMPLView
-  InitFonts(BrandedStrings::ExtraFonts);
-
 #ifdef SIMPLView_USE_STYLESHEETEDITOR
   InitStyleSheetEditor();
 #endif
 
   // Open pipeline if SIMPLView was opened from a compatible file
-  if(argc == 2)
+  qint64 showUSecs = StartupTracer::Instance()->now();
+  SIMPLView_UI* ui = nullptr;
+  if(positionalArgs.size() == 1)
   {
-    char* two = argv[1];
-    QString filePath = QString::fromLatin1(two);
+    QString filePath = positionalArgs[0];
     if(!filePath.isEmpty())
     {
-      qtapp.newInstanceFromFile(filePath);
+      StartupTraceScope traceScope("SIMPLViewApplication::newInstanceFromFile");
+      ui = qtapp.newInstanceFromFile(filePath);
     }
   }
   else
   {
-    SIMPLView_UI* ui = qtapp.getNewSIMPLViewInstance();
+    {
+      StartupTraceScope traceScope("SIMPLViewApplication::getNewSIMPLViewInstance");
+      ui = qtapp.getNewSIMPLViewInstance();
+    }
     ui->show();
   }
 
+  // Close out the trace once the main window's first frame is on screen
+  std::function<void()> finishStartupTrace = [startupUSecs, showUSecs, quitAfterStartup] {
+    StartupTracer* tracer = StartupTracer::Instance();
+    qint64 nowUSecs = tracer->now();
+    tracer->addSpan("First Paint", "Startup", showUSecs, nowUSecs);
+    tracer->addSpan("Total Startup", "Startup", startupUSecs, nowUSecs);
+    qDebug() << "Startup Time (ms): " << (nowUSecs - startupUSecs) / 1000;
+    tracer->writeFile();
+    if(quitAfterStartup)
+    {
+      QTimer::singleShot(0, qApp, &QCoreApplication::quit);
+    }
+  };
+  if(ui != nullptr && ui->windowHandle() != nullptr)
+  {
+    ui->windowHandle()->installEventFilter(new FirstFrameObserver(finishStartupTrace, ui));
+  }
+  else
+  {
+    // No window was opened, so there is no frame to wait for
+    QTimer::singleShot(0, finishStartupTrace);
+  }
+
 #ifdef SIMPL_USE_MKDOCS
   QtSDocServer::Instance();
 #endif
@@ -0,0 +1,303 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include <QtCore/QCoreApplication>
+#include <QtCore/QStandardPaths>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/DataContainers/DataContainerArrayProxy.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/DataContainerArrayProxyFilterParameter.h"
+#include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
+#include "SIMPLib/Testing/UnitTestSupport.hpp"
+
+#include "SIMPLView/ArrayLiveness.h"
+
+/**
+ * @brief The LivenessProbe class opens up the prediction of ArrayLiveness to the test
+ */
+class LivenessProbe : public ArrayLiveness
+{
+public:
+  using ArrayLiveness::FindArrayUses;
+  using ArrayLiveness::FindDeadArrays;
+};
+
+/**
+ * @brief The SelectingFilter class selects a single array
+ */
+class SelectingFilter : public AbstractFilter
+{
+public:
+  SIMPL_SHARED_POINTERS(SelectingFilter)
+  SIMPL_STATIC_NEW_MACRO(SelectingFilter)
+
+  SIMPL_FILTER_PARAMETER(DataArrayPath, SelectedArrayPath)
+
+  ~SelectingFilter() override = default;
+
+  void setupFilterParameters() override
+  {
+    FilterParameterVectorType parameters;
+    DataArraySelectionFilterParameter::RequirementType req;
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Selected Array", SelectedArrayPath, FilterParameter::RequiredArray, SelectingFilter, req));
+    setFilterParameters(parameters);
+  }
+
+protected:
+  SelectingFilter()
+  {
+    setupFilterParameters();
+  }
+};
+
+/**
+ * @brief The WriterFilter class writes a file like a DataContainerWriter, with or without a proxy of what to write
+ */
+class WriterFilter : public AbstractFilter
+{
+public:
+  SIMPL_SHARED_POINTERS(WriterFilter)
+
+  static Pointer New(bool withProxy)
+  {
+    Pointer sharedPtr(new WriterFilter(withProxy));
+    return sharedPtr;
+  }
+
+  SIMPL_FILTER_PARAMETER(QString, OutputFile)
+  SIMPL_FILTER_PARAMETER(DataContainerArrayProxy, DataContainerArrayProxy)
+
+  ~WriterFilter() override = default;
+
+protected:
+  WriterFilter(bool withProxy)
+  {
+    FilterParameterVectorType parameters;
+    parameters.push_back(SIMPL_NEW_OUTPUT_FILE_FP("Output File", OutputFile, FilterParameter::Parameter, WriterFilter, "*.dream3d"));
+    if(withProxy)
+    {
+      parameters.push_back(SIMPL_NEW_DCA_PROXY_FP("Arrays to Write", DataContainerArrayProxy, FilterParameter::Parameter, WriterFilter, DataContainerArrayProxy(), Qt::Unchecked));
+    }
+    setFilterParameters(parameters);
+  }
+};
+
+class ArrayLivenessTest
+{
+public:
+  ArrayLivenessTest() = default;
+  ~ArrayLivenessTest() = default;
+
+  const size_t k_Tuples = 1000;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataContainerArray(const QStringList& arrayNames)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("DataContainer");
+    dca->addDataContainer(dc);
+    AttributeMatrix::Pointer am = AttributeMatrix::New(QVector<size_t>(1, k_Tuples), "CellData", AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(am->getName(), am);
+    for(const QString& arrayName : arrayNames)
+    {
+      FloatArrayType::Pointer array = FloatArrayType::CreateArray(k_Tuples, QVector<size_t>(1, 1), arrayName, true);
+      am->addAttributeArray(array->getName(), array);
+    }
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer selecting(const QString& arrayName, bool enabled = true)
+  {
+    SelectingFilter::Pointer filter = SelectingFilter::New();
+    filter->setSelectedArrayPath(DataArrayPath("DataContainer", "CellData", arrayName));
+    filter->setEnabled(enabled);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QStringList deadArrayNames(const QList<AbstractFilter::Pointer>& filters, int position, const DataContainerArray::Pointer& dca)
+  {
+    QStringList arrayNames;
+    for(const ArrayLiveness::DeadArray& deadArray : LivenessProbe::FindDeadArrays(filters, LivenessProbe::FindArrayUses(filters), position, dca))
+    {
+      arrayNames.push_back(deadArray.path.getDataArrayName());
+    }
+    arrayNames.sort();
+    return arrayNames;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestLaterUsesAreKept()
+  {
+    DataContainerArray::Pointer dca = createDataContainerArray({"A", "B", "C"});
+    QList<AbstractFilter::Pointer> filters = {AbstractFilter::New(), selecting("A"), selecting("B", false), AbstractFilter::New()};
+
+    // A disabled filter does not keep B alive
+    QStringList deadArrays = deadArrayNames(filters, 0, dca);
+    DREAM3D_REQUIRE_EQUAL(deadArrays.size(), 2)
+    DREAM3D_REQUIRE(deadArrays[0] == QString("B"))
+    DREAM3D_REQUIRE(deadArrays[1] == QString("C"))
+
+    // Behind the last use of A every array is dead
+    DREAM3D_REQUIRE_EQUAL(deadArrayNames(filters, 1, dca).size(), 3)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestNothingFreedBehindLastFilter()
+  {
+    DataContainerArray::Pointer dca = createDataContainerArray({"A", "B"});
+    QList<AbstractFilter::Pointer> filters = {AbstractFilter::New(), AbstractFilter::New()};
+    DREAM3D_REQUIRE_EQUAL(deadArrayNames(filters, 1, dca).size(), 0)
+
+    // A disabled filter at the end does not move the result of the run
+    AbstractFilter::Pointer disabled = selecting("A", false);
+    filters.push_back(disabled);
+    DREAM3D_REQUIRE_EQUAL(deadArrayNames(filters, 1, dca).size(), 0)
+    DREAM3D_REQUIRE_EQUAL(deadArrayNames(filters, 0, dca).size(), 2)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestEndFilter()
+  {
+    for(bool keepEverything : {true, false})
+    {
+      DataContainerArray::Pointer dca = createDataContainerArray({"A", "B", "C"});
+      QList<AbstractFilter::Pointer> filters = {AbstractFilter::New(), selecting("A"), AbstractFilter::New()};
+      for(const AbstractFilter::Pointer& filter : filters)
+      {
+        filter->setDataContainerArray(dca);
+      }
+
+      ArrayLiveness::Pointer liveness = ArrayLiveness::New();
+      liveness->setKeepEverything(keepEverything);
+      liveness->setPipeline(filters);
+      liveness->beginFilter(filters[0].get());
+      liveness->endFilter(filters[0].get());
+
+      AttributeMatrix::Pointer am = dca->getDataContainer("DataContainer")->getAttributeMatrix("CellData");
+      DREAM3D_REQUIRE(am->doesAttributeArrayExist("A"))
+      DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist("B"), keepEverything)
+      DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist("C"), keepEverything)
+      DREAM3D_REQUIRE_EQUAL(liveness->getDroppedArrays().size(), keepEverything ? 0 : 2)
+
+      // A goes behind its last use, the last filter frees nothing
+      liveness->beginFilter(filters[1].get());
+      liveness->endFilter(filters[1].get());
+      DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist("A"), keepEverything)
+      DREAM3D_REQUIRE_EQUAL(liveness->getDroppedArrays().size(), keepEverything ? 0 : 3)
+
+      FloatArrayType::Pointer result = FloatArrayType::CreateArray(k_Tuples, QVector<size_t>(1, 1), "Result", true);
+      am->addAttributeArray(result->getName(), result);
+      liveness->beginFilter(filters[2].get());
+      liveness->endFilter(filters[2].get());
+      liveness->finishRun();
+      DREAM3D_REQUIRE(am->doesAttributeArrayExist("Result"))
+      DREAM3D_REQUIRE_EQUAL(liveness->getDroppedArrays().size(), keepEverything ? 0 : 3)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestWriterProxy()
+  {
+    DataContainerArray::Pointer dca = createDataContainerArray({"A", "B"});
+
+    // The proxy is built from a structure with only A in it, so only A is written
+    DataContainerArray::Pointer written = createDataContainerArray({"A"});
+    WriterFilter::Pointer writer = WriterFilter::New(true);
+    writer->setDataContainerArrayProxy(DataContainerArrayProxy(written.get()));
+
+    QList<AbstractFilter::Pointer> filters = {AbstractFilter::New(), writer, AbstractFilter::New()};
+    QStringList deadArrays = deadArrayNames(filters, 0, dca);
+    DREAM3D_REQUIRE_EQUAL(deadArrays.size(), 1)
+    DREAM3D_REQUIRE(deadArrays[0] == QString("B"))
+
+    // Without a proxy the writer writes everything
+    filters[1] = WriterFilter::New(false);
+    DREAM3D_REQUIRE_EQUAL(deadArrayNames(filters, 0, dca).size(), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "#### ArrayLivenessTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestLaterUsesAreKept())
+    DREAM3D_REGISTER_TEST(TestNothingFreedBehindLastFilter())
+    DREAM3D_REGISTER_TEST(TestEndFilter())
+    DREAM3D_REGISTER_TEST(TestWriterProxy())
+  }
+
+private:
+  ArrayLivenessTest(const ArrayLivenessTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const ArrayLivenessTest&) = delete;    // Move assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QStandardPaths::setTestModeEnabled(true);
+
+  int err = EXIT_SUCCESS;
+  ArrayLivenessTest test;
+  test();
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,241 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include <QtCore/QCoreApplication>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QTemporaryDir>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/Testing/UnitTestSupport.hpp"
+
+#include "SIMPLView/ArraySpiller.h"
+
+namespace
+{
+const size_t k_Tuples = 1024 * 1024;
+
+/**
+ * @brief The SelectingFilter class selects a single array, like most filters that remove or reorder tuples
+ */
+class SelectingFilter : public AbstractFilter
+{
+public:
+  SIMPL_SHARED_POINTERS(SelectingFilter)
+  SIMPL_STATIC_NEW_MACRO(SelectingFilter)
+
+  SIMPL_FILTER_PARAMETER(DataArrayPath, SelectedArrayPath)
+
+  ~SelectingFilter() override = default;
+
+  void setupFilterParameters() override
+  {
+    FilterParameterVectorType parameters;
+    DataArraySelectionFilterParameter::RequirementType req;
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Selected Array", SelectedArrayPath, FilterParameter::RequiredArray, SelectingFilter, req));
+    setFilterParameters(parameters);
+  }
+
+protected:
+  SelectingFilter()
+  {
+    setupFilterParameters();
+  }
+};
+}
+
+class ArraySpillerTest
+{
+public:
+  ArraySpillerTest() = default;
+  ~ArraySpillerTest() = default;
+
+  // -----------------------------------------------------------------------------
+  // A takes 4 MB and B 8 MB
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataContainerArray()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("DataContainer");
+    dca->addDataContainer(dc);
+    AttributeMatrix::Pointer am = AttributeMatrix::New(QVector<size_t>(1, k_Tuples), "CellData", AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(am->getName(), am);
+
+    FloatArrayType::Pointer a = FloatArrayType::CreateArray(k_Tuples, QVector<size_t>(1, 1), "A", true);
+    FloatArrayType::Pointer b = FloatArrayType::CreateArray(k_Tuples, QVector<size_t>(1, 2), "B", true);
+    for(size_t i = 0; i < k_Tuples; i++)
+    {
+      a->setValue(i, static_cast<float>(i));
+      b->setComponent(i, 0, -static_cast<float>(i));
+      b->setComponent(i, 1, static_cast<float>(i) * 0.5f);
+    }
+    am->addAttributeArray(a->getName(), a);
+    am->addAttributeArray(b->getName(), b);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A filter that uses nothing, followed by one that selects A
+  // -----------------------------------------------------------------------------
+  QList<AbstractFilter::Pointer> createFilters(const DataContainerArray::Pointer& dca)
+  {
+    AbstractFilter::Pointer first = AbstractFilter::New();
+    first->setDataContainerArray(dca);
+
+    SelectingFilter::Pointer second = SelectingFilter::New();
+    second->setSelectedArrayPath(DataArrayPath("DataContainer", "CellData", "A"));
+    second->setDataContainerArray(dca);
+
+    return {first, second};
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void checkB(const AttributeMatrix::Pointer& am)
+  {
+    FloatArrayType::Pointer b = std::dynamic_pointer_cast<FloatArrayType>(am->getAttributeArray("B"));
+    DREAM3D_REQUIRE(b.get() != nullptr)
+    DREAM3D_REQUIRE_EQUAL(b->getNumberOfTuples(), k_Tuples)
+    for(size_t i = 0; i < k_Tuples; i += 4099)
+    {
+      DREAM3D_REQUIRE_EQUAL(b->getComponent(i, 0), -static_cast<float>(i))
+      DREAM3D_REQUIRE_EQUAL(b->getComponent(i, 1), static_cast<float>(i) * 0.5f)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestAttributeMatrixIsUsedAsAWhole()
+  {
+    QTemporaryDir tempDir;
+    DREAM3D_REQUIRE(tempDir.isValid())
+
+    DataContainerArray::Pointer dca = createDataContainerArray();
+    QList<AbstractFilter::Pointer> filters = createFilters(dca);
+    AttributeMatrix::Pointer am = dca->getDataContainer("DataContainer")->getAttributeMatrix("CellData");
+
+    ArraySpiller::Pointer spiller = ArraySpiller::New();
+    spiller->setBudgetMB(10);
+    spiller->setScratchDirectory(tempDir.path());
+    spiller->setPipeline(filters);
+
+    // Both arrays are next used by the second filter, the larger one goes
+    spiller->beginFilter(filters[0].get());
+    DREAM3D_REQUIRE(am->doesAttributeArrayExist("A"))
+    DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist("B"), false)
+    spiller->endFilter(filters[0].get());
+
+    // The second filter only selects A, but it could remove tuples from all of CellData
+    spiller->beginFilter(filters[1].get());
+    DREAM3D_REQUIRE(am->doesAttributeArrayExist("A"))
+    checkB(am);
+
+    spiller->finishRun();
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestArraysStayOnDisk()
+  {
+    QTemporaryDir tempDir;
+    DREAM3D_REQUIRE(tempDir.isValid())
+
+    DataContainerArray::Pointer dca = createDataContainerArray();
+    QList<AbstractFilter::Pointer> filters = createFilters(dca);
+    AttributeMatrix::Pointer am = dca->getDataContainer("DataContainer")->getAttributeMatrix("CellData");
+
+    ArraySpiller::Pointer spiller = ArraySpiller::New();
+    spiller->setBudgetMB(10);
+    spiller->setScratchDirectory(tempDir.path());
+    spiller->setPipeline(filters);
+    for(const AbstractFilter::Pointer& filter : filters)
+    {
+      spiller->beginFilter(filter.get());
+      spiller->endFilter(filter.get());
+    }
+
+    // B does not fit back under the budget and waits in its scratch file
+    spiller->finishRun();
+    DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist("B"), false)
+    DREAM3D_REQUIRE_EQUAL(spiller->getDroppedArrays().size(), 0)
+    QStringList onDisk = spiller->getArraysOnDisk();
+    DREAM3D_REQUIRE_EQUAL(onDisk.size(), 1)
+    DREAM3D_REQUIRE(onDisk[0] == QString("DataContainer/CellData/B"))
+
+    DREAM3D_REQUIRE_EQUAL(spiller->restoreSpilledArrays(), 1)
+    spiller->setBudgetMB(0);
+    DREAM3D_REQUIRE_EQUAL(spiller->restoreSpilledArrays(), 0)
+    DREAM3D_REQUIRE_EQUAL(spiller->getArraysOnDisk().size(), 0)
+    checkB(am);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "#### ArraySpillerTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestAttributeMatrixIsUsedAsAWhole())
+    DREAM3D_REGISTER_TEST(TestArraysStayOnDisk())
+  }
+
+private:
+  ArraySpillerTest(const ArraySpillerTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const ArraySpillerTest&) = delete;   // Move assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QStandardPaths::setTestModeEnabled(true);
+
+  int err = EXIT_SUCCESS;
+  ArraySpillerTest test;
+  test();
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
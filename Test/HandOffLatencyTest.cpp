@@ -0,0 +1,189 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include <algorithm>
+#include <iostream>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QProcess>
+#include <QtCore/QProcessEnvironment>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QVector>
+
+/*
+ * Starts the application once and waits until its first window is painted, then launches it again with a
+ * pipeline file several times. Each of those launches has to hand the file to the running instance and exit
+ * with success, and the median time from launch to exit has to stay below k_MaxMedianMSecs. The instances run
+ * with their own home directory, so they neither see nor touch a SIMPLView that the user has open.
+ */
+
+namespace
+{
+const int k_Launches = 10;
+const int k_StartupTimeoutMSecs = 180000;
+const int k_HandOffTimeoutMSecs = 10000;
+const qint64 k_MaxMedianMSecs = 1000;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QProcessEnvironment testEnvironment(const QString& homeDir)
+{
+  QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+  // The local socket name and the preferences both follow the home directory
+  env.insert("HOME", homeDir);
+  env.insert("USERPROFILE", homeDir);
+  env.insert("XDG_CONFIG_HOME", homeDir + "/.config");
+  env.insert("XDG_CACHE_HOME", homeDir + "/.cache");
+  if(!env.contains("QT_QPA_PLATFORM"))
+  {
+    env.insert("QT_QPA_PLATFORM", "offscreen");
+  }
+  env.insert("SIMPL_SINGLE_INSTANCE", "1");
+  env.insert("SIMPL_RESERVE_WINDOW", "0");
+  return env;
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  if(app.arguments().size() != 2)
+  {
+    std::cout << "Usage: HandOffLatencyTest <path to the application>" << std::endl;
+    return EXIT_FAILURE;
+  }
+  QString executable = app.arguments()[1];
+
+  QTemporaryDir tempDir;
+  if(!tempDir.isValid())
+  {
+    std::cout << "Could not create a temporary directory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  QDir(tempDir.path()).mkpath("home");
+  QProcessEnvironment env = testEnvironment(tempDir.filePath("home"));
+
+  QString pipelineFilePath = tempDir.filePath("Empty.json");
+  QFile pipelineFile(pipelineFilePath);
+  if(!pipelineFile.open(QIODevice::WriteOnly) || pipelineFile.write(R"({"PipelineBuilder": {"Name": "Empty", "Number_Filters": 0, "Version": 6}})") < 0)
+  {
+    std::cout << "Could not write " << pipelineFilePath.toStdString() << std::endl;
+    return EXIT_FAILURE;
+  }
+  pipelineFile.close();
+
+  // The startup trace is written once the first window is on screen, which is after the hand-off server listens
+  QString traceFilePath = tempDir.filePath("Startup.json");
+  QProcess running;
+  running.setProcessEnvironment(env);
+  running.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+  running.setStandardOutputFile(QProcess::nullDevice());
+  running.start(executable, QStringList() << "--startup-trace" << traceFilePath);
+
+  QElapsedTimer startupTimer;
+  startupTimer.start();
+  while(!QFile::exists(traceFilePath) && running.state() != QProcess::NotRunning && startupTimer.elapsed() < k_StartupTimeoutMSecs)
+  {
+    running.waitForFinished(100);
+  }
+  if(!QFile::exists(traceFilePath))
+  {
+    std::cout << "The first instance did not finish starting up" << std::endl;
+    running.kill();
+    running.waitForFinished();
+    return EXIT_FAILURE;
+  }
+  std::cout << "First instance started in " << startupTimer.elapsed() << " ms" << std::endl;
+
+  int err = EXIT_SUCCESS;
+  QVector<qint64> handOffMSecs;
+  for(int i = 0; i < k_Launches; i++)
+  {
+    QProcess handOff;
+    handOff.setProcessEnvironment(env);
+    handOff.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    handOff.setStandardOutputFile(QProcess::nullDevice());
+
+    QElapsedTimer timer;
+    timer.start();
+    handOff.start(executable, QStringList() << pipelineFilePath);
+    // A launch that did not hand its file over starts up fully and keeps running
+    if(!handOff.waitForFinished(k_HandOffTimeoutMSecs))
+    {
+      std::cout << "Launch " << i + 1 << " did not exit, the file was not handed to the running instance" << std::endl;
+      handOff.kill();
+      handOff.waitForFinished();
+      err = EXIT_FAILURE;
+      break;
+    }
+    qint64 msecs = timer.elapsed();
+    if(handOff.exitStatus() != QProcess::NormalExit || handOff.exitCode() != 0)
+    {
+      std::cout << "Launch " << i + 1 << " exited with code " << handOff.exitCode() << std::endl;
+      err = EXIT_FAILURE;
+      break;
+    }
+    std::cout << "Launch " << i + 1 << " handed its file over and exited in " << msecs << " ms" << std::endl;
+    handOffMSecs.push_back(msecs);
+  }
+
+  if(running.state() == QProcess::NotRunning)
+  {
+    std::cout << "The first instance exited during the test" << std::endl;
+    err = EXIT_FAILURE;
+  }
+  running.kill();
+  running.waitForFinished();
+
+  if(err == EXIT_SUCCESS)
+  {
+    std::sort(handOffMSecs.begin(), handOffMSecs.end());
+    qint64 median = handOffMSecs[handOffMSecs.size() / 2];
+    std::cout << "Hand-off latency (ms) min: " << handOffMSecs.first() << "  median: " << median << "  max: " << handOffMSecs.last() << std::endl;
+    if(median > k_MaxMedianMSecs)
+    {
+      std::cout << "The median hand-off latency is above " << k_MaxMedianMSecs << " ms" << std::endl;
+      err = EXIT_FAILURE;
+    }
+  }
+
+  return err;
+}
@@ -0,0 +1,226 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Testing/UnitTestSupport.hpp"
+
+#include "SIMPLView/LogModel.h"
+
+class LogModelTest
+{
+public:
+  LogModelTest() = default;
+  ~LogModelTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QVector<LogModel::Entry> makeEntries(int first, int count, LogModel::Level level = LogModel::Level::Info)
+  {
+    QVector<LogModel::Entry> entries;
+    for(int i = first; i < first + count; i++)
+    {
+      LogModel::Entry entry;
+      entry.level = level;
+      entry.text = QString("Line %1").arg(i);
+      entries.push_back(entry);
+    }
+    return entries;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QString rowText(const LogModel& model, int row)
+  {
+    return model.data(model.index(row, 0), Qt::DisplayRole).toString();
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestRetentionLimit()
+  {
+    LogModel model;
+    model.setRetentionLimit(10);
+
+    model.append(makeEntries(0, 7));
+    DREAM3D_REQUIRE_EQUAL(model.rowCount(), 7)
+    DREAM3D_REQUIRE_EQUAL(model.getDroppedCount(), 0)
+
+    // The buffer wraps around; only the newest ten lines are kept, oldest first
+    model.append(makeEntries(7, 8));
+    DREAM3D_REQUIRE_EQUAL(model.rowCount(), 10)
+    DREAM3D_REQUIRE_EQUAL(model.getEntryCount(), 10)
+    DREAM3D_REQUIRE_EQUAL(model.getDroppedCount(), 5)
+    DREAM3D_REQUIRE(rowText(model, 0).endsWith("Line 5"))
+    DREAM3D_REQUIRE(rowText(model, 9).endsWith("Line 14"))
+
+    // A single batch that is larger than the buffer keeps its own tail
+    model.append(makeEntries(15, 25));
+    DREAM3D_REQUIRE_EQUAL(model.rowCount(), 10)
+    DREAM3D_REQUIRE_EQUAL(model.getDroppedCount(), 30)
+    DREAM3D_REQUIRE(rowText(model, 0).endsWith("Line 30"))
+    DREAM3D_REQUIRE(rowText(model, 9).endsWith("Line 39"))
+
+    // Shrinking keeps the newest lines, growing keeps them all
+    model.setRetentionLimit(4);
+    DREAM3D_REQUIRE_EQUAL(model.rowCount(), 4)
+    DREAM3D_REQUIRE(rowText(model, 0).endsWith("Line 36"))
+    model.setRetentionLimit(100);
+    model.append(makeEntries(40, 2));
+    DREAM3D_REQUIRE_EQUAL(model.rowCount(), 6)
+    DREAM3D_REQUIRE(rowText(model, 0).endsWith("Line 36"))
+    DREAM3D_REQUIRE(rowText(model, 5).endsWith("Line 41"))
+
+    model.clear();
+    DREAM3D_REQUIRE_EQUAL(model.rowCount(), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestFilter()
+  {
+    LogModel model;
+    model.setRetentionLimit(8);
+    model.append(makeEntries(0, 4, LogModel::Level::Info));
+    model.append(makeEntries(4, 2, LogModel::Level::Warning));
+    model.append(makeEntries(6, 2, LogModel::Level::Error));
+
+    model.setFilter(QString(), LogModel::Level::Warning);
+    DREAM3D_REQUIRE(model.isFiltered())
+    DREAM3D_REQUIRE_EQUAL(model.rowCount(), 4)
+    DREAM3D_REQUIRE(rowText(model, 0).endsWith("Line 4"))
+
+    model.setFilter("line 7", LogModel::Level::Info);
+    DREAM3D_REQUIRE_EQUAL(model.rowCount(), 1)
+
+    // Filtered rows that fall out of the buffer go away with it, new matches are added
+    model.setFilter(QString(), LogModel::Level::Error);
+    model.append(makeEntries(8, 6, LogModel::Level::Info));
+    DREAM3D_REQUIRE_EQUAL(model.rowCount(), 2)
+    model.append(makeEntries(14, 1, LogModel::Level::Info));
+    DREAM3D_REQUIRE_EQUAL(model.rowCount(), 1)
+    DREAM3D_REQUIRE(rowText(model, 0).endsWith("Line 7"))
+    model.append(makeEntries(15, 1, LogModel::Level::Error));
+    DREAM3D_REQUIRE_EQUAL(model.rowCount(), 1)
+    DREAM3D_REQUIRE(rowText(model, 0).endsWith("Line 15"))
+    DREAM3D_REQUIRE_EQUAL(model.getEntryCount(), 8)
+
+    model.setFilter(QString(), LogModel::Level::Info);
+    DREAM3D_REQUIRE(!model.isFiltered())
+    DREAM3D_REQUIRE_EQUAL(model.rowCount(), 8)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestFind()
+  {
+    LogModel model;
+    model.append(makeEntries(0, 5));
+
+    DREAM3D_REQUIRE_EQUAL(model.find("line 3", 0, false), 3)
+    DREAM3D_REQUIRE_EQUAL(model.find("line 1", 3, false), 1)
+    DREAM3D_REQUIRE_EQUAL(model.find("line 4", 1, true), 4)
+    DREAM3D_REQUIRE_EQUAL(model.find("missing", 0, false), -1)
+    DREAM3D_REQUIRE_EQUAL(model.find(QString(), 0, false), -1)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestExport()
+  {
+    LogModel model;
+    model.append(makeEntries(0, 3, LogModel::Level::Info));
+    model.append(makeEntries(3, 2, LogModel::Level::Error));
+    model.setFilter(QString(), LogModel::Level::Error);
+
+    QTemporaryDir tempDir;
+    DREAM3D_REQUIRE(tempDir.isValid())
+
+    QString allFilePath = tempDir.filePath("All.log");
+    QString filteredFilePath = tempDir.filePath("Filtered.log");
+    DREAM3D_REQUIRE(model.exportToFile(allFilePath, false))
+    DREAM3D_REQUIRE(model.exportToFile(filteredFilePath, true))
+
+    QFile allFile(allFilePath);
+    DREAM3D_REQUIRE(allFile.open(QIODevice::ReadOnly | QIODevice::Text))
+    DREAM3D_REQUIRE_EQUAL(QTextStream(&allFile).readAll().split('\n', QString::SkipEmptyParts).size(), 5)
+
+    QFile filteredFile(filteredFilePath);
+    DREAM3D_REQUIRE(filteredFile.open(QIODevice::ReadOnly | QIODevice::Text))
+    DREAM3D_REQUIRE_EQUAL(QTextStream(&filteredFile).readAll().split('\n', QString::SkipEmptyParts).size(), 2)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "#### LogModelTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestRetentionLimit())
+    DREAM3D_REGISTER_TEST(TestFilter())
+    DREAM3D_REGISTER_TEST(TestFind())
+    DREAM3D_REGISTER_TEST(TestExport())
+  }
+
+private:
+  LogModelTest(const LogModelTest&) = delete;   // Copy Constructor Not Implemented
+  void operator=(const LogModelTest&) = delete; // Move assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  int err = EXIT_SUCCESS;
+  LogModelTest test;
+  test();
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
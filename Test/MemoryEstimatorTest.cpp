@@ -0,0 +1,199 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Testing/UnitTestSupport.hpp"
+
+#include "SIMPLView/MemoryEstimator.h"
+
+class MemoryEstimatorTest
+{
+public:
+  MemoryEstimatorTest() = default;
+  ~MemoryEstimatorTest() = default;
+
+  const size_t k_Tuples = 1000;
+
+  // -----------------------------------------------------------------------------
+  // A filter as it looks after the preflight: its DataContainerArray declares, but does not allocate, the arrays
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer makePreflightedFilter(const QList<IDataArray::Pointer>& arrays)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("DataContainer");
+    dca->addDataContainer(dc);
+    AttributeMatrix::Pointer am = AttributeMatrix::New(QVector<size_t>(1, k_Tuples), "CellData", AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(am->getName(), am);
+    for(const IDataArray::Pointer& array : arrays)
+    {
+      am->addAttributeArray(array->getName(), array);
+    }
+
+    AbstractFilter::Pointer filter = AbstractFilter::New();
+    filter->setDataContainerArray(dca);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestDeclaredBytes()
+  {
+    FloatArrayType::Pointer vectors = FloatArrayType::CreateArray(100, QVector<size_t>(1, 3), "Vectors", false);
+    DREAM3D_REQUIRE_EQUAL(MemoryEstimator::DeclaredBytes(vectors), 1200)
+
+    DoubleArrayType::Pointer scalars = DoubleArrayType::CreateArray(100, QVector<size_t>(1, 1), "Scalars", false);
+    DREAM3D_REQUIRE_EQUAL(MemoryEstimator::DeclaredBytes(scalars), 800)
+
+    DREAM3D_REQUIRE_EQUAL(MemoryEstimator::DeclaredBytes(IDataArray::NullPointer()), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestEstimatePipeline()
+  {
+    IDataArray::Pointer a = FloatArrayType::CreateArray(k_Tuples, QVector<size_t>(1, 1), "A", false);
+    IDataArray::Pointer b = Int32ArrayType::CreateArray(k_Tuples, QVector<size_t>(1, 1), "B", false);
+    IDataArray::Pointer c = DoubleArrayType::CreateArray(k_Tuples, QVector<size_t>(1, 1), "C", false);
+
+    QList<AbstractFilter::Pointer> filters;
+    filters.push_back(makePreflightedFilter({a}));
+    filters.push_back(makePreflightedFilter({a, b}));
+    filters.push_back(makePreflightedFilter({a, b, c}));
+    AbstractFilter::Pointer disabled = makePreflightedFilter({a, b, c});
+    disabled->setEnabled(false);
+    filters.push_back(disabled);
+
+    // Without freeing, every array is held to the end
+    MemoryEstimator::Estimate keepAll = MemoryEstimator::EstimatePipeline(filters, QVector<ArrayLiveness::DeadArray>());
+    DREAM3D_REQUIRE_EQUAL(keepAll.steps.size(), 3)
+    DREAM3D_REQUIRE_EQUAL(keepAll.steps[0].peakBytes, 4000)
+    DREAM3D_REQUIRE_EQUAL(keepAll.steps[1].peakBytes, 8000)
+    DREAM3D_REQUIRE_EQUAL(keepAll.steps[2].peakBytes, 16000)
+    DREAM3D_REQUIRE_EQUAL(keepAll.peakBytes, 16000)
+    DREAM3D_REQUIRE_EQUAL(keepAll.peakStep, 2)
+
+    // A is still held while the filter that uses it last executes, and is gone behind it
+    ArrayLiveness::DeadArray deadArray;
+    deadArray.filterIndex = 1;
+    deadArray.path = DataArrayPath("DataContainer", "CellData", "A");
+    MemoryEstimator::Estimate freeing = MemoryEstimator::EstimatePipeline(filters, QVector<ArrayLiveness::DeadArray>() << deadArray);
+    DREAM3D_REQUIRE_EQUAL(freeing.steps.size(), 3)
+    DREAM3D_REQUIRE_EQUAL(freeing.steps[1].peakBytes, 8000)
+    DREAM3D_REQUIRE_EQUAL(freeing.steps[1].bytesAfter, 4000)
+    DREAM3D_REQUIRE_EQUAL(freeing.steps[2].peakBytes, 12000)
+    DREAM3D_REQUIRE_EQUAL(freeing.peakBytes, 12000)
+    DREAM3D_REQUIRE_EQUAL(freeing.steps[2].filterIndex, 2)
+
+    DREAM3D_REQUIRE(MemoryEstimator::Summary(freeing, 0).contains("in filter 3"))
+    DREAM3D_REQUIRE_EQUAL(MemoryEstimator::Timeline(freeing).size(), 3)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestRecreatedArray()
+  {
+    IDataArray::Pointer a = FloatArrayType::CreateArray(k_Tuples, QVector<size_t>(1, 1), "A", false);
+    IDataArray::Pointer b = Int32ArrayType::CreateArray(k_Tuples, QVector<size_t>(1, 1), "B", false);
+
+    // A is freed behind the first filter, deleted by the second and created again by the third
+    QList<AbstractFilter::Pointer> filters;
+    filters.push_back(makePreflightedFilter({a, b}));
+    filters.push_back(makePreflightedFilter({b}));
+    filters.push_back(makePreflightedFilter({a, b}));
+    filters.push_back(makePreflightedFilter({a, b}));
+
+    ArrayLiveness::DeadArray deadArray;
+    deadArray.filterIndex = 0;
+    deadArray.path = DataArrayPath("DataContainer", "CellData", "A");
+    MemoryEstimator::Estimate estimate = MemoryEstimator::EstimatePipeline(filters, QVector<ArrayLiveness::DeadArray>() << deadArray);
+    DREAM3D_REQUIRE_EQUAL(estimate.steps.size(), 4)
+    DREAM3D_REQUIRE_EQUAL(estimate.steps[0].bytesAfter, 4000)
+    DREAM3D_REQUIRE_EQUAL(estimate.steps[1].bytesAfter, 4000)
+    DREAM3D_REQUIRE_EQUAL(estimate.steps[2].peakBytes, 8000)
+    DREAM3D_REQUIRE_EQUAL(estimate.steps[2].bytesAfter, 8000)
+    DREAM3D_REQUIRE_EQUAL(estimate.steps[3].bytesAfter, 8000)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestEmptyPipeline()
+  {
+    MemoryEstimator::Estimate estimate = MemoryEstimator::EstimatePipeline(QList<AbstractFilter::Pointer>(), QVector<ArrayLiveness::DeadArray>());
+    DREAM3D_REQUIRE_EQUAL(estimate.peakStep, -1)
+    DREAM3D_REQUIRE_EQUAL(estimate.peakBytes, 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "#### MemoryEstimatorTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestDeclaredBytes())
+    DREAM3D_REGISTER_TEST(TestEstimatePipeline())
+    DREAM3D_REGISTER_TEST(TestRecreatedArray())
+    DREAM3D_REGISTER_TEST(TestEmptyPipeline())
+  }
+
+private:
+  MemoryEstimatorTest(const MemoryEstimatorTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const MemoryEstimatorTest&) = delete;      // Move assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  int err = EXIT_SUCCESS;
+  MemoryEstimatorTest test;
+  test();
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,237 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QTemporaryDir>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Testing/UnitTestSupport.hpp"
+
+#include "SIMPLView/ParameterSweep.h"
+
+class ParameterSweepTest
+{
+public:
+  ParameterSweepTest() = default;
+  ~ParameterSweepTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QString writePipeline(const QTemporaryDir& dir)
+  {
+    QJsonObject threshold;
+    threshold["Comparison Value"] = 0.5;
+    QJsonObject filter0;
+    filter0["Filter_Name"] = QString("ReadH5Ebsd");
+    filter0["InputFile"] = QString("/data/Small_IN100.h5ebsd");
+    QJsonObject filter1;
+    filter1["Filter_Name"] = QString("MultiThresholdObjects");
+    filter1["ArrayThresholds"] = QJsonArray({threshold});
+    QJsonObject filter2;
+    filter2["Filter_Name"] = QString("MinSize");
+    filter2["MinAllowedFeatureSize"] = 16;
+
+    QJsonObject builder;
+    builder["Number_Filters"] = 3;
+    QJsonObject pipeline;
+    pipeline["0"] = filter0;
+    pipeline["1"] = filter1;
+    pipeline["2"] = filter2;
+    pipeline["PipelineBuilder"] = builder;
+
+    QString filePath = dir.filePath("Sweep.json");
+    QFile file(filePath);
+    file.open(QIODevice::WriteOnly);
+    file.write(QJsonDocument(pipeline).toJson());
+    return filePath;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestParseRanges()
+  {
+    QVector<QJsonValue> values;
+    QString error;
+
+    // Integer ranges stay integers and include the stop value
+    DREAM3D_REQUIRE(ParameterSweep::ParseValues("10:50:10", values, error))
+    DREAM3D_REQUIRE_EQUAL(values.size(), 5)
+    DREAM3D_REQUIRE(values[0].isDouble())
+    DREAM3D_REQUIRE_EQUAL(values[0].toInt(), 10)
+    DREAM3D_REQUIRE_EQUAL(values[4].toInt(), 50)
+
+    // Floating point ranges do not lose the last value to rounding
+    DREAM3D_REQUIRE(ParameterSweep::ParseValues("0.1:0.3:0.1", values, error))
+    DREAM3D_REQUIRE_EQUAL(values.size(), 3)
+    DREAM3D_REQUIRE(qAbs(values[2].toDouble() - 0.3) < 1.0e-9)
+
+    // Descending ranges need a negative step
+    DREAM3D_REQUIRE(ParameterSweep::ParseValues("5:1:-2", values, error))
+    DREAM3D_REQUIRE_EQUAL(values.size(), 3)
+    DREAM3D_REQUIRE_EQUAL(values[2].toInt(), 1)
+
+    DREAM3D_REQUIRE(!ParameterSweep::ParseValues("1:5:0", values, error))
+    DREAM3D_REQUIRE(!ParameterSweep::ParseValues("5:1:1", values, error))
+    DREAM3D_REQUIRE(!ParameterSweep::ParseValues("a:5:1", values, error))
+    DREAM3D_REQUIRE(!ParameterSweep::ParseValues("0:1000000:1", values, error))
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestParseLists()
+  {
+    QVector<QJsonValue> values;
+    QString error;
+
+    DREAM3D_REQUIRE(ParameterSweep::ParseValues(" 8, 16 ,2.5,true,Disk ", values, error))
+    DREAM3D_REQUIRE_EQUAL(values.size(), 5)
+    DREAM3D_REQUIRE_EQUAL(values[0].toInt(), 8)
+    DREAM3D_REQUIRE_EQUAL(values[1].toInt(), 16)
+    DREAM3D_REQUIRE(qAbs(values[2].toDouble() - 2.5) < 1.0e-9)
+    DREAM3D_REQUIRE(values[3].isBool() && values[3].toBool())
+    DREAM3D_REQUIRE(values[4].toString() == "Disk")
+
+    DREAM3D_REQUIRE(!ParameterSweep::ParseValues(" , ", values, error))
+
+    ParameterSweep::Dimension dimension;
+    DREAM3D_REQUIRE(ParameterSweep::ParseDimension("2/MinAllowedFeatureSize=8,16,32", dimension, error))
+    DREAM3D_REQUIRE(dimension.path == "2/MinAllowedFeatureSize")
+    DREAM3D_REQUIRE_EQUAL(dimension.values.size(), 3)
+    DREAM3D_REQUIRE(!ParameterSweep::ParseDimension("=8,16", dimension, error))
+    DREAM3D_REQUIRE(!ParameterSweep::ParseDimension("2/MinAllowedFeatureSize", dimension, error))
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestGrid()
+  {
+    QTemporaryDir dir;
+    DREAM3D_REQUIRE(dir.isValid())
+    ParameterSweep::Pointer sweep = ParameterSweep::New();
+    QString error;
+    DREAM3D_REQUIRE(sweep->setPipelineFile(writePipeline(dir), error))
+    DREAM3D_REQUIRE_EQUAL(sweep->getPointCount(), 0)
+
+    ParameterSweep::Dimension minSize;
+    DREAM3D_REQUIRE(ParameterSweep::ParseDimension("2/MinAllowedFeatureSize=10:50:10", minSize, error))
+    DREAM3D_REQUIRE(sweep->addDimension(minSize, error))
+    DREAM3D_REQUIRE_EQUAL(sweep->getPointCount(), 5)
+    DREAM3D_REQUIRE_EQUAL(sweep->getSharedPrefixLength(), 2)
+
+    // Values inside structured parameters are reached through their keys and indices
+    ParameterSweep::Dimension threshold;
+    DREAM3D_REQUIRE(ParameterSweep::ParseDimension("1/ArrayThresholds/0/Comparison Value=0.1,0.2,0.3", threshold, error))
+    DREAM3D_REQUIRE(sweep->addDimension(threshold, error))
+    DREAM3D_REQUIRE_EQUAL(sweep->getPointCount(), 15)
+    DREAM3D_REQUIRE_EQUAL(sweep->getSharedPrefixLength(), 1)
+
+    // Paths that are not in the pipeline are refused and leave the grid as it was
+    ParameterSweep::Dimension missing;
+    DREAM3D_REQUIRE(ParameterSweep::ParseDimension("2/NoSuchParameter=1,2", missing, error))
+    DREAM3D_REQUIRE(!sweep->addDimension(missing, error))
+    DREAM3D_REQUIRE(ParameterSweep::ParseDimension("3/MinAllowedFeatureSize=1,2", missing, error))
+    DREAM3D_REQUIRE(!sweep->addDimension(missing, error))
+    DREAM3D_REQUIRE(ParameterSweep::ParseDimension("1/ArrayThresholds/4/Comparison Value=1,2", missing, error))
+    DREAM3D_REQUIRE(!sweep->addDimension(missing, error))
+    DREAM3D_REQUIRE_EQUAL(sweep->getPointCount(), 15)
+
+    // Grids that multiply out to too many points are refused as a whole
+    ParameterSweep::Dimension large;
+    DREAM3D_REQUIRE(ParameterSweep::ParseDimension("0/InputFile=0:9999:1", large, error))
+    DREAM3D_REQUIRE(!sweep->addDimension(large, error))
+    DREAM3D_REQUIRE_EQUAL(sweep->getDimensions().size(), 2)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestSetJsonValue()
+  {
+    QJsonObject threshold;
+    threshold["Comparison Value"] = 0.5;
+    QJsonObject filter;
+    filter["ArrayThresholds"] = QJsonArray({threshold});
+    QJsonObject pipelineObject;
+    pipelineObject["1"] = filter;
+    QJsonValue pipeline(pipelineObject);
+
+    QStringList path = QString("1/ArrayThresholds/0/Comparison Value").split('/');
+    DREAM3D_REQUIRE(ParameterSweep::SetJsonValue(pipeline, path, 0, QJsonValue(0.25)))
+    double value = pipeline.toObject()["1"].toObject()["ArrayThresholds"].toArray().at(0).toObject()["Comparison Value"].toDouble();
+    DREAM3D_REQUIRE(qAbs(value - 0.25) < 1.0e-9)
+
+    DREAM3D_REQUIRE(!ParameterSweep::SetJsonValue(pipeline, QString("1/ArrayThresholds/1/Comparison Value").split('/'), 0, QJsonValue(1)))
+    DREAM3D_REQUIRE(!ParameterSweep::SetJsonValue(pipeline, QString("2/MinAllowedFeatureSize").split('/'), 0, QJsonValue(1)))
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "#### ParameterSweepTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestParseRanges())
+    DREAM3D_REGISTER_TEST(TestParseLists())
+    DREAM3D_REGISTER_TEST(TestGrid())
+    DREAM3D_REGISTER_TEST(TestSetJsonValue())
+  }
+
+private:
+  ParameterSweepTest(const ParameterSweepTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const ParameterSweepTest&) = delete;     // Move assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  int err = EXIT_SUCCESS;
+  ParameterSweepTest test;
+  test();
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
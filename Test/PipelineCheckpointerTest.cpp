@@ -0,0 +1,187 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QTemporaryDir>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Testing/UnitTestSupport.hpp"
+
+#include "SIMPLView/ArraySpiller.h"
+#include "SIMPLView/PipelineCheckpointer.h"
+
+namespace
+{
+const size_t k_Tuples = 1024 * 1024;
+}
+
+class PipelineCheckpointerTest
+{
+public:
+  PipelineCheckpointerTest() = default;
+  ~PipelineCheckpointerTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataContainerArray()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("DataContainer");
+    dca->addDataContainer(dc);
+    AttributeMatrix::Pointer am = AttributeMatrix::New(QVector<size_t>(1, k_Tuples), "CellData", AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(am->getName(), am);
+
+    FloatArrayType::Pointer a = FloatArrayType::CreateArray(k_Tuples, QVector<size_t>(1, 1), "A", true);
+    FloatArrayType::Pointer b = FloatArrayType::CreateArray(k_Tuples, QVector<size_t>(1, 1), "B", true);
+    for(size_t i = 0; i < k_Tuples; i++)
+    {
+      a->setValue(i, static_cast<float>(i));
+      b->setValue(i, -static_cast<float>(i));
+    }
+    am->addAttributeArray(a->getName(), a);
+    am->addAttributeArray(b->getName(), b);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestResumeWithSpilledArrays()
+  {
+    QTemporaryDir tempDir;
+    DREAM3D_REQUIRE(tempDir.isValid())
+    QString checkpointDirectory = tempDir.path() + "/Checkpoints";
+
+    DataContainerArray::Pointer dca = createDataContainerArray();
+    QList<AbstractFilter::Pointer> filters;
+    for(int i = 0; i < 2; i++)
+    {
+      AbstractFilter::Pointer filter = AbstractFilter::New();
+      filter->setDataContainerArray(dca);
+      filters.push_back(filter);
+    }
+    QStringList keys = {"Key0", "Key1"};
+
+    // The two arrays take 8 MB, so the spiller has to move one of them out before the checkpoint is written
+    ArraySpiller::Pointer spiller = ArraySpiller::New();
+    spiller->setBudgetMB(5);
+    spiller->setScratchDirectory(tempDir.path() + "/Spill");
+    spiller->setPipeline(filters);
+
+    PipelineCheckpointer::Pointer checkpointer = PipelineCheckpointer::New();
+    checkpointer->setDirectory(checkpointDirectory);
+    checkpointer->setSelectedIndices(QSet<int>({0}));
+    checkpointer->setArraySpiller(spiller);
+    checkpointer->setPipeline(filters, keys);
+
+    AttributeMatrix::Pointer am = dca->getDataContainer("DataContainer")->getAttributeMatrix("CellData");
+    QList<IDataArray::Pointer> arrays = {am->getAttributeArray("A"), am->getAttributeArray("B")};
+
+    AbstractFilter* filter = filters[0].get();
+    spiller->beginFilter(filter);
+    checkpointer->beginFilter(filter);
+    spiller->endFilter(filter);
+    checkpointer->endFilter(filter);
+
+    // The spilled array went into the checkpoint from its scratch file and is empty again
+    DREAM3D_REQUIRE_EQUAL(am->getAttributeArrayNames().size(), 1)
+    for(const IDataArray::Pointer& array : arrays)
+    {
+      DREAM3D_REQUIRE_EQUAL(array->getNumberOfTuples(), am->doesAttributeArrayExist(array->getName()) ? k_Tuples : 0)
+    }
+
+    QVector<PipelineCheckpointer::Checkpoint> checkpoints = checkpointer->getCheckpoints();
+    DREAM3D_REQUIRE_EQUAL(checkpoints.size(), 1)
+    DREAM3D_REQUIRE(checkpoints[0].written)
+    DREAM3D_REQUIRE_EQUAL(checkpoints[0].spilledArrays, 1)
+
+    DREAM3D_REQUIRE_EQUAL(PipelineCheckpointer::FindResumeIndex(checkpointDirectory, keys), 0)
+    DataContainerArray::Pointer restored = PipelineCheckpointer::Restore(checkpointDirectory, keys[0]);
+    DREAM3D_REQUIRE(restored.get() != nullptr)
+    AttributeMatrix::Pointer restoredAm = restored->getDataContainer("DataContainer")->getAttributeMatrix("CellData");
+    DREAM3D_REQUIRE(restoredAm.get() != nullptr)
+
+    FloatArrayType::Pointer a = std::dynamic_pointer_cast<FloatArrayType>(restoredAm->getAttributeArray("A"));
+    FloatArrayType::Pointer b = std::dynamic_pointer_cast<FloatArrayType>(restoredAm->getAttributeArray("B"));
+    DREAM3D_REQUIRE(a.get() != nullptr)
+    DREAM3D_REQUIRE(b.get() != nullptr)
+    DREAM3D_REQUIRE_EQUAL(a->getNumberOfTuples(), k_Tuples)
+    DREAM3D_REQUIRE_EQUAL(b->getNumberOfTuples(), k_Tuples)
+    for(size_t i = 0; i < k_Tuples; i += 4099)
+    {
+      DREAM3D_REQUIRE_EQUAL(a->getValue(i), static_cast<float>(i))
+      DREAM3D_REQUIRE_EQUAL(b->getValue(i), -static_cast<float>(i))
+    }
+
+    spiller->finishRun();
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "#### PipelineCheckpointerTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestResumeWithSpilledArrays())
+  }
+
+private:
+  PipelineCheckpointerTest(const PipelineCheckpointerTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const PipelineCheckpointerTest&) = delete;           // Move assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QStandardPaths::setTestModeEnabled(true);
+
+  int err = EXIT_SUCCESS;
+  PipelineCheckpointerTest test;
+  test();
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,187 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include <QtCore/QCoreApplication>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QTemporaryDir>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Testing/UnitTestSupport.hpp"
+
+#include "SIMPLView/PipelineEta.h"
+#include "SIMPLView/TimingHistory.h"
+
+class PipelineEtaTest
+{
+public:
+  PipelineEtaTest() = default;
+  ~PipelineEtaTest() = default;
+
+  // -----------------------------------------------------------------------------
+  // A filter holding its own preflight structure with one attribute matrix of the given size
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer makePreflightedFilter(size_t tuples)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("DataContainer");
+    dca->addDataContainer(dc);
+    AttributeMatrix::Pointer am = AttributeMatrix::New(QVector<size_t>(1, tuples), "CellData", AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(am->getName(), am);
+
+    AbstractFilter::Pointer filter = AbstractFilter::New();
+    filter->setDataContainerArray(dca);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestFormatDuration()
+  {
+    DREAM3D_REQUIRE(PipelineEta::FormatDuration(59499) == QString("59 s"))
+    DREAM3D_REQUIRE(PipelineEta::FormatDuration(90000) == QString("1 min 30 s"))
+    DREAM3D_REQUIRE(PipelineEta::FormatDuration(4320000) == QString("1 h 12 min"))
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestWithoutHistory()
+  {
+    TimingHistory::Instance()->clear();
+
+    PipelineEta::Pointer eta = PipelineEta::New();
+    eta->setPipeline({makePreflightedFilter(1000), makePreflightedFilter(1000)});
+    DREAM3D_REQUIRE_EQUAL(eta->getSteps().size(), 2)
+    DREAM3D_REQUIRE(!eta->hasHistory())
+    DREAM3D_REQUIRE(eta->isLowerBound())
+    DREAM3D_REQUIRE_EQUAL(eta->remainingMSecs(), -1)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestPerFilterStructures()
+  {
+    TimingHistory* history = TimingHistory::Instance();
+    history->clear();
+    history->record("AbstractFilter", 1000, 1000);
+
+    // Each filter is predicted from the size of its own structure, not from the last filter's
+    AbstractFilter::Pointer disabled = makePreflightedFilter(1000);
+    disabled->setEnabled(false);
+    PipelineEta::Pointer eta = PipelineEta::New();
+    eta->setPipeline({makePreflightedFilter(1000), disabled, makePreflightedFilter(1000000)});
+
+    QVector<PipelineEta::Step> steps = eta->getSteps();
+    DREAM3D_REQUIRE_EQUAL(steps.size(), 2)
+    DREAM3D_REQUIRE_EQUAL(steps[0].filterIndex, 0)
+    DREAM3D_REQUIRE_EQUAL(steps[0].tuples, 1000)
+    DREAM3D_REQUIRE_EQUAL(steps[0].predictedMSecs, 1000)
+    DREAM3D_REQUIRE_EQUAL(steps[1].filterIndex, 2)
+    DREAM3D_REQUIRE_EQUAL(steps[1].tuples, 1000000)
+    DREAM3D_REQUIRE_EQUAL(steps[1].predictedMSecs, -1)
+    DREAM3D_REQUIRE(eta->hasHistory())
+    DREAM3D_REQUIRE(eta->isLowerBound())
+    DREAM3D_REQUIRE_EQUAL(eta->remainingMSecs(), 1000)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestRunScale()
+  {
+    TimingHistory* history = TimingHistory::Instance();
+    history->clear();
+    history->record("AbstractFilter", 1000, 1000);
+
+    PipelineEta::Pointer eta = PipelineEta::New();
+    eta->setPipeline({makePreflightedFilter(1000), makePreflightedFilter(1000)});
+    DREAM3D_REQUIRE(!eta->isLowerBound())
+    DREAM3D_REQUIRE_EQUAL(eta->remainingMSecs(), 2000)
+
+    // The first filter took three times its prediction, the rest is scaled by at most two
+    eta->start();
+    eta->filterFinished(0, 3000);
+    qint64 remaining = eta->remainingMSecs();
+    DREAM3D_REQUIRE(remaining > 1500)
+    DREAM3D_REQUIRE(remaining <= 2000)
+
+    // Only the filters that completed are added to the history
+    eta->finishRun();
+    DREAM3D_REQUIRE(!eta->isRunning())
+    DREAM3D_REQUIRE_EQUAL(history->predictMSecs("AbstractFilter", 1000), 2000)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "#### PipelineEtaTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFormatDuration())
+    DREAM3D_REGISTER_TEST(TestWithoutHistory())
+    DREAM3D_REGISTER_TEST(TestPerFilterStructures())
+    DREAM3D_REGISTER_TEST(TestRunScale())
+  }
+
+private:
+  PipelineEtaTest(const PipelineEtaTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const PipelineEtaTest&) = delete;  // Move assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QStandardPaths::setTestModeEnabled(true);
+
+  // The history the estimates read must not be the user's
+  QTemporaryDir tempDir;
+  qputenv("SIMPL_TIMING_HISTORY", tempDir.filePath("TimingHistory.json").toLocal8Bit());
+
+  int err = EXIT_SUCCESS;
+  PipelineEtaTest test;
+  test();
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,216 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include <QtCore/QCoreApplication>
+#include <QtCore/QJsonArray>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Testing/UnitTestSupport.hpp"
+
+#include "SIMPLView/SettingsStore.h"
+
+class SettingsStoreTest
+{
+public:
+  SettingsStoreTest() = default;
+  ~SettingsStoreTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QVector<SettingsChange> record(const SettingsStore::WriterFunction& writer)
+  {
+    SettingsWriter settingsWriter;
+    writer(&settingsWriter);
+    return settingsWriter.getChanges();
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestWriterGroups()
+  {
+    QVector<SettingsChange> changes = record([](SettingsWriter* prefs) {
+      prefs->beginGroup("Application Settings");
+      prefs->setValue("Memory Budget MB", 512);
+      prefs->beginGroup("Nested");
+      prefs->remove("Old Key");
+      prefs->endGroup();
+      prefs->endGroup();
+      prefs->setValue("Program Mode", QString("Standard"));
+    });
+
+    DREAM3D_REQUIRE_EQUAL(changes.size(), 3)
+    DREAM3D_REQUIRE(changes[0].path == QStringList({"Application Settings", "Memory Budget MB"}))
+    DREAM3D_REQUIRE(!changes[0].removed)
+    DREAM3D_REQUIRE_EQUAL(changes[0].value.toInt(), 512)
+    DREAM3D_REQUIRE(changes[1].path == QStringList({"Application Settings", "Nested", "Old Key"}))
+    DREAM3D_REQUIRE(changes[1].removed)
+    DREAM3D_REQUIRE(changes[2].path == QStringList({"Program Mode"}))
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestEncoding()
+  {
+    QByteArray bytes("\x01\x02geometry\xff", 11);
+    QJsonValue encodedBytes = SettingsWriter::EncodeValue(bytes);
+    DREAM3D_REQUIRE(encodedBytes.isString())
+    DREAM3D_REQUIRE(SettingsWriter::DecodeValue(encodedBytes, QVariant::ByteArray).toByteArray() == bytes)
+
+    QStringList list = {"/data/a.json", "/data/b.json"};
+    QJsonValue encodedList = SettingsWriter::EncodeValue(list);
+    DREAM3D_REQUIRE(encodedList.isArray())
+    DREAM3D_REQUIRE(SettingsWriter::DecodeValue(encodedList, QVariant::StringList).toStringList() == list)
+
+    DREAM3D_REQUIRE_EQUAL(SettingsWriter::DecodeValue(SettingsWriter::EncodeValue(true), QVariant::Bool).toBool(), true)
+    DREAM3D_REQUIRE_EQUAL(SettingsWriter::DecodeValue(SettingsWriter::EncodeValue(42), QVariant::Int).toInt(), 42)
+    DREAM3D_REQUIRE(SettingsWriter::DecodeValue(SettingsWriter::EncodeValue(QString("Disk")), QVariant::String).toString() == "Disk")
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestRemovals()
+  {
+    QJsonObject group;
+    group.insert("Keep", 1);
+    group.insert("Drop", 2);
+    QJsonObject root;
+    root.insert("Group", group);
+    root.insert("Other", QString("untouched"));
+    root.insert("Obsolete", QJsonObject());
+
+    QVector<SettingsChange> changes = record([](SettingsWriter* prefs) {
+      prefs->beginGroup("Group");
+      prefs->remove("Drop");
+      prefs->remove("Missing");
+      prefs->endGroup();
+      prefs->remove("Obsolete");
+      prefs->beginGroup("Absent Group");
+      prefs->remove("Key");
+      prefs->endGroup();
+    });
+    SettingsStore::ApplyChanges(root, changes);
+
+    DREAM3D_REQUIRE(root.value("Group").toObject().contains("Keep"))
+    DREAM3D_REQUIRE(!root.value("Group").toObject().contains("Drop"))
+    DREAM3D_REQUIRE(!root.contains("Obsolete"))
+    DREAM3D_REQUIRE(!root.contains("Absent Group"))
+    DREAM3D_REQUIRE(root.value("Other").toString() == "untouched")
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestCoalescing()
+  {
+    QVector<SettingsChange> pending;
+    auto add = [&pending, this](const SettingsStore::WriterFunction& writer) {
+      for(const SettingsChange& change : record(writer))
+      {
+        SettingsStore::AddChange(pending, change);
+      }
+    };
+
+    // Repeated writes of the same key keep only the last value
+    for(int i = 0; i < 100; i++)
+    {
+      add([i](SettingsWriter* prefs) {
+        prefs->beginGroup("WindowSettings");
+        prefs->setValue("MainWindowGeometry", QByteArray::number(i));
+        prefs->endGroup();
+      });
+    }
+    DREAM3D_REQUIRE_EQUAL(pending.size(), 1)
+
+    // Removing a group drops the pending writes inside it, writing into it afterwards stays behind the removal
+    add([](SettingsWriter* prefs) {
+      prefs->beginGroup("WindowSettings");
+      prefs->setValue("MainWindowState", QByteArray("state"));
+      prefs->endGroup();
+      prefs->remove("WindowSettings");
+      prefs->beginGroup("WindowSettings");
+      prefs->setValue("MainWindowState", QByteArray("new state"));
+      prefs->endGroup();
+    });
+    DREAM3D_REQUIRE_EQUAL(pending.size(), 2)
+    DREAM3D_REQUIRE(pending[0].removed)
+
+    QJsonObject windowSettings;
+    windowSettings.insert("MainWindowGeometry", QString("old"));
+    windowSettings.insert("Stale", QString("old"));
+    QJsonObject root;
+    root.insert("WindowSettings", windowSettings);
+    SettingsStore::ApplyChanges(root, pending);
+
+    QJsonObject result = root.value("WindowSettings").toObject();
+    DREAM3D_REQUIRE_EQUAL(result.size(), 1)
+    DREAM3D_REQUIRE(SettingsWriter::DecodeValue(result.value("MainWindowState"), QVariant::ByteArray).toByteArray() == "new state")
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "#### SettingsStoreTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestWriterGroups())
+    DREAM3D_REGISTER_TEST(TestEncoding())
+    DREAM3D_REGISTER_TEST(TestRemovals())
+    DREAM3D_REGISTER_TEST(TestCoalescing())
+  }
+
+private:
+  SettingsStoreTest(const SettingsStoreTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const SettingsStoreTest&) = delete;    // Move assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  int err = EXIT_SUCCESS;
+  SettingsStoreTest test;
+  test();
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
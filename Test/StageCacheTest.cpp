@@ -0,0 +1,177 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QTemporaryDir>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Testing/UnitTestSupport.hpp"
+
+#include "SIMPLView/StageCache.h"
+
+class StageCacheTest
+{
+public:
+  StageCacheTest() = default;
+  ~StageCacheTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QJsonObject createPipeline(const QString& inputFile, int minSize)
+  {
+    QJsonObject filter0;
+    filter0["Filter_Name"] = QString("CreateDataContainer");
+    filter0["CreatedDataContainer"] = QString("DataContainer");
+    QJsonObject filter1;
+    filter1["Filter_Name"] = QString("ReadH5Ebsd");
+    filter1["InputFile"] = inputFile;
+    QJsonObject filter2;
+    filter2["Filter_Name"] = QString("MinSize");
+    filter2["MinAllowedFeatureSize"] = minSize;
+
+    QJsonObject builder;
+    builder["Number_Filters"] = 3;
+    QJsonObject pipeline;
+    pipeline["0"] = filter0;
+    pipeline["1"] = filter1;
+    pipeline["2"] = filter2;
+    pipeline["PipelineBuilder"] = builder;
+    return pipeline;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void writeFile(const QString& filePath, const QByteArray& contents)
+  {
+    QFile file(filePath);
+    DREAM3D_REQUIRE(file.open(QIODevice::WriteOnly))
+    file.write(contents);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestStageKeys()
+  {
+    QStringList keys = StageCache::ComputeStageKeys(createPipeline("/data/Small_IN100.h5ebsd", 16));
+    DREAM3D_REQUIRE_EQUAL(keys.size(), 3)
+    DREAM3D_REQUIRE(keys[0] != keys[1] && keys[1] != keys[2])
+    DREAM3D_REQUIRE(keys == StageCache::ComputeStageKeys(createPipeline("/data/Small_IN100.h5ebsd", 16)))
+
+    // A changed parameter changes the key of its filter and of everything downstream, but nothing upstream
+    QStringList changedKeys = StageCache::ComputeStageKeys(createPipeline("/data/Other.h5ebsd", 16));
+    DREAM3D_REQUIRE(changedKeys[0] == keys[0])
+    DREAM3D_REQUIRE(changedKeys[1] != keys[1])
+    DREAM3D_REQUIRE(changedKeys[2] != keys[2])
+
+    changedKeys = StageCache::ComputeStageKeys(createPipeline("/data/Small_IN100.h5ebsd", 32));
+    DREAM3D_REQUIRE(changedKeys[1] == keys[1])
+    DREAM3D_REQUIRE(changedKeys[2] != keys[2])
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestInputFiles()
+  {
+    QTemporaryDir dir;
+    DREAM3D_REQUIRE(dir.isValid())
+    QString inputFile = dir.filePath("Input.h5ebsd");
+    writeFile(inputFile, "0123456789");
+
+    QStringList keys = StageCache::ComputeStageKeys(createPipeline(inputFile, 16));
+    DREAM3D_REQUIRE(keys == StageCache::ComputeStageKeys(createPipeline(inputFile, 16)))
+
+    // Replacing the file on disk invalidates the filter that reads it and everything downstream
+    writeFile(inputFile, "01234567890123456789");
+    QStringList changedKeys = StageCache::ComputeStageKeys(createPipeline(inputFile, 16));
+    DREAM3D_REQUIRE(changedKeys[0] == keys[0])
+    DREAM3D_REQUIRE(changedKeys[1] != keys[1])
+    DREAM3D_REQUIRE(changedKeys[2] != keys[2])
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestScratchDirectories()
+  {
+    // A directory left behind by a process that is gone is removed, the one of this process is created
+    QString baseDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/StageCache";
+    QString staleDirectory = baseDirectory + "/999999999";
+    DREAM3D_REQUIRE(QDir().mkpath(staleDirectory))
+    writeFile(staleDirectory + "/Stale.dream3d", "0123456789");
+
+    StageCache::Instance();
+    DREAM3D_REQUIRE(!QDir(staleDirectory).exists())
+    DREAM3D_REQUIRE(QDir(baseDirectory + "/" + QString::number(QCoreApplication::applicationPid())).exists())
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "#### StageCacheTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestStageKeys())
+    DREAM3D_REGISTER_TEST(TestInputFiles())
+    DREAM3D_REGISTER_TEST(TestScratchDirectories())
+  }
+
+private:
+  StageCacheTest(const StageCacheTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const StageCacheTest&) = delete; // Move assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QStandardPaths::setTestModeEnabled(true);
+
+  int err = EXIT_SUCCESS;
+  StageCacheTest test;
+  test();
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
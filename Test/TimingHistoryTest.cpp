@@ -0,0 +1,166 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QTemporaryDir>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Testing/UnitTestSupport.hpp"
+
+#include "SIMPLView/TimingHistory.h"
+
+/**
+ * @brief The SeparateHistory class stands in for the TimingHistory of another process sharing the file
+ */
+class SeparateHistory : public TimingHistory
+{
+public:
+  SeparateHistory() = default;
+  ~SeparateHistory() override = default;
+};
+
+class TimingHistoryTest
+{
+public:
+  TimingHistoryTest() = default;
+  ~TimingHistoryTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QString useFile(const QTemporaryDir& tempDir, const QString& fileName)
+  {
+    QString filePath = tempDir.filePath(fileName);
+    qputenv("SIMPL_TIMING_HISTORY", filePath.toLocal8Bit());
+    return filePath;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestPrediction()
+  {
+    QTemporaryDir tempDir;
+    DREAM3D_REQUIRE(tempDir.isValid())
+    useFile(tempDir, "Prediction.json");
+
+    SeparateHistory history;
+    DREAM3D_REQUIRE_EQUAL(history.predictMSecs("FilterA", 1000), -1)
+
+    history.record("FilterA", 1000, 100);
+    DREAM3D_REQUIRE_EQUAL(history.predictMSecs("FilterA", 1000), 100)
+    // The next bucket up still scales from this one
+    DREAM3D_REQUIRE_EQUAL(history.predictMSecs("FilterA", 2000), 200)
+    DREAM3D_REQUIRE_EQUAL(history.predictMSecs("FilterA", 1000000), -1)
+    DREAM3D_REQUIRE_EQUAL(history.predictMSecs("FilterB", 1000), -1)
+
+    history.record("FilterA", 1000, 300);
+    DREAM3D_REQUIRE_EQUAL(history.predictMSecs("FilterA", 1000), 200)
+
+    DREAM3D_REQUIRE(history.save())
+    SeparateHistory reread;
+    DREAM3D_REQUIRE_EQUAL(reread.predictMSecs("FilterA", 1000), 200)
+
+    reread.clear();
+    DREAM3D_REQUIRE(!QFile::exists(reread.getFilePath()))
+    DREAM3D_REQUIRE_EQUAL(reread.predictMSecs("FilterA", 1000), -1)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestMergeOnSave()
+  {
+    QTemporaryDir tempDir;
+    DREAM3D_REQUIRE(tempDir.isValid())
+    useFile(tempDir, "Merge.json");
+
+    // Both read the file before either of them saved
+    SeparateHistory first;
+    SeparateHistory second;
+    first.record("FilterA", 1000, 100);
+    first.record("FilterC", 1000, 100);
+    second.record("FilterB", 1000, 300);
+    second.record("FilterC", 1000, 300);
+    DREAM3D_REQUIRE(first.save())
+    DREAM3D_REQUIRE(second.save())
+
+    SeparateHistory merged;
+    DREAM3D_REQUIRE_EQUAL(merged.predictMSecs("FilterA", 1000), 100)
+    DREAM3D_REQUIRE_EQUAL(merged.predictMSecs("FilterB", 1000), 300)
+    DREAM3D_REQUIRE_EQUAL(merged.predictMSecs("FilterC", 1000), 200)
+
+    // The runs that were saved already are not added a second time
+    DREAM3D_REQUIRE(second.save())
+    SeparateHistory unchanged;
+    DREAM3D_REQUIRE_EQUAL(unchanged.predictMSecs("FilterC", 1000), 200)
+
+    // A save also picks up what the other process wrote
+    DREAM3D_REQUIRE_EQUAL(second.predictMSecs("FilterA", 1000), 100)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "#### TimingHistoryTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestPrediction())
+    DREAM3D_REGISTER_TEST(TestMergeOnSave())
+  }
+
+private:
+  TimingHistoryTest(const TimingHistoryTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const TimingHistoryTest&) = delete;    // Move assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QStandardPaths::setTestModeEnabled(true);
+
+  int err = EXIT_SUCCESS;
+  TimingHistoryTest test;
+  test();
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,272 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QTemporaryDir>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Testing/UnitTestSupport.hpp"
+
+#include "SIMPLView/WorkerProtocol.h"
+
+namespace
+{
+const size_t k_Tuples = 1000;
+}
+
+class WorkerProtocolTest
+{
+public:
+  WorkerProtocolTest() = default;
+  ~WorkerProtocolTest() = default;
+
+  // -----------------------------------------------------------------------------
+  // The result of a worker: cell data with two arrays and an empty feature matrix
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createResult()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("DataContainer");
+    dca->addDataContainer(dc);
+
+    AttributeMatrix::Pointer cellData = AttributeMatrix::New(QVector<size_t>(1, k_Tuples), "CellData", AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(cellData->getName(), cellData);
+    FloatArrayType::Pointer a = FloatArrayType::CreateArray(k_Tuples, QVector<size_t>(1, 3), "A", true);
+    Int32ArrayType::Pointer b = Int32ArrayType::CreateArray(k_Tuples, QVector<size_t>(1, 1), "B", true);
+    for(size_t i = 0; i < k_Tuples; i++)
+    {
+      a->setComponent(i, 0, static_cast<float>(i));
+      a->setComponent(i, 1, static_cast<float>(i) * 0.5f);
+      a->setComponent(i, 2, -static_cast<float>(i));
+      b->setValue(i, static_cast<int32_t>(i * 7));
+    }
+    cellData->addAttributeArray(a->getName(), a);
+    cellData->addAttributeArray(b->getName(), b);
+
+    AttributeMatrix::Pointer featureData = AttributeMatrix::New(QVector<size_t>(1, 0), "FeatureData", AttributeMatrix::Type::CellFeature);
+    dc->addAttributeMatrix(featureData->getName(), featureData);
+    Int32ArrayType::Pointer sizes = Int32ArrayType::CreateArray(0, QVector<size_t>(1, 1), "Sizes", true);
+    featureData->addAttributeArray(sizes->getName(), sizes);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The structure the GUI holds from the preflight, where the feature matrix still has a guessed size
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createPreflight()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("DataContainer");
+    dca->addDataContainer(dc);
+
+    AttributeMatrix::Pointer cellData = AttributeMatrix::New(QVector<size_t>(1, k_Tuples), "CellData", AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(cellData->getName(), cellData);
+    cellData->addAttributeArray("A", FloatArrayType::CreateArray(k_Tuples, QVector<size_t>(1, 3), "A", false));
+    cellData->addAttributeArray("B", Int32ArrayType::CreateArray(k_Tuples, QVector<size_t>(1, 1), "B", false));
+
+    AttributeMatrix::Pointer featureData = AttributeMatrix::New(QVector<size_t>(1, 1), "FeatureData", AttributeMatrix::Type::CellFeature);
+    dc->addAttributeMatrix(featureData->getName(), featureData);
+    featureData->addAttributeArray("Sizes", Int32ArrayType::CreateArray(1, QVector<size_t>(1, 1), "Sizes", false));
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestFraming()
+  {
+    QJsonObject first;
+    first["Type"] = QString("Message");
+    first["Text"] = QString("Reading file");
+    QJsonObject second;
+    second["Type"] = QString("Finished");
+    second["Error Code"] = -42;
+
+    QByteArray stream = WorkerProtocol::Frame(first) + WorkerProtocol::Frame(second);
+
+    // The socket delivers the stream in arbitrary pieces, here one byte at a time
+    QByteArray buffer;
+    QVector<QJsonObject> messages;
+    for(int i = 0; i < stream.size(); i++)
+    {
+      buffer.append(stream.at(i));
+      QJsonObject message;
+      while(WorkerProtocol::TakeMessage(buffer, message))
+      {
+        messages.push_back(message);
+      }
+    }
+
+    DREAM3D_REQUIRE_EQUAL(messages.size(), 2)
+    DREAM3D_REQUIRE(messages[0] == first)
+    DREAM3D_REQUIRE(messages[1] == second)
+    DREAM3D_REQUIRE(buffer.isEmpty())
+
+    QJsonObject message;
+    buffer = WorkerProtocol::Frame(first).left(3);
+    DREAM3D_REQUIRE(!WorkerProtocol::TakeMessage(buffer, message))
+    DREAM3D_REQUIRE_EQUAL(buffer.size(), 3)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestMessages()
+  {
+    PipelineMessage msg("ReadAngData", "Could not open the file", -1000, PipelineMessage::MessageType::Error, 3);
+    msg.setFilterHumanLabel("Import EDAX EBSD Data (.ang)");
+    msg.setProgressValue(40);
+
+    PipelineMessage copy = WorkerProtocol::MessageFromJson(WorkerProtocol::MessageToJson(msg));
+    DREAM3D_REQUIRE(copy.getFilterClassName() == msg.getFilterClassName())
+    DREAM3D_REQUIRE(copy.getFilterHumanLabel() == msg.getFilterHumanLabel())
+    DREAM3D_REQUIRE(copy.getText() == msg.getText())
+    DREAM3D_REQUIRE_EQUAL(copy.getCode(), msg.getCode())
+    DREAM3D_REQUIRE(copy.getType() == msg.getType())
+    DREAM3D_REQUIRE_EQUAL(copy.getPipelineIndex(), msg.getPipelineIndex())
+    DREAM3D_REQUIRE_EQUAL(copy.getProgressValue(), msg.getProgressValue())
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestArrayRoundTrip()
+  {
+    QTemporaryDir tempDir;
+    DREAM3D_REQUIRE(tempDir.isValid())
+
+    QString error;
+    QJsonObject manifest = WorkerProtocol::ExportArrays(createResult(), tempDir.filePath("Run_1"), error);
+    DREAM3D_REQUIRE(!manifest.isEmpty())
+    DREAM3D_REQUIRE(error.isEmpty())
+
+    DataContainerArray::Pointer dca = createPreflight();
+    DREAM3D_REQUIRE_EQUAL(WorkerProtocol::ImportArrays(manifest, dca, error), 3)
+    DREAM3D_REQUIRE(error.isEmpty())
+
+    AttributeMatrix::Pointer cellData = dca->getDataContainer("DataContainer")->getAttributeMatrix("CellData");
+    FloatArrayType::Pointer a = std::dynamic_pointer_cast<FloatArrayType>(cellData->getAttributeArray("A"));
+    Int32ArrayType::Pointer b = std::dynamic_pointer_cast<Int32ArrayType>(cellData->getAttributeArray("B"));
+    DREAM3D_REQUIRE(a.get() != nullptr)
+    DREAM3D_REQUIRE(b.get() != nullptr)
+    DREAM3D_REQUIRE_EQUAL(a->getNumberOfTuples(), k_Tuples)
+    for(size_t i = 0; i < k_Tuples; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(a->getComponent(i, 1), static_cast<float>(i) * 0.5f)
+      DREAM3D_REQUIRE_EQUAL(a->getComponent(i, 2), -static_cast<float>(i))
+      DREAM3D_REQUIRE_EQUAL(b->getValue(i), static_cast<int32_t>(i * 7))
+    }
+
+    // The feature matrix takes the worker's size, including the empty array
+    AttributeMatrix::Pointer featureData = dca->getDataContainer("DataContainer")->getAttributeMatrix("FeatureData");
+    DREAM3D_REQUIRE_EQUAL(featureData->getNumberOfTuples(), 0)
+    DREAM3D_REQUIRE(featureData->getAttributeArray("Sizes").get() != nullptr)
+    DREAM3D_REQUIRE_EQUAL(featureData->getAttributeArray("Sizes")->getNumberOfTuples(), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestSkippedArraysAreRemoved()
+  {
+    QTemporaryDir tempDir;
+    DREAM3D_REQUIRE(tempDir.isValid())
+
+    QString error;
+    QJsonObject manifest = WorkerProtocol::ExportArrays(createResult(), tempDir.filePath("Run_2"), error);
+    DREAM3D_REQUIRE(!manifest.isEmpty())
+
+    // "B" has another type than in the worker and "C" is not in the worker's result at all
+    DataContainerArray::Pointer dca = createPreflight();
+    AttributeMatrix::Pointer cellData = dca->getDataContainer("DataContainer")->getAttributeMatrix("CellData");
+    cellData->removeAttributeArray("B");
+    cellData->addAttributeArray("B", DoubleArrayType::CreateArray(k_Tuples, QVector<size_t>(1, 1), "B", false));
+    cellData->addAttributeArray("C", DoubleArrayType::CreateArray(k_Tuples, QVector<size_t>(1, 1), "C", false));
+
+    DREAM3D_REQUIRE_EQUAL(WorkerProtocol::ImportArrays(manifest, dca, error), 2)
+    DREAM3D_REQUIRE(error.contains("B"))
+    DREAM3D_REQUIRE(cellData->getAttributeArray("A").get() != nullptr)
+    DREAM3D_REQUIRE(cellData->getAttributeArray("B").get() == nullptr)
+    DREAM3D_REQUIRE(cellData->getAttributeArray("C").get() == nullptr)
+
+    // A file that went missing fails its array only
+    QDir(manifest["Directory"].toString()).removeRecursively();
+    dca = createPreflight();
+    error.clear();
+    DREAM3D_REQUIRE_EQUAL(WorkerProtocol::ImportArrays(manifest, dca, error), 1)
+    DREAM3D_REQUIRE(!error.isEmpty())
+    cellData = dca->getDataContainer("DataContainer")->getAttributeMatrix("CellData");
+    DREAM3D_REQUIRE_EQUAL(cellData->getAttributeArrayNames().size(), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "#### WorkerProtocolTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFraming())
+    DREAM3D_REGISTER_TEST(TestMessages())
+    DREAM3D_REGISTER_TEST(TestArrayRoundTrip())
+    DREAM3D_REGISTER_TEST(TestSkippedArraysAreRemoved())
+  }
+
+private:
+  WorkerProtocolTest(const WorkerProtocolTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const WorkerProtocolTest&) = delete;     // Move assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QStandardPaths::setTestModeEnabled(true);
+
+  int err = EXIT_SUCCESS;
+  WorkerProtocolTest test;
+  test();
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
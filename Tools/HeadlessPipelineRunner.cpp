@@ -0,0 +1,872 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QRunnable>
+#include <QtCore/QSet>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+
+#if SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLView/ArrayLiveness.h"
+#include "SIMPLView/ArraySpiller.h"
+#include "SIMPLView/DirectoryWatcher.h"
+#include "SIMPLView/MemoryEstimator.h"
+#include "SIMPLView/ParameterSweep.h"
+#include "SIMPLView/PipelineEta.h"
+#include "SIMPLView/ProcessStats.h"
+
+#include "BrandedStrings.h"
+
+namespace
+{
+const int k_MemoryLimitErrorCode = -70001;
+const int k_MemoryLimitExitCode = 3;
+
+/**
+ * @brief The ResidentMemoryLimit class enforces --memory-limit on the resident memory of this process,
+ * sampled on a background thread. An address space cap would fail on the large reservations that
+ * allocators and TBB make without touching them, and would not stop a run that actually pages.
+ * Once the limit is crossed the current filter is cancelled. If the filter does not return and the
+ * process is still over the limit after a grace period, the process exits.
+ */
+class ResidentMemoryLimit
+{
+public:
+  ResidentMemoryLimit(qint64 limitBytes)
+  : m_LimitBytes(limitBytes)
+  {
+  }
+
+  ~ResidentMemoryLimit()
+  {
+    stop();
+  }
+
+  void start()
+  {
+    m_Running = true;
+    m_Thread = std::thread([this] {
+      std::chrono::steady_clock::time_point exceededAt;
+      while(m_Running)
+      {
+        qint64 resident = ProcessStats::ResidentBytes();
+        if(resident > m_LimitBytes)
+        {
+          if(!m_Exceeded.exchange(true))
+          {
+            exceededAt = std::chrono::steady_clock::now();
+            std::cerr << "Resident memory of " << resident / (1024 * 1024) << " MB exceeds the memory limit of " << m_LimitBytes / (1024 * 1024) << " MB" << std::endl;
+          }
+          AbstractFilter* filter = m_CurrentFilter;
+          if(filter != nullptr)
+          {
+            filter->setCancel(true);
+          }
+          if(std::chrono::steady_clock::now() - exceededAt > std::chrono::milliseconds(k_GraceMSecs))
+          {
+            std::cerr << "The run did not stop within " << k_GraceMSecs << " ms of exceeding the memory limit" << std::endl;
+            std::_Exit(k_MemoryLimitExitCode);
+          }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(k_IntervalMSecs));
+      }
+    });
+  }
+
+  void stop()
+  {
+    if(m_Thread.joinable())
+    {
+      m_Running = false;
+      m_Thread.join();
+    }
+  }
+
+  /**
+   * @brief setCurrentFilter Sets the filter that is cancelled when the limit is crossed. The filter
+   * must stay alive until it is replaced or the limit is stopped.
+   */
+  void setCurrentFilter(AbstractFilter* filter)
+  {
+    m_CurrentFilter = filter;
+  }
+
+  bool wasExceeded() const
+  {
+    return m_Exceeded;
+  }
+
+private:
+  static const int k_IntervalMSecs = 20;
+  static const int k_GraceMSecs = 2000;
+
+  qint64 m_LimitBytes = 0;
+  std::atomic<bool> m_Running{false};
+  std::atomic<bool> m_Exceeded{false};
+  std::atomic<AbstractFilter*> m_CurrentFilter{nullptr};
+  std::thread m_Thread;
+
+  ResidentMemoryLimit(const ResidentMemoryLimit&) = delete; // Copy Constructor Not Implemented
+  void operator=(const ResidentMemoryLimit&) = delete;      // Move assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void printMessage(const PipelineMessage& msg)
+{
+  switch(msg.getType())
+  {
+  case PipelineMessage::MessageType::Error:
+    std::cerr << "Error (" << msg.getCode() << "): " << msg.generateErrorString().toStdString() << std::endl;
+    break;
+  case PipelineMessage::MessageType::Warning:
+    std::cerr << "Warning (" << msg.getCode() << "): " << msg.generateWarningString().toStdString() << std::endl;
+    break;
+  case PipelineMessage::MessageType::StandardOutputMessage:
+    std::cout << msg.getText().toStdString() << std::endl;
+    break;
+  default:
+    break;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Preflights every filter on its own copy of the structure, as the GUI does, so that the estimators
+// see the structure each filter starts from rather than the one the last filter leaves behind
+// -----------------------------------------------------------------------------
+int preflightFilters(const FilterPipeline::FilterContainerType& filters)
+{
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  int err = 0;
+  for(AbstractFilter::Pointer filter : filters)
+  {
+    if(!filter->getEnabled())
+    {
+      continue;
+    }
+    QMetaObject::Connection connection = QObject::connect(filter.get(), &AbstractFilter::filterGeneratedMessage, printMessage);
+    filter->setDataContainerArray(dca->deepCopy(true));
+    filter->preflight();
+    QObject::disconnect(connection);
+    err = filter->getErrorCondition();
+    if(err < 0)
+    {
+      std::cerr << filter->getHumanLabel().toStdString() << " failed to preflight with error " << err << std::endl;
+      break;
+    }
+    dca = filter->getDataContainerArray();
+  }
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+// Prints the memory a run would need without executing anything
+// -----------------------------------------------------------------------------
+int runEstimate(const FilterPipeline::Pointer& pipeline, bool keepAllArrays, qint64 memoryLimitMB, QJsonObject& report)
+{
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+  int err = preflightFilters(filters);
+  report["Preflight Error Code"] = err;
+  if(err < 0)
+  {
+    return 1;
+  }
+
+  ArrayLiveness::Pointer liveness = ArrayLiveness::New();
+  liveness->analyze(filters);
+  QVector<ArrayLiveness::DeadArray> freedArrays;
+  if(!keepAllArrays)
+  {
+    freedArrays = liveness->getPlan();
+  }
+  MemoryEstimator::Estimate estimate = MemoryEstimator::EstimatePipeline(filters, freedArrays);
+  qint64 availableBytes = ProcessStats::AvailableMemoryBytes();
+
+  for(const QString& line : MemoryEstimator::Timeline(estimate))
+  {
+    std::cout << "  " << line.toStdString() << std::endl;
+  }
+  std::cout << MemoryEstimator::Summary(estimate, availableBytes).toStdString() << std::endl;
+  std::cout << "Estimated peak bytes: " << estimate.peakBytes << std::endl;
+  if(memoryLimitMB > 0 && estimate.peakBytes > memoryLimitMB * 1024 * 1024)
+  {
+    std::cerr << "The estimate exceeds the memory limit of " << memoryLimitMB << " MB" << std::endl;
+  }
+
+  report["Memory Estimate"] = MemoryEstimator::ToJson(estimate, availableBytes);
+
+  PipelineEta::Pointer eta = PipelineEta::New();
+  eta->setPipeline(filters);
+  if(eta->hasHistory())
+  {
+    std::cout << "Estimated run time: " << (eta->isLowerBound() ? "at least " : "") << PipelineEta::FormatDuration(eta->remainingMSecs()).toStdString() << std::endl;
+  }
+  report["ETA"] = eta->toJson();
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Runs the pipeline once per grid point and prints a table that compares the points
+// -----------------------------------------------------------------------------
+int runSweep(const QString& pipelineFile, const QStringList& specs, int concurrency, QJsonObject& report)
+{
+  ParameterSweep::Pointer sweep = ParameterSweep::New();
+  QString error;
+  if(!sweep->setPipelineFile(pipelineFile, error))
+  {
+    std::cerr << error.toStdString() << std::endl;
+    return 1;
+  }
+  for(const QString& spec : specs)
+  {
+    ParameterSweep::Dimension dimension;
+    if(!ParameterSweep::ParseDimension(spec, dimension, error) || !sweep->addDimension(dimension, error))
+    {
+      std::cerr << error.toStdString() << std::endl;
+      return 1;
+    }
+  }
+  sweep->setMaxConcurrentPoints(concurrency);
+  sweep->setRunnerExecutable(QCoreApplication::applicationFilePath());
+
+  std::cout << "Sweeping " << sweep->getPointCount() << " points, the first " << sweep->getSharedPrefixLength() << " filters are shared" << std::endl;
+  if(!sweep->execute(error))
+  {
+    std::cerr << error.toStdString() << std::endl;
+    return 1;
+  }
+  report["Sweep"] = sweep->toJson();
+
+  // Only the attribute matrices whose size differs between the points say something about the parameters
+  QVector<ParameterSweep::PointResult> results = sweep->getResults();
+  QStringList varyingCounts;
+  for(const ParameterSweep::PointResult& result : results)
+  {
+    for(const QString& key : result.tupleCounts.keys())
+    {
+      if(!varyingCounts.contains(key) && result.tupleCounts[key] != results.front().tupleCounts.value(key, -1))
+      {
+        varyingCounts.push_back(key);
+      }
+    }
+  }
+
+  std::cout << "Shared filters: " << sweep->getPrefixWallTimeMSecs() << " ms" << std::endl;
+  std::cout << "#";
+  for(const ParameterSweep::Dimension& dimension : sweep->getDimensions())
+  {
+    std::cout << "\t" << dimension.path.toStdString();
+  }
+  std::cout << "\tError\tTime (ms)";
+  for(const QString& key : varyingCounts)
+  {
+    std::cout << "\t" << key.toStdString();
+  }
+  std::cout << std::endl;
+
+  int failedPoints = 0;
+  for(const ParameterSweep::PointResult& result : results)
+  {
+    std::cout << result.index;
+    for(const QJsonValue& value : result.values)
+    {
+      std::cout << "\t" << value.toVariant().toString().toStdString();
+    }
+    std::cout << "\t" << result.errorCode << "\t" << result.wallTimeMSecs;
+    for(const QString& key : varyingCounts)
+    {
+      std::cout << "\t" << result.tupleCounts.value(key, 0);
+    }
+    std::cout << std::endl;
+
+    if(result.errorCode < 0 || !result.message.isEmpty())
+    {
+      failedPoints++;
+      std::cerr << "Point " << result.index << ": " << result.message.toStdString() << std::endl;
+    }
+  }
+
+  return (failedPoints > 0) ? 1 : 0;
+}
+
+// -----------------------------------------------------------------------------
+// Executes one run of the directory watch on the thread pool and hands the
+// result back to the watcher on the main thread
+// -----------------------------------------------------------------------------
+class WatchRun : public QRunnable
+{
+public:
+  WatchRun(DirectoryWatcher* watcher, int id, const QString& pipelineFilePath)
+  : m_Watcher(watcher)
+  , m_Id(id)
+  , m_PipelineFilePath(pipelineFilePath)
+  {
+  }
+
+  void run() override
+  {
+    int err = -1;
+    QString message;
+    JsonFilterParametersReader::Pointer jsonReader = JsonFilterParametersReader::New();
+    FilterPipeline::Pointer pipeline = jsonReader->readPipelineFromFile(m_PipelineFilePath);
+    if(nullptr == pipeline.get())
+    {
+      message = QString("Could not read the pipeline file %1").arg(m_PipelineFilePath);
+    }
+    else
+    {
+      err = pipeline->preflightPipeline();
+      if(err < 0)
+      {
+        message = QString("The pipeline failed to preflight with error %1").arg(err);
+      }
+      else
+      {
+        pipeline->execute();
+        for(AbstractFilter::Pointer filter : pipeline->getFilterContainer())
+        {
+          if(filter->getErrorCondition() < 0)
+          {
+            err = filter->getErrorCondition();
+            message = QString("%1 failed with error %2").arg(filter->getHumanLabel()).arg(err);
+            break;
+          }
+        }
+      }
+    }
+
+    QMetaObject::invokeMethod(m_Watcher, "runFinished", Qt::QueuedConnection, Q_ARG(int, m_Id), Q_ARG(int, err), Q_ARG(QString, message));
+  }
+
+private:
+  DirectoryWatcher* m_Watcher = nullptr;
+  int m_Id = 0;
+  QString m_PipelineFilePath;
+};
+
+// -----------------------------------------------------------------------------
+// Runs the pipeline for every file that settles in the directory until the
+// run limit is reached. The plugins stay loaded between the runs.
+// -----------------------------------------------------------------------------
+int runWatch(QCoreApplication& app, const QString& pipelineFile, const QString& dirPath, const QCommandLineParser& parser, QJsonObject& report)
+{
+  DirectoryWatcher watcher;
+  QString error;
+  if(!watcher.setPipelineFile(pipelineFile, error))
+  {
+    std::cerr << error.toStdString() << std::endl;
+    return 1;
+  }
+
+  QString inputParameter = parser.value("watch-parameter");
+  if(inputParameter.isEmpty())
+  {
+    QStringList fileParameters = DirectoryWatcher::FindFileParameters(watcher.getPipelineJson());
+    for(const QString& parameter : fileParameters)
+    {
+      if(parameter.contains("Input", Qt::CaseInsensitive))
+      {
+        inputParameter = parameter;
+        break;
+      }
+    }
+    if(inputParameter.isEmpty())
+    {
+      std::cerr << "--watch-parameter is needed, the pipeline has these file parameters: " << fileParameters.join(", ").toStdString() << std::endl;
+      return 1;
+    }
+  }
+  if(!watcher.setInputParameter(inputParameter, error) || !watcher.setOutputParameter(parser.value("watch-output-parameter"), error))
+  {
+    std::cerr << error.toStdString() << std::endl;
+    return 1;
+  }
+
+  // The runs share this process and HDF5 is not thread safe, so by default one file is processed at a time
+  int concurrency = 1;
+  if(parser.isSet("watch-concurrency"))
+  {
+    concurrency = qMax(1, parser.value("watch-concurrency").toInt());
+  }
+  int settleMSecs = DirectoryWatcher::DefaultSettleMSecs;
+  if(parser.isSet("watch-settle-ms"))
+  {
+    settleMSecs = qMax(0, parser.value("watch-settle-ms").toInt());
+  }
+  int limit = 0;
+  if(parser.isSet("watch-limit"))
+  {
+    limit = qMax(0, parser.value("watch-limit").toInt());
+  }
+
+  watcher.setOutputDirectory(parser.value("watch-output-dir"));
+  watcher.setNameFilters(parser.values("watch-filter"));
+  watcher.setSettleMSecs(settleMSecs);
+  watcher.setMaxInFlight(concurrency);
+  watcher.setProcessExistingFiles(parser.isSet("watch-existing"));
+
+  // The runs get their own pool so that they do not take the threads the filters parallelize over
+  QThreadPool runPool;
+  runPool.setMaxThreadCount(concurrency);
+
+  QSet<int> reportedRuns;
+  int failedRuns = 0;
+  QObject::connect(&watcher, &DirectoryWatcher::runReady, [&](int id, const QString& inputFilePath, const QString& runPipelineFile) {
+    std::cout << "Queued " << inputFilePath.toStdString() << std::endl;
+    runPool.start(new WatchRun(&watcher, id, runPipelineFile));
+  });
+  QObject::connect(&watcher, &DirectoryWatcher::runsChanged, [&]() {
+    for(const DirectoryWatcher::Run& run : watcher.getRuns())
+    {
+      if(run.finishedMSecs == 0 || reportedRuns.contains(run.id))
+      {
+        continue;
+      }
+      reportedRuns.insert(run.id);
+      if(run.status == DirectoryWatcher::RunStatus::Failed)
+      {
+        failedRuns++;
+        std::cerr << "Failed " << run.inputFilePath.toStdString() << ": " << run.message.toStdString() << std::endl;
+      }
+      else
+      {
+        std::cout << "Completed " << run.inputFilePath.toStdString() << " in " << (run.finishedMSecs - run.startedMSecs) << " ms" << std::endl;
+      }
+    }
+
+    if(limit > 0 && reportedRuns.size() >= limit)
+    {
+      watcher.stop();
+      app.quit();
+    }
+  });
+
+  QString watchDir = QFileInfo(dirPath).absoluteFilePath();
+  if(!watcher.start(watchDir, error))
+  {
+    std::cerr << error.toStdString() << std::endl;
+    return 1;
+  }
+  std::cout << "Watching " << QDir::toNativeSeparators(watchDir).toStdString() << " with " << concurrency << " concurrent runs" << std::endl;
+  app.exec();
+  runPool.waitForDone();
+
+  QJsonArray runReports;
+  for(const DirectoryWatcher::Run& run : watcher.getRuns())
+  {
+    QJsonObject runReport;
+    runReport["Input"] = run.inputFilePath;
+    runReport["Output"] = run.outputFilePath;
+    runReport["Status"] = DirectoryWatcher::StatusString(run.status);
+    runReport["Latency MSecs"] = (run.finishedMSecs > 0) ? run.finishedMSecs - run.detectedMSecs : 0;
+    runReport["Wall Time MSecs"] = (run.finishedMSecs > 0) ? run.finishedMSecs - run.startedMSecs : 0;
+    runReport["Error Code"] = run.errorCode;
+    runReports.append(runReport);
+  }
+  QJsonObject watchReport;
+  watchReport["Directory"] = watchDir;
+  watchReport["Input Parameter"] = inputParameter;
+  watchReport["Concurrency"] = concurrency;
+  watchReport["Runs"] = runReports;
+  report["Watch"] = watchReport;
+
+  return (failedRuns > 0) ? 1 : 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool writeReport(const QString& filePath, const QJsonObject& report)
+{
+  QSaveFile file(filePath);
+  if(!file.open(QIODevice::WriteOnly))
+  {
+    std::cerr << "Could not open the report file " << filePath.toStdString() << std::endl;
+    return false;
+  }
+  file.write(QJsonDocument(report).toJson());
+  return file.commit();
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationDomain(BrandedStrings::OrganizationDomain);
+  QCoreApplication::setOrganizationName(BrandedStrings::OrganizationName);
+  QCoreApplication::setApplicationName("HeadlessPipelineRunner");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Executes a pipeline file without a display");
+  parser.addHelpOption();
+  parser.addPositionalArgument("pipeline", "The pipeline JSON file to execute");
+  QCommandLineOption threadsOption("threads", "Maximum number of threads the filters may use", "count");
+  QCommandLineOption memoryLimitOption("memory-limit", "Maximum resident memory this process may use, in megabytes. The running filter is cancelled once it is crossed.", "MB");
+  QCommandLineOption jsonReportOption("json-report", "Write per-filter wall time and peak memory to this file", "file");
+  QCommandLineOption memoryBudgetOption("memory-budget", "Spill attribute arrays to scratch files while they hold more than this, in megabytes", "MB");
+  QCommandLineOption scratchDirOption("scratch-dir", "Directory for the arrays spilled under --memory-budget", "dir");
+  parser.addOption(threadsOption);
+  parser.addOption(memoryLimitOption);
+  parser.addOption(memoryBudgetOption);
+  parser.addOption(scratchDirOption);
+  QCommandLineOption keepAllArraysOption("keep-all-arrays", "Keep every attribute array until the end instead of freeing it behind its last use");
+  parser.addOption(keepAllArraysOption);
+  QCommandLineOption estimateOnlyOption("estimate-only", "Preflight the pipeline and print the memory and the time a run would need instead of executing it");
+  parser.addOption(estimateOnlyOption);
+  QCommandLineOption sweepOption("sweep", "Sweep a parameter, e.g. 3/MinAllowedFeatureSize=10:50:10 or 3/MinAllowedFeatureSize=8,16,32. "
+                                         "Give the option once per parameter to sweep a grid.",
+                                 "path=values");
+  QCommandLineOption sweepConcurrencyOption("sweep-concurrency", "Number of sweep points that run at the same time", "count");
+  parser.addOption(jsonReportOption);
+  parser.addOption(sweepOption);
+  parser.addOption(sweepConcurrencyOption);
+  QCommandLineOption watchOption("watch", "Run the pipeline for every new file that appears in this directory", "dir");
+  QCommandLineOption watchParameterOption("watch-parameter", "The file parameter that receives each new file, e.g. 0/InputFile", "path");
+  QCommandLineOption watchFilterOption("watch-filter", "Only watch files that match this wildcard, e.g. *.ang. May be given more than once.", "pattern");
+  QCommandLineOption watchOutputParameterOption("watch-output-parameter", "The file parameter that is named after each new file, e.g. 7/OutputFile", "path");
+  QCommandLineOption watchOutputDirOption("watch-output-dir", "Directory for the files named by --watch-output-parameter", "dir");
+  QCommandLineOption watchConcurrencyOption("watch-concurrency", "Number of files that are processed at the same time, 1 unless the pipeline does not use HDF5", "count");
+  QCommandLineOption watchSettleOption("watch-settle-ms", "How long a file must stay unchanged before it is processed", "ms");
+  QCommandLineOption watchExistingOption("watch-existing", "Also process the files that are in the directory when the watch starts");
+  QCommandLineOption watchLimitOption("watch-limit", "Stop after this many files have been processed", "count");
+  parser.addOption(watchOption);
+  parser.addOption(watchParameterOption);
+  parser.addOption(watchFilterOption);
+  parser.addOption(watchOutputParameterOption);
+  parser.addOption(watchOutputDirOption);
+  parser.addOption(watchConcurrencyOption);
+  parser.addOption(watchSettleOption);
+  parser.addOption(watchExistingOption);
+  parser.addOption(watchLimitOption);
+  parser.process(app);
+
+  QStringList positionalArgs = parser.positionalArguments();
+  if(positionalArgs.size() != 1)
+  {
+    parser.showHelp(1);
+  }
+  QString pipelineFile = QFileInfo(positionalArgs[0]).absoluteFilePath();
+
+  int threads = QThread::idealThreadCount();
+  if(parser.isSet(threadsOption))
+  {
+    bool ok = false;
+    threads = parser.value(threadsOption).toInt(&ok);
+    if(!ok || threads < 1)
+    {
+      std::cerr << "--threads expects a positive number" << std::endl;
+      return 1;
+    }
+  }
+  QThreadPool::globalInstance()->setMaxThreadCount(threads);
+#if SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init taskSchedulerInit(threads);
+#endif
+
+  qint64 memoryLimitMB = 0;
+  if(parser.isSet(memoryLimitOption))
+  {
+    bool ok = false;
+    memoryLimitMB = parser.value(memoryLimitOption).toLongLong(&ok);
+    if(!ok || memoryLimitMB < 1)
+    {
+      std::cerr << "--memory-limit expects a positive number of megabytes" << std::endl;
+      return 1;
+    }
+  }
+  std::unique_ptr<ResidentMemoryLimit> memoryLimit;
+  if(memoryLimitMB > 0 && !parser.isSet(estimateOnlyOption))
+  {
+    memoryLimit.reset(new ResidentMemoryLimit(memoryLimitMB * 1024 * 1024));
+    memoryLimit->start();
+  }
+
+  ArraySpiller::Pointer spiller = ArraySpiller::New();
+  if(parser.isSet(memoryBudgetOption))
+  {
+    bool ok = false;
+    qint64 memoryBudgetMB = parser.value(memoryBudgetOption).toLongLong(&ok);
+    if(!ok || memoryBudgetMB < 1)
+    {
+      std::cerr << "--memory-budget expects a positive number of megabytes" << std::endl;
+      return 1;
+    }
+    spiller->setBudgetMB(memoryBudgetMB);
+  }
+  if(parser.isSet(scratchDirOption))
+  {
+    spiller->setScratchDirectory(QFileInfo(parser.value(scratchDirOption)).absoluteFilePath());
+  }
+  spiller->setActivityHandler([](const QString& activity) { std::cout << "  " << activity.toStdString() << std::endl; });
+
+  ArrayLiveness::Pointer liveness = ArrayLiveness::New();
+  liveness->setKeepEverything(parser.isSet(keepAllArraysOption));
+
+  QElapsedTimer totalTimer;
+  totalTimer.start();
+
+  // Only the filters are registered. None of the plugins' widgets are needed without a GUI.
+  QElapsedTimer pluginTimer;
+  pluginTimer.start();
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm, true);
+  QMetaObjectUtilities::RegisterMetaTypes();
+  qint64 pluginLoadMSecs = pluginTimer.elapsed();
+
+  JsonFilterParametersReader::Pointer jsonReader = JsonFilterParametersReader::New();
+  FilterPipeline::Pointer pipeline = jsonReader->readPipelineFromFile(pipelineFile);
+  if(nullptr == pipeline.get())
+  {
+    std::cerr << "Could not read the pipeline file " << pipelineFile.toStdString() << std::endl;
+    return 1;
+  }
+
+  QJsonObject report;
+  report["Pipeline"] = pipelineFile;
+  report["Threads"] = threads;
+  report["Memory Limit MB"] = memoryLimitMB;
+  report["Plugin Load Time MSecs"] = pluginLoadMSecs;
+
+  if(parser.isSet(estimateOnlyOption))
+  {
+    int estimateErr = runEstimate(pipeline, parser.isSet(keepAllArraysOption), memoryLimitMB, report);
+    report["Total Wall Time MSecs"] = totalTimer.elapsed();
+    if(parser.isSet(jsonReportOption) && !writeReport(parser.value(jsonReportOption), report))
+    {
+      return 1;
+    }
+    return estimateErr;
+  }
+
+  if(parser.isSet(sweepOption))
+  {
+    int sweepConcurrency = qMax(1, threads / 4);
+    if(parser.isSet(sweepConcurrencyOption))
+    {
+      sweepConcurrency = qMax(1, parser.value(sweepConcurrencyOption).toInt());
+    }
+    int sweepErr = runSweep(pipelineFile, parser.values(sweepOption), sweepConcurrency, report);
+    report["Total Wall Time MSecs"] = totalTimer.elapsed();
+    if(parser.isSet(jsonReportOption) && !writeReport(parser.value(jsonReportOption), report))
+    {
+      return 1;
+    }
+    return sweepErr;
+  }
+
+  if(parser.isSet(watchOption))
+  {
+    int watchErr = runWatch(app, pipelineFile, parser.value(watchOption), parser, report);
+    report["Total Wall Time MSecs"] = totalTimer.elapsed();
+    if(parser.isSet(jsonReportOption) && !writeReport(parser.value(jsonReportOption), report))
+    {
+      return 1;
+    }
+    return watchErr;
+  }
+
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+  int err = preflightFilters(filters);
+  report["Preflight Error Code"] = err;
+  if(err < 0)
+  {
+    std::cerr << "The pipeline failed to preflight with error " << err << std::endl;
+  }
+
+  // The filters are executed one at a time here, rather than through FilterPipeline::execute(),
+  // so that each one can be timed and its memory sampled
+  QJsonArray filterReports;
+  qint64 pipelinePeakBytes = ProcessStats::ResidentBytes();
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  liveness->analyze(filters);
+  liveness->setPipeline(filters);
+  spiller->setPipeline(filters);
+  PipelineEta::Pointer eta = PipelineEta::New();
+  eta->setPipeline(filters);
+  eta->start();
+  for(int i = 0; i < filters.size() && err >= 0; i++)
+  {
+    AbstractFilter::Pointer filter = filters[i];
+    if(!filter->getEnabled())
+    {
+      continue;
+    }
+
+    std::cout << "[" << (i + 1) << "/" << filters.size() << "] " << filter->getHumanLabel().toStdString() << std::endl;
+
+    filter->setDataContainerArray(dca);
+    QMetaObject::Connection connection = QObject::connect(filter.get(), &AbstractFilter::filterGeneratedMessage, printMessage);
+
+    qint64 residentBefore = ProcessStats::ResidentBytes();
+    ProcessSampler sampler;
+    sampler.start();
+    QElapsedTimer filterTimer;
+    filterTimer.start();
+
+    if(memoryLimit)
+    {
+      memoryLimit->setCurrentFilter(filter.get());
+    }
+    liveness->beginFilter(filter.get());
+    spiller->beginFilter(filter.get());
+    filter->execute();
+    liveness->endFilter(filter.get());
+    spiller->endFilter(filter.get());
+    if(memoryLimit)
+    {
+      memoryLimit->setCurrentFilter(nullptr);
+    }
+
+    qint64 wallTimeMSecs = filterTimer.elapsed();
+    sampler.stop();
+    qint64 peakBytes = sampler.getPeakResidentBytes();
+    pipelinePeakBytes = qMax(pipelinePeakBytes, peakBytes);
+    QObject::disconnect(connection);
+
+    err = filter->getErrorCondition();
+    if(memoryLimit && memoryLimit->wasExceeded() && err >= 0)
+    {
+      err = k_MemoryLimitErrorCode;
+    }
+
+    QJsonObject filterReport;
+    filterReport["Index"] = i;
+    filterReport["Class Name"] = filter->getNameOfClass();
+    filterReport["Human Label"] = filter->getHumanLabel();
+    filterReport["Wall Time MSecs"] = wallTimeMSecs;
+    filterReport["Peak Memory Bytes"] = peakBytes;
+    filterReport["Memory Delta Bytes"] = ProcessStats::ResidentBytes() - residentBefore;
+    filterReport["Error Code"] = err;
+    filterReports.append(filterReport);
+
+    if(err < 0)
+    {
+      std::cerr << filter->getHumanLabel().toStdString() << " failed with error " << err << std::endl;
+    }
+    else
+    {
+      eta->filterFinished(i, wallTimeMSecs);
+      if(eta->hasHistory())
+      {
+        std::cout << "  " << eta->statusText().toStdString() << std::endl;
+      }
+    }
+  }
+
+  eta->finishRun();
+  std::cout << eta->summary().toStdString() << std::endl;
+  report["ETA"] = eta->toJson();
+
+  liveness->finishRun();
+  std::cout << liveness->summary().toStdString() << std::endl;
+  report["Array Liveness"] = liveness->toJson();
+
+  if(spiller->getBudgetMB() > 0)
+  {
+    spiller->finishRun();
+    std::cout << spiller->summary().toStdString() << std::endl;
+    report["Memory Budget"] = spiller->toJson();
+  }
+
+  if(memoryLimit)
+  {
+    memoryLimit->stop();
+    report["Memory Limit Exceeded"] = memoryLimit->wasExceeded();
+  }
+
+  // A parameter sweep compares its points by these
+  QJsonObject tupleCounts;
+  for(DataContainer::Pointer dc : dca->getDataContainers())
+  {
+    for(AttributeMatrix::Pointer am : dc->getAttributeMatrices())
+    {
+      tupleCounts[dc->getName() + "/" + am->getName()] = static_cast<qint64>(am->getNumberOfTuples());
+    }
+  }
+  report["Tuple Counts"] = tupleCounts;
+
+  // Release the data before the totals are taken
+  for(AbstractFilter::Pointer filter : filters)
+  {
+    filter->setDataContainerArray(DataContainerArray::NullPointer());
+  }
+  dca = DataContainerArray::NullPointer();
+
+  report["Filters"] = filterReports;
+  report["Error Code"] = err;
+  report["Peak Memory Bytes"] = pipelinePeakBytes;
+  report["Total Wall Time MSecs"] = totalTimer.elapsed();
+
+  if(parser.isSet(jsonReportOption) && !writeReport(parser.value(jsonReportOption), report))
+  {
+    return 1;
+  }
+
+  return (err < 0) ? 1 : 0;
+}
@@ -0,0 +1,422 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QEvent>
+#include <QtCore/QEventLoop>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+#include <QtCore/QTimer>
+
+#include "SIMPLView/PipelineMessageChannel.h"
+
+/*
+ * Measures how busy the GUI thread is while a pipeline floods it with progress, status and standard
+ * output messages. The same message stream is delivered twice: once as one queued event per message,
+ * which is how the pipeline's signals used to reach the window, and once through the
+ * PipelineMessageChannel that the window now drains once per display refresh. The widgets themselves
+ * are not part of the measurement, only the dispatch and the formatting that feeds them.
+ */
+
+namespace
+{
+const QEvent::Type k_MessageEventType = static_cast<QEvent::Type>(QEvent::User + 1);
+const QEvent::Type k_WakeEventType = static_cast<QEvent::Type>(QEvent::User + 2);
+
+struct BenchmarkResult
+{
+  QString mode;
+  qint64 postedMessages = 0;
+  qint64 deliveredMessages = 0;
+  qint64 uiUpdates = 0;
+  qint64 wallTimeMSecs = 0;
+  qint64 busyTimeMSecs = 0;
+  qint64 drainTimeMSecs = 0;
+};
+
+/**
+ * @brief The MessageEvent class carries a single message, like a queued signal does
+ */
+class MessageEvent : public QEvent
+{
+public:
+  MessageEvent(const PipelineMessage& msg)
+  : QEvent(k_MessageEventType)
+  , m_Message(msg)
+  {
+  }
+
+  PipelineMessage m_Message;
+};
+
+/**
+ * @brief The UiSink class stands in for the widgets. It keeps what would have been shown so
+ * that the formatting work can not be optimized away.
+ */
+class UiSink
+{
+public:
+  void setProgress(int value)
+  {
+    m_Progress = value;
+  }
+
+  void showStatus(const QString& status)
+  {
+    m_Status = status;
+  }
+
+  void appendText(const QString& text)
+  {
+    m_Log.append(text);
+    if(m_Log.size() > 1024 * 1024)
+    {
+      m_Log.clear();
+    }
+  }
+
+  int m_Progress = 0;
+  QString m_Status;
+  QString m_Log;
+};
+
+/**
+ * @brief The PerMessageReceiver class handles every message as it arrives
+ */
+class PerMessageReceiver : public QObject
+{
+public:
+  bool event(QEvent* event) override
+  {
+    if(event->type() != k_MessageEventType)
+    {
+      return QObject::event(event);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const PipelineMessage& msg = static_cast<MessageEvent*>(event)->m_Message;
+    if(msg.getType() == PipelineMessage::MessageType::ProgressValue)
+    {
+      m_Sink.setProgress(msg.getProgressValue());
+    }
+    else if(msg.getType() == PipelineMessage::MessageType::StatusMessageAndProgressValue)
+    {
+      m_Sink.setProgress(msg.getProgressValue());
+      m_Sink.showStatus(msg.generateStatusString());
+    }
+    else if(msg.getType() == PipelineMessage::MessageType::StandardOutputMessage)
+    {
+      QString text = "<span style=\" color:#000000;\" >";
+      text.append(msg.getText());
+      text.append("</span>");
+      m_Sink.appendText(text);
+    }
+    m_Delivered++;
+    m_UiUpdates++;
+    m_BusyNSecs += timer.nsecsElapsed();
+    return true;
+  }
+
+  UiSink m_Sink;
+  qint64 m_Delivered = 0;
+  qint64 m_UiUpdates = 0;
+  qint64 m_BusyNSecs = 0;
+};
+
+/**
+ * @brief The ChannelReceiver class drains the channel once per display refresh
+ */
+class ChannelReceiver : public QObject
+{
+public:
+  ChannelReceiver(PipelineMessageChannel* channel)
+  : m_Channel(channel)
+  {
+    m_Timer.setSingleShot(true);
+    m_Timer.setInterval(PipelineMessageChannel::RefreshIntervalMSecs);
+    QObject::connect(&m_Timer, &QTimer::timeout, [this] { flush(); });
+  }
+
+  bool event(QEvent* event) override
+  {
+    if(event->type() != k_WakeEventType)
+    {
+      return QObject::event(event);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    m_Timer.start();
+    m_BusyNSecs += timer.nsecsElapsed();
+    return true;
+  }
+
+  void flush()
+  {
+    QElapsedTimer timer;
+    timer.start();
+    PipelineMessageChannel::Batch batch = m_Channel->take();
+    if(batch.hasProgress)
+    {
+      m_Sink.setProgress(batch.progressValue);
+    }
+    if(batch.hasStatus)
+    {
+      m_Sink.showStatus(batch.status);
+    }
+    if(!batch.lines.isEmpty())
+    {
+      QString text = "<span style=\" color:#000000;\" >";
+      text.append(batch.lines.join("<br>"));
+      text.append("</span>");
+      m_Sink.appendText(text);
+    }
+    m_Delivered += batch.messageCount;
+    m_UiUpdates++;
+    m_BusyNSecs += timer.nsecsElapsed();
+  }
+
+  PipelineMessageChannel* m_Channel = nullptr;
+  QTimer m_Timer;
+  UiSink m_Sink;
+  qint64 m_Delivered = 0;
+  qint64 m_UiUpdates = 0;
+  qint64 m_BusyNSecs = 0;
+};
+
+// -----------------------------------------------------------------------------
+// Mostly per slice progress, with some status and standard output mixed in
+// -----------------------------------------------------------------------------
+PipelineMessage createMessage(qint64 sequence)
+{
+  int kind = static_cast<int>(sequence % 10);
+  if(kind == 0)
+  {
+    PipelineMessage msg("BenchmarkFilter", QString("Processing slice %1").arg(sequence), 0, PipelineMessage::MessageType::StatusMessageAndProgressValue, 0);
+    msg.setProgressValue(static_cast<int>(sequence % 100));
+    return msg;
+  }
+  if(kind == 1)
+  {
+    return PipelineMessage("BenchmarkFilter", QString("Finished slice %1").arg(sequence), 0, PipelineMessage::MessageType::StandardOutputMessage, 0);
+  }
+  PipelineMessage msg("BenchmarkFilter", QString(), 0, PipelineMessage::MessageType::ProgressValue, 0);
+  msg.setProgressValue(static_cast<int>(sequence % 100));
+  return msg;
+}
+
+// -----------------------------------------------------------------------------
+// Posts messages from several threads at a steady total rate
+// -----------------------------------------------------------------------------
+template <typename PostFunction>
+void runProducers(int producerCount, int rate, int seconds, std::atomic<qint64>& posted, PostFunction post)
+{
+  std::vector<std::thread> producers;
+  for(int p = 0; p < producerCount; p++)
+  {
+    producers.emplace_back([=, &posted] {
+      int perMilliSecond = qMax(1, rate / producerCount / 1000);
+      auto start = std::chrono::steady_clock::now();
+      for(int tick = 0; tick < seconds * 1000; tick++)
+      {
+        for(int i = 0; i < perMilliSecond; i++)
+        {
+          post(createMessage(posted++));
+        }
+        std::this_thread::sleep_until(start + std::chrono::milliseconds(tick + 1));
+      }
+    });
+  }
+  for(std::thread& producer : producers)
+  {
+    producer.join();
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Runs the producers while the main thread's event loop delivers, until everything has arrived
+// -----------------------------------------------------------------------------
+template <typename PostFunction, typename DeliveredFunction>
+BenchmarkResult runMode(const QString& mode, int producerCount, int rate, int seconds, PostFunction post, DeliveredFunction delivered)
+{
+  BenchmarkResult result;
+  result.mode = mode;
+
+  std::atomic<qint64> posted{0};
+  std::atomic<bool> producersDone{false};
+  QElapsedTimer wallTimer;
+  wallTimer.start();
+  std::thread driver([&] {
+    runProducers(producerCount, rate, seconds, posted, post);
+    producersDone = true;
+  });
+
+  QEventLoop loop;
+  QElapsedTimer drainTimer;
+  QTimer poll;
+  poll.setInterval(1);
+  QObject::connect(&poll, &QTimer::timeout, [&] {
+    if(!producersDone)
+    {
+      return;
+    }
+    if(!drainTimer.isValid())
+    {
+      drainTimer.start();
+    }
+    if(delivered() >= posted)
+    {
+      loop.quit();
+    }
+  });
+  poll.start();
+  loop.exec();
+  driver.join();
+
+  result.postedMessages = posted;
+  result.wallTimeMSecs = wallTimer.elapsed();
+  result.drainTimeMSecs = drainTimer.elapsed();
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject printResult(const BenchmarkResult& result)
+{
+  double load = (result.wallTimeMSecs > 0) ? 100.0 * result.busyTimeMSecs / result.wallTimeMSecs : 0.0;
+  std::cout << result.mode.toStdString() << ": " << result.postedMessages << " messages, " << result.uiUpdates << " UI updates, "
+            << "UI thread busy " << result.busyTimeMSecs << " ms of " << result.wallTimeMSecs << " ms (" << load << "%), "
+            << "backlog drained " << result.drainTimeMSecs << " ms after the producers stopped" << std::endl;
+
+  QJsonObject json;
+  json["Mode"] = result.mode;
+  json["Posted Messages"] = result.postedMessages;
+  json["Delivered Messages"] = result.deliveredMessages;
+  json["UI Updates"] = result.uiUpdates;
+  json["Wall Time MSecs"] = result.wallTimeMSecs;
+  json["UI Busy Time MSecs"] = result.busyTimeMSecs;
+  json["UI Load Percent"] = load;
+  json["Drain Time MSecs"] = result.drainTimeMSecs;
+  return json;
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("PipelineMessageBenchmark");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Measures the GUI thread load of delivering pipeline messages");
+  parser.addHelpOption();
+  QCommandLineOption rateOption("rate", "Messages per second, 100000 by default", "count", "100000");
+  QCommandLineOption secondsOption("seconds", "How long the producers run, 5 by default", "seconds", "5");
+  QCommandLineOption producersOption("producers", "Number of producing threads, 4 by default", "count", "4");
+  QCommandLineOption jsonReportOption("json-report", "Write the results to this file", "file");
+  parser.addOption(rateOption);
+  parser.addOption(secondsOption);
+  parser.addOption(producersOption);
+  parser.addOption(jsonReportOption);
+  parser.process(app);
+
+  int rate = qMax(1000, parser.value(rateOption).toInt());
+  int seconds = qMax(1, parser.value(secondsOption).toInt());
+  int producerCount = qMax(1, parser.value(producersOption).toInt());
+  std::cout << "Posting " << rate << " messages per second from " << producerCount << " threads for " << seconds << " seconds" << std::endl;
+
+  QJsonArray results;
+
+  {
+    PerMessageReceiver receiver;
+    BenchmarkResult result = runMode("Per message", producerCount, rate, seconds,
+                                     [&receiver](const PipelineMessage& msg) { QCoreApplication::postEvent(&receiver, new MessageEvent(msg)); },
+                                     [&receiver] { return receiver.m_Delivered; });
+    result.deliveredMessages = receiver.m_Delivered;
+    result.uiUpdates = receiver.m_UiUpdates;
+    result.busyTimeMSecs = receiver.m_BusyNSecs / 1000000;
+    results.append(printResult(result));
+  }
+
+  {
+    PipelineMessageChannel channel;
+    ChannelReceiver receiver(&channel);
+    BenchmarkResult result = runMode("Coalesced channel", producerCount, rate, seconds,
+                                     [&channel, &receiver](const PipelineMessage& msg) {
+                                       if(channel.post(msg))
+                                       {
+                                         QCoreApplication::postEvent(&receiver, new QEvent(k_WakeEventType));
+                                       }
+                                     },
+                                     [&receiver] { return receiver.m_Delivered; });
+    result.deliveredMessages = receiver.m_Delivered;
+    result.uiUpdates = receiver.m_UiUpdates;
+    result.busyTimeMSecs = receiver.m_BusyNSecs / 1000000;
+    results.append(printResult(result));
+  }
+
+  if(parser.isSet(jsonReportOption))
+  {
+    QSaveFile file(parser.value(jsonReportOption));
+    if(!file.open(QIODevice::WriteOnly))
+    {
+      std::cerr << "Could not open the report file " << parser.value(jsonReportOption).toStdString() << std::endl;
+      return 1;
+    }
+    QJsonObject report;
+    report["Rate"] = rate;
+    report["Seconds"] = seconds;
+    report["Producers"] = producerCount;
+    report["Results"] = results;
+    file.write(QJsonDocument(report).toJson());
+    file.commit();
+  }
+
+  return 0;
+}
@@ -0,0 +1,382 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QEvent>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTimer>
+
+#include <QtNetwork/QLocalSocket>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+
+#include "SIMPLView/PipelineMessageChannel.h"
+#include "SIMPLView/SIMPLViewConstants.h"
+#include "SIMPLView/WorkerProtocol.h"
+
+#include "BrandedStrings.h"
+
+/*
+ * A worker process of the GUI's WorkerPool. It loads the plugins once, connects to the pool's local
+ * server and then executes one pipeline at a time as the pool sends them. The pipeline runs on a
+ * separate thread so that the socket keeps being served. Errors and warnings are sent as they
+ * happen, progress, status and standard output are coalesced through a PipelineMessageChannel like
+ * they are in the window. The worker quits when the connection to the pool goes away.
+ */
+
+namespace
+{
+const QEvent::Type k_IssueEventType = static_cast<QEvent::Type>(QEvent::User + 1);
+const QEvent::Type k_WakeEventType = static_cast<QEvent::Type>(QEvent::User + 2);
+const QEvent::Type k_FinishedEventType = static_cast<QEvent::Type>(QEvent::User + 3);
+
+// How often coalesced messages are sent to the pool while a pipeline runs
+const int k_FlushIntervalMSecs = 50;
+
+/**
+ * @brief The IssueEvent class carries an error or warning, which the window shows with all its details
+ */
+class IssueEvent : public QEvent
+{
+public:
+  IssueEvent(const PipelineMessage& msg)
+  : QEvent(k_IssueEventType)
+  , m_Message(msg)
+  {
+  }
+
+  PipelineMessage m_Message;
+};
+
+/**
+ * @brief The FinishedEvent class carries the outcome of a pipeline
+ */
+class FinishedEvent : public QEvent
+{
+public:
+  FinishedEvent(int errorCode, const QString& message, const QJsonObject& arrays)
+  : QEvent(k_FinishedEventType)
+  , m_ErrorCode(errorCode)
+  , m_Message(message)
+  , m_Arrays(arrays)
+  {
+  }
+
+  int m_ErrorCode = 0;
+  QString m_Message;
+  QJsonObject m_Arrays;
+};
+
+/**
+ * @brief The WorkerSession class serves the connection to the pool on the main thread
+ */
+class WorkerSession : public QObject
+{
+public:
+  WorkerSession(QLocalSocket* socket)
+  : m_Socket(socket)
+  {
+    m_FlushTimer.setSingleShot(true);
+    m_FlushTimer.setInterval(k_FlushIntervalMSecs);
+    QObject::connect(&m_FlushTimer, &QTimer::timeout, [this] { flushMessages(); });
+    QObject::connect(m_Socket, &QLocalSocket::readyRead, [this] { readMessages(); });
+    QObject::connect(m_Socket, &QLocalSocket::disconnected, [] { QCoreApplication::quit(); });
+  }
+
+  ~WorkerSession() override
+  {
+    if(m_RunThread.joinable())
+    {
+      m_RunThread.join();
+    }
+  }
+
+  bool isRunning() const
+  {
+    return m_RunThread.joinable();
+  }
+
+  void sendReady()
+  {
+    QJsonObject message;
+    message[SIMPLView::WorkerMessage::Type] = SIMPLView::WorkerMessage::Ready;
+    message["Process Id"] = QCoreApplication::applicationPid();
+    send(message);
+  }
+
+  bool event(QEvent* event) override
+  {
+    if(event->type() == k_IssueEventType)
+    {
+      sendMessage(static_cast<IssueEvent*>(event)->m_Message);
+      return true;
+    }
+    if(event->type() == k_WakeEventType)
+    {
+      if(!m_FlushTimer.isActive())
+      {
+        m_FlushTimer.start();
+      }
+      return true;
+    }
+    if(event->type() == k_FinishedEventType)
+    {
+      m_RunThread.join();
+      m_FlushTimer.stop();
+      flushMessages();
+
+      FinishedEvent* finished = static_cast<FinishedEvent*>(event);
+      QJsonObject message;
+      message[SIMPLView::WorkerMessage::Type] = SIMPLView::WorkerMessage::Finished;
+      message["Error Code"] = finished->m_ErrorCode;
+      message["Message"] = finished->m_Message;
+      message["Arrays"] = finished->m_Arrays;
+      send(message);
+
+      // The arrays are in files that the pool owns, nothing has to be held until it read them
+      sendReady();
+      return true;
+    }
+    return QObject::event(event);
+  }
+
+protected:
+  void readMessages()
+  {
+    m_Buffer.append(m_Socket->readAll());
+    QJsonObject message;
+    while(WorkerProtocol::TakeMessage(m_Buffer, message))
+    {
+      QString type = message[SIMPLView::WorkerMessage::Type].toString();
+      if(type == SIMPLView::WorkerMessage::Execute && !isRunning())
+      {
+        QJsonObject pipelineJson = message["Pipeline"].toObject();
+        QString arrayDirectory = message["Array Directory"].toString();
+        m_RunThread = std::thread([this, pipelineJson, arrayDirectory] { executePipeline(pipelineJson, arrayDirectory); });
+      }
+    }
+  }
+
+  void send(const QJsonObject& message)
+  {
+    m_Socket->write(WorkerProtocol::Frame(message));
+    m_Socket->flush();
+  }
+
+  void sendMessage(const PipelineMessage& msg)
+  {
+    QJsonObject message;
+    message[SIMPLView::WorkerMessage::Type] = SIMPLView::WorkerMessage::PipelineMessage;
+    message["Message"] = WorkerProtocol::MessageToJson(msg);
+    send(message);
+  }
+
+  void flushMessages()
+  {
+    PipelineMessageChannel::Batch batch = m_Channel.take();
+    for(int i = 0; i < batch.lines.size(); i++)
+    {
+      sendMessage(PipelineMessage("PipelineWorker", batch.lines[i], 0, batch.lineTypes[i], -1));
+    }
+    if(batch.hasStatus)
+    {
+      sendMessage(PipelineMessage("PipelineWorker", batch.status, 0, PipelineMessage::MessageType::StatusMessage, -1));
+    }
+    if(batch.hasProgress)
+    {
+      PipelineMessage progress("PipelineWorker", QString(), 0, PipelineMessage::MessageType::ProgressValue, -1);
+      progress.setProgressValue(batch.progressValue);
+      sendMessage(progress);
+    }
+  }
+
+  // Runs on m_RunThread
+  void postMessage(const PipelineMessage& msg)
+  {
+    if(msg.getType() == PipelineMessage::MessageType::Error || msg.getType() == PipelineMessage::MessageType::Warning)
+    {
+      QCoreApplication::postEvent(this, new IssueEvent(msg));
+    }
+    else if(m_Channel.post(msg))
+    {
+      QCoreApplication::postEvent(this, new QEvent(k_WakeEventType));
+    }
+  }
+
+  // Runs on m_RunThread
+  void executePipeline(const QJsonObject& pipelineJson, const QString& arrayDirectory)
+  {
+    QTemporaryDir tempDir;
+    QFile file(tempDir.filePath("Pipeline.json"));
+    if(!tempDir.isValid() || !file.open(QIODevice::WriteOnly) || file.write(QJsonDocument(pipelineJson).toJson()) < 0)
+    {
+      QCoreApplication::postEvent(this, new FinishedEvent(-1, QString("The pipeline could not be written to a temporary file"), QJsonObject()));
+      return;
+    }
+    file.close();
+
+    JsonFilterParametersReader::Pointer jsonReader = JsonFilterParametersReader::New();
+    FilterPipeline::Pointer pipeline = jsonReader->readPipelineFromFile(file.fileName());
+    if(nullptr == pipeline.get())
+    {
+      QCoreApplication::postEvent(this, new FinishedEvent(-1, QString("The pipeline could not be read"), QJsonObject()));
+      return;
+    }
+
+    int err = pipeline->preflightPipeline();
+    if(err < 0)
+    {
+      QCoreApplication::postEvent(this, new FinishedEvent(err, QString("The pipeline failed to preflight with error %1").arg(err), QJsonObject()));
+      return;
+    }
+
+    QString message;
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+    for(int i = 0; i < filters.size() && err >= 0; i++)
+    {
+      AbstractFilter::Pointer filter = filters[i];
+      if(!filter->getEnabled())
+      {
+        continue;
+      }
+
+      PipelineMessage progress("PipelineWorker", QString("[%1/%2] %3").arg(i + 1).arg(filters.size()).arg(filter->getHumanLabel()), 0,
+                               PipelineMessage::MessageType::StatusMessageAndProgressValue, i);
+      progress.setProgressValue(100 * i / filters.size());
+      postMessage(progress);
+
+      filter->setDataContainerArray(dca);
+      QMetaObject::Connection connection = QObject::connect(filter.get(), &AbstractFilter::filterGeneratedMessage, [this](const PipelineMessage& msg) { postMessage(msg); });
+      filter->execute();
+      QObject::disconnect(connection);
+
+      err = filter->getErrorCondition();
+      if(err < 0)
+      {
+        message = QString("%1 failed with error %2").arg(filter->getHumanLabel()).arg(err);
+      }
+    }
+
+    QJsonObject arrays;
+    if(err >= 0 && !arrayDirectory.isEmpty())
+    {
+      QString error;
+      arrays = WorkerProtocol::ExportArrays(dca, arrayDirectory, error);
+      if(!error.isEmpty())
+      {
+        postMessage(PipelineMessage("PipelineWorker", error, 0, PipelineMessage::MessageType::Warning, -1));
+      }
+    }
+
+    // The memory goes back before the pool hands out the next pipeline
+    for(AbstractFilter::Pointer filter : filters)
+    {
+      filter->setDataContainerArray(DataContainerArray::NullPointer());
+    }
+    dca = DataContainerArray::NullPointer();
+    pipeline = FilterPipeline::NullPointer();
+
+    QCoreApplication::postEvent(this, new FinishedEvent(err, message, arrays));
+  }
+
+private:
+  QLocalSocket* m_Socket = nullptr;
+  QByteArray m_Buffer;
+  QTimer m_FlushTimer;
+  PipelineMessageChannel m_Channel;
+  std::thread m_RunThread;
+};
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationDomain(BrandedStrings::OrganizationDomain);
+  QCoreApplication::setOrganizationName(BrandedStrings::OrganizationName);
+  QCoreApplication::setApplicationName("PipelineWorker");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Executes pipelines for the worker pool of the GUI");
+  parser.addHelpOption();
+  QCommandLineOption serverOption("server", "The local server of the worker pool to connect to", "name");
+  parser.addOption(serverOption);
+  parser.process(app);
+
+  if(!parser.isSet(serverOption))
+  {
+    parser.showHelp(1);
+  }
+
+  // This is the cost that the pool pays once per worker instead of once per pipeline
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm, true);
+  QMetaObjectUtilities::RegisterMetaTypes();
+
+  QLocalSocket socket;
+  socket.connectToServer(parser.value(serverOption));
+  if(!socket.waitForConnected(5000))
+  {
+    std::cerr << "Could not connect to " << parser.value(serverOption).toStdString() << ": " << socket.errorString().toStdString() << std::endl;
+    return 1;
+  }
+
+  WorkerSession session(&socket);
+  session.sendReady();
+  app.exec();
+
+  // The pool is gone, nobody waits for the result of a pipeline that is still running
+  if(session.isRunning())
+  {
+    std::_Exit(1);
+  }
+  return 0;
+}
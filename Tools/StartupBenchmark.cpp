@@ -0,0 +1,292 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <iostream>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMap>
+#include <QtCore/QProcess>
+#include <QtCore/QProcessEnvironment>
+#include <QtCore/QSaveFile>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QVector>
+
+#include "BrandedStrings.h"
+
+/*
+ * Measures how long the application takes to start, once with every plugin loaded at startup and once with the
+ * filters populated from a warm plugin manifest. The application is launched with --startup-trace and
+ * --quit-after-startup, and the spans of its startup trace are collected over several launches. The first
+ * launch of each mode is not counted, it warms the file system cache and, for the manifest mode, the manifest.
+ */
+
+namespace
+{
+const QStringList k_Spans = {"Total Startup", "SIMPLViewApplication::loadPlugins", "SIMPLViewApplication::registerPluginsFromManifest"};
+
+struct ModeResult
+{
+  QString mode;
+  QVector<qint64> processMSecs;
+  QMap<QString, QVector<qint64>> spanMSecs;
+  int failedLaunches = 0;
+};
+
+// -----------------------------------------------------------------------------
+// Reads the duration of the named complete events from a Chrome trace file
+// -----------------------------------------------------------------------------
+QMap<QString, qint64> readSpans(const QString& traceFilePath)
+{
+  QMap<QString, qint64> spans;
+  QFile file(traceFilePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return spans;
+  }
+  QJsonArray events = QJsonDocument::fromJson(file.readAll()).object()["traceEvents"].toArray();
+  for(const QJsonValue& value : events)
+  {
+    QJsonObject event = value.toObject();
+    QString name = event["name"].toString();
+    if(event["ph"].toString() == "X" && k_Spans.contains(name))
+    {
+      spans[name] += static_cast<qint64>(event["dur"].toDouble()) / 1000;
+    }
+  }
+  return spans;
+}
+
+// -----------------------------------------------------------------------------
+// Launches the application once and returns false if it did not start and quit on its own
+// -----------------------------------------------------------------------------
+bool launch(const QString& executable, const QProcessEnvironment& env, const QString& traceFilePath, int timeoutMSecs, qint64& processMSecs)
+{
+  QFile::remove(traceFilePath);
+
+  QProcess process;
+  process.setProcessEnvironment(env);
+  process.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+  process.setStandardOutputFile(QProcess::nullDevice());
+
+  QElapsedTimer timer;
+  timer.start();
+  process.start(executable, QStringList() << "--new-instance"
+                                          << "--quit-after-startup"
+                                          << "--startup-trace" << traceFilePath);
+  if(!process.waitForFinished(timeoutMSecs))
+  {
+    process.kill();
+    process.waitForFinished();
+    return false;
+  }
+  processMSecs = timer.elapsed();
+  return process.exitStatus() == QProcess::NormalExit && QFile::exists(traceFilePath);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ModeResult runMode(const QString& mode, const QString& executable, const QProcessEnvironment& env, const QString& traceFilePath, int launches, int timeoutMSecs)
+{
+  ModeResult result;
+  result.mode = mode;
+  for(int i = 0; i <= launches; i++)
+  {
+    qint64 processMSecs = 0;
+    if(!launch(executable, env, traceFilePath, timeoutMSecs, processMSecs))
+    {
+      result.failedLaunches++;
+      continue;
+    }
+    if(i == 0)
+    {
+      continue;
+    }
+
+    result.processMSecs.push_back(processMSecs);
+    QMap<QString, qint64> spans = readSpans(traceFilePath);
+    for(QMap<QString, qint64>::const_iterator iter = spans.constBegin(); iter != spans.constEnd(); ++iter)
+    {
+      result.spanMSecs[iter.key()].push_back(iter.value());
+    }
+  }
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject summarize(const QString& name, QVector<qint64> values)
+{
+  QJsonObject json;
+  if(values.isEmpty())
+  {
+    return json;
+  }
+  std::sort(values.begin(), values.end());
+  qint64 total = 0;
+  QJsonArray samples;
+  for(qint64 value : values)
+  {
+    total += value;
+    samples.append(value);
+  }
+  qint64 median = values[values.size() / 2];
+  std::cout << "  " << name.toStdString() << ": median " << median << " ms, min " << values.front() << " ms, max " << values.back() << " ms" << std::endl;
+
+  json["Median MSecs"] = median;
+  json["Min MSecs"] = values.front();
+  json["Max MSecs"] = values.back();
+  json["Mean MSecs"] = static_cast<double>(total) / values.size();
+  json["Samples"] = samples;
+  return json;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject printResult(const ModeResult& result)
+{
+  std::cout << result.mode.toStdString() << " (" << result.processMSecs.size() << " launches";
+  if(result.failedLaunches > 0)
+  {
+    std::cout << ", " << result.failedLaunches << " failed";
+  }
+  std::cout << ")" << std::endl;
+
+  QJsonObject json;
+  json["Mode"] = result.mode;
+  json["Failed Launches"] = result.failedLaunches;
+  json["Process"] = summarize("Process", result.processMSecs);
+  QJsonObject spans;
+  for(const QString& span : k_Spans)
+  {
+    if(result.spanMSecs.contains(span))
+    {
+      spans[span] = summarize(span, result.spanMSecs[span]);
+    }
+  }
+  json["Spans"] = spans;
+  return json;
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("StartupBenchmark");
+
+  QString defaultExecutable = QDir(QCoreApplication::applicationDirPath()).filePath(BrandedStrings::ApplicationName);
+#if defined(Q_OS_WIN)
+  defaultExecutable += ".exe";
+#endif
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Measures the startup of the application with and without the plugin manifest");
+  parser.addHelpOption();
+  QCommandLineOption executableOption("executable", "The application to launch, the one next to this tool by default", "file", defaultExecutable);
+  QCommandLineOption launchesOption("launches", "Measured launches per mode, 5 by default", "count", "5");
+  QCommandLineOption timeoutOption("timeout", "Seconds a single launch may take, 120 by default", "seconds", "120");
+  QCommandLineOption jsonReportOption("json-report", "Write the results to this file", "file");
+  parser.addOption(executableOption);
+  parser.addOption(launchesOption);
+  parser.addOption(timeoutOption);
+  parser.addOption(jsonReportOption);
+  parser.process(app);
+
+  QString executable = parser.value(executableOption);
+  int launches = qMax(1, parser.value(launchesOption).toInt());
+  int timeoutMSecs = qMax(1, parser.value(timeoutOption).toInt()) * 1000;
+  if(!QFile::exists(executable))
+  {
+    std::cerr << "The application " << executable.toStdString() << " does not exist" << std::endl;
+    return 1;
+  }
+
+  QTemporaryDir tempDir;
+  if(!tempDir.isValid())
+  {
+    std::cerr << "Could not create a temporary directory" << std::endl;
+    return 1;
+  }
+  QString traceFilePath = tempDir.filePath("StartupTrace.json");
+
+  // Nothing but the startup itself is measured
+  QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+  env.insert("SIMPL_RESERVE_WINDOW", "0");
+  env.insert("SIMPL_SINGLE_INSTANCE", "0");
+
+  QJsonArray results;
+
+  // Loading every plugin also writes the manifest that the second mode starts from
+  QProcessEnvironment fullLoadEnv = env;
+  fullLoadEnv.insert("SIMPL_PLUGIN_MANIFEST", "0");
+  ModeResult fullLoad = runMode("Full plugin load", executable, fullLoadEnv, traceFilePath, launches, timeoutMSecs);
+  results.append(printResult(fullLoad));
+
+  QProcessEnvironment manifestEnv = env;
+  manifestEnv.insert("SIMPL_PLUGIN_MANIFEST", "1");
+  ModeResult manifest = runMode("Warm plugin manifest", executable, manifestEnv, traceFilePath, launches, timeoutMSecs);
+  results.append(printResult(manifest));
+
+  if(parser.isSet(jsonReportOption))
+  {
+    QSaveFile file(parser.value(jsonReportOption));
+    if(!file.open(QIODevice::WriteOnly))
+    {
+      std::cerr << "Could not open the report file " << parser.value(jsonReportOption).toStdString() << std::endl;
+      return 1;
+    }
+    QJsonObject report;
+    report["Executable"] = executable;
+    report["Launches"] = launches;
+    report["Results"] = results;
+    file.write(QJsonDocument(report).toJson());
+    file.commit();
+  }
+
+  return (fullLoad.failedLaunches > 0 || manifest.failedLaunches > 0) ? 1 : 0;
+}